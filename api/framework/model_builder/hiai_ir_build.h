@@ -73,6 +73,24 @@ public:
 
     void ReleaseModelBuff(ModelBufferData& output);
 
+    /*
+     * @ingroup domi_omg
+     * @brief 权值去重, 合并内容相同的Const/QuantizedConst节点, 需在BuildIRModel/Build之前调用
+     * @param [in] irModel 输入模型数据
+     * @param [out] savedBytes 去重节省的权值字节数
+     * @return Status 执行结果
+     */
+    Status ShareIdenticalWeights(ge::Model& irModel, uint64_t& savedBytes);
+
+    /*
+     * @ingroup domi_omg
+     * @brief 常量折叠, 将输入全为Const的可计算节点替换为Const, 需在BuildIRModel/Build之前调用
+     * @param [in] irModel 输入模型数据
+     * @param [out] foldedNum 被折叠的节点个数
+     * @return Status 执行结果
+     */
+    Status FoldConstants(ge::Model& irModel, uint32_t& foldedNum);
+
     Status Build(const hiai::ModelBuildOptions& options, const std::string& modelName,
         const std::shared_ptr<ge::Model>& model, std::shared_ptr<hiai::IBuiltModel>& builtModel);
 
@@ -30,6 +30,8 @@ enum class DeviceConfigMode { AUTO, MODEL_LEVEL, OP_LEVEL };
 enum class FallBackMode { ENABLE, DISABLE };
 enum class ExecuteDevice { NPU = 0, CPU = 1 };
 enum class TuningStrategy { OFF = 0, ON_DEVICE_TUNING, ON_DEVICE_PREPROCESS_TUNING, ON_CLOUD_TUNING };
+// LOWER_TO_OPS: IR模型中参数全部为Const的AIPP图像算子在编译时展开为普通算子, 用于无硬件AIPP的ROM
+enum class StaticAippMode { HARDWARE = 0, LOWER_TO_OPS };
 static const uint32_t MIN_DYNAMIC_SHAPE_CACHE_NUM = 1;
 static const uint32_t MAX_DYNAMIC_SHAPE_CACHE_NUM = 10;
 struct DynamicShapeConfig {
@@ -54,6 +56,7 @@ struct ModelBuildOptions {
     TuningStrategy tuningStrategy = TuningStrategy::OFF;
     size_t estimatedOutputSize = 0;
     std::string quantizeConfig = "";
+    StaticAippMode staticAippMode = StaticAippMode::HARDWARE;
 };
 } // namespace hiai
 #endif // HIAI_API_MODEL_BUILDER_TYPES_H
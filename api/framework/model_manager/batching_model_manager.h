@@ -0,0 +1,41 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIAI_API_BATCHING_MODEL_MANAGER_H
+#define HIAI_API_BATCHING_MODEL_MANAGER_H
+
+#include "model_manager.h"
+
+namespace hiai {
+struct BatchingOptions {
+    // 一次合并执行的最大请求数, 固定batch模型取该值与模型batch的较小值
+    uint32_t maxBatchSize = 8;
+    // 首个请求入队后等待凑批的最长时间, 越大吞吐越高, 单请求时延越长, 0表示不等待
+    uint32_t maxDelayInUS = 2000;
+};
+
+/*
+ * @brief 创建合批推理的模型管理器, 将并发的单样本请求沿N维拼接后调用一次modelManager的Run,
+ *        再将输出按N拆分回各请求. 模型所有输入输出的第0维为batch维, 取固定值N或-1(动态batch),
+ *        其余维度需为固定值. Run/RunAsync的每个输入输出均为单样本(batch为1),
+ *        outputs为空时由管理器按模型输出创建.
+ * @param [in] modelManager 实际执行推理的模型管理器, Init/DeInit由合批管理器转调
+ * @param [in] options 合批参数
+ * @return 合批模型管理器, 参数非法时返回nullptr
+ */
+HIAI_MM_API_EXPORT std::shared_ptr<IModelManager> CreateBatchingModelManager(
+    const std::shared_ptr<IModelManager>& modelManager, const BatchingOptions& options);
+} // namespace hiai
+#endif // HIAI_API_BATCHING_MODEL_MANAGER_H
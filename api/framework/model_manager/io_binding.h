@@ -0,0 +1,37 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIAI_API_IO_BINDING_H
+#define HIAI_API_IO_BINDING_H
+
+#include <memory>
+#include <vector>
+
+#include "tensor/nd_tensor_buffer.h"
+
+namespace hiai {
+/*
+ * 绑定到某个模型管理器的一组输入输出tensor, 创建时校验一次, 之后Run(binding)直接使用缓存的底层句柄.
+ * 绑定持有tensor的引用, 重复推理时调用者直接改写tensor内容即可; 模型管理器重新Init后绑定失效.
+ */
+class IIOBinding {
+public:
+    virtual ~IIOBinding() = default;
+
+    virtual const std::vector<std::shared_ptr<INDTensorBuffer>>& GetInputs() const = 0;
+    virtual const std::vector<std::shared_ptr<INDTensorBuffer>>& GetOutputs() const = 0;
+};
+} // namespace hiai
+#endif // HIAI_API_IO_BINDING_H
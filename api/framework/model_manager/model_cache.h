@@ -0,0 +1,65 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIAI_API_MODEL_CACHE_H
+#define HIAI_API_MODEL_CACHE_H
+
+#include <string>
+
+#include "model_manager.h"
+
+namespace hiai {
+/*
+ * 进程内已Init模型管理器的缓存, 按模型文件及ModelInitOptions区分. 缓存的模型按模型文件大小计入内存占用,
+ * 超出预算时按最近最少使用淘汰未被调用者持有的模型. 缓存的模型管理器未设置listener, 只支持同步推理.
+ */
+struct ModelCacheOptions {
+    // 缓存模型总大小上限, 单位字节, 0表示不限制
+    uint64_t memoryBudget = 256 * 1024 * 1024;
+    // 加载后空跑一次推理, 使首次Run不再承担运行时的首帧开销
+    bool warmUp = true;
+};
+
+// 时间单位us
+struct ModelCacheStats {
+    uint64_t hitNum = 0;
+    uint64_t missNum = 0;
+    uint64_t evictNum = 0;
+    uint64_t prefetchNum = 0;
+    uint64_t avgLoadTime = 0;
+    uint64_t maxLoadTime = 0;
+    uint64_t usedMemory = 0;
+    uint32_t cachedModelNum = 0;
+};
+
+HIAI_MM_API_EXPORT void SetModelCacheOptions(const ModelCacheOptions& options);
+
+/*
+ * @brief 获取缓存的模型管理器, 未命中时同步加载; 该模型正在后台预加载时等待其完成
+ * @param [in] modelFile om模型文件
+ * @param [out] modelManager 已Init的模型管理器, 调用者持有期间不会被淘汰, 不可调用其DeInit
+ */
+HIAI_MM_API_EXPORT Status GetCachedModelManager(const std::string& modelFile, const ModelInitOptions& options,
+    std::shared_ptr<IModelManager>& modelManager);
+
+// 在后台线程中加载模型并放入缓存, 已缓存或正在加载时直接返回SUCCESS
+HIAI_MM_API_EXPORT Status PrefetchModel(const std::string& modelFile, const ModelInitOptions& options);
+
+HIAI_MM_API_EXPORT Status GetModelCacheStats(ModelCacheStats& stats);
+
+// 清空缓存及统计, 调用者仍持有的模型管理器在释放时卸载
+HIAI_MM_API_EXPORT void ClearModelCache();
+} // namespace hiai
+#endif // HIAI_API_MODEL_CACHE_H
@@ -16,10 +16,23 @@
 #ifndef FRAMEWORK_MODEL_MANAGER_MODEL_MANAGER_EXT_H
 #define FRAMEWORK_MODEL_MANAGER_MODEL_MANAGER_EXT_H
 
+#include <cstdint>
+
 #include "model_manager/model_manager_aipp.h"
 #include "shared_mem_allocator.h"
+#include "io_binding.h"
+#include "shape_gear.h"
 
 namespace hiai {
+// 异步推理完成回调, 在推理完成线程中执行, 不可阻塞
+using RunDoneCallback = void (*)(void* userData, Status result);
+
+// 异步推理句柄, 对应一个预分配的完成槽; 结果被Wait取走(或回调返回)后句柄失效
+struct RunToken {
+    uint32_t slot = UINT32_MAX;
+    uint32_t sequence = 0;
+};
+
 class IModelManagerExt : public IModelManagerAipp {
 public:
     HIAI_MM_API_EXPORT static std::shared_ptr<IModelManagerExt> CreateModelManagerExt();
@@ -29,6 +42,44 @@ public:
     virtual Status Init(const ModelInitOptions& options, const std::shared_ptr<IBuiltModel>& builtModel,
         const std::shared_ptr<IModelManagerListener>& listener,
         const std::shared_ptr<ISharedMemAllocator>& allocator) = 0;
+
+    /*
+     * @brief 绑定输入输出, 校验tensor个数及shape与模型一致, AIPP模型不支持
+     * @return 绑定对象, 校验失败返回nullptr
+     */
+    virtual std::shared_ptr<IIOBinding> CreateIOBinding(const std::vector<std::shared_ptr<INDTensorBuffer>>& inputs,
+        const std::vector<std::shared_ptr<INDTensorBuffer>>& outputs) = 0;
+
+    using IModelManagerAipp::Run;
+    // 同步推理, 不再转换及校验输入输出
+    virtual Status Run(const std::shared_ptr<IIOBinding>& binding) = 0;
+
+    using IModelManagerAipp::RunAsync;
+    /*
+     * @brief 异步推理, 不需要IModelManagerListener, 每次调用不申请内存. 需Init时设置asyncSlotNum,
+     *        binding需保持到推理完成
+     * @param callback 非空时完成后调用callback(userData, result), 此时不能再Wait该token
+     * @return 下发结果, 无空闲完成槽时返回FAILURE
+     */
+    virtual Status RunAsync(const std::shared_ptr<IIOBinding>& binding, int32_t timeoutInMS, RunToken& token,
+        RunDoneCallback callback = nullptr, void* userData = nullptr) = 0;
+
+    /*
+     * 等待结果, timeoutInMS小于0表示一直等待; 超时返回TIMEOUT, 结果保留可再次等待.
+     * 返回SUCCESS时result为推理结果, 对应的token随即失效
+     */
+    virtual Status Wait(const RunToken& token, int32_t timeoutInMS, Status& result) = 0;
+    // 等待任意一个完成, index为完成的token在tokens中的下标
+    virtual Status WaitAny(const std::vector<RunToken>& tokens, int32_t timeoutInMS, size_t& index,
+        Status& result) = 0;
+    // 等待全部完成, 超时则不取走任何结果
+    virtual Status WaitAll(const std::vector<RunToken>& tokens, int32_t timeoutInMS, std::vector<Status>& results) = 0;
+
+    /*
+     * @brief 登记多档位模型的档位, 之后Run(inputs, outputs)按输入shape查表选择档位; outputs为空时返回该档位
+     *        预分配的输出, 不再被持有后复用. 重新Init后失效, gears为空时取消. AIPP模型不支持
+     */
+    virtual Status SetShapeGears(const std::vector<ShapeGear>& gears, const ShapeDispatchOptions& options) = 0;
 };
 } // namespace hiai
 #endif
@@ -45,6 +45,10 @@ enum class PerfMode {
 struct ModelInitOptions {
     PerfMode perfMode = PerfMode::MIDDLE;
     ModelBuildOptions buildOptions;
+    // 共享同一份BuiltModel的运行时实例个数, 取值[1, 16], 多个实例时并发的Run分派到空闲实例上执行
+    uint32_t runtimeInstanceNum = 1;
+    // IModelManagerExt::RunAsync(binding)同时在途的请求数上限, 完成槽在Init时预分配, 0表示不使用, 取值[0, 1024]
+    uint32_t asyncSlotNum = 0;
 };
 
 class Context {
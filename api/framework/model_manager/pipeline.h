@@ -0,0 +1,67 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIAI_API_PIPELINE_H
+#define HIAI_API_PIPELINE_H
+
+#include <functional>
+
+#include "model_manager.h"
+
+namespace hiai {
+// 一帧在相邻两级之间传递的tensor, 上一级的输出直接作为下一级的输入, 不拷贝
+using PipelineTensors = std::vector<std::shared_ptr<INDTensorBuffer>>;
+
+// CPU处理级, 由inputs生成outputs, 返回非SUCCESS时该帧不再进入后续各级
+using PipelineCpuFunc = std::function<Status(const PipelineTensors& inputs, PipelineTensors& outputs)>;
+
+// 帧完成回调, 在最后一级的线程中按送入顺序调用; result非SUCCESS时outputs为出错级的输入
+using PipelineDoneFunc = std::function<void(uint64_t frameId, Status result, const PipelineTensors& outputs)>;
+
+struct PipelineOptions {
+    // 相邻两级之间最多缓存的帧数, 下一级来不及处理时上一级阻塞
+    uint32_t queueDepth = 2;
+};
+
+/*
+ * 多模型流水线: 每一级(模型推理或CPU处理)在独立线程中执行, 第i帧的第k级与第i-1帧的第k+1级并行,
+ * NPU推理与前后处理重叠. 各级按AddXxxStage的顺序串联, Start之后不能再增加.
+ */
+class IPipeline {
+public:
+    virtual ~IPipeline() = default;
+
+    /*
+     * @brief 增加一级模型推理, 输入为上一级的全部输出
+     * @param [in] modelManager 已Init的模型管理器, 由调用者负责生命周期
+     * @param [in] builtModel modelManager加载的模型, 用于按输出描述创建输出tensor, 输出tensor在流水线内复用
+     */
+    virtual Status AddModelStage(
+        const std::shared_ptr<IModelManager>& modelManager, const std::shared_ptr<IBuiltModel>& builtModel) = 0;
+
+    virtual Status AddCpuStage(const PipelineCpuFunc& func) = 0;
+
+    virtual Status Start(const PipelineDoneFunc& done) = 0;
+
+    // 送入一帧, 第一级的队列满时阻塞
+    virtual Status Submit(uint64_t frameId, const PipelineTensors& inputs) = 0;
+
+    // 等待已送入的帧全部完成后停止各级线程
+    virtual void Stop() = 0;
+};
+
+HIAI_MM_API_EXPORT std::shared_ptr<IPipeline> CreatePipeline(const PipelineOptions& options);
+} // namespace hiai
+#endif // HIAI_API_PIPELINE_H
@@ -0,0 +1,48 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIAI_API_REQUEST_SCHEDULER_H
+#define HIAI_API_REQUEST_SCHEDULER_H
+
+#include "model_manager_api_export.h"
+#include "model_manager_types.h"
+#include "base/error_types.h"
+
+namespace hiai {
+/*
+ * 进程内所有IModelManager共享的请求调度参数. 请求按模型优先级(SetPriority设置)排队,
+ * 高优先级先执行, 排队越久的请求优先级逐级提升. 异步请求只在下发期间占用并发名额.
+ */
+struct RequestSchedulerOptions {
+    // 同时执行的请求数上限, 0表示不限制(不排队)
+    uint32_t maxConcurrency = 0;
+    // 排队每满该时长提升一级优先级, 0表示不提升
+    uint32_t agingIntervalInMS = 100;
+};
+
+// requestNum/cancelledNum为进程内累计值, 时延取最近1024个请求统计, 单位us
+struct RequestSchedulerStats {
+    uint64_t requestNum = 0;
+    uint64_t cancelledNum = 0;
+    uint64_t avgQueueDelay = 0;
+    uint64_t p99QueueDelay = 0;
+    uint64_t p99Latency = 0; // 排队 + 执行
+};
+
+HIAI_MM_API_EXPORT void SetRequestSchedulerOptions(const RequestSchedulerOptions& options);
+
+HIAI_MM_API_EXPORT Status GetRequestSchedulerStats(ModelPriority priority, RequestSchedulerStats& stats);
+} // namespace hiai
+#endif // HIAI_API_REQUEST_SCHEDULER_H
@@ -0,0 +1,40 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIAI_API_SHAPE_GEAR_H
+#define HIAI_API_SHAPE_GEAR_H
+
+#include <vector>
+
+#include "model_manager_api_export.h"
+#include "tensor/nd_tensor_desc.h"
+#include "base/error_types.h"
+
+namespace hiai {
+// 多档位(静态多shape)模型的一个档位, 各维度均为固定值
+struct ShapeGear {
+    std::vector<NDTensorDesc> inputDescs;
+    std::vector<NDTensorDesc> outputDescs;
+};
+
+struct ShapeDispatchOptions {
+    // 输入shape不属于任何档位时, 在CPU上补零到各维度均不小于输入的最小档位, 输出为该档位的shape
+    bool padToLargerGear = false;
+};
+
+// 读取om多档位模型的全部档位, 最多16档
+HIAI_MM_API_EXPORT Status GetShapeGears(const char* modelFile, std::vector<ShapeGear>& gears);
+} // namespace hiai
+#endif // HIAI_API_SHAPE_GEAR_H
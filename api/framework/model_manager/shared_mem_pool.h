@@ -0,0 +1,50 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIAI_API_SHARED_MEM_POOL_H
+#define HIAI_API_SHARED_MEM_POOL_H
+
+#include "shared_mem_allocator.h"
+#include "base/error_types.h"
+
+namespace hiai {
+/*
+ * 带缓存的共享内存分配器, 包装调用者的ISharedMemAllocator. 申请大小向上取整到档位(每个2的幂区间分4档),
+ * 释放的内存按档位缓存, 同一分配器用于多次模型Init时直接复用, 不再反复申请ion/dmabuf.
+ * C接口onAllocate的handlesSize仅为出参, 运行时按10个handle分配数组,
+ * 因此被包装的分配器单次Allocate返回的handle仍不能超过10个.
+ */
+struct SharedMemPoolOptions {
+    // 缓存的空闲内存上限, 单位字节, 超出时优先归还最大的块; 为0时不限制
+    uint64_t maxCachedBytes = 64 * 1024 * 1024;
+};
+
+struct SharedMemPoolStats {
+    uint64_t allocateNum = 0;
+    uint64_t hitNum = 0; // 命中率 = hitNum / allocateNum
+    uint64_t inUseBytes = 0; // 已分配出去的块, 按档位大小累计
+    uint64_t requestedBytes = 0; // 已分配出去的块, 按申请大小累计; 内部碎片 = inUseBytes - requestedBytes
+    uint64_t cachedBytes = 0;
+    uint32_t cachedBlockNum = 0;
+};
+
+HIAI_MM_API_EXPORT std::shared_ptr<ISharedMemAllocator> CreatePooledSharedMemAllocator(
+    const std::shared_ptr<ISharedMemAllocator>& allocator, const SharedMemPoolOptions& options);
+
+// allocator须由CreatePooledSharedMemAllocator创建, 否则返回INVALID_PARAM
+HIAI_MM_API_EXPORT Status GetSharedMemPoolStats(
+    const std::shared_ptr<ISharedMemAllocator>& allocator, SharedMemPoolStats& stats);
+} // namespace hiai
+#endif // HIAI_API_SHARED_MEM_POOL_H
@@ -0,0 +1,41 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FRAMEWORK_TENSOR_AIPP_CPU_EXECUTOR_H
+#define FRAMEWORK_TENSOR_AIPP_CPU_EXECUTOR_H
+
+#include <memory>
+
+#include "tensor_api_export.h"
+#include "base/error_types.h"
+#include "aipp_para.h"
+#include "image_tensor_buffer.h"
+#include "nd_tensor_buffer.h"
+
+namespace hiai {
+/*
+ * @brief 在CPU上按aippPara执行AIPP预处理(crop -> 通道交换 -> CSC -> resize -> DTC -> padding),
+ *        用于无硬件AIPP的设备或在主机上校验AIPP模型的输入.
+ * @param [in] aippPara AIPP参数, 与下发给NPU的参数布局一致, 不支持旋转
+ * @param [in] image 输入图片, batch为1时所有AIPP batch共用该图片, 否则batch需与aippPara的batch数一致
+ *                    CreateImageTensorBufferFromPlanes创建的图片按各平面行跨度直接读取, 不做重排
+ * @param [in] output 输出tensor, FLOAT32, NCHW, N为AIPP batch数, C取1~4
+ * @return Status SUCCESS: 成功, 其他: 参数非法
+ */
+HIAI_TENSOR_API_EXPORT Status ExecuteAippOnCpu(const std::shared_ptr<IAIPPPara>& aippPara,
+    const std::shared_ptr<IImageTensorBuffer>& image, const std::shared_ptr<INDTensorBuffer>& output);
+} // namespace hiai
+
+#endif // FRAMEWORK_TENSOR_AIPP_CPU_EXECUTOR_H
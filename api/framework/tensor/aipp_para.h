@@ -64,6 +64,26 @@ public:
 };
 
 HIAI_TENSOR_API_EXPORT std::shared_ptr<IAIPPPara> CreateAIPPPara(uint32_t batchCount = 1);
+
+// batch interface for multi-batch aippPara, paras[i] is applied to batch i, size of paras must equal batch count
+HIAI_TENSOR_API_EXPORT Status SetBatchCropPara(
+    const std::shared_ptr<IAIPPPara>& aippPara, const std::vector<CropPara>& cropParas);
+HIAI_TENSOR_API_EXPORT Status SetBatchResizePara(
+    const std::shared_ptr<IAIPPPara>& aippPara, const std::vector<ResizePara>& resizeParas);
+HIAI_TENSOR_API_EXPORT Status SetBatchPaddingPara(
+    const std::shared_ptr<IAIPPPara>& aippPara, const std::vector<PadPara>& paddingParas);
+HIAI_TENSOR_API_EXPORT Status SetBatchDtcPara(
+    const std::shared_ptr<IAIPPPara>& aippPara, const std::vector<DtcPara>& dtcParas);
+
+/*
+ * AIPP参数快照, 创建后只读. 逐帧使用相同配置时, 先配置一次aippPara并生成快照,
+ * 之后每帧通过ApplyAIPPParaSnapshot以一次内存拷贝写入batch数相同的aippPara, 无需逐项重新设置.
+ */
+class AIPPParaSnapshot;
+HIAI_TENSOR_API_EXPORT std::shared_ptr<const AIPPParaSnapshot> CreateAIPPParaSnapshot(
+    const std::shared_ptr<IAIPPPara>& aippPara);
+HIAI_TENSOR_API_EXPORT Status ApplyAIPPParaSnapshot(
+    const std::shared_ptr<const AIPPParaSnapshot>& snapshot, const std::shared_ptr<IAIPPPara>& aippPara);
 } // namespace hiai
 
 #endif // FRAMEWORK_BUFFER_AIPP_TENSOR_BUFFER_H
@@ -0,0 +1,84 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FRAMEWORK_TENSOR_IMAGE_CONVERT_H
+#define FRAMEWORK_TENSOR_IMAGE_CONVERT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "tensor_api_export.h"
+#include "base/error_types.h"
+#include "image_format.h"
+#include "image_tensor_buffer.h"
+
+namespace hiai {
+// YUV420SP中UV分量的排列顺序
+enum class YuvSemiPlanarOrder {
+    NV12, // Y平面后为UVUV...
+    NV21, // Y平面后为VUVU...
+};
+
+/*
+ * 以下接口在主机侧完成图像格式转换, 结果直接写入dst的内存, dst的batch/height/width即为转换的尺寸,
+ * src需按dst的尺寸连续存放batch张图片. 色域转换使用与AIPP CSC相同的定点系数.
+ */
+
+/*
+ * @brief NV12/NV21转换为RGB888/BGR888/XRGB8888
+ * @param [in] src 源图片数据, 大小为batch * height * width * 3 / 2, height与width需为偶数
+ * @param [in] order src中UV的排列顺序
+ * @param [in] colorSpace src的色域
+ * @param [in] dst 目标图片, 格式为RGB888/BGR888/XRGB8888, XRGB8888的X填充为255
+ */
+HIAI_TENSOR_API_EXPORT Status ConvertYuv420SPToRgb(const uint8_t* src, size_t srcSize, YuvSemiPlanarOrder order,
+    ImageColorSpace colorSpace, const std::shared_ptr<IImageTensorBuffer>& dst);
+
+/*
+ * @brief RGB888/BGR888/XRGB8888转换为NV12/NV21, 色度取2x2像素均值
+ * @param [in] src 源图片数据, 按srcFormat交织存放
+ * @param [in] srcFormat src的格式, 支持RGB888/BGR888/XRGB8888
+ * @param [in] order dst中UV的排列顺序
+ * @param [in] dst 目标图片, 格式为YUV420SP, 使用dst的色域
+ */
+HIAI_TENSOR_API_EXPORT Status ConvertRgbToYuv420SP(const uint8_t* src, size_t srcSize, ImageFormat srcFormat,
+    YuvSemiPlanarOrder order, const std::shared_ptr<IImageTensorBuffer>& dst);
+
+/*
+ * @brief YUYV(Y0 U0 Y1 V0)重排为YUV422SP(Y平面 + UV交织平面)
+ * @param [in] dst 目标图片, 格式为YUV422SP, width需为偶数
+ */
+HIAI_TENSOR_API_EXPORT Status ConvertYuyvToYuv422SP(
+    const uint8_t* src, size_t srcSize, const std::shared_ptr<IImageTensorBuffer>& dst);
+
+/*
+ * @brief 平面(CHW)数据交织为dst的格式(HWC)
+ * @param [in] src 每张图片按通道依次存放height * width大小的平面
+ * @param [in] dst 目标图片, 格式为RGB888/BGR888/XRGB8888/ARGB8888, 平面个数与其通道数一致
+ */
+HIAI_TENSOR_API_EXPORT Status ConvertPlanarToInterleaved(
+    const uint8_t* src, size_t srcSize, const std::shared_ptr<IImageTensorBuffer>& dst);
+
+/*
+ * @brief 交织图片(HWC)拆分为平面(CHW)数据
+ * @param [in] src 源图片, 格式为RGB888/BGR888/XRGB8888/ARGB8888
+ * @param [out] dst 输出缓存, 大小需为src的大小
+ */
+HIAI_TENSOR_API_EXPORT Status ConvertInterleavedToPlanar(
+    const std::shared_ptr<IImageTensorBuffer>& src, uint8_t* dst, size_t dstSize);
+} // namespace hiai
+
+#endif // FRAMEWORK_TENSOR_IMAGE_CONVERT_H
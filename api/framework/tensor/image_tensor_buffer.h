@@ -16,7 +16,9 @@
 #ifndef _HIAI_IMAGE_BUFFER_H_
 #define _HIAI_IMAGE_BUFFER_H_
 
+#include <functional>
 #include <memory>
+#include <vector>
 
 #include "nd_tensor_buffer.h"
 #include "buffer.h"
@@ -39,5 +41,26 @@ HIAI_TENSOR_API_EXPORT std::shared_ptr<IImageTensorBuffer> CreateImageTensorBuff
     ImageFormat format, ImageColorSpace colorSpace, int32_t rotation);
 HIAI_TENSOR_API_EXPORT std::shared_ptr<IImageTensorBuffer> CreateImageTensorBufferFromHandle(const NativeHandle& handle,
     int32_t b, int32_t h, int32_t w, ImageFormat format, ImageColorSpace colorSpace, int32_t rotation);
+
+/*
+ * 外部内存中的图像平面. 半平面格式(YUV420SP/YUV422SP)planes[0]为Y平面, planes[1]为UV平面, 其他格式只有planes[0].
+ * stride为相邻两行起始地址的字节差, 不小于该平面一行紧密排列的字节数.
+ */
+struct ImagePlane {
+    void* data {nullptr};
+    size_t stride {0};
+};
+
+/*
+ * @brief 直接引用外部(相机/解码器)帧内存创建单batch图片, 不拷贝数据
+ * @param [in] planes 各平面地址与行跨度, 个数需与图片格式的平面数一致
+ * @param [in] release 图片对象析构时调用, 用于归还帧内存, 可为空; 创建失败时不调用, 内存仍归调用者所有
+ * @return 失败返回nullptr
+ * @note 各平面连续存放且行跨度一致(UV平面紧跟在对齐后的Y平面之后)时, 行跨度作为AIPP输入宽度下发, NPU推理无需重排;
+ *       平面不连续时仅支持ExecuteAippOnCpu等CPU处理, GetData()/GetSize()只覆盖planes[0].
+ */
+HIAI_TENSOR_API_EXPORT std::shared_ptr<IImageTensorBuffer> CreateImageTensorBufferFromPlanes(
+    const std::vector<ImagePlane>& planes, int32_t h, int32_t w, ImageFormat format, ImageColorSpace colorSpace,
+    int32_t rotation, const std::function<void()>& release);
 }; // namespace hiai
 #endif
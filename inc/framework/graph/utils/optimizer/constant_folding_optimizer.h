@@ -0,0 +1,42 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FRAMEWORK_GRAPH_UTILS_OPTIMIZER_CONSTANT_FOLDING_OPTIMIZER_H
+#define FRAMEWORK_GRAPH_UTILS_OPTIMIZER_CONSTANT_FOLDING_OPTIMIZER_H
+
+#include <cstdint>
+
+#include "graph/graph_api_export.h"
+#include "base/error_types.h"
+
+namespace ge {
+class ComputeGraph;
+
+class ConstantFoldingOptimizer {
+public:
+    /*
+     * @brief 在CPU上计算输入全部为Const的节点, 并用单个Const替换.
+     *        支持Reshape/ExpandDims/Squeeze/Flatten/Permute/CastT/Add/Sub/Mul/RealDiv,
+     *        其余算子或不支持的数据类型保持原样.
+     * @param [in] graph 待优化的图(含子图)
+     * @param [out] foldedNum 被折叠的节点个数
+     * @return hiai::Status SUCCESS: 优化成功, 其他: 图修改失败
+     */
+    GRAPH_API_EXPORT static hiai::Status Optimize(ComputeGraph& graph, std::uint32_t& foldedNum);
+};
+} // namespace ge
+
+#endif // FRAMEWORK_GRAPH_UTILS_OPTIMIZER_CONSTANT_FOLDING_OPTIMIZER_H
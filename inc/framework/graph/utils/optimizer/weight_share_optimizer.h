@@ -0,0 +1,41 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FRAMEWORK_GRAPH_UTILS_OPTIMIZER_WEIGHT_SHARE_OPTIMIZER_H
+#define FRAMEWORK_GRAPH_UTILS_OPTIMIZER_WEIGHT_SHARE_OPTIMIZER_H
+
+#include <cstdint>
+
+#include "graph/graph_api_export.h"
+#include "base/error_types.h"
+
+namespace ge {
+class ComputeGraph;
+
+class WeightShareOptimizer {
+public:
+    /*
+     * @brief 合并图(含子图)中权值内容与TensorDesc完全相同的Const/QuantizedConst节点,
+     *        消费者统一连接到首个出现的常量节点, 重复节点被删除.
+     * @param [in] graph 待优化的图
+     * @param [out] savedBytes 去重后节省的权值字节数
+     * @return hiai::Status SUCCESS: 优化成功, 其他: 图修改失败
+     */
+    GRAPH_API_EXPORT static hiai::Status Optimize(ComputeGraph& graph, std::uint64_t& savedBytes);
+};
+} // namespace ge
+
+#endif // FRAMEWORK_GRAPH_UTILS_OPTIMIZER_WEIGHT_SHARE_OPTIMIZER_H
@@ -0,0 +1,114 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __COMMON_RW_MUTEX_H__
+#define __COMMON_RW_MUTEX_H__
+#include <cstdint>
+#include <mutex>
+#include <condition_variable>
+
+namespace hiai {
+/*
+ * 读写锁(C++11无std::shared_mutex), 写者优先: 有写者等待时新的读者阻塞, 避免生命周期操作被持续的推理请求饿死.
+ * 不可重入, 持有读锁时不能再次加读锁或写锁.
+ */
+class RWMutex {
+public:
+    RWMutex() = default;
+    ~RWMutex() = default;
+    RWMutex(const RWMutex&) = delete;
+    RWMutex& operator=(const RWMutex&) = delete;
+
+    void LockShared()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        readCond_.wait(lock, [this] { return !writing_ && waitingWriters_ == 0; });
+        readers_++;
+    }
+
+    void UnlockShared()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        readers_--;
+        if (readers_ == 0 && waitingWriters_ != 0) {
+            writeCond_.notify_one();
+        }
+    }
+
+    void Lock()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        waitingWriters_++;
+        writeCond_.wait(lock, [this] { return !writing_ && readers_ == 0; });
+        waitingWriters_--;
+        writing_ = true;
+    }
+
+    void Unlock()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        writing_ = false;
+        if (waitingWriters_ != 0) {
+            writeCond_.notify_one();
+        } else {
+            readCond_.notify_all();
+        }
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable readCond_;
+    std::condition_variable writeCond_;
+    uint32_t readers_ {0};
+    uint32_t waitingWriters_ {0};
+    bool writing_ {false};
+};
+
+class ReadLockGuard {
+public:
+    explicit ReadLockGuard(RWMutex& mutex) : mutex_(mutex)
+    {
+        mutex_.LockShared();
+    }
+    ~ReadLockGuard()
+    {
+        mutex_.UnlockShared();
+    }
+    ReadLockGuard(const ReadLockGuard&) = delete;
+    ReadLockGuard& operator=(const ReadLockGuard&) = delete;
+
+private:
+    RWMutex& mutex_;
+};
+
+class WriteLockGuard {
+public:
+    explicit WriteLockGuard(RWMutex& mutex) : mutex_(mutex)
+    {
+        mutex_.Lock();
+    }
+    ~WriteLockGuard()
+    {
+        mutex_.Unlock();
+    }
+    WriteLockGuard(const WriteLockGuard&) = delete;
+    WriteLockGuard& operator=(const WriteLockGuard&) = delete;
+
+private:
+    RWMutex& mutex_;
+};
+} // namespace hiai
+#endif
@@ -16,6 +16,7 @@
 
 #include "framework/compatible/ir_transformer.h"
 #include <algorithm>
+#include <unordered_map>
 #include "array_op_transformer.h"
 #include "math_op_transformer.h"
 #include "nn_op_transformer.h"
@@ -29,6 +30,7 @@
 #include "framework/graph/core/node/node_spec.h"
 #include "framework/graph/core/node/node_sub_graph.h"
 #include "framework/graph/core/cgraph/graph_list_walker.h"
+#include "framework/graph/debug/ge_graph_attr_define.h"
 #include "framework/util/rom_version_util.h"
 #include "graph/op/const_defs.h"
 
@@ -51,7 +53,7 @@ struct ConvertConfig {
 };
 
 // 算子版本 0 <-> 3 映射表
-const static std::map<std::string, ConvertConfig> IR_DEF_CONVERT_MAP = {
+const static std::unordered_map<std::string, ConvertConfig> IR_DEF_CONVERT_MAP = {
     {"HardSwish", {HardSwishConverter, {"Activation", false, {}}}},
     {"Select", {SelectConverter, {"", false, {}}}},
     {"SpaceToDepth", {SpaceToDepthConverter, {"", true, {}}}},
@@ -236,7 +238,7 @@ const static std::map<std::string, ConvertConfig> IR_DEF_CONVERT_MAP = {
 };
 
 /* Reserved attr verify map */
-const static std::map<std::string, OP_VERIFY_FUNC> IR_VERIFY_MAP = {
+const static std::unordered_map<std::string, OP_VERIFY_FUNC> IR_VERIFY_MAP = {
     {"Data", DataVerify},
     {"FullyConnection", FullyConnectionVerify},
     {"Scale", ScaleVerify},
@@ -265,7 +267,7 @@ const static std::map<std::string, OP_VERIFY_FUNC> IR_VERIFY_MAP = {
 const static std::vector<std::string> IR_NEED_CONVERT_VEC = {"HardSwish"};
 
 // 算子版本 3 <-> 5 映射表
-const static std::map<std::string, ConvertConfig> OM_DEF_CONVERT_MAP = {
+const static std::unordered_map<std::string, ConvertConfig> OM_DEF_CONVERT_MAP = {
     {"MirrorPad", {MirrorPadOMConverter, {"", false, {}}}},
     {"Convolution", {ConvOMConverter, {"", false, {}}}},
     {"Correlation", {ConvOMConverter, {"", false, {}}}},
@@ -338,32 +340,62 @@ const static std::map<std::string, ConvertConfig> OM_DEF_CONVERT_MAP = {
 };
 
 namespace {
-static void GetRomVersion(bool& isOldRom, bool& is990C20Rom, string& aiRomVersion)
+// 整图转换前解析一次ROM版本, 避免逐节点重复截取和比较版本字符串
+struct RomVersionInfo {
+    bool isOldIrRom = false; // true : rom <= 100.320, 使用版本0的IR
+    bool is990C20Rom = false;
+    bool isOldOmRom = false; // true : old rom(< 100.333) ; false : new rom (>= 100.333)
+};
+
+RomVersionInfo ParseRomVersion(const string& romVersion)
 {
-    if (aiRomVersion.empty()) {
-        return;
+    RomVersionInfo info;
+    if (romVersion.empty()) {
+        return info;
     }
 
-    bool is3rdRomVersion = Is3rdRomVersion(aiRomVersion.c_str());
+    bool is3rdRomVersion = Is3rdRomVersion(romVersion.c_str());
 
+    string aiRomVersion = romVersion;
     if (aiRomVersion.length() > BASE_990C20_VERSION.length()) {
         aiRomVersion = aiRomVersion.substr(0, BASE_990C20_VERSION.length());
-        is990C20Rom = aiRomVersion == BASE_990C20_VERSION;
+        info.is990C20Rom = aiRomVersion == BASE_990C20_VERSION;
         aiRomVersion = aiRomVersion.substr(0, BASE_ROM_VERSION.length());
     }
-
     if (aiRomVersion <= BASE_ROM_VERSION && !is3rdRomVersion) {
-        isOldRom = true;
+        info.isOldIrRom = true;
     }
+
+    if (!is3rdRomVersion) {
+        string omRomVersion = romVersion.substr(0, BASE_UX11_VERSION.length());
+        if (omRomVersion < BASE_UX11_VERSION || omRomVersion == BASE_BALC10_VERSION) {
+            info.isOldOmRom = true;
+        }
+    }
+    return info;
 }
 
-// convert ir version between 0 <-> 3
-bool IRConverter(ge::Node& node, string aiRomVersion, bool& isGraphChanged)
+/*
+ * 合并权重延迟拆分时Const仍通过merged_offset引用输入模型的WEIGHTS_DATA, 数据为空.
+ * 算子转换会读取、改写或新增权重, 调用任一转换函数前先拆分整图的合并权重.
+ */
+bool SplitMergedWeightBeforeConvert(ge::Node& node)
 {
-    bool isOldRom = false; // newRom
-    bool is990C20Rom = false;
+    ge::ComputeGraph& graph = node.ROLE(NodeSpec).OwnerComputeGraph();
+    if (!graph.HasAttr(SRC_MERGED_WEIGHT_ADDR) || !graph.HasAttr(SRC_MERGED_WEIGHT_SIZE)) {
+        return true;
+    }
+    if (SplitGraphMergedWeight(graph) != ge::GRAPH_SUCCESS) {
+        FMK_LOGE("split graph merged weight failed");
+        return false;
+    }
+    return true;
+}
 
-    GetRomVersion(isOldRom, is990C20Rom, aiRomVersion);
+// convert ir version between 0 <-> 3
+bool IRConverter(ge::Node& node, const RomVersionInfo& romInfo, bool& isGraphChanged)
+{
+    bool isOldRom = romInfo.isOldIrRom;
 
     ge::OpDesc& opDesc = node.ROLE(NodeSpec).OpDesc();
 
@@ -397,7 +429,10 @@ bool IRConverter(ge::Node& node, string aiRomVersion, bool& isGraphChanged)
         // for hardswish
         if (std::find(IR_NEED_CONVERT_VEC.begin(), IR_NEED_CONVERT_VEC.end(), opDesc.GetType()) !=
             IR_NEED_CONVERT_VEC.end()) {
-            isOldToNew = !is990C20Rom;
+            isOldToNew = !romInfo.is990C20Rom;
+        }
+        if (!SplitMergedWeightBeforeConvert(node)) {
+            return false;
         }
         if (convertItem->second.func(node, convertItem->second.cfg, isOldToNew) != ge::GRAPH_SUCCESS) {
             FMK_LOGE("IR mapping failed");
@@ -408,18 +443,9 @@ bool IRConverter(ge::Node& node, string aiRomVersion, bool& isGraphChanged)
 }
 
 // convert ir version between 3 <-> 5
-bool OMConverter(ge::Node& node, string aiRomVersion, bool& isGraphChanged)
+bool OMConverter(ge::Node& node, const RomVersionInfo& romInfo, bool& isGraphChanged)
 {
-    bool isOldRom = false; // true : old rom(< 100.333) ; false : new rom (>= 100.333)
-    bool is3rdRomVersion = Is3rdRomVersion(aiRomVersion.c_str());
-    if (!is3rdRomVersion && !aiRomVersion.empty()) {
-        if (aiRomVersion.length() > BASE_UX11_VERSION.length()) {
-            aiRomVersion = aiRomVersion.substr(0, BASE_UX11_VERSION.length());
-        }
-        if (aiRomVersion < BASE_UX11_VERSION || aiRomVersion == BASE_BALC10_VERSION) {
-            isOldRom = true;
-        }
-    }
+    bool isOldRom = romInfo.isOldOmRom;
 
     ge::OpDesc& opDesc = node.ROLE(NodeSpec).OpDesc();
     int versionIR = 0;
@@ -452,6 +478,9 @@ bool OMConverter(ge::Node& node, string aiRomVersion, bool& isGraphChanged)
         if (modelFlag && (nodeType == "MatMul" || nodeType == "ConcatD")) {
             return true;
         }
+        if (!SplitMergedWeightBeforeConvert(node)) {
+            return false;
+        }
         if (convertItem->second.func(node, convertItem->second.cfg, isOldToNew) != ge::GRAPH_SUCCESS) {
             FMK_LOGE("IR mapping failed");
             return false;
@@ -476,23 +505,20 @@ bool IRTransformer::IsCompatible(ge::ComputeGraphPtr graph, string hiaiRomVersio
         hiaiRomVersion = hiaiRomVersion.substr(0, BASE_UX11_VERSION.length());
     }
 
-    auto visitor = [&hiaiRomVersion](ge::Node& node) {
+    // 各IR版本与当前ROM是否兼容只与ROM版本相关, 遍历前一次性判定
+    const bool isV5Incompatible = hiaiRomVersion < BASE_UX11_VERSION || hiaiRomVersion == BASE_BALC10_VERSION;
+    const bool isV3Incompatible = hiaiRomVersion < BASE_VERSION3_BASE ||
+        (hiaiRomVersion >= BASE_UX11_VERSION && hiaiRomVersion != BASE_BALC10_VERSION);
+    const bool isV0Incompatible = hiaiRomVersion > BASE_ROM_VERSION;
+
+    auto visitor = [isV5Incompatible, isV3Incompatible, isV0Incompatible](ge::Node& node) {
         ge::OpDesc& opDesc = node.ROLE(NodeSpec).OpDesc();
         int versionIR = 0;
         (void)ge::AttrUtils::GetInt(opDesc, OP_VERSION, versionIR);
-        if (versionIR == VESION_VALUE_FIVE) {
-            if (hiaiRomVersion < BASE_UX11_VERSION || hiaiRomVersion == BASE_BALC10_VERSION) {
-                return hiai::COMM_EXCEPTION;
-            }
-        } else if (versionIR == VESION_VALUE_THREE) {
-            if (hiaiRomVersion < BASE_VERSION3_BASE ||
-                (hiaiRomVersion >= BASE_UX11_VERSION && hiaiRomVersion != BASE_BALC10_VERSION)) {
-                return hiai::COMM_EXCEPTION;
-            }
-        } else if (versionIR == VESION_VALUE_DEFAULT) {
-            if (hiaiRomVersion > BASE_ROM_VERSION) {
-                return hiai::COMM_EXCEPTION;
-            }
+        if ((versionIR == VESION_VALUE_FIVE && isV5Incompatible) ||
+            (versionIR == VESION_VALUE_THREE && isV3Incompatible) ||
+            (versionIR == VESION_VALUE_DEFAULT && isV0Incompatible)) {
+            return hiai::COMM_EXCEPTION;
         }
         return hiai::SUCCESS;
     };
@@ -533,27 +559,29 @@ bool IRTransformer::TransferToTargetVersion(ge::ComputeGraphPtr graph, string ai
     };
 
     (void)graph->ROLE(GraphListWalker).WalkAllNodes(visitor);
+
+    const RomVersionInfo romInfo = ParseRomVersion(aiRomVersion);
     for (const auto node : cacheNodes) {
         ge::OpDesc& opDesc = node->ROLE(NodeSpec).OpDesc();
         int versionIR = 0;
         (void)ge::AttrUtils::GetInt(opDesc, OP_VERSION, versionIR);
 
         if (versionIR == VESION_VALUE_DEFAULT || versionIR == VESION_VALUE_THREE) {
-            if (!IRConverter(*node, aiRomVersion, isGraphChanged)) {
+            if (!IRConverter(*node, romInfo, isGraphChanged)) {
                 FMK_LOGE("ir converter failed.");
                 return false;
             }
-            if (!OMConverter(*node, aiRomVersion, isGraphChanged)) {
+            if (!OMConverter(*node, romInfo, isGraphChanged)) {
                 FMK_LOGE("om converter failed.");
                 return false;
             }
         }
         if (versionIR == VESION_VALUE_FIVE) {
-            if (!OMConverter(*node, aiRomVersion, isGraphChanged)) {
+            if (!OMConverter(*node, romInfo, isGraphChanged)) {
                 FMK_LOGE("om converter failed.");
                 return false;
             }
-            if (!IRConverter(*node, aiRomVersion, isGraphChanged)) {
+            if (!IRConverter(*node, romInfo, isGraphChanged)) {
                 FMK_LOGE("ir converter failed.");
                 return false;
             }
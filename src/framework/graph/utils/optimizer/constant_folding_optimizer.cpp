@@ -0,0 +1,563 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "framework/graph/utils/optimizer/constant_folding_optimizer.h"
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "graph/op/array_defs.h"
+#include "graph/op/const_defs.h"
+#include "graph/op/detection_defs.h"
+#include "graph/op/math_defs.h"
+#include "graph/tensor.h"
+#include "graph/buffer.h"
+
+#include "infra/base/assertion.h"
+
+#include "framework/graph/core/cgraph/compute_graph.h"
+#include "framework/graph/core/cgraph/graph_list_walker.h"
+#include "framework/graph/core/cgraph/graph_modifier.h"
+#include "framework/graph/core/cgraph/graph_spec.h"
+#include "framework/graph/core/cgraph/graph_topo_walker.h"
+#include "framework/graph/core/node/node.h"
+#include "framework/graph/core/node/node_spec.h"
+#include "framework/graph/core/node/node_walker.h"
+#include "framework/graph/core/node/node_sub_graph.h"
+#include "framework/graph/core/edge/edge.h"
+#include "framework/graph/core/op/op_desc.h"
+#include "framework/graph/utils/attr_utils.h"
+#include "framework/graph/utils/op_desc_utils.h"
+#include "framework/graph/debug/ge_graph_attr_define.h"
+#include "framework/infra/log/log.h"
+
+namespace ge {
+namespace {
+using ConstTensors = std::vector<TensorPtr>;
+// 返回false表示当前节点不满足折叠条件, 保持原样
+using FoldKernel = bool (*)(const OpDesc& opDesc, const ConstTensors& inputs, TensorPtr& output);
+
+size_t ElementSize(DataType dataType)
+{
+    switch (dataType) {
+        case DT_FLOAT:
+        case DT_INT32:
+            return sizeof(int32_t);
+        case DT_INT64:
+            return sizeof(int64_t);
+        case DT_INT8:
+        case DT_UINT8:
+        case DT_BOOL:
+            return sizeof(uint8_t);
+        default:
+            return 0;
+    }
+}
+
+int64_t ElementCount(const std::vector<int64_t>& dims)
+{
+    int64_t count = 1;
+    for (int64_t dim : dims) {
+        if (dim < 0 || (dim != 0 && count > std::numeric_limits<int64_t>::max() / dim)) {
+            return -1;
+        }
+        count *= dim;
+    }
+    return count;
+}
+
+// 输入权值的shape与数据长度必须一致, 否则无法在host侧计算
+bool IsValidTensor(const TensorPtr& tensor)
+{
+    if (tensor == nullptr) {
+        return false;
+    }
+    const TensorDesc& desc = tensor->GetTensorDesc();
+    size_t elementSize = ElementSize(desc.GetDataType());
+    int64_t count = ElementCount(desc.GetShape().GetDims());
+    return elementSize != 0 && count >= 0 &&
+        static_cast<uint64_t>(count) * elementSize == tensor->GetData().GetSize();
+}
+
+TensorPtr MakeTensor(const TensorDesc& srcDesc, const std::vector<int64_t>& dims, DataType dataType,
+    const uint8_t* data, size_t size)
+{
+    TensorDesc desc(Shape(dims), srcDesc.GetFormat(), dataType);
+    TensorPtr tensor = std::make_shared<Tensor>(desc);
+    if (size != 0 && tensor->SetData(data, size) != GRAPH_SUCCESS) {
+        return nullptr;
+    }
+    return tensor;
+}
+
+bool GetShapeValues(const TensorPtr& tensor, std::vector<int64_t>& values)
+{
+    const Buffer& data = tensor->GetData();
+    DataType dataType = tensor->GetTensorDesc().GetDataType();
+    if (dataType == DT_INT32) {
+        const int32_t* src = reinterpret_cast<const int32_t*>(data.GetData());
+        values.assign(src, src + data.GetSize() / sizeof(int32_t));
+        return true;
+    }
+    if (dataType == DT_INT64) {
+        const int64_t* src = reinterpret_cast<const int64_t*>(data.GetData());
+        values.assign(src, src + data.GetSize() / sizeof(int64_t));
+        return true;
+    }
+    return false;
+}
+
+TensorPtr ReshapeTo(const TensorPtr& input, const std::vector<int64_t>& dims)
+{
+    if (ElementCount(dims) != ElementCount(input->GetTensorDesc().GetShape().GetDims())) {
+        return nullptr;
+    }
+    const Buffer& data = input->GetData();
+    return MakeTensor(input->GetTensorDesc(), dims, input->GetTensorDesc().GetDataType(), data.GetData(),
+        data.GetSize());
+}
+
+bool FoldReshape(const OpDesc& opDesc, const ConstTensors& inputs, TensorPtr& output)
+{
+    int64_t axis = 0;
+    int64_t numAxes = -1;
+    (void)AttrUtils::GetInt(opDesc, hiai::op::Reshape::axis, axis);
+    (void)AttrUtils::GetInt(opDesc, hiai::op::Reshape::num_axes, numAxes);
+    if (inputs.size() != 2 || axis != 0 || numAxes != -1) {
+        return false;
+    }
+
+    std::vector<int64_t> dims;
+    if (!GetShapeValues(inputs[1], dims)) {
+        return false;
+    }
+    int64_t known = 1;
+    auto inferIt = dims.end();
+    for (auto it = dims.begin(); it != dims.end(); ++it) {
+        if (*it == -1 && inferIt == dims.end()) {
+            inferIt = it;
+        } else if (*it > 0) {
+            known *= *it;
+        } else {
+            return false;
+        }
+    }
+    if (inferIt != dims.end()) {
+        int64_t total = ElementCount(inputs[0]->GetTensorDesc().GetShape().GetDims());
+        if (total % known != 0) {
+            return false;
+        }
+        *inferIt = total / known;
+    }
+    output = ReshapeTo(inputs[0], dims);
+    return output != nullptr;
+}
+
+bool FoldExpandDims(const OpDesc& opDesc, const ConstTensors& inputs, TensorPtr& output)
+{
+    (void)opDesc;
+    std::vector<int64_t> axis;
+    if (inputs.size() != 2 || !GetShapeValues(inputs[1], axis) || axis.size() != 1) {
+        return false;
+    }
+    std::vector<int64_t> dims = inputs[0]->GetTensorDesc().GetShape().GetDims();
+    int64_t rank = static_cast<int64_t>(dims.size());
+    int64_t pos = axis[0] < 0 ? axis[0] + rank + 1 : axis[0];
+    if (pos < 0 || pos > rank) {
+        return false;
+    }
+    dims.insert(dims.begin() + pos, 1);
+    output = ReshapeTo(inputs[0], dims);
+    return output != nullptr;
+}
+
+bool FoldSqueeze(const OpDesc& opDesc, const ConstTensors& inputs, TensorPtr& output)
+{
+    std::vector<int64_t> axis;
+    (void)AttrUtils::GetListInt(opDesc, hiai::op::Squeeze::axis, axis);
+    std::vector<int64_t> srcDims = inputs[0]->GetTensorDesc().GetShape().GetDims();
+    int64_t rank = static_cast<int64_t>(srcDims.size());
+
+    std::set<int64_t> squeezeAxis;
+    for (int64_t a : axis) {
+        int64_t pos = a < 0 ? a + rank : a;
+        if (pos < 0 || pos >= rank || srcDims[pos] != 1) {
+            return false;
+        }
+        squeezeAxis.insert(pos);
+    }
+    std::vector<int64_t> dims;
+    for (int64_t i = 0; i < rank; ++i) {
+        bool squeeze = axis.empty() ? (srcDims[i] == 1) : (squeezeAxis.count(i) != 0);
+        if (!squeeze) {
+            dims.push_back(srcDims[i]);
+        }
+    }
+    output = ReshapeTo(inputs[0], dims);
+    return output != nullptr;
+}
+
+bool FoldFlatten(const OpDesc& opDesc, const ConstTensors& inputs, TensorPtr& output)
+{
+    (void)opDesc;
+    std::vector<int64_t> srcDims = inputs[0]->GetTensorDesc().GetShape().GetDims();
+    if (srcDims.size() < 2) {
+        return false;
+    }
+    std::vector<int64_t> dims = {srcDims[0], ElementCount(std::vector<int64_t>(srcDims.begin() + 1, srcDims.end()))};
+    output = ReshapeTo(inputs[0], dims);
+    return output != nullptr;
+}
+
+bool FoldPermute(const OpDesc& opDesc, const ConstTensors& inputs, TensorPtr& output)
+{
+    std::vector<int64_t> order;
+    (void)AttrUtils::GetListInt(opDesc, hiai::op::Permute::order, order);
+    const TensorDesc& srcDesc = inputs[0]->GetTensorDesc();
+    std::vector<int64_t> srcDims = srcDesc.GetShape().GetDims();
+    size_t rank = srcDims.size();
+    if (order.size() != rank) {
+        return false;
+    }
+    std::vector<bool> used(rank, false);
+    for (int64_t axis : order) {
+        if (axis < 0 || static_cast<size_t>(axis) >= rank || used[axis]) {
+            return false;
+        }
+        used[axis] = true;
+    }
+
+    std::vector<int64_t> srcStrides(rank, 1);
+    for (size_t i = rank; i > 1; --i) {
+        srcStrides[i - 2] = srcStrides[i - 1] * srcDims[i - 1];
+    }
+    std::vector<int64_t> dims(rank);
+    std::vector<int64_t> strides(rank);
+    for (size_t i = 0; i < rank; ++i) {
+        dims[i] = srcDims[order[i]];
+        strides[i] = srcStrides[order[i]];
+    }
+
+    size_t elementSize = ElementSize(srcDesc.GetDataType());
+    const uint8_t* src = inputs[0]->GetData().GetData();
+    std::vector<uint8_t> dst(inputs[0]->GetData().GetSize());
+    std::vector<int64_t> index(rank, 0);
+    int64_t count = ElementCount(dims);
+    for (int64_t i = 0; i < count; ++i) {
+        int64_t offset = 0;
+        for (size_t d = 0; d < rank; ++d) {
+            offset += index[d] * strides[d];
+        }
+        std::copy_n(src + offset * elementSize, elementSize, dst.data() + i * elementSize);
+        for (size_t d = rank; d > 0; --d) {
+            if (++index[d - 1] < dims[d - 1]) {
+                break;
+            }
+            index[d - 1] = 0;
+        }
+    }
+    output = MakeTensor(srcDesc, dims, srcDesc.GetDataType(), dst.data(), dst.size());
+    return output != nullptr;
+}
+
+template <typename Dst>
+Dst CastValue(double value)
+{
+    if (std::is_same<Dst, bool>::value) {
+        return static_cast<Dst>(value != 0);
+    }
+    if (std::is_integral<Dst>::value) {
+        if (value != value) {
+            return static_cast<Dst>(0);
+        }
+        value = std::min(std::max(value, static_cast<double>(std::numeric_limits<Dst>::lowest())),
+            static_cast<double>(std::numeric_limits<Dst>::max()));
+    }
+    return static_cast<Dst>(value);
+}
+
+template <typename Src>
+double LoadValue(const uint8_t* data, int64_t idx)
+{
+    return static_cast<double>(reinterpret_cast<const Src*>(data)[idx]);
+}
+
+double LoadElement(DataType dataType, const uint8_t* data, int64_t idx)
+{
+    switch (dataType) {
+        case DT_FLOAT:
+            return LoadValue<float>(data, idx);
+        case DT_INT32:
+            return LoadValue<int32_t>(data, idx);
+        case DT_UINT8:
+            return LoadValue<uint8_t>(data, idx);
+        default:
+            return LoadValue<bool>(data, idx);
+    }
+}
+
+template <typename Dst>
+std::vector<uint8_t> CastElements(DataType srcType, const uint8_t* src, int64_t count)
+{
+    std::vector<uint8_t> dst(count * sizeof(Dst));
+    Dst* out = reinterpret_cast<Dst*>(dst.data());
+    for (int64_t i = 0; i < count; ++i) {
+        out[i] = CastValue<Dst>(LoadElement(srcType, src, i));
+    }
+    return dst;
+}
+
+bool FoldCast(const OpDesc& opDesc, const ConstTensors& inputs, TensorPtr& output)
+{
+    static const std::set<DataType> CAST_TYPES = {DT_FLOAT, DT_INT32, DT_UINT8, DT_BOOL};
+    int64_t dstType = -1;
+    (void)AttrUtils::GetInt(opDesc, hiai::op::CastT::dst_dtype, dstType);
+    const TensorDesc& srcDesc = inputs[0]->GetTensorDesc();
+    DataType srcType = srcDesc.GetDataType();
+    DataType dataType = static_cast<DataType>(dstType);
+    if (CAST_TYPES.count(srcType) == 0 || CAST_TYPES.count(dataType) == 0) {
+        return false;
+    }
+
+    std::vector<int64_t> dims = srcDesc.GetShape().GetDims();
+    int64_t count = ElementCount(dims);
+    const uint8_t* src = inputs[0]->GetData().GetData();
+    std::vector<uint8_t> dst;
+    switch (dataType) {
+        case DT_FLOAT:
+            dst = CastElements<float>(srcType, src, count);
+            break;
+        case DT_INT32:
+            dst = CastElements<int32_t>(srcType, src, count);
+            break;
+        case DT_UINT8:
+            dst = CastElements<uint8_t>(srcType, src, count);
+            break;
+        default:
+            dst = CastElements<bool>(srcType, src, count);
+            break;
+    }
+    output = MakeTensor(srcDesc, dims, dataType, dst.data(), dst.size());
+    return output != nullptr;
+}
+
+std::vector<int64_t> BroadcastDims(const std::vector<int64_t>& lhsDims, const std::vector<int64_t>& rhsDims)
+{
+    const std::vector<int64_t>& longer = lhsDims.size() >= rhsDims.size() ? lhsDims : rhsDims;
+    const std::vector<int64_t>& shorter = lhsDims.size() >= rhsDims.size() ? rhsDims : lhsDims;
+    std::vector<int64_t> dims = longer;
+    size_t offset = longer.size() - shorter.size();
+    for (size_t i = 0; i < shorter.size(); ++i) {
+        if (dims[offset + i] == 1) {
+            dims[offset + i] = shorter[i];
+        }
+    }
+    return dims;
+}
+
+template <typename Func>
+bool FoldBinary(const ConstTensors& inputs, TensorPtr& output, Func func)
+{
+    if (inputs.size() != 2) {
+        return false;
+    }
+    const TensorDesc& lhsDesc = inputs[0]->GetTensorDesc();
+    const TensorDesc& rhsDesc = inputs[1]->GetTensorDesc();
+    if (lhsDesc.GetDataType() != DT_FLOAT || rhsDesc.GetDataType() != DT_FLOAT) {
+        return false;
+    }
+
+    // 只支持同shape或一侧为单元素的广播
+    std::vector<int64_t> lhsDims = lhsDesc.GetShape().GetDims();
+    std::vector<int64_t> rhsDims = rhsDesc.GetShape().GetDims();
+    int64_t lhsCount = ElementCount(lhsDims);
+    int64_t rhsCount = ElementCount(rhsDims);
+    bool sameShape = lhsDims == rhsDims;
+    if (!sameShape && lhsCount != 1 && rhsCount != 1) {
+        return false;
+    }
+    bool useLhsDims = sameShape || rhsCount == 1;
+    int64_t count = useLhsDims ? lhsCount : rhsCount;
+    // 单元素一侧各维均为1, 广播结果按右对齐逐维取非1的一侧, rank取两者较大者
+    std::vector<int64_t> dims = BroadcastDims(lhsDims, rhsDims);
+
+    const float* lhs = reinterpret_cast<const float*>(inputs[0]->GetData().GetData());
+    const float* rhs = reinterpret_cast<const float*>(inputs[1]->GetData().GetData());
+    std::vector<float> dst(count);
+    for (int64_t i = 0; i < count; ++i) {
+        dst[i] = func(lhs[lhsCount == 1 ? 0 : i], rhs[rhsCount == 1 ? 0 : i]);
+    }
+    output = MakeTensor(useLhsDims ? lhsDesc : rhsDesc, dims, DT_FLOAT, reinterpret_cast<const uint8_t*>(dst.data()),
+        dst.size() * sizeof(float));
+    return output != nullptr;
+}
+
+bool FoldAdd(const OpDesc& opDesc, const ConstTensors& inputs, TensorPtr& output)
+{
+    (void)opDesc;
+    return FoldBinary(inputs, output, [](float a, float b) { return a + b; });
+}
+
+bool FoldSub(const OpDesc& opDesc, const ConstTensors& inputs, TensorPtr& output)
+{
+    (void)opDesc;
+    return FoldBinary(inputs, output, [](float a, float b) { return a - b; });
+}
+
+bool FoldMul(const OpDesc& opDesc, const ConstTensors& inputs, TensorPtr& output)
+{
+    (void)opDesc;
+    return FoldBinary(inputs, output, [](float a, float b) { return a * b; });
+}
+
+bool FoldRealDiv(const OpDesc& opDesc, const ConstTensors& inputs, TensorPtr& output)
+{
+    (void)opDesc;
+    return FoldBinary(inputs, output, [](float a, float b) { return a / b; });
+}
+
+const std::map<std::string, FoldKernel>& FoldKernels()
+{
+    static const std::map<std::string, FoldKernel> kernels = {
+        {hiai::op::Reshape::TYPE, FoldReshape},
+        {hiai::op::ExpandDims::TYPE, FoldExpandDims},
+        {hiai::op::Squeeze::TYPE, FoldSqueeze},
+        {hiai::op::Flatten::TYPE, FoldFlatten},
+        {hiai::op::Permute::TYPE, FoldPermute},
+        {hiai::op::CastT::TYPE, FoldCast},
+        {hiai::op::Add::TYPE, FoldAdd},
+        {hiai::op::Sub::TYPE, FoldSub},
+        {hiai::op::Mul::TYPE, FoldMul},
+        {hiai::op::RealDiv::TYPE, FoldRealDiv},
+    };
+    return kernels;
+}
+
+// 所有输入都来自Const节点时按输入序号取出权值, 否则返回false
+bool GetConstInputs(Node& node, ConstTensors& inputs)
+{
+    const NodeSpec& spec = node.ROLE(NodeSpec);
+    int32_t inputSize = spec.OpDesc().GetInputsDescSize();
+    if (inputSize <= 0 || spec.InCtrlEdgeSize() != 0 || spec.InDataEdgeSize() != static_cast<size_t>(inputSize)) {
+        return false;
+    }
+
+    inputs.assign(inputSize, nullptr);
+    bool allConst = true;
+    auto visitor = [&inputs, &allConst](Edge& edge) {
+        Node& src = edge.SrcNode();
+        if (src.ROLE(NodeSpec).Type() != hiai::op::Const::TYPE || edge.DstIdx() < 0 ||
+            static_cast<size_t>(edge.DstIdx()) >= inputs.size()) {
+            allConst = false;
+            return hiai::COMM_EXCEPTION;
+        }
+        std::vector<TensorPtr> weights = OpDescUtils::MutableWeights(src);
+        if (weights.empty() || !IsValidTensor(weights[0])) {
+            allConst = false;
+            return hiai::COMM_EXCEPTION;
+        }
+        inputs[edge.DstIdx()] = weights[0];
+        return hiai::SUCCESS;
+    };
+    (void)node.ROLE(NodeWalker).ListInDataEdges(visitor);
+    return allConst && std::find(inputs.begin(), inputs.end(), nullptr) == inputs.end();
+}
+
+hiai::Status ReplaceWithConst(ComputeGraph& graph, Node& node, const TensorPtr& weight)
+{
+    OpDescPtr constDesc = std::make_shared<OpDesc>(node.ROLE(NodeSpec).Name(), hiai::op::Const::TYPE);
+    HIAI_EXPECT_TRUE(constDesc->AddOutputDesc(weight->GetTensorDesc()) == GRAPH_SUCCESS);
+    HIAI_EXPECT_TRUE(AttrUtils::SetTensor(constDesc, hiai::ATTR_NAME_WEIGHTS, weight));
+
+    GraphModifier& modifier = graph.ROLE(GraphModifier);
+    Node* constNode = modifier.AddNode(constDesc);
+    HIAI_EXPECT_NOT_NULL(constNode);
+
+    std::vector<Edge> outEdges;
+    auto visitor = [&outEdges](Edge& edge) {
+        outEdges.push_back(edge);
+        return hiai::SUCCESS;
+    };
+    HIAI_EXPECT_EXEC(node.ROLE(NodeWalker).ListOutDataEdges(visitor));
+    for (const Edge& edge : outEdges) {
+        HIAI_EXPECT_EXEC(modifier.RemoveEdge(edge));
+        HIAI_EXPECT_EXEC(modifier.AddEdge(Endpoint(*constNode, 0), edge.Dst()));
+    }
+    return modifier.RemoveNodeWithConstInputs(node);
+}
+
+bool IsFoldable(const Node& node, const std::set<const Node*>& outNodes)
+{
+    const NodeSpec& spec = node.ROLE(NodeSpec);
+    return FoldKernels().count(spec.Type()) != 0 && spec.OpDesc().GetOutputsSize() == 1 &&
+        spec.OutCtrlEdgeSize() == 0 && spec.OutDataEdgeSize() != 0 && outNodes.count(&node) == 0;
+}
+
+hiai::Status OptimizeGraph(ComputeGraph& graph, uint32_t& foldedNum)
+{
+    std::set<const Node*> outNodes;
+    (void)graph.ROLE(GraphListWalker).WalkOutNodes([&outNodes](Node& node) {
+        outNodes.insert(&node);
+        return hiai::SUCCESS;
+    });
+
+    // 按拓扑序处理, 前驱折叠出的Const可以继续参与后继节点的折叠
+    std::vector<Node*> nodes;
+    std::vector<ComputeGraphPtr> subGraphs;
+    HIAI_EXPECT_EXEC(graph.ROLE(GraphTopoWalker).DFSWalk([&nodes, &subGraphs](Node& node) {
+        nodes.push_back(&node);
+        const std::vector<ComputeGraphPtr>& nodeSubGraphs = node.ROLE(NodeSubGraph).SubGraphs();
+        subGraphs.insert(subGraphs.end(), nodeSubGraphs.begin(), nodeSubGraphs.end());
+        return hiai::SUCCESS;
+    }));
+
+    for (Node* node : nodes) {
+        if (!IsFoldable(*node, outNodes)) {
+            continue;
+        }
+        ConstTensors inputs;
+        if (!GetConstInputs(*node, inputs)) {
+            continue;
+        }
+        const NodeSpec& spec = node->ROLE(NodeSpec);
+        TensorPtr output = nullptr;
+        if (!FoldKernels().at(spec.Type())(spec.OpDesc(), inputs, output) || output == nullptr) {
+            FMK_LOGI("node %s can not be folded.", spec.Name().c_str());
+            continue;
+        }
+        HIAI_EXPECT_EXEC(ReplaceWithConst(graph, *node, output));
+        foldedNum++;
+    }
+
+    for (const ComputeGraphPtr& subGraph : subGraphs) {
+        HIAI_EXPECT_NOT_NULL(subGraph);
+        HIAI_EXPECT_EXEC(OptimizeGraph(*subGraph, foldedNum));
+    }
+    return hiai::SUCCESS;
+}
+} // namespace
+
+hiai::Status ConstantFoldingOptimizer::Optimize(ComputeGraph& graph, std::uint32_t& foldedNum)
+{
+    foldedNum = 0;
+    return OptimizeGraph(graph, foldedNum);
+}
+} // namespace ge
@@ -0,0 +1,233 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "framework/graph/utils/optimizer/weight_share_optimizer.h"
+
+#include <cstring>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "graph/op/const_defs.h"
+#include "graph/tensor.h"
+#include "graph/buffer.h"
+
+#include "infra/base/assertion.h"
+
+#include "framework/graph/core/cgraph/compute_graph.h"
+#include "framework/graph/core/cgraph/graph_list_walker.h"
+#include "framework/graph/core/cgraph/graph_spec.h"
+#include "framework/graph/core/cgraph/graph_modifier.h"
+#include "framework/graph/core/node/node.h"
+#include "framework/graph/core/node/node_spec.h"
+#include "framework/graph/core/node/node_walker.h"
+#include "framework/graph/core/node/node_sub_graph.h"
+#include "framework/graph/core/edge/edge.h"
+#include "framework/graph/utils/attr_utils.h"
+#include "framework/graph/utils/node_utils.h"
+#include "framework/graph/utils/op_desc_utils.h"
+#include "framework/infra/log/log.h"
+
+namespace ge {
+namespace {
+const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+const uint64_t FNV_PRIME = 1099511628211ULL;
+const size_t BITS_PER_BYTE = 8;
+
+// FNV-1a, 按8字节步长处理权值以减少大权值的哈希开销
+uint64_t HashBytes(uint64_t hash, const uint8_t* data, size_t size)
+{
+    size_t pos = 0;
+    for (; pos + sizeof(uint64_t) <= size; pos += sizeof(uint64_t)) {
+        uint64_t word = 0;
+        for (size_t i = 0; i < sizeof(uint64_t); ++i) {
+            word |= static_cast<uint64_t>(data[pos + i]) << (i * BITS_PER_BYTE);
+        }
+        hash = (hash ^ word) * FNV_PRIME;
+    }
+    for (; pos < size; ++pos) {
+        hash = (hash ^ data[pos]) * FNV_PRIME;
+    }
+    return hash;
+}
+
+template <typename T>
+uint64_t HashValue(uint64_t hash, const T& value)
+{
+    return HashBytes(hash, reinterpret_cast<const uint8_t*>(&value), sizeof(T));
+}
+
+struct ConstWeight {
+    Node* node;
+    TensorPtr weight;
+};
+
+uint64_t HashConstWeight(const ConstWeight& constWeight)
+{
+    const std::string& type = constWeight.node->ROLE(NodeSpec).Type();
+    uint64_t hash = HashBytes(FNV_OFFSET_BASIS, reinterpret_cast<const uint8_t*>(type.data()), type.size());
+
+    const TensorDesc& desc = constWeight.weight->GetTensorDesc();
+    hash = HashValue(hash, static_cast<int32_t>(desc.GetDataType()));
+    hash = HashValue(hash, static_cast<int32_t>(desc.GetFormat()));
+    for (int64_t dim : desc.GetShape().GetDims()) {
+        hash = HashValue(hash, dim);
+    }
+
+    const Buffer& data = constWeight.weight->GetData();
+    hash = HashValue(hash, data.GetSize());
+    return HashBytes(hash, data.GetData(), data.GetSize());
+}
+
+bool IsSameQuantizeParams(const OpDesc& lhs, const OpDesc& rhs)
+{
+    std::vector<float> lhsScale;
+    std::vector<float> rhsScale;
+    (void)AttrUtils::GetListFloat(lhs, hiai::op::QuantizedConst::scale, lhsScale);
+    (void)AttrUtils::GetListFloat(rhs, hiai::op::QuantizedConst::scale, rhsScale);
+    if (lhsScale != rhsScale) {
+        return false;
+    }
+
+    std::vector<float> lhsOffset;
+    std::vector<float> rhsOffset;
+    (void)AttrUtils::GetListFloat(lhs, hiai::op::QuantizedConst::offset, lhsOffset);
+    (void)AttrUtils::GetListFloat(rhs, hiai::op::QuantizedConst::offset, rhsOffset);
+    return lhsOffset == rhsOffset;
+}
+
+bool IsSameConstWeight(const ConstWeight& lhs, const ConstWeight& rhs)
+{
+    const NodeSpec& lhsSpec = lhs.node->ROLE(NodeSpec);
+    const NodeSpec& rhsSpec = rhs.node->ROLE(NodeSpec);
+    if (lhsSpec.Type() != rhsSpec.Type()) {
+        return false;
+    }
+
+    const TensorDesc& lhsDesc = lhs.weight->GetTensorDesc();
+    const TensorDesc& rhsDesc = rhs.weight->GetTensorDesc();
+    if (lhsDesc.GetDataType() != rhsDesc.GetDataType() || lhsDesc.GetFormat() != rhsDesc.GetFormat() ||
+        lhsDesc.GetShape().GetDims() != rhsDesc.GetShape().GetDims()) {
+        return false;
+    }
+
+    const Buffer& lhsData = lhs.weight->GetData();
+    const Buffer& rhsData = rhs.weight->GetData();
+    if (lhsData.GetSize() != rhsData.GetSize()) {
+        return false;
+    }
+    if (lhsData.GetSize() != 0 && memcmp(lhsData.GetData(), rhsData.GetData(), lhsData.GetSize()) != 0) {
+        return false;
+    }
+
+    if (lhsSpec.Type() == hiai::op::QuantizedConst::TYPE) {
+        return IsSameQuantizeParams(lhsSpec.OpDesc(), rhsSpec.OpDesc());
+    }
+    return true;
+}
+
+// 只处理仅有数据输出边的常量节点, 控制边及图输出上的常量保持原样
+bool IsShareableConst(const Node& node, const std::set<const Node*>& outNodes)
+{
+    if (!NodeUtils::IsConstNode(node)) {
+        return false;
+    }
+    const NodeSpec& spec = node.ROLE(NodeSpec);
+    if (spec.InEdgeSize() != 0 || spec.OutCtrlEdgeSize() != 0 || spec.OutDataEdgeSize() == 0) {
+        return false;
+    }
+    return outNodes.count(&node) == 0;
+}
+
+hiai::Status RelinkToCanonical(ComputeGraph& graph, Node& duplicate, Node& canonical)
+{
+    std::vector<Edge> outEdges;
+    auto visitor = [&outEdges](Edge& edge) {
+        outEdges.push_back(edge);
+        return hiai::SUCCESS;
+    };
+    HIAI_EXPECT_EXEC(duplicate.ROLE(NodeWalker).ListOutDataEdges(visitor));
+
+    GraphModifier& modifier = graph.ROLE(GraphModifier);
+    for (const Edge& edge : outEdges) {
+        HIAI_EXPECT_EXEC(modifier.RemoveEdge(edge));
+        HIAI_EXPECT_EXEC(modifier.AddEdge(Endpoint(canonical, 0), edge.Dst()));
+    }
+    return modifier.RemoveNode(duplicate);
+}
+
+hiai::Status OptimizeGraph(ComputeGraph& graph, uint64_t& savedBytes)
+{
+    std::set<const Node*> outNodes;
+    (void)graph.ROLE(GraphListWalker).WalkOutNodes([&outNodes](Node& node) {
+        outNodes.insert(&node);
+        return hiai::SUCCESS;
+    });
+
+    std::unordered_map<uint64_t, std::vector<ConstWeight>> buckets;
+    std::vector<std::pair<ConstWeight, Node*>> duplicates;
+    std::vector<ComputeGraphPtr> subGraphs;
+
+    auto visitor = [&](Node& node) {
+        const std::vector<ComputeGraphPtr>& nodeSubGraphs = node.ROLE(NodeSubGraph).SubGraphs();
+        subGraphs.insert(subGraphs.end(), nodeSubGraphs.begin(), nodeSubGraphs.end());
+
+        if (!IsShareableConst(node, outNodes)) {
+            return hiai::SUCCESS;
+        }
+        std::vector<TensorPtr> weights = OpDescUtils::MutableWeights(node);
+        if (weights.empty() || weights[0] == nullptr) {
+            return hiai::SUCCESS;
+        }
+
+        ConstWeight current = {&node, weights[0]};
+        std::vector<ConstWeight>& candidates = buckets[HashConstWeight(current)];
+        for (const ConstWeight& candidate : candidates) {
+            if (IsSameConstWeight(candidate, current)) {
+                duplicates.emplace_back(current, candidate.node);
+                return hiai::SUCCESS;
+            }
+        }
+        candidates.push_back(current);
+        return hiai::SUCCESS;
+    };
+    HIAI_EXPECT_EXEC(graph.ROLE(GraphListWalker).WalkAllNodes(visitor));
+
+    for (const auto& duplicate : duplicates) {
+        uint64_t weightSize = duplicate.first.weight->GetData().GetSize();
+        HIAI_EXPECT_EXEC(RelinkToCanonical(graph, *duplicate.first.node, *duplicate.second));
+        savedBytes += weightSize;
+    }
+    if (!duplicates.empty()) {
+        FMK_LOGI("graph %s shared %zu duplicate weights.", graph.ROLE(GraphSpec).Name().c_str(), duplicates.size());
+    }
+
+    for (const ComputeGraphPtr& subGraph : subGraphs) {
+        HIAI_EXPECT_NOT_NULL(subGraph);
+        HIAI_EXPECT_EXEC(OptimizeGraph(*subGraph, savedBytes));
+    }
+    return hiai::SUCCESS;
+}
+} // namespace
+
+hiai::Status WeightShareOptimizer::Optimize(ComputeGraph& graph, std::uint64_t& savedBytes)
+{
+    savedBytes = 0;
+    return OptimizeGraph(graph, savedBytes);
+}
+} // namespace ge
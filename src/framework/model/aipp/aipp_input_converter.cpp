@@ -16,11 +16,13 @@
 
 #include "aipp_input_converter.h"
 
-#include <map>
-#include <functional>
-
 #include "tensor/image_tensor_buffer.h"
+#include "tensor/aipp/aipp_para_impl.h"
+#include "tensor/base/nd_tensor_buffer_impl.h"
+#include "tensor/image/image_tensor_buffer_impl.h"
 #include "securec.h"
+#include "infra/base/assertion.h"
+#include "infra/base/securestl.h"
 #include "framework/common/fmk_error_codes.h"
 #include "framework/infra/log/log.h"
 
@@ -35,7 +37,7 @@ static T* GetAippParam(size_t size, void* tensor)
     return static_cast<T*>(tensor);
 }
 
-bool HasDynamicPara(hiai::AippPreprocessConfig& aippConfig, size_t type, size_t& idx)
+bool HasDynamicPara(const hiai::AippPreprocessConfig& aippConfig, size_t type, size_t& idx)
 {
     for (int32_t i = 0; i < aippConfig.configDataCnt; i++) {
         if ((static_cast<uint32_t>(aippConfig.configDataInfo[i].type) == type) &&
@@ -53,7 +55,7 @@ bool CheckIndexValid(size_t idx, const std::vector<std::shared_ptr<INDTensorBuff
 }
 
 static Status SetCropPara(
-    hiai::AippPreprocessConfig& aippConfig, std::shared_ptr<IAIPPPara>& aippPara, size_t size, void* tensor)
+    const hiai::AippPreprocessConfig& aippConfig, std::shared_ptr<IAIPPPara>& aippPara, size_t size, void* tensor)
 {
     auto para = GetAippParam<CropPara>(size, tensor);
     if (para == nullptr) {
@@ -70,7 +72,7 @@ static Status SetCropPara(
     return aippPara->SetCropPara(0, std::move(*para));
 }
 
-static Status PrepareCropParam(std::shared_ptr<IAIPPPara>& aippPara, hiai::AippPreprocessConfig& aippConfig,
+static Status PrepareCropParam(std::shared_ptr<IAIPPPara>& aippPara, const hiai::AippPreprocessConfig& aippConfig,
     const std::vector<std::shared_ptr<INDTensorBuffer>>& inputs)
 {
     size_t idx;
@@ -82,7 +84,8 @@ static Status PrepareCropParam(std::shared_ptr<IAIPPPara>& aippPara, hiai::AippP
         return SetCropPara(aippConfig, aippPara, inputs[idx]->GetSize(), inputs[idx]->GetData());
     } else {
         if (aippConfig.aippParamInfo.enableCrop) {
-            return aippPara->SetCropPara(0, std::move(aippConfig.aippParamInfo.cropPara));
+            CropPara cropPara = aippConfig.aippParamInfo.cropPara;
+            return aippPara->SetCropPara(0, std::move(cropPara));
         }
     }
     return hiai::SUCCESS;
@@ -99,8 +102,8 @@ static Status SetChannelSwapPara(std::shared_ptr<IAIPPPara>& aippPara, size_t si
     return aippPara->SetChannelSwapPara(std::move(*para));
 }
 
-static Status PrepareChannelSwapParam(std::shared_ptr<IAIPPPara>& aippPara, hiai::AippPreprocessConfig& aippConfig,
-    const std::vector<std::shared_ptr<INDTensorBuffer>>& inputs)
+static Status PrepareChannelSwapParam(std::shared_ptr<IAIPPPara>& aippPara,
+    const hiai::AippPreprocessConfig& aippConfig, const std::vector<std::shared_ptr<INDTensorBuffer>>& inputs)
 {
     size_t idx;
     if (HasDynamicPara(aippConfig, AIPP_FUNC_IMAGE_CHANNEL_SWAP_V2, idx)) {
@@ -110,13 +113,14 @@ static Status PrepareChannelSwapParam(std::shared_ptr<IAIPPPara>& aippPara, hiai
         }
         return SetChannelSwapPara(aippPara, inputs[idx]->GetSize(), inputs[idx]->GetData());
     } else {
-        aippPara->SetChannelSwapPara(std::move(aippConfig.aippParamInfo.channelSwapPara));
+        ChannelSwapPara channelSwapPara = aippConfig.aippParamInfo.channelSwapPara;
+        aippPara->SetChannelSwapPara(std::move(channelSwapPara));
     }
     return hiai::SUCCESS;
 }
 
 static Status SetCSCPara(
-    hiai::AippPreprocessConfig& aippConfig, std::shared_ptr<IAIPPPara>& aippPara, size_t size, void* tensor)
+    const hiai::AippPreprocessConfig& aippConfig, std::shared_ptr<IAIPPPara>& aippPara, size_t size, void* tensor)
 {
     hiai::CscMatrixPara* matrixPara = GetAippParam<CscMatrixPara>(size, tensor);
     if (matrixPara != nullptr) {
@@ -134,7 +138,7 @@ static Status SetCSCPara(
     return hiai::FAILED;
 }
 
-static Status PrepareCscParam(std::shared_ptr<IAIPPPara>& aippPara, hiai::AippPreprocessConfig& aippConfig,
+static Status PrepareCscParam(std::shared_ptr<IAIPPPara>& aippPara, const hiai::AippPreprocessConfig& aippConfig,
     const std::vector<std::shared_ptr<INDTensorBuffer>>& inputs)
 {
     size_t idx;
@@ -153,7 +157,7 @@ static Status PrepareCscParam(std::shared_ptr<IAIPPPara>& aippPara, hiai::AippPr
 }
 
 static Status SetResizePara(
-    hiai::AippPreprocessConfig& aippConfig, std::shared_ptr<IAIPPPara>& aippPara, size_t size, void* tensor)
+    const hiai::AippPreprocessConfig& aippConfig, std::shared_ptr<IAIPPPara>& aippPara, size_t size, void* tensor)
 {
     auto para = GetAippParam<ResizePara>(size, tensor);
     if (para == nullptr) {
@@ -169,7 +173,7 @@ static Status SetResizePara(
     return aippPara->SetResizePara(0, std::move(*para));
 }
 
-static Status PrepareResizeParam(std::shared_ptr<IAIPPPara>& aippPara, hiai::AippPreprocessConfig& aippConfig,
+static Status PrepareResizeParam(std::shared_ptr<IAIPPPara>& aippPara, const hiai::AippPreprocessConfig& aippConfig,
     const std::vector<std::shared_ptr<INDTensorBuffer>>& inputs)
 {
     size_t idx;
@@ -181,7 +185,8 @@ static Status PrepareResizeParam(std::shared_ptr<IAIPPPara>& aippPara, hiai::Aip
         return SetResizePara(aippConfig, aippPara, inputs[idx]->GetSize(), inputs[idx]->GetData());
     } else {
         if (aippConfig.aippParamInfo.enableResize) {
-            return aippPara->SetResizePara(0, std::move(aippConfig.aippParamInfo.resizePara));
+            ResizePara resizePara = aippConfig.aippParamInfo.resizePara;
+            return aippPara->SetResizePara(0, std::move(resizePara));
         }
     }
     return hiai::SUCCESS;
@@ -198,7 +203,7 @@ static Status SetDtcPara(std::shared_ptr<IAIPPPara>& aippPara, size_t size, void
     return aippPara->SetDtcPara(0, std::move(*para));
 }
 
-static Status PrepareDtcParam(std::shared_ptr<IAIPPPara>& aippPara, hiai::AippPreprocessConfig& aippConfig,
+static Status PrepareDtcParam(std::shared_ptr<IAIPPPara>& aippPara, const hiai::AippPreprocessConfig& aippConfig,
     const std::vector<std::shared_ptr<INDTensorBuffer>>& inputs)
 {
     size_t idx;
@@ -210,7 +215,8 @@ static Status PrepareDtcParam(std::shared_ptr<IAIPPPara>& aippPara, hiai::AippPr
         return SetDtcPara(aippPara, inputs[idx]->GetSize(), inputs[idx]->GetData());
     } else {
         if (aippConfig.aippParamInfo.enableDtc) {
-            return aippPara->SetDtcPara(0, std::move(aippConfig.aippParamInfo.dtcPara));
+            DtcPara dtcPara = aippConfig.aippParamInfo.dtcPara;
+            return aippPara->SetDtcPara(0, std::move(dtcPara));
         }
     }
     return hiai::SUCCESS;
@@ -227,7 +233,7 @@ static Status SetPaddingPara(std::shared_ptr<IAIPPPara>& aippPara, size_t size,
     return aippPara->SetPaddingPara(0, std::move(*para));
 }
 
-static Status PreparePaddingParam(std::shared_ptr<IAIPPPara>& aippPara, hiai::AippPreprocessConfig& aippConfig,
+static Status PreparePaddingParam(std::shared_ptr<IAIPPPara>& aippPara, const hiai::AippPreprocessConfig& aippConfig,
     const std::vector<std::shared_ptr<INDTensorBuffer>>& inputs)
 {
     size_t idx;
@@ -239,13 +245,14 @@ static Status PreparePaddingParam(std::shared_ptr<IAIPPPara>& aippPara, hiai::Ai
         return SetPaddingPara(aippPara, inputs[idx]->GetSize(), inputs[idx]->GetData());
     } else {
         if (aippConfig.aippParamInfo.enablePadding) {
-            return aippPara->SetPaddingPara(0, std::move(aippConfig.aippParamInfo.paddingPara));
+            PadPara paddingPara = aippConfig.aippParamInfo.paddingPara;
+            return aippPara->SetPaddingPara(0, std::move(paddingPara));
         }
     }
     return hiai::SUCCESS;
 }
 
-static void SetInputParam(hiai::AippPreprocessConfig& aippConfig,
+static void SetInputParam(const hiai::AippPreprocessConfig& aippConfig,
     const std::vector<std::shared_ptr<INDTensorBuffer>>& inputs, std::shared_ptr<IAIPPPara>& aippPara)
 {
     std::shared_ptr<IImageTensorBuffer> imageTensorBuffer =
@@ -258,12 +265,32 @@ static void SetInputParam(hiai::AippPreprocessConfig& aippConfig,
     aippPara->SetInputIndex(aippConfig.tensorDataIdx);
 }
 
-static Status ConvertParams(hiai::AippPreprocessConfig& aippConfig,
+// 外部帧内存带行跨度时, AIPP按存储宽高读取整段内存并裁剪出有效区域, 无需重排成紧密图片
+static Status SetInputStorageShape(const hiai::AippPreprocessConfig& aippConfig,
+    const std::vector<std::shared_ptr<INDTensorBuffer>>& inputs, std::shared_ptr<IAIPPPara>& aippPara)
+{
+    std::shared_ptr<ImageTensorBufferImpl> image =
+        std::dynamic_pointer_cast<ImageTensorBufferImpl>(inputs[aippConfig.graphDataIdx]);
+    if (image == nullptr || image->GetPlaneLayout().planes.empty()) {
+        return SUCCESS;
+    }
+    const ImagePlaneLayout& layout = image->GetPlaneLayout();
+    if (layout.storageWidth == 0) {
+        FMK_LOGE("image planes are not contiguous, can not be read by aipp.");
+        return FAILED;
+    }
+    std::shared_ptr<AIPPParaImpl> paraImpl = std::dynamic_pointer_cast<AIPPParaImpl>(aippPara);
+    HIAI_EXPECT_NOT_NULL(paraImpl);
+    return paraImpl->SetInputShape(
+        {image->Width(), image->Height()}, {layout.storageWidth, layout.storageHeight});
+}
+
+static Status ConvertParams(const hiai::AippPreprocessConfig& aippConfig,
     const std::vector<std::shared_ptr<INDTensorBuffer>>& inputs, std::shared_ptr<IAIPPPara>& aippPara)
 {
-    using SetAippPramFunc = std::function<hiai::Status(std::shared_ptr<IAIPPPara>&,
-        hiai::AippPreprocessConfig & aippConfig, const std::vector<std::shared_ptr<INDTensorBuffer>>&)>;
-    std::vector<SetAippPramFunc> convertFuncList {PrepareCropParam, PrepareChannelSwapParam, PrepareCscParam,
+    using SetAippPramFunc = Status (*)(std::shared_ptr<IAIPPPara>&, const hiai::AippPreprocessConfig&,
+        const std::vector<std::shared_ptr<INDTensorBuffer>>&);
+    static const SetAippPramFunc convertFuncList[] = {PrepareCropParam, PrepareChannelSwapParam, PrepareCscParam,
         PrepareResizeParam, PrepareDtcParam, PreparePaddingParam};
 
     for (const auto& func : convertFuncList) {
@@ -298,94 +325,250 @@ static Status ExtractAippPreprocessConfig(const CustomModelData& customModelData
     return SUCCESS;
 }
 
-static Status ConvertInputs2DataInptusParaInputs(std::vector<hiai::AippPreprocessConfig>& aippConfigs,
-    const std::vector<std::shared_ptr<INDTensorBuffer>>& inputs,
-    std::vector<std::shared_ptr<INDTensorBuffer>>& dataInputs, std::vector<std::shared_ptr<IAIPPPara>>& paraInputs)
-{
-    std::vector<bool> inputsVisited(inputs.size(), false);
-    for (size_t i = 0; i < aippConfigs.size(); i++) {
-        if (aippConfigs[i].graphDataIdx < 0 || static_cast<uint32_t>(aippConfigs[i].graphDataIdx) >= inputs.size()) {
-            FMK_LOGE("inputs size error");
-            return hiai::FAILED;
+// 复用AIPP参数对象, 取出时按空白模板重置, 引用释放后自动归还, 避免推理路径上的内存申请
+class AippParaPool : public std::enable_shared_from_this<AippParaPool> {
+public:
+    explicit AippParaPool(const std::shared_ptr<IAIPPPara>& blankPara) : blankPara_(blankPara)
+    {
+    }
+    ~AippParaPool() = default;
+
+    std::shared_ptr<IAIPPPara> Acquire()
+    {
+        std::shared_ptr<IAIPPPara> para = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!freeParas_.empty()) {
+                para = freeParas_.back();
+                freeParas_.pop_back();
+            }
         }
-        if (aippConfigs[i].tensorDataIdx < 0 ||
-            static_cast<uint32_t>(aippConfigs[i].tensorDataIdx) >= dataInputs.size()) {
-            FMK_LOGE("inputs size error");
-            return hiai::FAILED;
+        if (para == nullptr) {
+            para = CreateAIPPPara(1);
+            HIAI_EXPECT_NOT_NULL_R(para, nullptr);
         }
-        dataInputs[aippConfigs[i].tensorDataIdx] = inputs[aippConfigs[i].graphDataIdx];
-        inputsVisited[aippConfigs[i].graphDataIdx] = true;
-        std::shared_ptr<IAIPPPara> aippPara = CreateAIPPPara(1);
-        SetInputParam(aippConfigs[i], inputs, aippPara);
-        aippPara->SetInputAippIndex(i);
-        if (ConvertParams(aippConfigs[i], inputs, aippPara) != SUCCESS) {
-            return FAILED;
+        if (memcpy_s(para->GetData(), para->GetSize(), blankPara_->GetData(), blankPara_->GetSize()) != EOK) {
+            FMK_LOGE("reset aipp para failed.");
+            return nullptr;
         }
 
-        paraInputs.push_back(aippPara);
+        std::weak_ptr<AippParaPool> weakPool = shared_from_this();
+        return std::shared_ptr<IAIPPPara>(para.get(), [weakPool, para](IAIPPPara*) {
+            std::shared_ptr<AippParaPool> pool = weakPool.lock();
+            if (pool != nullptr) {
+                std::lock_guard<std::mutex> lock(pool->mutex_);
+                pool->freeParas_.push_back(para);
+            }
+        });
+    }
+
+private:
+    std::shared_ptr<IAIPPPara> blankPara_;
+    std::mutex mutex_;
+    std::vector<std::shared_ptr<IAIPPPara>> freeParas_;
+};
+
+static void GetInputImageInfo(const std::shared_ptr<INDTensorBuffer>& input, ImageFormat& format, int32_t& width,
+    int32_t& height)
+{
+    std::shared_ptr<IImageTensorBuffer> imageTensorBuffer = std::dynamic_pointer_cast<IImageTensorBuffer>(input);
+    if (imageTensorBuffer != nullptr) {
+        format = imageTensorBuffer->Format();
+        width = imageTensorBuffer->Width();
+        height = imageTensorBuffer->Height();
+    }
+}
+
+static void GetInputStorageShape(const std::shared_ptr<INDTensorBuffer>& input, int32_t& width, int32_t& height)
+{
+    std::shared_ptr<ImageTensorBufferImpl> image = std::dynamic_pointer_cast<ImageTensorBufferImpl>(input);
+    if (image != nullptr) {
+        width = image->GetPlaneLayout().storageWidth;
+        height = image->GetPlaneLayout().storageHeight;
+    }
+}
 
-        for (int32_t j = 0; j < aippConfigs[i].configDataCnt; j++) {
-            inputsVisited[aippConfigs[i].configDataInfo[j].idx] = true;
+// 模型数据输入依次取AIPP图片输入(按tensorDataIdx), 其余位置按原顺序取既非图片也非动态参数的输入
+static Status BuildDataInputSlots(const std::vector<AippPreprocessConfig>& aippConfigs, size_t inputNum,
+    size_t dynamicInputCount, std::vector<size_t>& dataInputSlots)
+{
+    if (inputNum <= dynamicInputCount) {
+        FMK_LOGE("inputs size [%zu] error, dynamic inputs size [%zu]", inputNum, dynamicInputCount);
+        return hiai::FAILED;
+    }
+    size_t dataInputNum = inputNum - dynamicInputCount;
+    std::vector<bool> inputsVisited(inputNum, false);
+    std::vector<bool> slotsVisited(dataInputNum, false);
+    dataInputSlots.assign(dataInputNum, 0);
+    for (const AippPreprocessConfig& aippConfig : aippConfigs) {
+        if (aippConfig.graphDataIdx < 0 || static_cast<uint32_t>(aippConfig.graphDataIdx) >= inputNum ||
+            aippConfig.tensorDataIdx < 0 || static_cast<uint32_t>(aippConfig.tensorDataIdx) >= dataInputNum) {
+            FMK_LOGE("inputs size error");
+            return hiai::FAILED;
+        }
+        dataInputSlots[aippConfig.tensorDataIdx] = static_cast<size_t>(aippConfig.graphDataIdx);
+        slotsVisited[aippConfig.tensorDataIdx] = true;
+        inputsVisited[aippConfig.graphDataIdx] = true;
+
+        for (int32_t j = 0; j < aippConfig.configDataCnt; j++) {
+            if (aippConfig.configDataInfo[j].idx < 0 ||
+                static_cast<uint32_t>(aippConfig.configDataInfo[j].idx) >= inputNum) {
+                FMK_LOGE("inputs size error");
+                return hiai::FAILED;
+            }
+            inputsVisited[aippConfig.configDataInfo[j].idx] = true;
         }
     }
 
     size_t j = 0;
-    for (size_t i = 0; i < dataInputs.size(); i++) {
-        if (dataInputs[i] != nullptr) {
+    for (size_t i = 0; i < dataInputNum; i++) {
+        if (slotsVisited[i]) {
             continue;
         }
-
-        for (; j < inputsVisited.size(); j++) {
-            if (!inputsVisited[j]) {
-                dataInputs[i] = inputs[j];
-                inputsVisited[j] = true;
-                break;
-            }
+        while (j < inputNum && inputsVisited[j]) {
+            j++;
+        }
+        if (j == inputNum) {
+            FMK_LOGE("no input for model data input %zu", i);
+            return hiai::FAILED;
         }
+        dataInputSlots[i] = j++;
     }
+    return SUCCESS;
+}
 
+Status AippRunInputs::Init(size_t dataInputNum, size_t paraInputNum)
+{
+    if (dataInputNum > INLINE_INPUT_NUM) {
+        heapDataInputs_.reset(new (std::nothrow) HIAI_MR_NDTensorBuffer* [dataInputNum]);
+        HIAI_EXPECT_NOT_NULL(heapDataInputs_);
+        dataInputs_ = heapDataInputs_.get();
+    }
+    if (paraInputNum > INLINE_INPUT_NUM) {
+        heapParaInputs_.reset(new (std::nothrow) HIAI_MR_TensorAippPara* [paraInputNum]);
+        HIAI_EXPECT_NOT_NULL(heapParaInputs_);
+        heapParaHolders_.reset(new (std::nothrow) std::shared_ptr<IAIPPPara>[paraInputNum]);
+        HIAI_EXPECT_NOT_NULL(heapParaHolders_);
+        paraInputs_ = heapParaInputs_.get();
+        paraHolders_ = heapParaHolders_.get();
+    }
+    dataInputNum_ = dataInputNum;
+    paraInputNum_ = paraInputNum;
     return SUCCESS;
 }
 
-Status AippInputConverter::ConvertInputs(const std::vector<std::shared_ptr<INDTensorBuffer>>& inputs,
-    const CustomModelData& customModelData, std::vector<std::shared_ptr<INDTensorBuffer>>& dataInputs,
-    std::vector<std::shared_ptr<IAIPPPara>>& paraInputs)
+Status AippInputConverter::Init(const CustomModelData& customModelData, size_t inputNum)
 {
-    std::vector<AippPreprocessConfig> aippConfigs;
-    size_t dynamicInputCount = 0;
+    aippConfigs_.clear();
+    staticParas_.clear();
+    dataInputSlots_.clear();
+    dynamicInputCount_ = 0;
+    HIAI_EXPECT_EXEC(ExtractAippPreprocessConfig(customModelData, dynamicInputCount_, aippConfigs_));
+    inputNum_ = 0;
+    if (BuildDataInputSlots(aippConfigs_, inputNum, dynamicInputCount_, dataInputSlots_) == SUCCESS) {
+        inputNum_ = inputNum;
+    } else {
+        FMK_LOGW("build input slots for %zu inputs failed, slots will be built on each run.", inputNum);
+        dataInputSlots_.clear();
+    }
 
-    if (ExtractAippPreprocessConfig(customModelData, dynamicInputCount, aippConfigs) != SUCCESS) {
-        return hiai::FAILED;
+    std::shared_ptr<IAIPPPara> blankPara = CreateAIPPPara(1);
+    HIAI_EXPECT_NOT_NULL(blankPara);
+    paraPool_ = make_shared_nothrow<AippParaPool>(blankPara);
+    HIAI_EXPECT_NOT_NULL(paraPool_);
+
+    staticParas_.resize(aippConfigs_.size());
+    return SUCCESS;
+}
+
+Status AippInputConverter::BuildAippPara(size_t aippIndex, const std::vector<std::shared_ptr<INDTensorBuffer>>& inputs,
+    std::shared_ptr<IAIPPPara>& aippPara)
+{
+    const AippPreprocessConfig& aippConfig = aippConfigs_[aippIndex];
+    SetInputParam(aippConfig, inputs, aippPara);
+    aippPara->SetInputAippIndex(aippIndex);
+    HIAI_EXPECT_EXEC(ConvertParams(aippConfig, inputs, aippPara));
+    return SetInputStorageShape(aippConfig, inputs, aippPara);
+}
+
+Status AippInputConverter::GetStaticAippPara(size_t aippIndex,
+    const std::vector<std::shared_ptr<INDTensorBuffer>>& inputs, std::shared_ptr<IAIPPPara>& aippPara)
+{
+    StaticAippPara key;
+    GetInputImageInfo(inputs[aippConfigs_[aippIndex].graphDataIdx], key.format, key.width, key.height);
+    GetInputStorageShape(inputs[aippConfigs_[aippIndex].graphDataIdx], key.storageWidth, key.storageHeight);
+
+    std::lock_guard<std::mutex> lock(staticParaMutex_);
+    StaticAippPara& cached = staticParas_[aippIndex];
+    if (cached.para == nullptr || cached.format != key.format || cached.width != key.width ||
+        cached.height != key.height || cached.storageWidth != key.storageWidth ||
+        cached.storageHeight != key.storageHeight) {
+        // 已发布的参数不再修改, 输入图片规格变化时重新生成
+        key.para = CreateAIPPPara(1);
+        HIAI_EXPECT_NOT_NULL(key.para);
+        HIAI_EXPECT_EXEC(BuildAippPara(aippIndex, inputs, key.para));
+        cached = key;
     }
-    if (inputs.size() <= dynamicInputCount) {
-        FMK_LOGE("inputs size error");
-        return hiai::FAILED;
+    aippPara = cached.para;
+    return SUCCESS;
+}
+
+Status AippInputConverter::ConvertInputs(
+    const std::vector<std::shared_ptr<INDTensorBuffer>>& inputs, AippRunInputs& runInputs)
+{
+    HIAI_EXPECT_NOT_NULL(paraPool_);
+    // 输入个数与模型声明不一致时按本次输入个数临时生成索引表
+    std::vector<size_t> tmpDataInputSlots;
+    if (inputs.size() != inputNum_) {
+        HIAI_EXPECT_EXEC(BuildDataInputSlots(aippConfigs_, inputs.size(), dynamicInputCount_, tmpDataInputSlots));
+    }
+    const std::vector<size_t>& dataInputSlots = inputs.size() == inputNum_ ? dataInputSlots_ : tmpDataInputSlots;
+    HIAI_EXPECT_EXEC(runInputs.Init(dataInputSlots.size(), aippConfigs_.size()));
+
+    HIAI_MR_NDTensorBuffer** dataInputs = runInputs.DataInputs();
+    for (size_t i = 0; i < dataInputSlots.size(); i++) {
+        dataInputs[i] = GetRawBufferFromNDTensorBuffer(inputs[dataInputSlots[i]]);
+        HIAI_EXPECT_NOT_NULL(dataInputs[i]);
     }
-    dataInputs.resize(inputs.size() - dynamicInputCount);
-    ConvertInputs2DataInptusParaInputs(aippConfigs, inputs, dataInputs, paraInputs);
 
+    HIAI_MR_TensorAippPara** paraInputs = runInputs.ParaInputs();
+    std::shared_ptr<IAIPPPara>* paraHolders = runInputs.ParaHolders();
+    for (size_t i = 0; i < aippConfigs_.size(); i++) {
+        std::shared_ptr<IAIPPPara>& aippPara = paraHolders[i];
+        if (aippConfigs_[i].configDataCnt <= 0) {
+            HIAI_EXPECT_EXEC(GetStaticAippPara(i, inputs, aippPara));
+        } else {
+            aippPara = paraPool_->Acquire();
+            HIAI_EXPECT_NOT_NULL(aippPara);
+            HIAI_EXPECT_EXEC(BuildAippPara(i, inputs, aippPara));
+        }
+        paraInputs[i] = GetTensorAippParaFromAippPara(aippPara);
+        HIAI_EXPECT_NOT_NULL(paraInputs[i]);
+    }
     return SUCCESS;
 }
 
-static NDTensorDesc MakeNDTesnorDescWithType(int type)
+// 各AIPP功能参数的字节数, 未知类型返回0
+static constexpr int32_t GetAippFuncParaSize(int type)
 {
-    static std::map<int, int> size {
-        {AIPP_FUNC_IMAGE_CROP_V2, sizeof(CropPara)},
-        {AIPP_FUNC_IMAGE_CHANNEL_SWAP_V2, sizeof(ChannelSwapPara)},
-        {AIPP_FUNC_IMAGE_COLOR_SPACE_CONVERTION_V2, sizeof(CscPara)},
-        {AIPP_FUNC_IMAGE_RESIZE_V2, sizeof(ResizePara)},
-        {AIPP_FUNC_IMAGE_DATA_TYPE_CONVERSION_V2, sizeof(DtcPara)},
-        {AIPP_FUNC_IAMGE_PADDING_V2, sizeof(PadPara)},
-    };
+    return type == AIPP_FUNC_IMAGE_CROP_V2 ? static_cast<int32_t>(sizeof(CropPara)) :
+        type == AIPP_FUNC_IMAGE_CHANNEL_SWAP_V2 ? static_cast<int32_t>(sizeof(ChannelSwapPara)) :
+        type == AIPP_FUNC_IMAGE_COLOR_SPACE_CONVERTION_V2 ? static_cast<int32_t>(sizeof(CscPara)) :
+        type == AIPP_FUNC_IMAGE_RESIZE_V2 ? static_cast<int32_t>(sizeof(ResizePara)) :
+        type == AIPP_FUNC_IMAGE_DATA_TYPE_CONVERSION_V2 ? static_cast<int32_t>(sizeof(DtcPara)) :
+        type == AIPP_FUNC_IAMGE_PADDING_V2 ? static_cast<int32_t>(sizeof(PadPara)) : 0;
+}
 
+static NDTensorDesc MakeNDTesnorDescWithType(int type)
+{
     NDTensorDesc ndTensorDesc;
 
-    const auto& iter = size.find(type);
-    if (iter == size.cend()) {
+    const int32_t paraSize = GetAippFuncParaSize(type);
+    if (paraSize == 0) {
         return ndTensorDesc;
     }
 
-    std::vector<int32_t> dims {1, iter->second, 1, 1};
+    std::vector<int32_t> dims {1, paraSize, 1, 1};
     ndTensorDesc.format = Format::NCHW;
     ndTensorDesc.dataType = DataType::UINT8;
     ndTensorDesc.dims = dims;
@@ -413,7 +596,7 @@ static void MakeInputTensor(std::vector<AippPreprocessConfig>& aippConfig,
     std::vector<NDTensorDesc>& dataInputTensorDesc, std::vector<NDTensorDesc>& modelInputTensor)
 {
     std::vector<bool> dataInputTensorVisited(dataInputTensorDesc.size(), false);
-    std::vector<bool> modelInputTensorVisited(dataInputTensorDesc.size(), false);
+    std::vector<bool> modelInputTensorVisited(modelInputTensor.size(), false);
 
     ConvertInputTesnor2NewInputTesnor(
         aippConfig, dataInputTensorDesc, modelInputTensor, dataInputTensorVisited, modelInputTensorVisited);
@@ -453,4 +636,4 @@ Status AippInputConverter::ConvertInputTensorDesc(
     inputTensorDescVec.assign(modelInputTensor.begin(), modelInputTensor.end());
     return SUCCESS;
 }
-} // namespace hiai
\ No newline at end of file
+} // namespace hiai
\ No newline at end of file
@@ -16,7 +16,13 @@
 #ifndef FRAMEWORK_MODEL_MANAGER_AIPP_COMPATIBLE_H
 #define FRAMEWORK_MODEL_MANAGER_AIPP_COMPATIBLE_H
 
+#include <memory>
+#include <mutex>
+#include <vector>
+
 #include "model/built_model_aipp.h"
+#include "framework/c/hiai_nd_tensor_buffer.h"
+#include "framework/c/hiai_tensor_aipp_para.h"
 
 namespace hiai {
 enum AIPP_FUNC_INDEX {
@@ -29,17 +35,96 @@ enum AIPP_FUNC_INDEX {
     AIPP_FUNC_IAMGE_PADDING_V2,
 };
 
+class AippParaPool;
+
+// 单次运行转换后的模型输入, 输入个数不超过INLINE_INPUT_NUM时直接使用对象内的数组, 运行路径上不申请内存
+class AippRunInputs {
+public:
+    AippRunInputs() = default;
+    ~AippRunInputs() = default;
+    AippRunInputs(const AippRunInputs&) = delete;
+    AippRunInputs& operator=(const AippRunInputs&) = delete;
+
+    Status Init(size_t dataInputNum, size_t paraInputNum);
+
+    HIAI_MR_NDTensorBuffer** DataInputs()
+    {
+        return dataInputs_;
+    }
+    size_t DataInputNum() const
+    {
+        return dataInputNum_;
+    }
+    HIAI_MR_TensorAippPara** ParaInputs()
+    {
+        return paraInputs_;
+    }
+    // 持有本次运行使用的参数对象, 运行结束前不会被复用或释放
+    std::shared_ptr<IAIPPPara>* ParaHolders()
+    {
+        return paraHolders_;
+    }
+    size_t ParaInputNum() const
+    {
+        return paraInputNum_;
+    }
+
+private:
+    static const size_t INLINE_INPUT_NUM = 8;
+
+    HIAI_MR_NDTensorBuffer* inlineDataInputs_[INLINE_INPUT_NUM] {nullptr};
+    HIAI_MR_TensorAippPara* inlineParaInputs_[INLINE_INPUT_NUM] {nullptr};
+    std::shared_ptr<IAIPPPara> inlineParaHolders_[INLINE_INPUT_NUM];
+    std::unique_ptr<HIAI_MR_NDTensorBuffer*[]> heapDataInputs_ {nullptr};
+    std::unique_ptr<HIAI_MR_TensorAippPara*[]> heapParaInputs_ {nullptr};
+    std::unique_ptr<std::shared_ptr<IAIPPPara>[]> heapParaHolders_ {nullptr};
+
+    HIAI_MR_NDTensorBuffer** dataInputs_ {inlineDataInputs_};
+    HIAI_MR_TensorAippPara** paraInputs_ {inlineParaInputs_};
+    std::shared_ptr<IAIPPPara>* paraHolders_ {inlineParaHolders_};
+    size_t dataInputNum_ {0};
+    size_t paraInputNum_ {0};
+};
+
 class AippInputConverter {
 public:
     AippInputConverter() = default;
     ~AippInputConverter() = default;
 
-    static Status ConvertInputs(const std::vector<std::shared_ptr<INDTensorBuffer>>& inputs,
-        const CustomModelData& customModelData, std::vector<std::shared_ptr<INDTensorBuffer>>& dataInputs,
-        std::vector<std::shared_ptr<IAIPPPara>>& paraInputs);
+    // 模型加载时解析一次customModelData并生成输入索引表, 推理时复用; inputNum为用户侧输入个数(含动态参数输入)
+    Status Init(const CustomModelData& customModelData, size_t inputNum);
+
+    Status ConvertInputs(const std::vector<std::shared_ptr<INDTensorBuffer>>& inputs, AippRunInputs& runInputs);
 
     static Status ConvertInputTensorDesc(
         const CustomModelData& customModelData, std::vector<NDTensorDesc>& inputTensorDescVec);
+
+private:
+    struct StaticAippPara {
+        ImageFormat format {ImageFormat::INVALID};
+        int32_t width {0};
+        int32_t height {0};
+        int32_t storageWidth {0};
+        int32_t storageHeight {0};
+        std::shared_ptr<IAIPPPara> para {nullptr};
+    };
+
+    Status BuildAippPara(size_t aippIndex, const std::vector<std::shared_ptr<INDTensorBuffer>>& inputs,
+        std::shared_ptr<IAIPPPara>& aippPara);
+    Status GetStaticAippPara(size_t aippIndex, const std::vector<std::shared_ptr<INDTensorBuffer>>& inputs,
+        std::shared_ptr<IAIPPPara>& aippPara);
+
+private:
+    std::vector<AippPreprocessConfig> aippConfigs_;
+    size_t dynamicInputCount_ {0};
+    size_t inputNum_ {0};
+    // 模型数据输入i对应的用户输入下标, AIPP图片输入与透传输入统一在Init时确定
+    std::vector<size_t> dataInputSlots_;
+    // 无动态参数的AIPP输入, 按输入图片格式和宽高缓存生成好的参数, 发布后只读
+    std::mutex staticParaMutex_;
+    std::vector<StaticAippPara> staticParas_;
+    // 含动态参数的AIPP输入, 每次运行从复用池取参数对象并只刷新本次参数
+    std::shared_ptr<AippParaPool> paraPool_ {nullptr};
 };
 } // namespace hiai
 
@@ -114,6 +114,7 @@ Status BuiltModelImpl::RestoreFromBuffer(const std::shared_ptr<IBuffer>& buffer)
     HIAI_EXPECT_TRUE(builtModelImpl_ == nullptr);
 
     const std::shared_ptr<IBuffer> outBuffer = CustomDataUtil::GetModelData(buffer, customModelData_);
+    InvalidateTensorDescs();
     HIAI_EXPECT_NOT_NULL(outBuffer);
     modelBuffer_ = outBuffer;
 
@@ -139,6 +140,7 @@ Status BuiltModelImpl::RestoreFromFile(const char* file)
         return RestoreFromBuffer(buffer);
     }
 
+    InvalidateTensorDescs();
     builtModelImpl_.reset(
         HIAI_MR_BuiltModel_RestoreFromFile(file), [](HIAI_MR_BuiltModel* p) { HIAI_MR_BuiltModel_Destroy(&p); });
 
@@ -207,10 +209,20 @@ std::vector<NDTensorDesc> BuiltModelImpl::GetInputTensorDescs() const
         return std::vector<NDTensorDesc>();
     }
 
+    std::lock_guard<std::mutex> lock(tensorDescsMutex_);
+    if (inputTensorDescsValid_) {
+        return inputTensorDescs_;
+    }
+
     std::vector<NDTensorDesc> inputTensorDescVec = GetTensorDescs(
         builtModelImpl_.get(), HIAI_MR_BuiltModel_GetInputTensorNum, HIAI_MR_BuiltModel_GetInputTensorDesc);
+    if (inputTensorDescVec.empty() ||
+        AippInputConverter::ConvertInputTensorDesc(customModelData_, inputTensorDescVec) != SUCCESS) {
+        return inputTensorDescVec;
+    }
 
-    AippInputConverter::ConvertInputTensorDesc(customModelData_, inputTensorDescVec);
+    inputTensorDescs_ = inputTensorDescVec;
+    inputTensorDescsValid_ = true;
     return inputTensorDescVec;
 }
 
@@ -221,8 +233,27 @@ std::vector<NDTensorDesc> BuiltModelImpl::GetOutputTensorDescs() const
         return std::vector<NDTensorDesc>();
     }
 
-    return GetTensorDescs(
+    std::lock_guard<std::mutex> lock(tensorDescsMutex_);
+    if (outputTensorDescsValid_) {
+        return outputTensorDescs_;
+    }
+
+    std::vector<NDTensorDesc> outputTensorDescVec = GetTensorDescs(
         builtModelImpl_.get(), HIAI_MR_BuiltModel_GetOutputTensorNum, HIAI_MR_BuiltModel_GetOutputTensorDesc);
+    if (!outputTensorDescVec.empty()) {
+        outputTensorDescs_ = outputTensorDescVec;
+        outputTensorDescsValid_ = true;
+    }
+    return outputTensorDescVec;
+}
+
+void BuiltModelImpl::InvalidateTensorDescs()
+{
+    std::lock_guard<std::mutex> lock(tensorDescsMutex_);
+    inputTensorDescsValid_ = false;
+    outputTensorDescsValid_ = false;
+    inputTensorDescs_.clear();
+    outputTensorDescs_.clear();
 }
 
 std::string BuiltModelImpl::GetName() const
@@ -247,6 +278,7 @@ void BuiltModelImpl::SetName(const std::string& name)
 void BuiltModelImpl::SetCustomData(const CustomModelData& customModelData)
 {
     customModelData_ = customModelData;
+    InvalidateTensorDescs();
 }
 const CustomModelData& BuiltModelImpl::GetCustomData()
 {
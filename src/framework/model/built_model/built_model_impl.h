@@ -15,6 +15,7 @@
  */
 #ifndef FRAMEWORK_MODEL_BUILT_MODEL_IMPL_H
 #define FRAMEWORK_MODEL_BUILT_MODEL_IMPL_H
+#include <mutex>
 // api/framework
 #include "model/built_model_ext.h"
 // inc
@@ -53,11 +54,20 @@ private:
     Status GetTensorAippInfo(int32_t index, uint32_t* aippParaNum, uint32_t* batchCount) override;
     Status GetTensorAippPara(int32_t index, std::vector<std::shared_ptr<IAIPPPara>>& aippParas) const override;
 
+    void InvalidateTensorDescs();
+
 private:
     std::shared_ptr<HIAI_MR_BuiltModel> builtModelImpl_ {nullptr};
     std::shared_ptr<BaseBuffer> buffer_ {nullptr};
     CustomModelData customModelData_;
     std::shared_ptr<IBuffer> modelBuffer_ {nullptr};
+
+    // 输入输出描述(已按customData展开AIPP参数输入)只在首次查询时计算, 模型或customData变化时失效
+    mutable std::mutex tensorDescsMutex_;
+    mutable bool inputTensorDescsValid_ {false};
+    mutable bool outputTensorDescsValid_ {false};
+    mutable std::vector<NDTensorDesc> inputTensorDescs_;
+    mutable std::vector<NDTensorDesc> outputTensorDescs_;
 };
 } // namespace hiai
 #endif // FRAMEWORK_MODEL_BUILT_MODEL_IMPL_H
@@ -49,6 +49,7 @@
 
 #include "model_builder/ir/aipp/converter/aipp_param_info_converter.h"
 #include "model_builder/ir/aipp/infershape/aipp_infershape_util.h"
+#include "model_builder/ir/aipp/lowering/aipp_static_lowering.h"
 #include "hiai_ir_aipp_compatible_adapter_dl.h"
 
 using namespace hiai;
@@ -395,6 +396,34 @@ public:
         return hiai::SUCCESS;
     }
 
+    // 参数全部为Const时展开为普通算子, 不支持展开的配置保持lowered为false, 走硬件AIPP
+    hiai::Status LowerStaticAipp(bool& lowered)
+    {
+        lowered = false;
+        hiai::AippParamInfo paramInfo;
+        for (std::uint32_t i = 1; i < aippImages_.size(); i++) {
+            ge::Node& imageNode = *aippImages_[i];
+            ge::Node* paramNode = imageNode.ROLE(NodeWalker).InDataNode(1);
+            HIAI_EXPECT_NOT_NULL(paramNode);
+            if (paramNode->ROLE(NodeSpec).Type() != hiai::op::Const::TYPE) {
+                return hiai::SUCCESS;
+            }
+            HIAI_EXPECT_EXEC(AippParamInfoConverter::ConvertConst2AippParamInfo(
+                *paramNode, imageNode.ROLE(NodeSpec).Type(), paramInfo));
+        }
+
+        HIAI_EXPECT_EXEC(AippImagesInferShaper::InferShape(aippImages_));
+
+        hiai::Status ret = AippStaticLowering::Lower(graph_, *DataNode(), *aippImages_.back(), paramInfo);
+        if (ret == hiai::UNSUPPORTED) {
+            return hiai::SUCCESS;
+        }
+        HIAI_EXPECT_EXEC(ret);
+
+        lowered = true;
+        return hiai::SUCCESS;
+    }
+
     void ReverseAippImageNodes()
     {
         std::reverse(aippImages_.begin(), aippImages_.end());
@@ -564,11 +593,18 @@ public:
         return !chains_.empty();
     }
 
-    hiai::Status FusionAippImages(std::string& customData)
+    hiai::Status FusionAippImages(std::string& customData, bool lowerStaticAipp)
     {
         std::vector<hiai::AippPreprocessConfig> configs;
 
         for (auto& chain : chains_) {
+            if (lowerStaticAipp) {
+                bool lowered = false;
+                HIAI_EXPECT_EXEC(chain.LowerStaticAipp(lowered));
+                if (lowered) {
+                    continue;
+                }
+            }
             HIAI_EXPECT_EXEC(chain.AddAippNode());
 
             hiai::AippPreprocessConfig config;
@@ -655,11 +691,12 @@ private:
 } // namespace
 
 namespace hiai {
-Status HiAIIRAippCompatible::GenerateAippCompatibleInfo(ge::ComputeGraph& graph, std::string& customData)
+Status HiAIIRAippCompatible::GenerateAippCompatibleInfo(
+    ge::ComputeGraph& graph, std::string& customData, bool lowerStaticAipp)
 {
     GraphAippImagesChains chains = AippImagesChainSearcher::Search(graph);
     if (chains.HasAippImageChain()) {
-        HIAI_EXPECT_EXEC(chains.FusionAippImages(customData));
+        HIAI_EXPECT_EXEC(chains.FusionAippImages(customData, lowerStaticAipp));
     }
 
     // This optimizer not only optimize aipps created above, but also aipps already exist.
@@ -672,4 +709,9 @@ GRAPH_API_EXPORT Status GenerateAippCompatibleInfoAdapter(ge::ComputeGraph& grap
 {
     return HiAIIRAippCompatible::GenerateAippCompatibleInfo(graph, customData);
 }
+
+GRAPH_API_EXPORT Status LowerStaticAippAdapter(ge::ComputeGraph& graph, std::string& customData)
+{
+    return HiAIIRAippCompatible::GenerateAippCompatibleInfo(graph, customData, true);
+}
 } // namespace hiai
@@ -25,7 +25,9 @@
 namespace hiai {
 class HiAIIRAippCompatible {
 public:
-    static Status GenerateAippCompatibleInfo(ge::ComputeGraph& graph, std::string& customData);
+    // lowerStaticAipp: 参数全部为Const的图像算子链展开为普通算子, 不生成Aipp节点
+    static Status GenerateAippCompatibleInfo(
+        ge::ComputeGraph& graph, std::string& customData, bool lowerStaticAipp = false);
 };
 } // namespace hiai
 
@@ -30,6 +30,7 @@ namespace hiai {
 extern "C" {
 #endif
 Status GenerateAippCompatibleInfoAdapter(ge::ComputeGraph& graph, std::string& customData);
+Status LowerStaticAippAdapter(ge::ComputeGraph& graph, std::string& customData);
 #ifdef __cplusplus
 }
 #endif
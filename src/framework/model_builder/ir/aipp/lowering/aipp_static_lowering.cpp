@@ -0,0 +1,653 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "model_builder/ir/aipp/lowering/aipp_static_lowering.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <utility>
+
+// api/framework
+#include "graph/op/array_defs.h"
+#include "graph/op/const_defs.h"
+#include "graph/op/detection_defs.h"
+#include "graph/op/image_defs.h"
+#include "graph/op/math_defs.h"
+#include "graph/op/nn_defs.h"
+
+// inc/common
+#include "infra/base/securestl.h"
+
+// inc/framework
+#include "framework/graph/core/cgraph/compute_graph.h"
+#include "framework/graph/core/cgraph/graph_bypasser.h"
+#include "framework/graph/core/cgraph/graph_list_walker.h"
+#include "framework/graph/core/cgraph/graph_modifier.h"
+#include "framework/graph/core/edge/edge.h"
+#include "framework/graph/core/node/node.h"
+#include "framework/graph/core/node/node_spec.h"
+#include "framework/graph/core/node/node_walker.h"
+#include "framework/graph/debug/ge_graph_attr_define.h"
+#include "framework/graph/utils/attr_utils.h"
+#include "framework/infra/log/log.h"
+
+// src/framework/inc
+#include "infra/base/assertion.h"
+
+#include "tensor/image/image_format_desc.h"
+
+using namespace hiai;
+
+namespace {
+const uint32_t MAX_CHANNEL = 4;
+const uint32_t CSC_CHANNEL = 3;
+const float CSC_SCALE = 256.0f;
+const size_t NCHW_DIM_NUM = 4;
+const size_t DIM_N = 0;
+const size_t DIM_C = 1;
+const size_t DIM_H = 2;
+const size_t DIM_W = 3;
+
+// 逐像素的通道仿射变换: out[i] = sum(matrix[i][j] * in[j]) + bias[i]
+struct ChannelAffine {
+    uint32_t inChannel {0};
+    uint32_t outChannel {0};
+    float matrix[MAX_CHANNEL][MAX_CHANNEL] {};
+    float bias[MAX_CHANNEL] {};
+};
+
+struct LoweringPlan {
+    std::vector<int64_t> inDims; // Data的NCHW
+    std::vector<int64_t> outDims; // 图像算子链输出的NCHW
+    ChannelAffine color; // 通道交换 + CSC, 存在时DTC一并折叠进来
+    bool explicitDtc {false};
+    float dtcSub[MAX_CHANNEL] {};
+    float dtcScale[MAX_CHANNEL] {};
+    ge::Node* foldConv {nullptr}; // 承接DTC的模型首个卷积
+};
+
+void SwapRows(ChannelAffine& affine, uint32_t a, uint32_t b)
+{
+    for (uint32_t j = 0; j < MAX_CHANNEL; ++j) {
+        std::swap(affine.matrix[a][j], affine.matrix[b][j]);
+    }
+    std::swap(affine.bias[a], affine.bias[b]);
+}
+
+// 与CPU AIPP的执行顺序一致: ax交换(ARGB -> RGBA) -> rb/uv交换 -> CSC
+void InitColorAffine(const AippParamInfo& para, const ImageFormatDesc& desc, uint32_t outChannel,
+    ChannelAffine& affine)
+{
+    affine.inChannel = desc.channel;
+    affine.outChannel = outChannel;
+    for (uint32_t c = 0; c < desc.channel; ++c) {
+        affine.matrix[c][c] = 1.0f;
+    }
+    if (para.channelSwapPara.axSwapSwitch && desc.channel == MAX_CHANNEL) {
+        for (uint32_t c = 0; c + 1 < MAX_CHANNEL; ++c) {
+            SwapRows(affine, c, c + 1);
+        }
+    }
+    if (para.channelSwapPara.rbuvSwapSwitch) {
+        SwapRows(affine, desc.colorModel == ImageColorModel::RGB ? 0 : 1, 2);
+    }
+    if (!para.enableCsc) {
+        return;
+    }
+
+    const CscMatrixPara& csc = para.cscMatrixPara;
+    const int32_t matrix[CSC_CHANNEL][CSC_CHANNEL] = {{csc.matrixR0C0, csc.matrixR0C1, csc.matrixR0C2},
+        {csc.matrixR1C0, csc.matrixR1C1, csc.matrixR1C2}, {csc.matrixR2C0, csc.matrixR2C1, csc.matrixR2C2}};
+    const int32_t inBias[CSC_CHANNEL] = {csc.inputBias0, csc.inputBias1, csc.inputBias2};
+    const int32_t outBias[CSC_CHANNEL] = {csc.outputBias0, csc.outputBias1, csc.outputBias2};
+    const ChannelAffine src = affine;
+    for (uint32_t i = 0; i < CSC_CHANNEL; ++i) {
+        float bias = static_cast<float>(outBias[i]);
+        for (uint32_t j = 0; j < MAX_CHANNEL; ++j) {
+            float sum = 0.0f;
+            for (uint32_t k = 0; k < CSC_CHANNEL; ++k) {
+                sum += static_cast<float>(matrix[i][k]) * src.matrix[k][j];
+            }
+            affine.matrix[i][j] = sum / CSC_SCALE;
+        }
+        for (uint32_t k = 0; k < CSC_CHANNEL; ++k) {
+            bias += static_cast<float>(matrix[i][k]) * (src.bias[k] - static_cast<float>(inBias[k])) / CSC_SCALE;
+        }
+        affine.bias[i] = bias;
+    }
+}
+
+bool IsIdentity(const ChannelAffine& affine)
+{
+    if (affine.inChannel != affine.outChannel) {
+        return false;
+    }
+    for (uint32_t i = 0; i < affine.outChannel; ++i) {
+        for (uint32_t j = 0; j < affine.inChannel; ++j) {
+            if (affine.matrix[i][j] != (i == j ? 1.0f : 0.0f)) {
+                return false;
+            }
+        }
+        if (affine.bias[i] != 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// DTC: out = (in - mean - min) * varReci, 全部为默认值时返回false
+bool InitDtc(const DtcPara& dtc, float (&sub)[MAX_CHANNEL], float (&scale)[MAX_CHANNEL])
+{
+    const float mean[MAX_CHANNEL] = {static_cast<float>(dtc.pixelMeanChn0), static_cast<float>(dtc.pixelMeanChn1),
+        static_cast<float>(dtc.pixelMeanChn2), static_cast<float>(dtc.pixelMeanChn3)};
+    const float min[MAX_CHANNEL] = {dtc.pixelMinChn0, dtc.pixelMinChn1, dtc.pixelMinChn2, dtc.pixelMinChn3};
+    const float varReci[MAX_CHANNEL] = {
+        dtc.pixelVarReciChn0, dtc.pixelVarReciChn1, dtc.pixelVarReciChn2, dtc.pixelVarReciChn3};
+    bool changed = false;
+    for (uint32_t c = 0; c < MAX_CHANNEL; ++c) {
+        sub[c] = mean[c] + min[c];
+        scale[c] = varReci[c];
+        changed = changed || sub[c] != 0.0f || scale[c] != 1.0f;
+    }
+    return changed;
+}
+
+void ScaleAffine(ChannelAffine& affine, const float (&sub)[MAX_CHANNEL], const float (&scale)[MAX_CHANNEL])
+{
+    for (uint32_t i = 0; i < MAX_CHANNEL; ++i) {
+        for (uint32_t j = 0; j < MAX_CHANNEL; ++j) {
+            affine.matrix[i][j] *= scale[i];
+        }
+        affine.bias[i] = (affine.bias[i] - sub[i]) * scale[i];
+    }
+}
+
+ge::Node* FindSoleConsumer(ge::Node& node)
+{
+    if (node.ROLE(NodeSpec).OutDataEdgeSize() != 1) {
+        return nullptr;
+    }
+    return node.ROLE(NodeWalker).OutDataNode(0, 0);
+}
+
+bool IsCastToFloat(ge::Node& node)
+{
+    if (node.ROLE(NodeSpec).Type() != hiai::op::CastT::TYPE) {
+        return false;
+    }
+    int64_t dstType = -1;
+    (void)ge::AttrUtils::GetInt(node.ROLE(NodeSpec).OpDesc(), hiai::op::CastT::dst_dtype, dstType);
+    return dstType == ge::DT_FLOAT;
+}
+
+// 仅修改本节点独占的FLOAT权值, 避免影响共享权值的其他节点
+ge::TensorPtr GetExclusiveFloatWeight(ge::Node& node, std::size_t index)
+{
+    ge::Node* constNode = node.ROLE(NodeWalker).InDataNode(index);
+    if (constNode == nullptr || constNode->ROLE(NodeSpec).Type() != hiai::op::Const::TYPE ||
+        constNode->ROLE(NodeSpec).OutDataEdgeSize() != 1) {
+        return nullptr;
+    }
+    ge::TensorPtr weight = nullptr;
+    if (!ge::AttrUtils::MutableTensor(constNode->ROLE(NodeSpec).OpDesc(), hiai::ATTR_NAME_WEIGHTS, weight) ||
+        weight == nullptr || weight->GetTensorDesc().GetDataType() != ge::DT_FLOAT) {
+        return nullptr;
+    }
+    return weight;
+}
+
+size_t GetElementCount(const std::vector<int64_t>& dims)
+{
+    size_t count = 1;
+    for (auto dim : dims) {
+        count *= static_cast<size_t>(dim);
+    }
+    return count;
+}
+
+/*
+ * DTC只能折叠进无padding的卷积: padding补的0在DTC之前和之后含义不同.
+ * 图像算子链 -> [CastT(FLOAT)] -> Convolution(groups = 1, 带Const bias, 非量化)
+ */
+ge::Node* FindFoldableConv(ge::Node& lastNode, uint32_t channel)
+{
+    ge::Node* pre = &lastNode;
+    ge::Node* conv = FindSoleConsumer(lastNode);
+    if (conv != nullptr && IsCastToFloat(*conv)) {
+        pre = conv;
+        conv = FindSoleConsumer(*conv);
+    }
+    if (conv == nullptr || conv->ROLE(NodeSpec).Type() != hiai::op::Convolution::TYPE ||
+        conv->ROLE(NodeSpec).InDataEdgeSize() != 3 || conv->ROLE(NodeWalker).InDataNode(0) != pre) {
+        return nullptr;
+    }
+
+    ge::OpDesc& opDesc = conv->ROLE(NodeSpec).OpDesc();
+    int64_t groups = 1;
+    (void)ge::AttrUtils::GetInt(opDesc, hiai::op::Convolution::groups, groups);
+    std::vector<int64_t> pads;
+    (void)ge::AttrUtils::GetListInt(opDesc, hiai::op::Convolution::pads, pads);
+    std::string padMode = "SPECIFIC";
+    (void)ge::AttrUtils::GetStr(opDesc, hiai::op::Convolution::pad_mode, padMode);
+    bool hasPad = std::any_of(pads.cbegin(), pads.cend(), [](int64_t pad) { return pad != 0; });
+    if (groups != 1 || hasPad || (padMode != "SPECIFIC" && padMode != "VALID")) {
+        return nullptr;
+    }
+
+    ge::TensorPtr filter = GetExclusiveFloatWeight(*conv, 1);
+    ge::TensorPtr bias = GetExclusiveFloatWeight(*conv, 2);
+    if (filter == nullptr || bias == nullptr) {
+        return nullptr;
+    }
+    const std::vector<int64_t> dims = filter->GetTensorDesc().GetShape().GetDims();
+    if (dims.size() != NCHW_DIM_NUM || dims[DIM_C] != static_cast<int64_t>(channel) ||
+        filter->GetData().GetSize() != GetElementCount(dims) * sizeof(float) ||
+        bias->GetData().GetSize() != static_cast<size_t>(dims[DIM_N]) * sizeof(float)) {
+        return nullptr;
+    }
+    return conv;
+}
+
+// conv(W, (x - m) * s) + b = conv(W * s, x) + (b - sum(W * s * m))
+hiai::Status FoldDtcIntoConv(ge::Node& conv, const float (&sub)[MAX_CHANNEL], const float (&scale)[MAX_CHANNEL])
+{
+    ge::TensorPtr filter = GetExclusiveFloatWeight(conv, 1);
+    ge::TensorPtr bias = GetExclusiveFloatWeight(conv, 2);
+    HIAI_EXPECT_NOT_NULL(filter);
+    HIAI_EXPECT_NOT_NULL(bias);
+
+    const std::vector<int64_t> dims = filter->GetTensorDesc().GetShape().GetDims();
+    const size_t outChannel = static_cast<size_t>(dims[DIM_N]);
+    const size_t inChannel = static_cast<size_t>(dims[DIM_C]);
+    const size_t kernelSize = static_cast<size_t>(dims[DIM_H] * dims[DIM_W]);
+    float* w = reinterpret_cast<float*>(filter->MutableData().MutableData());
+    float* b = reinterpret_cast<float*>(bias->MutableData().MutableData());
+    HIAI_EXPECT_NOT_NULL(w);
+    HIAI_EXPECT_NOT_NULL(b);
+
+    for (size_t o = 0; o < outChannel; ++o) {
+        for (size_t c = 0; c < inChannel; ++c) {
+            float* kernel = w + (o * inChannel + c) * kernelSize;
+            for (size_t k = 0; k < kernelSize; ++k) {
+                kernel[k] *= scale[c];
+                b[o] -= kernel[k] * sub[c];
+            }
+        }
+    }
+    return hiai::SUCCESS;
+}
+
+hiai::Status InitLoweringPlan(
+    ge::Node& dataNode, ge::Node& lastNode, const AippParamInfo& para, LoweringPlan& plan)
+{
+    if (para.enableRotate) {
+        FMK_LOGW("aipp rotation can not be lowered.");
+        return hiai::UNSUPPORTED;
+    }
+    // YUV420SP/YUV422SP/YUYV的色度需要上采样, 保留硬件AIPP
+    const ImageFormatDesc* desc = GetImageFormatDesc(para.inputFormat);
+    if (desc == nullptr || desc->planeNum != 1 || desc->chromaBytes != 0) {
+        FMK_LOGW("aipp input format %d can not be lowered.", static_cast<int>(para.inputFormat));
+        return hiai::UNSUPPORTED;
+    }
+
+    plan.inDims = dataNode.ROLE(NodeSpec).OpDesc().GetOutputDesc(0).GetShape().GetDims();
+    plan.outDims = lastNode.ROLE(NodeSpec).OpDesc().GetOutputDesc(0).GetShape().GetDims();
+    auto isValidDims = [](const std::vector<int64_t>& dims) {
+        return dims.size() == NCHW_DIM_NUM && std::all_of(dims.cbegin(), dims.cend(), [](int64_t d) { return d > 0; });
+    };
+    if (!isValidDims(plan.inDims) || !isValidDims(plan.outDims) || plan.inDims[DIM_C] != desc->channel ||
+        plan.outDims[DIM_C] > MAX_CHANNEL) {
+        return hiai::UNSUPPORTED;
+    }
+
+    int64_t h = plan.inDims[DIM_H];
+    int64_t w = plan.inDims[DIM_W];
+    if (para.enableCrop) {
+        const CropPara& crop = para.cropPara;
+        if (crop.cropSizeW == 0 || crop.cropSizeH == 0 || crop.cropStartPosW + crop.cropSizeW > w ||
+            crop.cropStartPosH + crop.cropSizeH > h) {
+            return hiai::UNSUPPORTED;
+        }
+        h = crop.cropSizeH;
+        w = crop.cropSizeW;
+    }
+    if (para.enableResize) {
+        h = para.resizePara.resizeOutputSizeH;
+        w = para.resizePara.resizeOutputSizeW;
+    }
+    if (para.enablePadding) {
+        h += para.paddingPara.paddingSizeTop + para.paddingPara.paddingSizeBottom;
+        w += para.paddingPara.paddingSizeLeft + para.paddingPara.paddingSizeRight;
+    }
+    if (h != plan.outDims[DIM_H] || w != plan.outDims[DIM_W]) {
+        return hiai::UNSUPPORTED;
+    }
+
+    InitColorAffine(para, *desc, static_cast<uint32_t>(plan.outDims[DIM_C]), plan.color);
+    if (para.enableDtc && InitDtc(para.dtcPara, plan.dtcSub, plan.dtcScale)) {
+        if (!IsIdentity(plan.color)) {
+            ScaleAffine(plan.color, plan.dtcSub, plan.dtcScale);
+        } else {
+            plan.foldConv = para.enablePadding ? nullptr : FindFoldableConv(lastNode, plan.color.outChannel);
+            plan.explicitDtc = plan.foldConv == nullptr;
+        }
+    }
+    return hiai::SUCCESS;
+}
+
+class LoweringBuilder {
+public:
+    LoweringBuilder(ge::ComputeGraph& graph, ge::Node& dataNode, std::vector<int64_t> dims)
+        : graph_(graph), prefix_(dataNode.ROLE(NodeSpec).Name() + "_aipp_"), curr_(&dataNode), dims_(std::move(dims)),
+          dataType_(dataNode.ROLE(NodeSpec).OpDesc().GetOutputDesc(0).GetDataType())
+    {
+    }
+    ~LoweringBuilder() = default;
+
+    ge::Node& Current() const
+    {
+        return *curr_;
+    }
+
+    const std::vector<int64_t>& Dims() const
+    {
+        return dims_;
+    }
+
+    ge::Node* AddConst(const std::vector<int64_t>& dims, ge::DataType type, const void* data, size_t size)
+    {
+        ge::TensorDesc desc(ge::Shape(dims), ge::FORMAT_NCHW, type);
+        ge::TensorPtr tensor =
+            hiai::make_shared_nothrow<ge::Tensor>(desc, static_cast<const uint8_t*>(data), size);
+        HIAI_EXPECT_NOT_NULL_R(tensor, nullptr);
+
+        auto opDesc = hiai::make_shared_nothrow<ge::OpDesc>(NextName(), std::string(hiai::op::Const::TYPE));
+        HIAI_EXPECT_NOT_NULL_R(opDesc, nullptr);
+        HIAI_EXPECT_TRUE_R(ge::AttrUtils::SetTensor(opDesc, hiai::ATTR_NAME_WEIGHTS, tensor), nullptr);
+        HIAI_EXPECT_EXEC_R(opDesc->AddOutputDesc(desc), nullptr);
+
+        return graph_.ROLE(GraphModifier).AddNodeFront(opDesc);
+    }
+
+    template <typename T>
+    ge::Node* AddConst(const std::vector<int64_t>& dims, ge::DataType type, const std::vector<T>& values)
+    {
+        return AddConst(dims, type, values.data(), values.size() * sizeof(T));
+    }
+
+    // 以当前输出为x, consts依次作为后续输入, 追加一个FLOAT输出的算子
+    ge::Node* Append(const std::string& type, const std::vector<ge::Node*>& consts, const std::vector<int64_t>& outDims)
+    {
+        for (const auto& node : consts) {
+            HIAI_EXPECT_NOT_NULL_R(node, nullptr);
+        }
+        auto opDesc = hiai::make_shared_nothrow<ge::OpDesc>(NextName(), type);
+        HIAI_EXPECT_NOT_NULL_R(opDesc, nullptr);
+        HIAI_EXPECT_EXEC_R(opDesc->AddInputDesc(ge::TensorDesc(ge::Shape(dims_), ge::FORMAT_NCHW, dataType_)), nullptr);
+        for (const auto& node : consts) {
+            HIAI_EXPECT_EXEC_R(opDesc->AddInputDesc(node->ROLE(NodeSpec).OpDesc().GetOutputDesc(0)), nullptr);
+        }
+        HIAI_EXPECT_EXEC_R(
+            opDesc->AddOutputDesc(ge::TensorDesc(ge::Shape(outDims), ge::FORMAT_NCHW, ge::DT_FLOAT)), nullptr);
+
+        ge::GraphModifier& modifier = graph_.ROLE(GraphModifier);
+        ge::Node* node = modifier.AddNode(opDesc);
+        HIAI_EXPECT_NOT_NULL_R(node, nullptr);
+        HIAI_EXPECT_EXEC_R(modifier.AddEdge({*curr_, 0}, {*node, 0}), nullptr);
+        for (size_t i = 0; i < consts.size(); ++i) {
+            HIAI_EXPECT_EXEC_R(modifier.AddEdge({*consts[i], 0}, {*node, static_cast<int>(i + 1)}), nullptr);
+        }
+
+        curr_ = node;
+        dims_ = outDims;
+        dataType_ = ge::DT_FLOAT;
+        return node;
+    }
+
+private:
+    std::string NextName()
+    {
+        return prefix_ + std::to_string(index_++);
+    }
+
+private:
+    ge::ComputeGraph& graph_;
+    std::string prefix_;
+    ge::Node* curr_;
+    std::vector<int64_t> dims_;
+    ge::DataType dataType_;
+    uint32_t index_ {0};
+};
+
+std::vector<int64_t> WithDim(std::vector<int64_t> dims, size_t idx, int64_t value)
+{
+    dims[idx] = value;
+    return dims;
+}
+
+hiai::Status AppendCast(LoweringBuilder& builder)
+{
+    ge::Node* cast = builder.Append(hiai::op::CastT::TYPE, {}, builder.Dims());
+    HIAI_EXPECT_NOT_NULL(cast);
+    ge::OpDesc& opDesc = cast->ROLE(NodeSpec).OpDesc();
+    HIAI_EXPECT_TRUE(ge::AttrUtils::SetInt(opDesc, hiai::op::CastT::src_dtype, static_cast<int64_t>(ge::DT_UINT8)));
+    HIAI_EXPECT_TRUE(ge::AttrUtils::SetInt(opDesc, hiai::op::CastT::dst_dtype, static_cast<int64_t>(ge::DT_FLOAT)));
+    return hiai::SUCCESS;
+}
+
+// AIPP输入按像素交织存放, Data声明为NCHW, 先按内存布局重解释为NHWC再转置
+hiai::Status AppendToNchw(LoweringBuilder& builder)
+{
+    const std::vector<int64_t> dims = builder.Dims();
+    if (dims[DIM_C] == 1) {
+        return hiai::SUCCESS;
+    }
+    const std::vector<int64_t> nhwc = {dims[DIM_N], dims[DIM_H], dims[DIM_W], dims[DIM_C]};
+    const std::vector<int32_t> shape(nhwc.cbegin(), nhwc.cend());
+    ge::Node* shapeConst = builder.AddConst({static_cast<int64_t>(NCHW_DIM_NUM)}, ge::DT_INT32, shape);
+    HIAI_EXPECT_NOT_NULL(builder.Append(hiai::op::Reshape::TYPE, {shapeConst}, nhwc));
+
+    ge::Node* permute = builder.Append(hiai::op::Permute::TYPE, {}, dims);
+    HIAI_EXPECT_NOT_NULL(permute);
+    HIAI_EXPECT_TRUE(ge::AttrUtils::SetListInt(
+        permute->ROLE(NodeSpec).OpDesc(), hiai::op::Permute::order, std::vector<int64_t> {0, 3, 1, 2}));
+    return hiai::SUCCESS;
+}
+
+hiai::Status AppendCrop(LoweringBuilder& builder, const CropPara& crop)
+{
+    std::vector<int64_t> dims = builder.Dims();
+    dims[DIM_H] = crop.cropSizeH;
+    dims[DIM_W] = crop.cropSizeW;
+    const std::vector<int32_t> offsets = {
+        0, 0, static_cast<int32_t>(crop.cropStartPosH), static_cast<int32_t>(crop.cropStartPosW)};
+    const std::vector<int32_t> size(dims.cbegin(), dims.cend());
+    ge::Node* offsetsConst = builder.AddConst({static_cast<int64_t>(NCHW_DIM_NUM)}, ge::DT_INT32, offsets);
+    ge::Node* sizeConst = builder.AddConst({static_cast<int64_t>(NCHW_DIM_NUM)}, ge::DT_INT32, size);
+    HIAI_EXPECT_NOT_NULL(builder.Append(hiai::op::Slice::TYPE, {offsetsConst, sizeConst}, dims));
+    return hiai::SUCCESS;
+}
+
+// 通道交换与CSC(含已折叠的DTC)合并为一个1x1卷积, CSC的四舍五入与[0, 255]截断不再保留
+hiai::Status AppendColorConv(LoweringBuilder& builder, const ChannelAffine& affine)
+{
+    std::vector<float> filter;
+    std::vector<float> bias;
+    for (uint32_t i = 0; i < affine.outChannel; ++i) {
+        for (uint32_t j = 0; j < affine.inChannel; ++j) {
+            filter.push_back(affine.matrix[i][j]);
+        }
+        bias.push_back(affine.bias[i]);
+    }
+    ge::Node* filterConst = builder.AddConst({affine.outChannel, affine.inChannel, 1, 1}, ge::DT_FLOAT, filter);
+    ge::Node* biasConst = builder.AddConst({affine.outChannel}, ge::DT_FLOAT, bias);
+    ge::Node* conv = builder.Append(
+        hiai::op::Convolution::TYPE, {filterConst, biasConst}, WithDim(builder.Dims(), DIM_C, affine.outChannel));
+    HIAI_EXPECT_NOT_NULL(conv);
+    HIAI_EXPECT_TRUE(ge::AttrUtils::SetListInt(
+        conv->ROLE(NodeSpec).OpDesc(), hiai::op::Convolution::strides, std::vector<int64_t> {1, 1}));
+    return hiai::SUCCESS;
+}
+
+hiai::Status AppendResize(LoweringBuilder& builder, const ResizePara& resize)
+{
+    std::vector<int64_t> dims = builder.Dims();
+    dims[DIM_H] = resize.resizeOutputSizeH;
+    dims[DIM_W] = resize.resizeOutputSizeW;
+    const std::vector<int32_t> size = {static_cast<int32_t>(dims[DIM_H]), static_cast<int32_t>(dims[DIM_W])};
+    ge::Node* sizeConst = builder.AddConst({static_cast<int64_t>(size.size())}, ge::DT_INT32, size);
+    ge::Node* resizeNode = builder.Append(hiai::op::ResizeBilinearV2::TYPE, {sizeConst}, dims);
+    HIAI_EXPECT_NOT_NULL(resizeNode);
+    ge::OpDesc& opDesc = resizeNode->ROLE(NodeSpec).OpDesc();
+    HIAI_EXPECT_TRUE(ge::AttrUtils::SetBool(opDesc, hiai::op::ResizeBilinearV2::align_corners, false));
+    HIAI_EXPECT_TRUE(ge::AttrUtils::SetBool(opDesc, hiai::op::ResizeBilinearV2::half_pixel_centers, true));
+    return hiai::SUCCESS;
+}
+
+// 按通道逐元素运算, 参数广播为[1, C, 1, 1]
+hiai::Status AppendChannelEltwise(LoweringBuilder& builder, const std::string& type, const float* values)
+{
+    const int64_t channel = builder.Dims()[DIM_C];
+    const std::vector<float> data(values, values + channel);
+    ge::Node* valueConst = builder.AddConst({1, channel, 1, 1}, ge::DT_FLOAT, data);
+    HIAI_EXPECT_NOT_NULL(builder.Append(type, {valueConst}, builder.Dims()));
+    return hiai::SUCCESS;
+}
+
+// Pad只补0, 非0填充值通过 Pad(x - v) + v 实现
+hiai::Status AppendPadding(LoweringBuilder& builder, const PadPara& pad)
+{
+    const float values[MAX_CHANNEL] = {
+        pad.paddingValueChn0, pad.paddingValueChn1, pad.paddingValueChn2, pad.paddingValueChn3};
+    const int64_t channel = builder.Dims()[DIM_C];
+    bool zeroPad = std::all_of(values, values + channel, [](float v) { return v == 0.0f; });
+    if (!zeroPad) {
+        HIAI_EXPECT_EXEC(AppendChannelEltwise(builder, hiai::op::Sub::TYPE, values));
+    }
+
+    std::vector<int64_t> dims = builder.Dims();
+    dims[DIM_H] += pad.paddingSizeTop + pad.paddingSizeBottom;
+    dims[DIM_W] += pad.paddingSizeLeft + pad.paddingSizeRight;
+    const std::vector<int32_t> paddings = {0, 0, 0, 0, static_cast<int32_t>(pad.paddingSizeTop),
+        static_cast<int32_t>(pad.paddingSizeBottom), static_cast<int32_t>(pad.paddingSizeLeft),
+        static_cast<int32_t>(pad.paddingSizeRight)};
+    ge::Node* paddingsConst = builder.AddConst({static_cast<int64_t>(NCHW_DIM_NUM), 2}, ge::DT_INT32, paddings);
+    HIAI_EXPECT_NOT_NULL(builder.Append(hiai::op::Pad::TYPE, {paddingsConst}, dims));
+
+    if (!zeroPad) {
+        HIAI_EXPECT_EXEC(AppendChannelEltwise(builder, hiai::op::Add::TYPE, values));
+    }
+    return hiai::SUCCESS;
+}
+
+hiai::Status AppendLoweredOps(LoweringBuilder& builder, const AippParamInfo& para, const LoweringPlan& plan)
+{
+    HIAI_EXPECT_EXEC(AppendCast(builder));
+    HIAI_EXPECT_EXEC(AppendToNchw(builder));
+    if (para.enableCrop) {
+        HIAI_EXPECT_EXEC(AppendCrop(builder, para.cropPara));
+    }
+    if (!IsIdentity(plan.color)) {
+        HIAI_EXPECT_EXEC(AppendColorConv(builder, plan.color));
+    }
+    if (para.enableResize) {
+        HIAI_EXPECT_EXEC(AppendResize(builder, para.resizePara));
+    }
+    if (plan.explicitDtc) {
+        HIAI_EXPECT_EXEC(AppendChannelEltwise(builder, hiai::op::Sub::TYPE, plan.dtcSub));
+        HIAI_EXPECT_EXEC(AppendChannelEltwise(builder, hiai::op::Mul::TYPE, plan.dtcScale));
+    }
+    if (para.enablePadding) {
+        HIAI_EXPECT_EXEC(AppendPadding(builder, para.paddingPara));
+    }
+    HIAI_EXPECT_TRUE(builder.Dims() == plan.outDims);
+    return hiai::SUCCESS;
+}
+
+hiai::Status UpdateGraphOutputNode(ge::ComputeGraph& graph, ge::Node& lastNode, ge::Node& lowered)
+{
+    std::vector<ge::Node*> graphOutputNodes;
+    (void)graph.ROLE(GraphListWalker).WalkOutNodes([&graphOutputNodes](ge::Node& node) {
+        graphOutputNodes.push_back(&node);
+        return hiai::SUCCESS;
+    });
+
+    for (size_t i = 0; i < graphOutputNodes.size(); ++i) {
+        if (graphOutputNodes[i] == &lastNode) {
+            graphOutputNodes[i] = &lowered;
+            return graph.ROLE(GraphModifier).SetOutputs(graphOutputNodes);
+        }
+    }
+    return hiai::SUCCESS;
+}
+
+// 展开结果为FLOAT, 与硬件AIPP的输出一致, 其后转FLOAT的CastT不再需要
+hiai::Status RelinkConsumers(ge::ComputeGraph& graph, ge::Node& lastNode, ge::Node& lowered)
+{
+    ge::GraphModifier& modifier = graph.ROLE(GraphModifier);
+    std::vector<ge::Node*> castNodes;
+    auto relink = [&modifier, &lowered, &castNodes](ge::Edge& edge) {
+        HIAI_EXPECT_EXEC(modifier.RemoveEdge(edge));
+        HIAI_EXPECT_EXEC(modifier.AddEdge({lowered, 0}, edge.Dst()));
+
+        ge::Node& dst = edge.DstNode();
+        ge::TensorDescPtr inputDesc = dst.ROLE(NodeSpec).OpDesc().MutableInputDesc(edge.DstIdx());
+        if (inputDesc != nullptr) {
+            inputDesc->SetDataType(ge::DT_FLOAT);
+        }
+        if (dst.ROLE(NodeSpec).Type() == hiai::op::CastT::TYPE) {
+            castNodes.push_back(&dst);
+        }
+        return hiai::SUCCESS;
+    };
+    HIAI_EXPECT_EXEC(lastNode.ROLE(NodeWalker).ListOutDataEdges(std::move(relink)));
+    HIAI_EXPECT_EXEC(UpdateGraphOutputNode(graph, lastNode, lowered));
+
+    for (const auto& cast : castNodes) {
+        HIAI_EXPECT_TRUE(ge::AttrUtils::SetInt(
+            cast->ROLE(NodeSpec).OpDesc(), hiai::op::CastT::src_dtype, static_cast<int64_t>(ge::DT_FLOAT)));
+        if (IsCastToFloat(*cast) && graph.ROLE(GraphBypasser).PreCheck(*cast)) {
+            HIAI_EXPECT_EXEC(graph.ROLE(GraphBypasser).ByPassNode(*cast));
+        }
+    }
+    return hiai::SUCCESS;
+}
+} // namespace
+
+namespace hiai {
+Status AippStaticLowering::Lower(ge::ComputeGraph& graph, ge::Node& dataNode, ge::Node& lastNode,
+    const AippParamInfo& para)
+{
+    LoweringPlan plan;
+    Status ret = InitLoweringPlan(dataNode, lastNode, para, plan);
+    if (ret != SUCCESS) {
+        return ret;
+    }
+
+    LoweringBuilder builder(graph, dataNode, plan.inDims);
+    HIAI_EXPECT_EXEC(AppendLoweredOps(builder, para, plan));
+    if (plan.foldConv != nullptr) {
+        HIAI_EXPECT_EXEC(FoldDtcIntoConv(*plan.foldConv, plan.dtcSub, plan.dtcScale));
+    }
+    HIAI_EXPECT_EXEC(RelinkConsumers(graph, lastNode, builder.Current()));
+
+    FMK_LOGI("static aipp of %s is lowered, dtc folded into conv: %d.", dataNode.ROLE(NodeSpec).Name().c_str(),
+        plan.foldConv != nullptr);
+    return SUCCESS;
+}
+} // namespace hiai
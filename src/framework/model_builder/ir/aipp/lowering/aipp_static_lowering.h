@@ -0,0 +1,43 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FRAMEWORK_MODEL_BUILDER_IR_AIPP_AIPP_STATIC_LOWERING_H
+#define FRAMEWORK_MODEL_BUILDER_IR_AIPP_AIPP_STATIC_LOWERING_H
+
+#include "base/error_types.h"
+#include "model/built_model_aipp.h"
+#include "framework/graph/core/cgraph/graph_fwd.h"
+#include "framework/graph/core/node/node_fwd.h"
+
+namespace hiai {
+/*
+ * 将参数全部为Const的静态AIPP图像算子链展开为普通算子, 用于无硬件AIPP的ROM:
+ * CastT -> Reshape/Permute(NHWC->NCHW) -> Slice(crop) -> Convolution 1x1(通道交换+CSC) -> ResizeBilinearV2
+ *       -> Sub/Mul(DTC) -> Pad(padding)
+ * DTC优先折叠进生成的1x1卷积, 否则折叠进模型首个卷积的filter/bias.
+ */
+class AippStaticLowering {
+public:
+    /*
+     * @param [in] dataNode 图像输入Data
+     * @param [in] lastNode 图像算子链的最后一个节点, 其输出已完成infershape
+     * @return SUCCESS: 展开成功, 图像算子链的消费者已改接到展开结果; UNSUPPORTED: 配置不支持展开, 图未修改
+     */
+    static Status Lower(ge::ComputeGraph& graph, ge::Node& dataNode, ge::Node& lastNode, const AippParamInfo& para);
+};
+} // namespace hiai
+
+#endif // FRAMEWORK_MODEL_BUILDER_IR_AIPP_AIPP_STATIC_LOWERING_H
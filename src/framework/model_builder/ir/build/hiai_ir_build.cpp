@@ -34,6 +34,8 @@
 
 #include "framework/graph/utils/graph_utils.h"
 #include "framework/graph/utils/attr_utils.h"
+#include "framework/graph/utils/optimizer/constant_folding_optimizer.h"
+#include "framework/graph/utils/optimizer/weight_share_optimizer.h"
 #include "framework/compatible/ir_transformer.h"
 #include "model/built_model_aipp.h"
 #include "model_builder/ir/aipp/compatible/hiai_ir_aipp_compatible_adapter_dl.h"
@@ -207,6 +209,30 @@ GRAPH_API_EXPORT void HiaiIrBuild::ReleaseModelBuff(ModelBufferData& output)
     }
 }
 
+GRAPH_API_EXPORT Status HiaiIrBuild::ShareIdenticalWeights(ge::Model& irModel, uint64_t& savedBytes)
+{
+    H_LOG_INTERFACE_FILTER(ITF_COUNT);
+    savedBytes = 0;
+    ge::ComputeGraphPtr graph = ge::GraphUtils::GetComputeGraph(irModel.GetGraph());
+    HIAI_EXPECT_NOT_NULL(graph);
+
+    HIAI_EXPECT_EXEC(ge::WeightShareOptimizer::Optimize(*graph, savedBytes));
+    FMK_LOGI("share identical weights saved %llu bytes.", static_cast<unsigned long long>(savedBytes));
+    return SUCCESS;
+}
+
+GRAPH_API_EXPORT Status HiaiIrBuild::FoldConstants(ge::Model& irModel, uint32_t& foldedNum)
+{
+    H_LOG_INTERFACE_FILTER(ITF_COUNT);
+    foldedNum = 0;
+    ge::ComputeGraphPtr graph = ge::GraphUtils::GetComputeGraph(irModel.GetGraph());
+    HIAI_EXPECT_NOT_NULL(graph);
+
+    HIAI_EXPECT_EXEC(ge::ConstantFoldingOptimizer::Optimize(*graph, foldedNum));
+    FMK_LOGI("fold constants removed %u nodes.", foldedNum);
+    return SUCCESS;
+}
+
 static std::shared_ptr<hiai::IBuiltModel> BuildModel(
     const hiai::ModelBuildOptions& buildOptions, const std::string& modelName, ge::Model& irModel)
 {
@@ -299,9 +325,11 @@ bool IsSupportNewAipp()
     return false;
 }
 
-static hiai::Status MakeAippCompatible(ExtendedCompatibleModel& extendedModel)
+static hiai::Status MakeAippCompatible(ExtendedCompatibleModel& extendedModel, StaticAippMode staticAippMode)
 {
-    if (IsSupportNewAipp()) {
+    // 显式要求展开静态AIPP时, 不论ROM是否支持新AIPP都必须展开, 否则模型中会保留硬件Aipp节点
+    const bool lowerToOps = staticAippMode == StaticAippMode::LOWER_TO_OPS;
+    if (!lowerToOps && IsSupportNewAipp()) {
         return hiai::SUCCESS;
     }
 
@@ -311,17 +339,22 @@ static hiai::Status MakeAippCompatible(ExtendedCompatibleModel& extendedModel)
     const char* HIAI_IR_BUILD_AIPP = "libhiai_ir_build_aipp.so";
     void* handle = dlopen(HIAI_IR_BUILD_AIPP, RTLD_LAZY);
     if (handle == nullptr) {
+        if (lowerToOps) {
+            FMK_LOGE("lowering static aipp requires libhiai_ir_build_aipp.so!");
+            return hiai::FAILURE;
+        }
         FMK_LOGW("have no libhiai_ir_build_aipp.so!");
         return hiai::SUCCESS;
     }
-    auto func = reinterpret_cast<Status (*)(ge::ComputeGraph&, std::string&)>(
-        dlsym(handle, "GenerateAippCompatibleInfoAdapter"));
+    const char* adapterName = lowerToOps ? "LowerStaticAippAdapter" : "GenerateAippCompatibleInfoAdapter";
+    auto func = reinterpret_cast<Status (*)(ge::ComputeGraph&, std::string&)>(dlsym(handle, adapterName));
     HIAI_EXPECT_NOT_NULL(func);
 
     return func(*graph, extendedModel.aippConfig_);
 }
 
-static std::unique_ptr<ExtendedCompatibleModel> MakeCompatibleModel(const std::shared_ptr<ge::Model>& model)
+static std::unique_ptr<ExtendedCompatibleModel> MakeCompatibleModel(
+    const std::shared_ptr<ge::Model>& model, StaticAippMode staticAippMode)
 {
     (void)ge::AttrUtils::SetInt(&*model, "stream_num", 1);
     std::unique_ptr<ExtendedCompatibleModel> compatibleModel = ge::make_unique<ExtendedCompatibleModel>(model.get());
@@ -331,7 +364,7 @@ static std::unique_ptr<ExtendedCompatibleModel> MakeCompatibleModel(const std::s
 
     HIAI_EXPECT_TRUE_R(VerifyIRAPI(graph), nullptr);
 
-    HIAI_EXPECT_EXEC_R(MakeAippCompatible(*compatibleModel.get()), nullptr);
+    HIAI_EXPECT_EXEC_R(MakeAippCompatible(*compatibleModel.get(), staticAippMode), nullptr);
 
     return compatibleModel;
 }
@@ -356,7 +389,7 @@ GRAPH_API_EXPORT Status HiaiIrBuild::Build(const hiai::ModelBuildOptions& option
     const std::shared_ptr<ge::Model>& model, std::shared_ptr<hiai::IBuiltModel>& builtModel)
 {
     H_LOG_INTERFACE_FILTER(ITF_COUNT);
-    auto compatibleModel = MakeCompatibleModel(model);
+    auto compatibleModel = MakeCompatibleModel(model, options.staticAippMode);
     HIAI_EXPECT_NOT_NULL(compatibleModel);
 
     builtModel = BuildCompatibleModel(options, modelName, compatibleModel);
@@ -0,0 +1,384 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "batching_model_manager_impl.h"
+
+#include <algorithm>
+
+#include "securec.h"
+#include "infra/base/assertion.h"
+#include "infra/base/securestl.h"
+
+#include "framework/infra/log/log.h"
+
+namespace hiai {
+BatchingModelManager::BatchingModelManager(
+    const std::shared_ptr<IModelManager>& modelManager, const BatchingOptions& options)
+    : modelManager_(modelManager), options_(options)
+{
+}
+
+BatchingModelManager::~BatchingModelManager()
+{
+    if (worker_.joinable()) {
+        DeInit();
+    }
+}
+
+Status BatchingModelManager::PrepareBatchTensors(
+    const std::vector<NDTensorDesc>& descs, int32_t modelBatch, BatchTensors& tensors)
+{
+    tensors = BatchTensors();
+    int32_t bufferBatch = dynamicBatch_ ? static_cast<int32_t>(maxBatch_) : modelBatch;
+
+    for (const auto& desc : descs) {
+        if (desc.dims.empty() || desc.dims[0] != modelBatch) {
+            FMK_LOGE("batch dim of all model inputs and outputs should be %d.", modelBatch);
+            return UNSUPPORTED;
+        }
+        for (size_t i = 1; i < desc.dims.size(); i++) {
+            if (desc.dims[i] <= 0) {
+                FMK_LOGE("only batch dim can be dynamic, dims[%zu] = %d.", i, desc.dims[i]);
+                return UNSUPPORTED;
+            }
+        }
+
+        NDTensorDesc batchDesc = desc;
+        batchDesc.dims[0] = bufferBatch;
+        std::shared_ptr<INDTensorBuffer> batchBuffer = CreateNDTensorBuffer(batchDesc);
+        HIAI_EXPECT_NOT_NULL_R(batchBuffer, MEMORY_EXCEPTION);
+        tensors.batchBuffers.push_back(batchBuffer);
+
+        NDTensorDesc sampleDesc = desc;
+        sampleDesc.dims[0] = 1;
+        tensors.sampleDescs.push_back(sampleDesc);
+        tensors.sampleSizes.push_back(batchBuffer->GetSize() / static_cast<size_t>(bufferBatch));
+    }
+
+    if (!dynamicBatch_) {
+        tensors.views.push_back(tensors.batchBuffers);
+        return SUCCESS;
+    }
+
+    tensors.views.resize(maxBatch_);
+    for (size_t num = 1; num <= maxBatch_; num++) {
+        for (size_t i = 0; i < descs.size(); i++) {
+            NDTensorDesc viewDesc = tensors.sampleDescs[i];
+            viewDesc.dims[0] = static_cast<int32_t>(num);
+            std::shared_ptr<INDTensorBuffer> view = CreateNDTensorBufferNoCopy(
+                viewDesc, tensors.batchBuffers[i]->GetData(), num * tensors.sampleSizes[i]);
+            HIAI_EXPECT_NOT_NULL_R(view, MEMORY_EXCEPTION);
+            tensors.views[num - 1].push_back(view);
+        }
+    }
+    return SUCCESS;
+}
+
+Status BatchingModelManager::PrepareBatchTensors(const std::shared_ptr<IBuiltModel>& builtModel)
+{
+    std::vector<NDTensorDesc> inputDescs = builtModel->GetInputTensorDescs();
+    std::vector<NDTensorDesc> outputDescs = builtModel->GetOutputTensorDescs();
+    HIAI_EXPECT_TRUE(!inputDescs.empty() && !outputDescs.empty());
+    HIAI_EXPECT_TRUE(!inputDescs[0].dims.empty());
+
+    int32_t modelBatch = inputDescs[0].dims[0];
+    if (modelBatch == 0) {
+        FMK_LOGE("model batch is 0.");
+        return UNSUPPORTED;
+    }
+    dynamicBatch_ = modelBatch < 0;
+    maxBatch_ = dynamicBatch_ ? options_.maxBatchSize :
+                                std::min(static_cast<size_t>(options_.maxBatchSize), static_cast<size_t>(modelBatch));
+
+    HIAI_EXPECT_EXEC(PrepareBatchTensors(inputDescs, modelBatch, inputs_));
+    return PrepareBatchTensors(outputDescs, modelBatch, outputs_);
+}
+
+Status BatchingModelManager::Init(const ModelInitOptions& options, const std::shared_ptr<IBuiltModel>& builtModel,
+    const std::shared_ptr<IModelManagerListener>& listener)
+{
+    WriteLockGuard lock(lifecycleMutex_);
+    HIAI_EXPECT_TRUE(!worker_.joinable());
+    HIAI_EXPECT_NOT_NULL(builtModel);
+
+    HIAI_EXPECT_EXEC(PrepareBatchTensors(builtModel));
+    HIAI_EXPECT_EXEC(modelManager_->Init(options, builtModel, listener));
+
+    {
+        std::lock_guard<std::mutex> queueLock(queueMutex_);
+        listener_ = listener;
+        running_ = true;
+    }
+    worker_ = std::thread(&BatchingModelManager::WorkLoop, this);
+    return SUCCESS;
+}
+
+Status BatchingModelManager::SetPriority(ModelPriority priority)
+{
+    return modelManager_->SetPriority(priority);
+}
+
+Status BatchingModelManager::CheckRequest(const std::vector<std::shared_ptr<INDTensorBuffer>>& inputs,
+    std::vector<std::shared_ptr<INDTensorBuffer>>& outputs) const
+{
+    if (inputs.size() != inputs_.sampleSizes.size()) {
+        FMK_LOGE("input num %zu is not equal to model input num %zu.", inputs.size(), inputs_.sampleSizes.size());
+        return INVALID_PARAM;
+    }
+    for (size_t i = 0; i < inputs.size(); i++) {
+        HIAI_EXPECT_NOT_NULL_R(inputs[i], INVALID_PARAM);
+        HIAI_EXPECT_NOT_NULL_R(inputs[i]->GetData(), INVALID_PARAM);
+        if (inputs[i]->GetSize() != inputs_.sampleSizes[i]) {
+            FMK_LOGE("input[%zu] size %zu is not one sample size %zu.", i, inputs[i]->GetSize(),
+                inputs_.sampleSizes[i]);
+            return INVALID_PARAM;
+        }
+    }
+
+    if (outputs.empty()) {
+        for (const auto& desc : outputs_.sampleDescs) {
+            std::shared_ptr<INDTensorBuffer> output = CreateNDTensorBuffer(desc);
+            HIAI_EXPECT_NOT_NULL_R(output, MEMORY_EXCEPTION);
+            outputs.push_back(output);
+        }
+        return SUCCESS;
+    }
+
+    if (outputs.size() != outputs_.sampleSizes.size()) {
+        FMK_LOGE("output num %zu is not equal to model output num %zu.", outputs.size(), outputs_.sampleSizes.size());
+        return INVALID_PARAM;
+    }
+    for (size_t i = 0; i < outputs.size(); i++) {
+        HIAI_EXPECT_NOT_NULL_R(outputs[i], INVALID_PARAM);
+        HIAI_EXPECT_NOT_NULL_R(outputs[i]->GetData(), INVALID_PARAM);
+        HIAI_EXPECT_TRUE_R(outputs[i]->GetSize() == outputs_.sampleSizes[i], INVALID_PARAM);
+    }
+    return SUCCESS;
+}
+
+Status BatchingModelManager::Enqueue(const std::shared_ptr<BatchRequest>& request)
+{
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        if (!running_) {
+            FMK_LOGE("batching model manager is not inited.");
+            return FAILURE;
+        }
+        request->enqueueTime = std::chrono::steady_clock::now();
+        queue_.push_back(request);
+    }
+    queueCond_.notify_one();
+    return SUCCESS;
+}
+
+Status BatchingModelManager::Run(
+    const std::vector<std::shared_ptr<INDTensorBuffer>>& inputs, std::vector<std::shared_ptr<INDTensorBuffer>>& outputs)
+{
+    ReadLockGuard lock(lifecycleMutex_);
+    HIAI_EXPECT_TRUE(worker_.joinable());
+    HIAI_EXPECT_EXEC(CheckRequest(inputs, outputs));
+
+    std::shared_ptr<BatchRequest> request = make_shared_nothrow<BatchRequest>();
+    HIAI_EXPECT_NOT_NULL_R(request, MEMORY_EXCEPTION);
+    request->inputs = inputs;
+    request->outputs = outputs;
+    HIAI_EXPECT_EXEC(Enqueue(request));
+
+    std::unique_lock<std::mutex> requestLock(request->mutex);
+    request->cond.wait(requestLock, [&request] { return request->done; });
+    return request->result;
+}
+
+Status BatchingModelManager::RunAsync(const Context& context,
+    const std::vector<std::shared_ptr<INDTensorBuffer>>& inputs, std::vector<std::shared_ptr<INDTensorBuffer>>& outputs,
+    int32_t timeout)
+{
+    // 合批后统一同步执行, 不单独计算每个请求的超时
+    (void)timeout;
+    ReadLockGuard lock(lifecycleMutex_);
+    HIAI_EXPECT_TRUE(worker_.joinable());
+    HIAI_EXPECT_NOT_NULL_R(listener_, UNSUPPORTED);
+    HIAI_EXPECT_EXEC(CheckRequest(inputs, outputs));
+
+    std::shared_ptr<BatchRequest> request = make_shared_nothrow<BatchRequest>();
+    HIAI_EXPECT_NOT_NULL_R(request, MEMORY_EXCEPTION);
+    request->inputs = inputs;
+    request->outputs = outputs;
+    request->isAsync = true;
+    request->context = context;
+    return Enqueue(request);
+}
+
+Status BatchingModelManager::Cancel()
+{
+    // 尚未合批的请求不会再下发, 与StopWorker一致直接以失败结束, 已下发的批次交由内部模型管理器取消
+    std::deque<std::shared_ptr<BatchRequest>> pending;
+    std::shared_ptr<IModelManagerListener> listener;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        pending.swap(queue_);
+        listener = listener_;
+    }
+    for (const auto& request : pending) {
+        Complete(request, FAILURE, listener);
+    }
+    return modelManager_->Cancel();
+}
+
+void BatchingModelManager::WorkLoop()
+{
+    const std::chrono::microseconds maxDelay(options_.maxDelayInUS);
+    std::vector<std::shared_ptr<BatchRequest>> batch;
+    batch.reserve(maxBatch_);
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(queueMutex_);
+            queueCond_.wait(lock, [this] { return !running_ || !queue_.empty(); });
+            if (!running_) {
+                return;
+            }
+            // 未凑满时最多等到首个请求入队后maxDelay
+            auto deadline = queue_.front()->enqueueTime + maxDelay;
+            queueCond_.wait_until(lock, deadline, [this] { return !running_ || queue_.size() >= maxBatch_; });
+            if (!running_) {
+                return;
+            }
+            // 等待期间队列可能已被Cancel清空
+            if (queue_.empty()) {
+                continue;
+            }
+            size_t num = std::min(queue_.size(), maxBatch_);
+            batch.assign(queue_.begin(), queue_.begin() + num);
+            queue_.erase(queue_.begin(), queue_.begin() + num);
+        }
+        RunBatch(batch);
+        batch.clear();
+    }
+}
+
+Status BatchingModelManager::GatherInputs(const std::vector<std::shared_ptr<BatchRequest>>& batch)
+{
+    for (size_t i = 0; i < inputs_.batchBuffers.size(); i++) {
+        uint8_t* dst = static_cast<uint8_t*>(inputs_.batchBuffers[i]->GetData());
+        size_t sampleSize = inputs_.sampleSizes[i];
+        for (size_t k = 0; k < batch.size(); k++) {
+            HIAI_EXPECT_TRUE(
+                memcpy_s(dst + k * sampleSize, sampleSize, batch[k]->inputs[i]->GetData(), sampleSize) == EOK);
+        }
+        if (dynamicBatch_) {
+            continue;
+        }
+        // 固定batch模型未凑满时补零
+        size_t usedSize = batch.size() * sampleSize;
+        size_t totalSize = inputs_.batchBuffers[i]->GetSize();
+        if (totalSize > usedSize) {
+            HIAI_EXPECT_TRUE(memset_s(dst + usedSize, totalSize - usedSize, 0, totalSize - usedSize) == EOK);
+        }
+    }
+    return SUCCESS;
+}
+
+Status BatchingModelManager::ScatterOutputs(const std::vector<std::shared_ptr<BatchRequest>>& batch)
+{
+    for (size_t i = 0; i < outputs_.batchBuffers.size(); i++) {
+        const uint8_t* src = static_cast<const uint8_t*>(outputs_.batchBuffers[i]->GetData());
+        size_t sampleSize = outputs_.sampleSizes[i];
+        for (size_t k = 0; k < batch.size(); k++) {
+            HIAI_EXPECT_TRUE(
+                memcpy_s(batch[k]->outputs[i]->GetData(), sampleSize, src + k * sampleSize, sampleSize) == EOK);
+        }
+    }
+    return SUCCESS;
+}
+
+void BatchingModelManager::RunBatch(const std::vector<std::shared_ptr<BatchRequest>>& batch)
+{
+    size_t viewIndex = dynamicBatch_ ? batch.size() - 1 : 0;
+    Status ret = GatherInputs(batch);
+    if (ret == SUCCESS) {
+        ret = modelManager_->Run(inputs_.views[viewIndex], outputs_.views[viewIndex]);
+    }
+    if (ret == SUCCESS) {
+        ret = ScatterOutputs(batch);
+    }
+    if (ret != SUCCESS) {
+        FMK_LOGE("run batch of %zu requests failed, ret = %d.", batch.size(), ret);
+    }
+
+    for (const auto& request : batch) {
+        Complete(request, ret, listener_);
+    }
+}
+
+void BatchingModelManager::Complete(const std::shared_ptr<BatchRequest>& request, Status result,
+    const std::shared_ptr<IModelManagerListener>& listener)
+{
+    if (request->isAsync) {
+        if (listener != nullptr) {
+            listener->OnRunDone(request->context, result, request->outputs);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(request->mutex);
+        request->result = result;
+        request->done = true;
+    }
+    request->cond.notify_one();
+}
+
+void BatchingModelManager::StopWorker()
+{
+    std::deque<std::shared_ptr<BatchRequest>> pending;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        running_ = false;
+        pending.swap(queue_);
+    }
+    queueCond_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+
+    for (const auto& request : pending) {
+        Complete(request, FAILURE, listener_);
+    }
+}
+
+void BatchingModelManager::DeInit()
+{
+    WriteLockGuard lock(lifecycleMutex_);
+    StopWorker();
+    modelManager_->DeInit();
+
+    {
+        std::lock_guard<std::mutex> queueLock(queueMutex_);
+        listener_ = nullptr;
+    }
+    inputs_ = BatchTensors();
+    outputs_ = BatchTensors();
+}
+
+std::shared_ptr<IModelManager> CreateBatchingModelManager(
+    const std::shared_ptr<IModelManager>& modelManager, const BatchingOptions& options)
+{
+    HIAI_EXPECT_NOT_NULL_R(modelManager, nullptr);
+    HIAI_EXPECT_TRUE_R(options.maxBatchSize != 0, nullptr);
+    return make_shared_nothrow<BatchingModelManager>(modelManager, options);
+}
+} // namespace hiai
@@ -0,0 +1,109 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FRAMEWORK_MODEL_MANAGER_BATCHING_MODEL_MANAGER_IMPL_H
+#define FRAMEWORK_MODEL_MANAGER_BATCHING_MODEL_MANAGER_IMPL_H
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "model_manager/batching_model_manager.h"
+#include "infra/base/rw_mutex.h"
+
+namespace hiai {
+struct BatchRequest {
+    std::vector<std::shared_ptr<INDTensorBuffer>> inputs;
+    std::vector<std::shared_ptr<INDTensorBuffer>> outputs;
+    std::chrono::steady_clock::time_point enqueueTime;
+    bool isAsync {false};
+    Context context;
+
+    // 同步请求等待完成
+    std::mutex mutex;
+    std::condition_variable cond;
+    bool done {false};
+    Status result {FAILURE};
+};
+
+class BatchingModelManager : public IModelManager {
+public:
+    BatchingModelManager(const std::shared_ptr<IModelManager>& modelManager, const BatchingOptions& options);
+    ~BatchingModelManager() override;
+
+    Status Init(const ModelInitOptions& options, const std::shared_ptr<IBuiltModel>& builtModel,
+        const std::shared_ptr<IModelManagerListener>& listener) override;
+
+    Status SetPriority(ModelPriority priority) override;
+
+    Status Run(const std::vector<std::shared_ptr<INDTensorBuffer>>& inputs,
+        std::vector<std::shared_ptr<INDTensorBuffer>>& outputs) override;
+
+    Status RunAsync(const Context& context, const std::vector<std::shared_ptr<INDTensorBuffer>>& inputs,
+        std::vector<std::shared_ptr<INDTensorBuffer>>& outputs, int32_t timeout) override;
+
+    Status Cancel() override;
+
+    void DeInit() override;
+
+private:
+    struct BatchTensors {
+        std::vector<std::shared_ptr<INDTensorBuffer>> batchBuffers;
+        // 动态batch模型views[n - 1]为前n个样本上的免拷贝视图, 固定batch模型只有views[0]
+        // 即batchBuffers本身
+        std::vector<std::vector<std::shared_ptr<INDTensorBuffer>>> views;
+        std::vector<NDTensorDesc> sampleDescs;
+        std::vector<size_t> sampleSizes;
+    };
+
+    Status PrepareBatchTensors(const std::vector<NDTensorDesc>& descs, int32_t modelBatch, BatchTensors& tensors);
+    Status PrepareBatchTensors(const std::shared_ptr<IBuiltModel>& builtModel);
+
+    Status CheckRequest(const std::vector<std::shared_ptr<INDTensorBuffer>>& inputs,
+        std::vector<std::shared_ptr<INDTensorBuffer>>& outputs) const;
+    Status Enqueue(const std::shared_ptr<BatchRequest>& request);
+
+    void WorkLoop();
+    void StopWorker();
+    void RunBatch(const std::vector<std::shared_ptr<BatchRequest>>& batch);
+    Status GatherInputs(const std::vector<std::shared_ptr<BatchRequest>>& batch);
+    Status ScatterOutputs(const std::vector<std::shared_ptr<BatchRequest>>& batch);
+    void Complete(const std::shared_ptr<BatchRequest>& request, Status result,
+        const std::shared_ptr<IModelManagerListener>& listener);
+
+private:
+    std::shared_ptr<IModelManager> modelManager_;
+    BatchingOptions options_;
+
+    // 读锁: Run/RunAsync, 写锁: Init/DeInit
+    RWMutex lifecycleMutex_;
+    // 写入时同时持有queueMutex_, Cancel不持有lifecycleMutex_, 在queueMutex_下读取
+    std::shared_ptr<IModelManagerListener> listener_ {nullptr};
+
+    bool dynamicBatch_ {false};
+    size_t maxBatch_ {0};
+    BatchTensors inputs_;
+    BatchTensors outputs_;
+
+    std::mutex queueMutex_;
+    std::condition_variable queueCond_;
+    std::deque<std::shared_ptr<BatchRequest>> queue_;
+    bool running_ {false};
+    std::thread worker_;
+};
+} // namespace hiai
+#endif // FRAMEWORK_MODEL_MANAGER_BATCHING_MODEL_MANAGER_IMPL_H
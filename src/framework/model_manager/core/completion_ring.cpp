@@ -0,0 +1,234 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "completion_ring.h"
+
+#include <chrono>
+
+#include "infra/base/assertion.h"
+#include "framework/infra/log/log.h"
+
+namespace hiai {
+CompletionRing::CompletionRing(uint32_t slotNum) : slots_(slotNum)
+{
+}
+
+bool CompletionRing::Acquire(RunDoneCallback callback, void* userData, RunToken& token)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < slots_.size(); i++) {
+        size_t index = (next_ + i) % slots_.size();
+        Slot& slot = slots_[index];
+        if (slot.busy) {
+            continue;
+        }
+        slot.busy = true;
+        slot.done = false;
+        slot.sequence++;
+        slot.callback = callback;
+        slot.userData = userData;
+        next_ = (index + 1) % slots_.size();
+
+        token.slot = static_cast<uint32_t>(index);
+        token.sequence = slot.sequence;
+        return true;
+    }
+    FMK_LOGE("all %zu async slots are in flight.", slots_.size());
+    return false;
+}
+
+void CompletionRing::Abandon(const RunToken& token)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (token.slot < slots_.size() && slots_[token.slot].sequence == token.sequence) {
+        ReleaseLocked(slots_[token.slot]);
+    }
+}
+
+void CompletionRing::Complete(uint32_t slot, Status result)
+{
+    HIAI_EXPECT_TRUE_VOID(slot < slots_.size());
+    RunDoneCallback callback = nullptr;
+    void* userData = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Slot& target = slots_[slot];
+        if (!target.busy || target.done) {
+            return;
+        }
+        target.result = result;
+        target.done = true;
+        callback = target.callback;
+        userData = target.userData;
+    }
+
+    if (callback == nullptr) {
+        cond_.notify_all();
+        return;
+    }
+    // 回调模式不会被Wait取走结果, 回调返回后即可复用
+    callback(userData, result);
+    std::lock_guard<std::mutex> lock(mutex_);
+    ReleaseLocked(slots_[slot]);
+}
+
+void CompletionRing::Close(Status result)
+{
+    for (size_t i = 0; i < slots_.size(); i++) {
+        Complete(static_cast<uint32_t>(i), result);
+    }
+}
+
+bool CompletionRing::IsWaitable(const RunToken& token) const
+{
+    if (token.slot >= slots_.size()) {
+        return false;
+    }
+    const Slot& slot = slots_[token.slot];
+    return slot.busy && slot.sequence == token.sequence && slot.callback == nullptr;
+}
+
+Status CompletionRing::CheckWaitable(const std::vector<RunToken>& tokens) const
+{
+    for (size_t i = 0; i < tokens.size(); i++) {
+        if (!IsWaitable(tokens[i])) {
+            FMK_LOGE("run token is invalid or already consumed.");
+            return INVALID_PARAM;
+        }
+        // token数量很少, 逐个比较即可, 避免在等待路径上申请内存
+        for (size_t j = 0; j < i; j++) {
+            if (tokens[j].slot == tokens[i].slot) {
+                FMK_LOGE("run token %zu is duplicated.", i);
+                return INVALID_PARAM;
+            }
+        }
+    }
+    return SUCCESS;
+}
+
+void CompletionRing::ReleaseLocked(Slot& slot)
+{
+    slot.busy = false;
+    slot.done = false;
+    slot.callback = nullptr;
+    slot.userData = nullptr;
+    // 同一token的其他等待者需要醒来发现token已失效, 否则槽被复用后会取走新请求的结果
+    cond_.notify_all();
+}
+
+template <typename Predicate>
+bool CompletionRing::WaitFor(std::unique_lock<std::mutex>& lock, int32_t timeoutInMS, Predicate predicate)
+{
+    if (timeoutInMS < 0) {
+        cond_.wait(lock, predicate);
+        return true;
+    }
+    return cond_.wait_for(lock, std::chrono::milliseconds(timeoutInMS), predicate);
+}
+
+Status CompletionRing::Wait(const RunToken& token, int32_t timeoutInMS, Status& result)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!IsWaitable(token)) {
+        FMK_LOGE("run token is invalid or already consumed.");
+        return INVALID_PARAM;
+    }
+    Slot& slot = slots_[token.slot];
+    if (!WaitFor(lock, timeoutInMS, [this, &token, &slot] { return !IsWaitable(token) || slot.done; })) {
+        return TIMEOUT;
+    }
+    if (!IsWaitable(token)) {
+        FMK_LOGE("run token is consumed by another waiter.");
+        return INVALID_PARAM;
+    }
+    result = slot.result;
+    ReleaseLocked(slot);
+    return SUCCESS;
+}
+
+Status CompletionRing::WaitAny(
+    const std::vector<RunToken>& tokens, int32_t timeoutInMS, size_t& index, Status& result)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    HIAI_EXPECT_TRUE_R(!tokens.empty(), INVALID_PARAM);
+    HIAI_EXPECT_EXEC(CheckWaitable(tokens));
+
+    size_t doneIndex = tokens.size();
+    bool consumed = false;
+    auto anyDone = [this, &tokens, &doneIndex, &consumed] {
+        for (size_t i = 0; i < tokens.size(); i++) {
+            if (!IsWaitable(tokens[i])) {
+                consumed = true;
+                return true;
+            }
+            if (slots_[tokens[i].slot].done) {
+                doneIndex = i;
+                return true;
+            }
+        }
+        return false;
+    };
+    if (!WaitFor(lock, timeoutInMS, anyDone)) {
+        return TIMEOUT;
+    }
+    if (consumed) {
+        FMK_LOGE("run token is consumed by another waiter.");
+        return INVALID_PARAM;
+    }
+    Slot& slot = slots_[tokens[doneIndex].slot];
+    index = doneIndex;
+    result = slot.result;
+    ReleaseLocked(slot);
+    return SUCCESS;
+}
+
+Status CompletionRing::WaitAll(
+    const std::vector<RunToken>& tokens, int32_t timeoutInMS, std::vector<Status>& results)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    HIAI_EXPECT_EXEC(CheckWaitable(tokens));
+
+    bool consumed = false;
+    auto allDone = [this, &tokens, &consumed] {
+        for (const auto& token : tokens) {
+            if (!IsWaitable(token)) {
+                consumed = true;
+                return true;
+            }
+        }
+        for (const auto& token : tokens) {
+            if (!slots_[token.slot].done) {
+                return false;
+            }
+        }
+        return true;
+    };
+    if (!WaitFor(lock, timeoutInMS, allDone)) {
+        return TIMEOUT;
+    }
+    if (consumed) {
+        FMK_LOGE("run token is consumed by another waiter.");
+        return INVALID_PARAM;
+    }
+    results.resize(tokens.size());
+    for (size_t i = 0; i < tokens.size(); i++) {
+        Slot& slot = slots_[tokens[i].slot];
+        results[i] = slot.result;
+        ReleaseLocked(slot);
+    }
+    return SUCCESS;
+}
+} // namespace hiai
@@ -0,0 +1,72 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FRAMEWORK_MODEL_MANAGER_COMPLETION_RING_H
+#define FRAMEWORK_MODEL_MANAGER_COMPLETION_RING_H
+
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+#include "model_manager/model_manager_ext.h"
+
+namespace hiai {
+// 异步推理完成槽, 槽在构造时一次分配, 之后占用/完成/取走结果均不申请内存
+class CompletionRing {
+public:
+    explicit CompletionRing(uint32_t slotNum);
+    ~CompletionRing() = default;
+    CompletionRing(const CompletionRing&) = delete;
+    CompletionRing& operator=(const CompletionRing&) = delete;
+
+    // 轮询占用一个空闲槽, 无空闲槽时返回false
+    bool Acquire(RunDoneCallback callback, void* userData, RunToken& token);
+    // 请求下发失败, 直接归还
+    void Abandon(const RunToken& token);
+    // 只对占用中且未完成的槽生效, 重复完成被忽略
+    void Complete(uint32_t slot, Status result);
+    // 运行时实例去初始化后调用, 仍在执行中的请求以result结束并唤醒等待者
+    void Close(Status result);
+
+    Status Wait(const RunToken& token, int32_t timeoutInMS, Status& result);
+    Status WaitAny(const std::vector<RunToken>& tokens, int32_t timeoutInMS, size_t& index, Status& result);
+    Status WaitAll(const std::vector<RunToken>& tokens, int32_t timeoutInMS, std::vector<Status>& results);
+
+private:
+    struct Slot {
+        uint32_t sequence {0};
+        bool busy {false};
+        bool done {false};
+        Status result {SUCCESS};
+        RunDoneCallback callback {nullptr};
+        void* userData {nullptr};
+    };
+
+    bool IsWaitable(const RunToken& token) const;
+    // 每个token都可等待且互不重复
+    Status CheckWaitable(const std::vector<RunToken>& tokens) const;
+    void ReleaseLocked(Slot& slot);
+    // timeoutInMS小于0时一直等待, 超时返回false
+    template <typename Predicate>
+    bool WaitFor(std::unique_lock<std::mutex>& lock, int32_t timeoutInMS, Predicate predicate);
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::vector<Slot> slots_;
+    size_t next_ {0};
+};
+} // namespace hiai
+#endif // FRAMEWORK_MODEL_MANAGER_COMPLETION_RING_H
@@ -0,0 +1,58 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FRAMEWORK_MODEL_MANAGER_IO_BINDING_IMPL_H
+#define FRAMEWORK_MODEL_MANAGER_IO_BINDING_IMPL_H
+
+#include "model_manager/io_binding.h"
+#include "framework/c/hiai_nd_tensor_buffer.h"
+
+namespace hiai {
+class IOBindingImpl : public IIOBinding {
+public:
+    IOBindingImpl(uint64_t generation, const std::vector<std::shared_ptr<INDTensorBuffer>>& inputs,
+        const std::vector<std::shared_ptr<INDTensorBuffer>>& outputs)
+        : generation_(generation), inputs_(inputs), outputs_(outputs)
+    {
+    }
+    ~IOBindingImpl() override = default;
+
+    const std::vector<std::shared_ptr<INDTensorBuffer>>& GetInputs() const override
+    {
+        return inputs_;
+    }
+
+    const std::vector<std::shared_ptr<INDTensorBuffer>>& GetOutputs() const override
+    {
+        return outputs_;
+    }
+
+    uint64_t GetGeneration() const
+    {
+        return generation_;
+    }
+
+public:
+    // 与inputs_/outputs_一一对应的底层句柄, 由inputs_/outputs_保证生命周期
+    std::vector<HIAI_MR_NDTensorBuffer*> cInputs;
+    std::vector<HIAI_MR_NDTensorBuffer*> cOutputs;
+
+private:
+    uint64_t generation_;
+    std::vector<std::shared_ptr<INDTensorBuffer>> inputs_;
+    std::vector<std::shared_ptr<INDTensorBuffer>> outputs_;
+};
+} // namespace hiai
+#endif // FRAMEWORK_MODEL_MANAGER_IO_BINDING_IMPL_H
@@ -0,0 +1,347 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "model_cache_impl.h"
+
+#include <chrono>
+#include <sstream>
+
+#include "infra/base/assertion.h"
+#include "framework/infra/log/log.h"
+#include "util/file_util.h"
+
+namespace hiai {
+namespace {
+void AppendDims(std::ostringstream& key, const std::vector<int32_t>& dims)
+{
+    key << '[';
+    for (int32_t dim : dims) {
+        key << dim << ',';
+    }
+    key << ']';
+}
+
+void AppendDevices(std::ostringstream& key, const std::vector<ExecuteDevice>& devices)
+{
+    key << '[';
+    for (ExecuteDevice device : devices) {
+        key << static_cast<int32_t>(device) << ',';
+    }
+    key << ']';
+}
+
+// 模型文件及影响加载结果的全部选项
+std::string BuildCacheKey(const std::string& modelFile, const ModelInitOptions& options)
+{
+    std::ostringstream key;
+    key << modelFile << '|' << static_cast<int32_t>(options.perfMode) << '|' << options.runtimeInstanceNum << '|'
+        << options.asyncSlotNum;
+
+    const ModelBuildOptions& buildOptions = options.buildOptions;
+    key << '|' << static_cast<int32_t>(buildOptions.formatMode) << '|' << buildOptions.precisionMode << '|'
+        << static_cast<int32_t>(buildOptions.tuningStrategy) << '|' << buildOptions.estimatedOutputSize << '|'
+        << buildOptions.quantizeConfig << '|' << static_cast<int32_t>(buildOptions.staticAippMode);
+    for (const auto& desc : buildOptions.inputTensorDescs) {
+        AppendDims(key, desc.dims);
+        key << static_cast<int32_t>(desc.dataType) << static_cast<int32_t>(desc.format);
+    }
+
+    const DynamicShapeConfig& shapeConfig = buildOptions.dynamicShapeConfig;
+    key << '|' << shapeConfig.enable << shapeConfig.maxCachedNum << shapeConfig.cacheMode;
+
+    const ModelDeviceConfig& deviceConfig = buildOptions.modelDeviceConfig;
+    key << '|' << static_cast<int32_t>(deviceConfig.deviceConfigMode) << static_cast<int32_t>(deviceConfig.fallBackMode)
+        << static_cast<int32_t>(deviceConfig.deviceMemoryReusePlan);
+    AppendDevices(key, deviceConfig.modelDeviceOrder);
+    for (const auto& op : deviceConfig.opDeviceOrder) {
+        key << op.first;
+        AppendDevices(key, op.second);
+    }
+    return key.str();
+}
+} // namespace
+
+ModelCache& ModelCache::GetInstance()
+{
+    static ModelCache instance;
+    return instance;
+}
+
+ModelCache::~ModelCache()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    prefetchCond_.notify_all();
+    if (prefetchThread_.joinable()) {
+        prefetchThread_.join();
+    }
+}
+
+void ModelCache::SetOptions(const ModelCacheOptions& options)
+{
+    std::vector<CachedModel> evicted;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        options_ = options;
+        EvictLocked(evicted);
+    }
+    Unload(evicted);
+}
+
+void ModelCache::WarmUp(CachedModel& model)
+{
+    std::vector<std::shared_ptr<INDTensorBuffer>> inputs;
+    for (const auto& desc : model.builtModel->GetInputTensorDescs()) {
+        inputs.push_back(CreateNDTensorBuffer(desc));
+        // 动态shape的输入无法预先构造
+        HIAI_EXPECT_NOT_NULL_VOID(inputs.back());
+    }
+    std::vector<std::shared_ptr<INDTensorBuffer>> outputs;
+    for (const auto& desc : model.builtModel->GetOutputTensorDescs()) {
+        outputs.push_back(CreateNDTensorBuffer(desc));
+        HIAI_EXPECT_NOT_NULL_VOID(outputs.back());
+    }
+    if (model.modelManager->Run(inputs, outputs) != SUCCESS) {
+        FMK_LOGW("warm up %s failed.", model.builtModel->GetName().c_str());
+    }
+}
+
+Status ModelCache::Load(const std::string& modelFile, const ModelInitOptions& options, bool warmUp,
+    CachedModel& model)
+{
+    model.builtModel = CreateBuiltModel();
+    HIAI_EXPECT_NOT_NULL(model.builtModel);
+    HIAI_EXPECT_EXEC(model.builtModel->RestoreFromFile(modelFile.c_str()));
+
+    model.modelManager = CreateModelManager();
+    HIAI_EXPECT_NOT_NULL(model.modelManager);
+    HIAI_EXPECT_EXEC(model.modelManager->Init(options, model.builtModel, nullptr));
+
+    long fileSize = FileUtil::GetFileSize(modelFile);
+    model.cost = fileSize > 0 ? static_cast<uint64_t>(fileSize) : 0;
+    if (warmUp) {
+        WarmUp(model);
+    }
+    return SUCCESS;
+}
+
+void ModelCache::Unload(std::vector<CachedModel>& models)
+{
+    for (auto& model : models) {
+        // 调用者仍持有的模型在其释放时由析构卸载
+        if (model.modelManager != nullptr && model.modelManager.use_count() == 1) {
+            model.modelManager->DeInit();
+        }
+    }
+    models.clear();
+}
+
+void ModelCache::EvictLocked(std::vector<CachedModel>& evicted)
+{
+    if (options_.memoryBudget == 0) {
+        return;
+    }
+    auto it = lru_.end();
+    while (usedMemory_ > options_.memoryBudget && it != lru_.begin()) {
+        --it;
+        auto model = models_.find(*it);
+        if (model->second.modelManager.use_count() > 1) {
+            continue;
+        }
+        usedMemory_ -= model->second.cost;
+        evictNum_++;
+        evicted.push_back(model->second);
+        models_.erase(model);
+        it = lru_.erase(it);
+    }
+}
+
+Status ModelCache::LoadEntry(const std::string& key, const std::string& modelFile, const ModelInitOptions& options,
+    std::shared_ptr<IModelManager>* modelManager)
+{
+    bool warmUp = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        warmUp = options_.warmUp;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    CachedModel loaded;
+    Status ret = Load(modelFile, options, warmUp, loaded);
+    uint64_t loadTime = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+
+    std::vector<CachedModel> evicted;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = models_.find(key);
+        if (ret != SUCCESS) {
+            FMK_LOGE("load %s failed.", modelFile.c_str());
+            models_.erase(it);
+        } else {
+            loadNum_++;
+            totalLoadTime_ += loadTime;
+            maxLoadTime_ = std::max(maxLoadTime_, loadTime);
+
+            loaded.loading = false;
+            lru_.push_front(key);
+            loaded.lruIt = lru_.begin();
+            usedMemory_ += loaded.cost;
+            it->second = std::move(loaded);
+            if (modelManager != nullptr) {
+                *modelManager = it->second.modelManager;
+            }
+            EvictLocked(evicted);
+        }
+    }
+    loadCond_.notify_all();
+    Unload(evicted);
+    return ret;
+}
+
+Status ModelCache::Get(const std::string& modelFile, const ModelInitOptions& options,
+    std::shared_ptr<IModelManager>& modelManager)
+{
+    std::string key = BuildCacheKey(modelFile, options);
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        auto it = models_.find(key);
+        // 正在(预)加载的模型等待其结束, 加载失败时由本次调用重新加载
+        while (it != models_.end() && it->second.loading) {
+            loadCond_.wait(lock);
+            it = models_.find(key);
+        }
+        if (it != models_.end()) {
+            hitNum_++;
+            lru_.splice(lru_.begin(), lru_, it->second.lruIt);
+            modelManager = it->second.modelManager;
+            return SUCCESS;
+        }
+        missNum_++;
+        models_.emplace(key, CachedModel());
+    }
+    return LoadEntry(key, modelFile, options, &modelManager);
+}
+
+Status ModelCache::Prefetch(const std::string& modelFile, const ModelInitOptions& options)
+{
+    std::string key = BuildCacheKey(modelFile, options);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        HIAI_EXPECT_TRUE_R(!stopping_, FAILURE);
+        if (models_.find(key) != models_.end()) {
+            return SUCCESS;
+        }
+        models_.emplace(key, CachedModel());
+        prefetchTasks_.push_back(PrefetchTask {key, modelFile, options});
+        prefetchNum_++;
+        if (!prefetchThread_.joinable()) {
+            prefetchThread_ = std::thread(&ModelCache::PrefetchLoop, this);
+        }
+    }
+    prefetchCond_.notify_one();
+    return SUCCESS;
+}
+
+void ModelCache::PrefetchLoop()
+{
+    while (true) {
+        PrefetchTask task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            prefetchCond_.wait(lock, [this] { return stopping_ || !prefetchTasks_.empty(); });
+            if (stopping_) {
+                // 放弃尚未开始的预加载, 移除其占位
+                for (const auto& pending : prefetchTasks_) {
+                    models_.erase(pending.key);
+                }
+                prefetchTasks_.clear();
+                loadCond_.notify_all();
+                return;
+            }
+            task = prefetchTasks_.front();
+            prefetchTasks_.pop_front();
+        }
+        (void)LoadEntry(task.key, task.modelFile, task.options, nullptr);
+    }
+}
+
+Status ModelCache::GetStats(ModelCacheStats& stats)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats.hitNum = hitNum_;
+    stats.missNum = missNum_;
+    stats.evictNum = evictNum_;
+    stats.prefetchNum = prefetchNum_;
+    stats.avgLoadTime = loadNum_ == 0 ? 0 : totalLoadTime_ / loadNum_;
+    stats.maxLoadTime = maxLoadTime_;
+    stats.usedMemory = usedMemory_;
+    stats.cachedModelNum = static_cast<uint32_t>(lru_.size());
+    return SUCCESS;
+}
+
+void ModelCache::Clear()
+{
+    std::vector<CachedModel> removed;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // 加载中的占位由加载方完成后填充, 不在此移除
+        for (const auto& key : lru_) {
+            auto it = models_.find(key);
+            removed.push_back(it->second);
+            models_.erase(it);
+        }
+        lru_.clear();
+        usedMemory_ = 0;
+        hitNum_ = 0;
+        missNum_ = 0;
+        evictNum_ = 0;
+        prefetchNum_ = 0;
+        loadNum_ = 0;
+        totalLoadTime_ = 0;
+        maxLoadTime_ = 0;
+    }
+    Unload(removed);
+}
+
+void SetModelCacheOptions(const ModelCacheOptions& options)
+{
+    ModelCache::GetInstance().SetOptions(options);
+}
+
+Status GetCachedModelManager(const std::string& modelFile, const ModelInitOptions& options,
+    std::shared_ptr<IModelManager>& modelManager)
+{
+    return ModelCache::GetInstance().Get(modelFile, options, modelManager);
+}
+
+Status PrefetchModel(const std::string& modelFile, const ModelInitOptions& options)
+{
+    return ModelCache::GetInstance().Prefetch(modelFile, options);
+}
+
+Status GetModelCacheStats(ModelCacheStats& stats)
+{
+    return ModelCache::GetInstance().GetStats(stats);
+}
+
+void ClearModelCache()
+{
+    ModelCache::GetInstance().Clear();
+}
+} // namespace hiai
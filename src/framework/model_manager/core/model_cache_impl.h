@@ -0,0 +1,98 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FRAMEWORK_MODEL_MANAGER_MODEL_CACHE_IMPL_H
+#define FRAMEWORK_MODEL_MANAGER_MODEL_CACHE_IMPL_H
+
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#include "model_manager/model_cache.h"
+
+namespace hiai {
+struct CachedModel {
+    // 加载中的模型只占位, 不计入内存占用也不参与淘汰
+    bool loading {true};
+    std::shared_ptr<IBuiltModel> builtModel {nullptr};
+    std::shared_ptr<IModelManager> modelManager {nullptr};
+    uint64_t cost {0};
+    std::list<std::string>::iterator lruIt;
+};
+
+class ModelCache {
+public:
+    static ModelCache& GetInstance();
+    ~ModelCache();
+
+    void SetOptions(const ModelCacheOptions& options);
+
+    Status Get(const std::string& modelFile, const ModelInitOptions& options,
+        std::shared_ptr<IModelManager>& modelManager);
+    Status Prefetch(const std::string& modelFile, const ModelInitOptions& options);
+
+    Status GetStats(ModelCacheStats& stats);
+    void Clear();
+
+private:
+    ModelCache() = default;
+
+    struct PrefetchTask {
+        std::string key;
+        std::string modelFile;
+        ModelInitOptions options;
+    };
+
+    static Status Load(const std::string& modelFile, const ModelInitOptions& options, bool warmUp,
+        CachedModel& model);
+    static void WarmUp(CachedModel& model);
+    static void Unload(std::vector<CachedModel>& models);
+
+    // 加载key对应的占位; modelManager非空时在淘汰之前取出, 保证调用者拿到的模型不会被立即淘汰
+    Status LoadEntry(const std::string& key, const std::string& modelFile, const ModelInitOptions& options,
+        std::shared_ptr<IModelManager>* modelManager);
+    // 从最近最少使用端淘汰未被调用者持有的模型, 直到不超出预算
+    void EvictLocked(std::vector<CachedModel>& evicted);
+
+    void PrefetchLoop();
+
+private:
+    std::mutex mutex_;
+    // 某个模型加载结束(成功或失败)
+    std::condition_variable loadCond_;
+    ModelCacheOptions options_;
+    std::map<std::string, CachedModel> models_;
+    // 队首为最近使用
+    std::list<std::string> lru_;
+    uint64_t usedMemory_ {0};
+
+    uint64_t hitNum_ {0};
+    uint64_t missNum_ {0};
+    uint64_t evictNum_ {0};
+    uint64_t prefetchNum_ {0};
+    uint64_t loadNum_ {0};
+    uint64_t totalLoadTime_ {0};
+    uint64_t maxLoadTime_ {0};
+
+    std::condition_variable prefetchCond_;
+    std::deque<PrefetchTask> prefetchTasks_;
+    std::thread prefetchThread_;
+    bool stopping_ {false};
+};
+} // namespace hiai
+#endif // FRAMEWORK_MODEL_MANAGER_MODEL_CACHE_IMPL_H
@@ -28,6 +28,10 @@
 #include "model_builder/om/model_build_options_util.h"
 #include "tensor/base/nd_tensor_buffer_impl.h"
 #include "model_manager/core/open_request_stats.h"
+#include "model_manager/core/request_scheduler_impl.h"
+#include "model_manager/core/io_binding_impl.h"
+#include "model_manager/core/completion_ring.h"
+#include "model_manager/core/shape_dispatcher.h"
 
 #ifdef AI_SUPPORT_AIPP_API
 #include "model/built_model_aipp.h"
@@ -38,16 +42,80 @@
 
 namespace hiai {
 
+namespace {
+const uint32_t MAX_RUNTIME_INSTANCE_NUM = 16;
+const uint32_t MAX_ASYNC_SLOT_NUM = 1024;
+// 运行时按10个handle分配onAllocate的handles数组
+const size_t MAX_NATIVE_HANDLE_NUM = 10;
+std::atomic<uint64_t> g_modelGeneration {0};
+}
+
+// 从空闲池中独占一个运行时实例, 析构时归还; 调用者需持有modelManagerMutex_读锁且实例池非空
+class RuntimeInstanceLease {
+public:
+    explicit RuntimeInstanceLease(ModelManagerImpl& impl) : impl_(impl), index_(impl.AcquireRuntimeInstance())
+    {
+    }
+    ~RuntimeInstanceLease()
+    {
+        impl_.ReleaseRuntimeInstance(index_);
+    }
+    RuntimeInstanceLease(const RuntimeInstanceLease&) = delete;
+    RuntimeInstanceLease& operator=(const RuntimeInstanceLease&) = delete;
+
+    HIAI_MR_ModelManager* Get() const
+    {
+        return impl_.modelManagers_[index_].get();
+    }
+
+private:
+    ModelManagerImpl& impl_;
+    size_t index_;
+};
+
 ModelManagerImpl::~ModelManagerImpl()
 {
-    if (modelManager_ != nullptr) {
+    if (!modelManagers_.empty()) {
         UnLoad();
     }
 }
 
+Status ModelManagerImpl::PrepareCompletionRing(const ModelInitOptions& options)
+{
+    {
+        std::lock_guard<std::mutex> lock(completionRingMutex_);
+        completionRing_.reset();
+    }
+    slotContexts_.clear();
+    if (options.asyncSlotNum == 0) {
+        return SUCCESS;
+    }
+    if (options.asyncSlotNum > MAX_ASYNC_SLOT_NUM) {
+        FMK_LOGE("asyncSlotNum %u is invalid.", options.asyncSlotNum);
+        return INVALID_PARAM;
+    }
+    // AIPP模型的同步Run依赖未设置listener时runtime同步执行, 不能为其注册内部listener
+    if (aippInputConverter_ != nullptr) {
+        FMK_LOGW("async slots are not supported by aipp model, ignore asyncSlotNum %u.", options.asyncSlotNum);
+        return SUCCESS;
+    }
+
+    std::shared_ptr<CompletionRing> completionRing = make_shared_nothrow<CompletionRing>(options.asyncSlotNum);
+    HIAI_EXPECT_NOT_NULL(completionRing);
+    slotContexts_.resize(options.asyncSlotNum);
+    for (size_t i = 0; i < slotContexts_.size(); i++) {
+        slotContexts_[i].modelManager = this;
+        slotContexts_[i].slot = static_cast<int64_t>(i);
+    }
+    std::lock_guard<std::mutex> lock(completionRingMutex_);
+    completionRing_ = completionRing;
+    return SUCCESS;
+}
+
 Status ModelManagerImpl::PrepareModelManagerListener(const std::shared_ptr<IModelManagerListener>& listener)
 {
-    if (listener != nullptr) {
+    // 完成槽的回调同样经由runtime的listener通知
+    if (listener != nullptr || completionRing_ != nullptr) {
         std::lock_guard<std::mutex> lock(listenerMutex_);
 
         cListener_ = make_shared_nothrow<HIAI_MR_ModelManagerListener>();
@@ -112,9 +180,20 @@ static std::unique_ptr<HIAI_MR_ModelInitOptions, decltype(DeleteModelInitOptions
         tmpOptions, DeleteModelInitOptions);
 }
 
-Status ModelManagerImpl::PrepareModelManager(
+Status ModelManagerImpl::CreateRuntimeInstances(
     const ModelInitOptions& options, const std::shared_ptr<IBuiltModel>& builtModel)
 {
+    uint32_t instanceNum = options.runtimeInstanceNum;
+    if (instanceNum == 0 || instanceNum > MAX_RUNTIME_INSTANCE_NUM) {
+        FMK_LOGE("runtimeInstanceNum %u is invalid.", instanceNum);
+        return INVALID_PARAM;
+    }
+    // 共享内存分配器的native handle按单实例记录, 不支持多实例
+    if (cAllocator_ != nullptr && instanceNum > 1) {
+        FMK_LOGW("shared mem allocator supports one runtime instance only, ignore runtimeInstanceNum %u.", instanceNum);
+        instanceNum = 1;
+    }
+
     std::shared_ptr<BuiltModelImpl> builtModelImpl =
         std::dynamic_pointer_cast<BuiltModelImpl>(std::const_pointer_cast<IBuiltModel>(builtModel));
     HIAI_EXPECT_NOT_NULL(builtModelImpl);
@@ -122,31 +201,101 @@ Status ModelManagerImpl::PrepareModelManager(
     auto cBuiltModel = builtModelImpl->GetBuiltModelImpl();
     HIAI_EXPECT_NOT_NULL(cBuiltModel);
 
-    auto cModelManager = HIAI_MR_ModelManager_Create();
-    if (cModelManager == nullptr) {
-        return FAILURE;
+    auto cOptions = ConvertToCInitOptions(options);
+    HIAI_EXPECT_NOT_NULL(cOptions);
+
+    for (uint32_t i = 0; i < instanceNum; i++) {
+        auto cModelManager = HIAI_MR_ModelManager_Create();
+        if (cModelManager == nullptr) {
+            return FAILURE;
+        }
+        std::shared_ptr<HIAI_MR_ModelManager> modelManager(
+            cModelManager, [](HIAI_MR_ModelManager* p) { HIAI_MR_ModelManager_Destroy(&p); });
+        modelManagers_.push_back(modelManager);
+
+        Status ret = SUCCESS;
+        if (cAllocator_ != nullptr) {
+            ret = HIAI_ModelManager_InitWithSharedMem(modelManager.get(), cOptions.get(), cBuiltModel.get(),
+                cListener_.get(), cAllocator_.get());
+        } else {
+            ret = HIAI_MR_ModelManager_Init(modelManager.get(), cOptions.get(), cBuiltModel.get(), cListener_.get());
+        }
+        if (ret != SUCCESS) {
+            FMK_LOGE("init runtime instance %u failed.", i);
+            return ret;
+        }
     }
 
-    modelManager_ = std::shared_ptr<HIAI_MR_ModelManager>(
-        cModelManager, [](HIAI_MR_ModelManager* p) { HIAI_MR_ModelManager_Destroy(&p); });
+    std::lock_guard<std::mutex> lock(idleMutex_);
+    idleInstances_.clear();
+    for (size_t i = modelManagers_.size(); i > 0; i--) {
+        idleInstances_.push_back(i - 1);
+    }
+    return SUCCESS;
+}
 
-    auto cOptions = ConvertToCInitOptions(options);
-    HIAI_EXPECT_NOT_NULL(cOptions);
+Status ModelManagerImpl::PrepareModelManager(
+    const ModelInitOptions& options, const std::shared_ptr<IBuiltModel>& builtModel)
+{
+    priority_ = PRIORITY_MIDDLE;
+    generation_ = ++g_modelGeneration;
+    inputTensorDescs_ = builtModel->GetInputTensorDescs();
+    outputTensorDescs_ = builtModel->GetOutputTensorDescs();
+    Status ret = CreateRuntimeInstances(options, builtModel);
+    if (ret != SUCCESS) {
+        DestroyRuntimeInstances();
+    }
+    return ret;
+}
+
+size_t ModelManagerImpl::AcquireRuntimeInstance()
+{
+    std::unique_lock<std::mutex> lock(idleMutex_);
+    idleCond_.wait(lock, [this] { return !idleInstances_.empty(); });
+    size_t index = idleInstances_.back();
+    idleInstances_.pop_back();
+    return index;
+}
+
+void ModelManagerImpl::ReleaseRuntimeInstance(size_t index)
+{
+    {
+        std::lock_guard<std::mutex> lock(idleMutex_);
+        idleInstances_.push_back(index);
+    }
+    idleCond_.notify_one();
+}
+
+Status ModelManagerImpl::PrepareAippInputConverter(const std::shared_ptr<IBuiltModel>& builtModel)
+{
+    aippInputConverter_.reset();
+    HIAI_EXPECT_NOT_NULL(builtModel);
+    const CustomModelData& customModelData = builtModel->GetCustomData();
+    if (customModelData.type.empty()) {
+        return SUCCESS;
+    }
 
-    return HIAI_MR_ModelManager_Init(modelManager_.get(), cOptions.get(), cBuiltModel.get(), cListener_.get());
+    aippInputConverter_.reset(new (std::nothrow) AippInputConverter());
+    HIAI_EXPECT_NOT_NULL(aippInputConverter_);
+    return aippInputConverter_->Init(customModelData, builtModel->GetInputTensorDescs().size());
 }
 
 Status ModelManagerImpl::Init(const ModelInitOptions& options, const std::shared_ptr<IBuiltModel>& builtModel,
     const std::shared_ptr<IModelManagerListener>& listener)
 {
     H_LOG_INTERFACE_FILTER(ITF_COUNT);
-    std::lock_guard<std::mutex> lock(modelManagerMutex_);
-    HIAI_EXPECT_TRUE(modelManager_ == nullptr);
+    WriteLockGuard lock(modelManagerMutex_);
+    HIAI_EXPECT_TRUE(modelManagers_.empty());
 
-    HIAI_EXPECT_EXEC(PrepareModelManagerListener(listener));
+    HIAI_EXPECT_EXEC(PrepareAippInputConverter(builtModel));
 
-    customModelData_ = builtModel->GetCustomData();
+    HIAI_EXPECT_EXEC(PrepareCompletionRing(options));
 
+    HIAI_EXPECT_EXEC(PrepareModelManagerListener(listener));
+
+    // 清理之前初始化失败残留的共享内存分配器
+    allocator_.reset();
+    cAllocator_.reset();
     Status result = PrepareModelManager(options, builtModel);
 
 #ifdef HIAI_DDK
@@ -162,36 +311,19 @@ Status ModelManagerImpl::Init(const ModelInitOptions& options, const std::shared
     H_LOG_INTERFACE_FILTER(ITF_COUNT);
     HIAI_EXPECT_NOT_NULL(allocator);
 
-    std::lock_guard<std::mutex> lock(modelManagerMutex_);
-    HIAI_EXPECT_TRUE(modelManager_ == nullptr);
+    WriteLockGuard lock(modelManagerMutex_);
+    HIAI_EXPECT_TRUE(modelManagers_.empty());
+
+    HIAI_EXPECT_EXEC(PrepareAippInputConverter(builtModel));
+
+    HIAI_EXPECT_EXEC(PrepareCompletionRing(options));
 
     HIAI_EXPECT_EXEC(PrepareModelManagerListener(listener));
 
     HIAI_EXPECT_EXEC(PrepareSharedMemAllocator(allocator));
     HIAI_EXPECT_NOT_NULL(cAllocator_);
 
-    customModelData_ = builtModel->GetCustomData();
-
-    std::shared_ptr<BuiltModelImpl> builtModelImpl =
-        std::dynamic_pointer_cast<BuiltModelImpl>(std::const_pointer_cast<IBuiltModel>(builtModel));
-    HIAI_EXPECT_NOT_NULL(builtModelImpl);
-
-    auto cBuiltModel = builtModelImpl->GetBuiltModelImpl();
-    HIAI_EXPECT_NOT_NULL(cBuiltModel);
-
-    auto cModelManager = HIAI_MR_ModelManager_Create();
-    if (cModelManager == nullptr) {
-        return FAILURE;
-    }
-
-    modelManager_ = std::shared_ptr<HIAI_MR_ModelManager>(
-        cModelManager, [](HIAI_MR_ModelManager* p) { HIAI_MR_ModelManager_Destroy(&p); });
-
-    auto cOptions = ConvertToCInitOptions(options);
-    HIAI_EXPECT_NOT_NULL(cOptions);
-
-    return HIAI_ModelManager_InitWithSharedMem(modelManager_.get(), cOptions.get(), cBuiltModel.get(), cListener_.get(),
-        cAllocator_.get());
+    return PrepareModelManager(options, builtModel);
 }
 
 void ModelManagerImpl::OnRunDone(
@@ -221,6 +353,19 @@ void ModelManagerImpl::OnRunDone(
     (void)output;
     (void)outputNum;
     RunAsyncContext* runAsyncContext = (RunAsyncContext*)userData;
+    if (runAsyncContext->slot >= 0) {
+        // DeInit可能同时重置completionRing_, 取本地引用后再完成
+        ModelManagerImpl* modelManager = runAsyncContext->modelManager;
+        std::shared_ptr<CompletionRing> completionRing = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(modelManager->completionRingMutex_);
+            completionRing = modelManager->completionRing_;
+        }
+        if (completionRing != nullptr) {
+            completionRing->Complete(static_cast<uint32_t>(runAsyncContext->slot), static_cast<Status>(errCode));
+        }
+        return;
+    }
     runAsyncContext->modelManager->OnRunDone(
         runAsyncContext->context, static_cast<Status>(errCode), runAsyncContext->outputs);
     delete runAsyncContext;
@@ -239,29 +384,37 @@ void ModelManagerImpl::OnAllocate(void* userData, uint32_t requiredSize,
     HIAI_EXPECT_NOT_NULL_VOID(userData);
     HIAI_EXPECT_NOT_NULL_VOID(handles);
     HIAI_EXPECT_NOT_NULL_VOID(handlesSize);
+    // handlesSize仅为出参, 不能从中推断handles数组容量
     *handlesSize = 0;
 
     MemAllocaterContext* context = (MemAllocaterContext*)userData;
-    std::shared_ptr<ISharedMemAllocator> memAllocator = context->modelManager->allocator_;
+    ModelManagerImpl* modelManager = context->modelManager;
+    std::shared_ptr<ISharedMemAllocator> memAllocator = modelManager->allocator_;
     HIAI_EXPECT_NOT_NULL_VOID(memAllocator);
 
     std::vector<hiai::NativeHandle> native = memAllocator->Allocate(requiredSize);
-    if (native.size() > 10) { // 10: native handle max
-        FMK_LOGE("Allocate client mem failed, size = %u", native.size());
+    if (native.empty()) {
+        FMK_LOGE("Allocate client mem of %u bytes failed.", requiredSize);
+        return;
+    }
+    if (native.size() > MAX_NATIVE_HANDLE_NUM) {
+        FMK_LOGE("Allocate client mem failed, handle num = %zu, max = %zu", native.size(), MAX_NATIVE_HANDLE_NUM);
         memAllocator->Free(native);
         return;
     }
 
-    for (uint32_t i = 0; i < native.size(); i++) {
+    std::lock_guard<std::mutex> lock(modelManager->nativeHandleMutex_);
+    for (size_t i = 0; i < native.size(); i++) {
         handles[i] = HIAI_NativeHandle_Create(native[i].fd, native[i].size, native[i].offset);
         if (handles[i] == nullptr) {
-            for (uint32_t j = 0; j < i; j++) {
+            for (size_t j = 0; j < i; j++) {
+                modelManager->nativeHandles_.erase(handles[j]);
                 HIAI_NativeHandle_Destroy(&handles[j]);
             }
-            context->modelManager->nativeHandle_.clear();
+            memAllocator->Free(native);
             return;
         }
-        context->modelManager->nativeHandle_.push_back(std::make_pair(handles[i], native[i]));
+        modelManager->nativeHandles_[handles[i]] = native[i];
     }
 
     *handlesSize = native.size();
@@ -274,25 +427,41 @@ void ModelManagerImpl::OnFree(void* userData, HIAI_NativeHandle* handles[], size
     HIAI_EXPECT_TRUE_VOID(handlesSize != 0);
 
     MemAllocaterContext* context = (MemAllocaterContext*)userData;
-    auto& nativeHandles = context->modelManager->nativeHandle_;
-    HIAI_EXPECT_TRUE_VOID(handlesSize == nativeHandles.size());
+    ModelManagerImpl* modelManager = context->modelManager;
+    std::shared_ptr<ISharedMemAllocator> memAllocator = modelManager->allocator_;
+    HIAI_EXPECT_NOT_NULL_VOID(memAllocator);
 
-    std::vector<NativeHandle> native;
+    std::lock_guard<std::mutex> lock(modelManager->nativeHandleMutex_);
+    auto& nativeHandles = modelManager->nativeHandles_;
+    auto& native = modelManager->freeHandles_;
+    native.clear();
     for (size_t i = 0; i < handlesSize; i++) {
-        HIAI_NativeHandle_Destroy(&nativeHandles[i].first);
-        native.push_back(nativeHandles[i].second);
+        auto it = nativeHandles.find(handles[i]);
+        if (it == nativeHandles.end()) {
+            FMK_LOGE("native handle %zu is not allocated by this model manager.", i);
+            continue;
+        }
+        native.push_back(it->second);
+        nativeHandles.erase(it);
+        HIAI_NativeHandle_Destroy(&handles[i]);
+    }
+    if (!native.empty()) {
+        memAllocator->Free(native);
     }
-
-    std::shared_ptr<ISharedMemAllocator> memAllocator = context->modelManager->allocator_;
-    HIAI_EXPECT_NOT_NULL_VOID(memAllocator);
-    memAllocator->Free(native);
 }
 
 Status ModelManagerImpl::SetPriority(ModelPriority priority)
 {
     H_LOG_INTERFACE_FILTER(ITF_COUNT);
-    std::lock_guard<std::mutex> lock(modelManagerMutex_);
-    return HIAI_MR_ModelManager_SetPriority(modelManager_.get(), static_cast<HIAI_ModelPriority>(priority));
+    WriteLockGuard lock(modelManagerMutex_);
+    HIAI_EXPECT_TRUE_R(!modelManagers_.empty(), INVALID_PARAM);
+
+    for (const auto& modelManager : modelManagers_) {
+        HIAI_EXPECT_EXEC(
+            HIAI_MR_ModelManager_SetPriority(modelManager.get(), static_cast<HIAI_ModelPriority>(priority)));
+    }
+    priority_ = priority;
+    return SUCCESS;
 }
 
 static std::unique_ptr<HIAI_MR_NDTensorBuffer* []> Convert2CNDTensorBuffers(
@@ -312,25 +481,41 @@ Status ModelManagerImpl::Run(
     const std::vector<std::shared_ptr<INDTensorBuffer>>& inputs, std::vector<std::shared_ptr<INDTensorBuffer>>& outputs)
 {
     H_LOG_INTERFACE_FILTER(ITF_COUNT);
-    if (!customModelData_.type.empty()) {
-        std::vector<std::shared_ptr<INDTensorBuffer>> dataInputs;
-        std::vector<std::shared_ptr<IAIPPPara>> paraInputs;
-
-        if (AippInputConverter::ConvertInputs(inputs, customModelData_, dataInputs, paraInputs) != hiai::SUCCESS) {
+    // 排队期间不持有modelManagerMutex_, 以免阻塞SetPriority/DeInit等写锁调用, 以及写者等待时的Cancel
+    ScheduledRequest request(this, static_cast<ModelPriority>(priority_.load()));
+    HIAI_EXPECT_EXEC(request.Admit());
+    ReadLockGuard lock(modelManagerMutex_);
+    HIAI_EXPECT_TRUE_R(!modelManagers_.empty(), INVALID_PARAM);
+
+    if (aippInputConverter_ != nullptr) {
+        AippRunInputs runInputs;
+        if (aippInputConverter_->ConvertInputs(inputs, runInputs) != hiai::SUCCESS) {
             return INVALID_PARAM;
         }
         Context context;
-        return RunAippModel(context, dataInputs, paraInputs, outputs, 1000);
+        return RunAippModel(context, runInputs.DataInputs(), runInputs.DataInputNum(), runInputs.ParaInputs(),
+            runInputs.ParaInputNum(), outputs, 1000);
+    }
+
+    if (shapeDispatcher_ == nullptr) {
+        return RunModel(inputs, outputs);
     }
+    std::vector<std::shared_ptr<INDTensorBuffer>> gearInputs;
+    HIAI_EXPECT_EXEC(shapeDispatcher_->Dispatch(inputs, gearInputs, outputs));
+    return RunModel(gearInputs.empty() ? inputs : gearInputs, outputs);
+}
 
+Status ModelManagerImpl::RunModel(
+    const std::vector<std::shared_ptr<INDTensorBuffer>>& inputs, std::vector<std::shared_ptr<INDTensorBuffer>>& outputs)
+{
     std::unique_ptr<HIAI_MR_NDTensorBuffer* []> cInputs = Convert2CNDTensorBuffers(inputs);
     HIAI_EXPECT_NOT_NULL_R(cInputs, INVALID_PARAM);
 
     std::unique_ptr<HIAI_MR_NDTensorBuffer* []> cOutputs = Convert2CNDTensorBuffers(outputs);
     HIAI_EXPECT_NOT_NULL_R(cOutputs, INVALID_PARAM);
 
-    std::lock_guard<std::mutex> lock(modelManagerMutex_);
-    return HIAI_MR_ModelManager_Run(modelManager_.get(), cInputs.get(), inputs.size(), cOutputs.get(), outputs.size());
+    RuntimeInstanceLease instance(*this);
+    return HIAI_MR_ModelManager_Run(instance.Get(), cInputs.get(), inputs.size(), cOutputs.get(), outputs.size());
 }
 
 Status ModelManagerImpl::RunAsync(const Context& context, const std::vector<std::shared_ptr<INDTensorBuffer>>& inputs,
@@ -343,7 +528,10 @@ Status ModelManagerImpl::RunAsync(const Context& context, const std::vector<std:
     std::unique_ptr<HIAI_MR_NDTensorBuffer* []> cOutputs = Convert2CNDTensorBuffers(outputs);
     HIAI_EXPECT_NOT_NULL_R(cOutputs, INVALID_PARAM);
 
-    std::lock_guard<std::mutex> lock(modelManagerMutex_);
+    ScheduledRequest request(this, static_cast<ModelPriority>(priority_.load()));
+    HIAI_EXPECT_EXEC(request.Admit());
+    ReadLockGuard lock(modelManagerMutex_);
+    HIAI_EXPECT_TRUE_R(!modelManagers_.empty(), INVALID_PARAM);
 
     HIAI_EXPECT_NOT_NULL_R(listener_, UNSUPPORTED);
 
@@ -354,8 +542,9 @@ Status ModelManagerImpl::RunAsync(const Context& context, const std::vector<std:
     runContext->modelManager = this;
     runContext->outputs = outputs;
 
+    RuntimeInstanceLease instance(*this);
     Status ret = HIAI_MR_ModelManager_RunAsync(
-        modelManager_.get(), cInputs.get(), inputs.size(), cOutputs.get(), outputs.size(), timeout, runContext);
+        instance.Get(), cInputs.get(), inputs.size(), cOutputs.get(), outputs.size(), timeout, runContext);
     if (ret != SUCCESS) {
         delete runContext;
     }
@@ -390,13 +579,23 @@ Status ModelManagerImpl::RunAippModel(const Context& context,
     std::unique_ptr<HIAI_MR_NDTensorBuffer* []> cInputs = Convert2CNDTensorBuffers(inputs);
     HIAI_EXPECT_NOT_NULL_R(cInputs, INVALID_PARAM);
 
-    std::unique_ptr<HIAI_MR_NDTensorBuffer* []> cOutputs = Convert2CNDTensorBuffers(outputs);
-    HIAI_EXPECT_NOT_NULL_R(cOutputs, INVALID_PARAM);
-
     std::unique_ptr<HIAI_MR_TensorAippPara* []> cAippParas = Convert2CTensorAippParas(aippParas);
     HIAI_EXPECT_NOT_NULL_R(cAippParas, INVALID_PARAM);
 
-    std::lock_guard<std::mutex> lock(modelManagerMutex_);
+    ScheduledRequest request(this, static_cast<ModelPriority>(priority_.load()));
+    HIAI_EXPECT_EXEC(request.Admit());
+    ReadLockGuard lock(modelManagerMutex_);
+    HIAI_EXPECT_TRUE_R(!modelManagers_.empty(), INVALID_PARAM);
+    return RunAippModel(
+        context, cInputs.get(), inputs.size(), cAippParas.get(), aippParas.size(), outputs, timeoutInMS);
+}
+
+Status ModelManagerImpl::RunAippModel(const Context& context, HIAI_MR_NDTensorBuffer* cInputs[], size_t inputNum,
+    HIAI_MR_TensorAippPara* cAippParas[], size_t aippParaNum, std::vector<std::shared_ptr<INDTensorBuffer>>& outputs,
+    int32_t timeoutInMS)
+{
+    std::unique_ptr<HIAI_MR_NDTensorBuffer* []> cOutputs = Convert2CNDTensorBuffers(outputs);
+    HIAI_EXPECT_NOT_NULL_R(cOutputs, INVALID_PARAM);
 
     RunAsyncContext* runContext = new (std::nothrow) RunAsyncContext();
     HIAI_EXPECT_NOT_NULL_R(runContext, MEMORY_EXCEPTION);
@@ -405,9 +604,11 @@ Status ModelManagerImpl::RunAippModel(const Context& context,
     runContext->modelManager = this;
     runContext->outputs = outputs;
 
-    Status ret = HIAI_MR_ModelManager_runAippModelV2(modelManager_.get(), cInputs.get(), inputs.size(),
-        cAippParas.get(), aippParas.size(), cOutputs.get(), outputs.size(), timeoutInMS, runContext);
-    if (listener_ == nullptr || ret != HIAI_SUCCESS) {
+    RuntimeInstanceLease instance(*this);
+    Status ret = HIAI_MR_ModelManager_runAippModelV2(instance.Get(), cInputs, inputNum, cAippParas, aippParaNum,
+        cOutputs.get(), outputs.size(), timeoutInMS, runContext);
+    // 未注册runtime listener时同步执行, 不会回调
+    if (cListener_ == nullptr || ret != HIAI_SUCCESS) {
         delete runContext;
     }
     return ret;
@@ -417,16 +618,199 @@ Status ModelManagerImpl::RunAippModel(const Context& context,
 Status ModelManagerImpl::Cancel()
 {
     H_LOG_INTERFACE_FILTER(ITF_COUNT);
-    std::lock_guard<std::mutex> lock(modelManagerMutex_);
+    // 排队中的请求不持有modelManagerMutex_, 先于读锁取消, 写锁调用等待期间也能及时返回
+    RequestScheduler::GetInstance().CancelQueued(this);
+
+    // 不占用实例, 以便取消正在各实例上执行的请求
+    ReadLockGuard lock(modelManagerMutex_);
+    HIAI_EXPECT_TRUE_R(!modelManagers_.empty(), INVALID_PARAM);
+    Status result = SUCCESS;
+    for (const auto& modelManager : modelManagers_) {
+        Status ret = HIAI_MR_ModelManager_Cancel(modelManager.get());
+        if (ret != SUCCESS) {
+            result = ret;
+        }
+    }
+    return result;
+}
+
+Status ModelManagerImpl::BindTensors(const std::vector<std::shared_ptr<INDTensorBuffer>>& buffers,
+    const std::vector<NDTensorDesc>& descs, std::vector<HIAI_MR_NDTensorBuffer*>& cBuffers)
+{
+    if (buffers.size() != descs.size()) {
+        FMK_LOGE("tensor num %zu is not equal to model tensor num %zu.", buffers.size(), descs.size());
+        return INVALID_PARAM;
+    }
 
-    return HIAI_MR_ModelManager_Cancel(modelManager_.get());
+    cBuffers.resize(buffers.size());
+    for (size_t i = 0; i < buffers.size(); i++) {
+        HIAI_EXPECT_NOT_NULL_R(buffers[i], INVALID_PARAM);
+        const std::vector<int32_t>& dims = buffers[i]->GetTensorDesc().dims;
+        const std::vector<int32_t>& modelDims = descs[i].dims;
+        bool matched = dims.size() == modelDims.size();
+        for (size_t j = 0; matched && j < dims.size(); j++) {
+            // 模型动态维度(<0)不校验
+            matched = modelDims[j] < 0 || dims[j] == modelDims[j];
+        }
+        if (!matched) {
+            FMK_LOGE("shape of tensor %zu does not match model.", i);
+            return INVALID_PARAM;
+        }
+
+        cBuffers[i] = GetRawBufferFromNDTensorBuffer(buffers[i]);
+        HIAI_EXPECT_NOT_NULL_R(cBuffers[i], INVALID_PARAM);
+    }
+    return SUCCESS;
+}
+
+std::shared_ptr<IIOBinding> ModelManagerImpl::CreateIOBinding(
+    const std::vector<std::shared_ptr<INDTensorBuffer>>& inputs,
+    const std::vector<std::shared_ptr<INDTensorBuffer>>& outputs)
+{
+    ReadLockGuard lock(modelManagerMutex_);
+    HIAI_EXPECT_TRUE_R(!modelManagers_.empty(), nullptr);
+    if (aippInputConverter_ != nullptr) {
+        FMK_LOGE("io binding is not supported by aipp model.");
+        return nullptr;
+    }
+
+    std::shared_ptr<IOBindingImpl> binding = make_shared_nothrow<IOBindingImpl>(generation_, inputs, outputs);
+    HIAI_EXPECT_NOT_NULL_R(binding, nullptr);
+    HIAI_EXPECT_EXEC_R(BindTensors(inputs, inputTensorDescs_, binding->cInputs), nullptr);
+    HIAI_EXPECT_EXEC_R(BindTensors(outputs, outputTensorDescs_, binding->cOutputs), nullptr);
+    return binding;
+}
+
+IOBindingImpl* ModelManagerImpl::GetBindingImpl(const std::shared_ptr<IIOBinding>& binding) const
+{
+    IOBindingImpl* bindingImpl = dynamic_cast<IOBindingImpl*>(binding.get());
+    HIAI_EXPECT_NOT_NULL_R(bindingImpl, nullptr);
+    if (bindingImpl->GetGeneration() != generation_) {
+        FMK_LOGE("io binding does not belong to the model currently loaded.");
+        return nullptr;
+    }
+    return bindingImpl;
+}
+
+Status ModelManagerImpl::Run(const std::shared_ptr<IIOBinding>& binding)
+{
+    H_LOG_INTERFACE_FILTER(ITF_COUNT);
+    ScheduledRequest request(this, static_cast<ModelPriority>(priority_.load()));
+    HIAI_EXPECT_EXEC(request.Admit());
+    ReadLockGuard lock(modelManagerMutex_);
+    HIAI_EXPECT_TRUE_R(!modelManagers_.empty(), INVALID_PARAM);
+
+    IOBindingImpl* bindingImpl = GetBindingImpl(binding);
+    HIAI_EXPECT_NOT_NULL_R(bindingImpl, INVALID_PARAM);
+
+    RuntimeInstanceLease instance(*this);
+    return HIAI_MR_ModelManager_Run(instance.Get(), bindingImpl->cInputs.data(), bindingImpl->cInputs.size(),
+        bindingImpl->cOutputs.data(), bindingImpl->cOutputs.size());
+}
+
+Status ModelManagerImpl::RunAsync(const std::shared_ptr<IIOBinding>& binding, int32_t timeoutInMS, RunToken& token,
+    RunDoneCallback callback, void* userData)
+{
+    H_LOG_INTERFACE_FILTER(ITF_COUNT);
+    ScheduledRequest request(this, static_cast<ModelPriority>(priority_.load()));
+    HIAI_EXPECT_EXEC(request.Admit());
+    ReadLockGuard lock(modelManagerMutex_);
+    HIAI_EXPECT_TRUE_R(!modelManagers_.empty(), INVALID_PARAM);
+    HIAI_EXPECT_NOT_NULL_R(completionRing_, UNSUPPORTED);
+
+    IOBindingImpl* bindingImpl = GetBindingImpl(binding);
+    HIAI_EXPECT_NOT_NULL_R(bindingImpl, INVALID_PARAM);
+
+    RunToken slotToken;
+    if (!completionRing_->Acquire(callback, userData, slotToken)) {
+        return FAILURE;
+    }
+    RuntimeInstanceLease instance(*this);
+    Status ret = HIAI_MR_ModelManager_RunAsync(instance.Get(), bindingImpl->cInputs.data(), bindingImpl->cInputs.size(),
+        bindingImpl->cOutputs.data(), bindingImpl->cOutputs.size(), timeoutInMS, &slotContexts_[slotToken.slot]);
+    if (ret != SUCCESS) {
+        completionRing_->Abandon(slotToken);
+        return ret;
+    }
+    token = slotToken;
+    return SUCCESS;
+}
+
+std::shared_ptr<CompletionRing> ModelManagerImpl::GetCompletionRing()
+{
+    // 等待期间不持有modelManagerMutex_, 以免阻塞DeInit
+    ReadLockGuard lock(modelManagerMutex_);
+    return completionRing_;
+}
+
+Status ModelManagerImpl::Wait(const RunToken& token, int32_t timeoutInMS, Status& result)
+{
+    std::shared_ptr<CompletionRing> completionRing = GetCompletionRing();
+    HIAI_EXPECT_NOT_NULL_R(completionRing, UNSUPPORTED);
+    return completionRing->Wait(token, timeoutInMS, result);
+}
+
+Status ModelManagerImpl::WaitAny(
+    const std::vector<RunToken>& tokens, int32_t timeoutInMS, size_t& index, Status& result)
+{
+    std::shared_ptr<CompletionRing> completionRing = GetCompletionRing();
+    HIAI_EXPECT_NOT_NULL_R(completionRing, UNSUPPORTED);
+    return completionRing->WaitAny(tokens, timeoutInMS, index, result);
+}
+
+Status ModelManagerImpl::WaitAll(
+    const std::vector<RunToken>& tokens, int32_t timeoutInMS, std::vector<Status>& results)
+{
+    std::shared_ptr<CompletionRing> completionRing = GetCompletionRing();
+    HIAI_EXPECT_NOT_NULL_R(completionRing, UNSUPPORTED);
+    return completionRing->WaitAll(tokens, timeoutInMS, results);
+}
+
+Status ModelManagerImpl::SetShapeGears(const std::vector<ShapeGear>& gears, const ShapeDispatchOptions& options)
+{
+    H_LOG_INTERFACE_FILTER(ITF_COUNT);
+    WriteLockGuard lock(modelManagerMutex_);
+    HIAI_EXPECT_TRUE_R(!modelManagers_.empty(), INVALID_PARAM);
+    if (aippInputConverter_ != nullptr) {
+        FMK_LOGE("aipp model does not support shape gears.");
+        return UNSUPPORTED;
+    }
+    if (gears.empty()) {
+        shapeDispatcher_.reset();
+        return SUCCESS;
+    }
+
+    std::shared_ptr<ShapeDispatcher> dispatcher = make_shared_nothrow<ShapeDispatcher>();
+    HIAI_EXPECT_NOT_NULL(dispatcher);
+    HIAI_EXPECT_EXEC(dispatcher->Init(gears, options));
+    shapeDispatcher_ = dispatcher;
+    return SUCCESS;
+}
+
+void ModelManagerImpl::DestroyRuntimeInstances()
+{
+    shapeDispatcher_.reset();
+    for (const auto& modelManager : modelManagers_) {
+        (void)HIAI_MR_ModelManager_Deinit(modelManager.get());
+    }
+    modelManagers_.clear();
+
+    std::lock_guard<std::mutex> lock(idleMutex_);
+    idleInstances_.clear();
 }
 
 void ModelManagerImpl::UnLoad()
 {
-    std::lock_guard<std::mutex> lock(modelManagerMutex_);
-    (void)HIAI_MR_ModelManager_Deinit(modelManager_.get());
-    modelManager_.reset();
+    std::shared_ptr<CompletionRing> completionRing = nullptr;
+    {
+        WriteLockGuard lock(modelManagerMutex_);
+        DestroyRuntimeInstances();
+        completionRing = completionRing_;
+    }
+    // 运行时实例已去初始化, 不会再完成槽; 在锁外结束仍在执行中的请求, 回调可能重新调用本对象
+    if (completionRing != nullptr) {
+        completionRing->Close(FAILURE);
+    }
 }
 
 void ModelManagerImpl::DeInit()
@@ -438,6 +822,14 @@ void ModelManagerImpl::DeInit()
         cListener_ = nullptr;
         listener_ = nullptr;
     }
+    {
+        WriteLockGuard lock(modelManagerMutex_);
+        {
+            std::lock_guard<std::mutex> ringLock(completionRingMutex_);
+            completionRing_.reset();
+        }
+        slotContexts_.clear();
+    }
     allocator_.reset();
     cAllocator_.reset();
 }
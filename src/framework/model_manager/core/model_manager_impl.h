@@ -18,16 +18,31 @@
 
 #include "framework/c/hiai_model_manager.h"
 #include "model_manager/model_manager_ext.h"
+#ifdef AI_SUPPORT_AIPP_API
+#include "framework/c/hiai_tensor_aipp_para.h"
+#endif
 
+#include <atomic>
+#include <map>
 #include <mutex>
+#include <condition_variable>
+
+#include "infra/base/rw_mutex.h"
 
 namespace hiai {
 
 class ModelManagerImpl;
+class AippInputConverter;
+class RuntimeInstanceLease;
+class CompletionRing;
+class IOBindingImpl;
+class ShapeDispatcher;
 struct RunAsyncContext {
     Context context;
     ModelManagerImpl* modelManager;
     std::vector<std::shared_ptr<INDTensorBuffer>> outputs;
+    // 预分配完成槽下标, 小于0表示按次new的上下文
+    int64_t slot {-1};
 };
 
 struct MemAllocaterContext {
@@ -64,11 +79,36 @@ private:
 
     void DeInit() override;
 
+    std::shared_ptr<IIOBinding> CreateIOBinding(const std::vector<std::shared_ptr<INDTensorBuffer>>& inputs,
+        const std::vector<std::shared_ptr<INDTensorBuffer>>& outputs) override;
+
+    Status Run(const std::shared_ptr<IIOBinding>& binding) override;
+
+    Status RunAsync(const std::shared_ptr<IIOBinding>& binding, int32_t timeoutInMS, RunToken& token,
+        RunDoneCallback callback, void* userData) override;
+
+    Status Wait(const RunToken& token, int32_t timeoutInMS, Status& result) override;
+    Status WaitAny(const std::vector<RunToken>& tokens, int32_t timeoutInMS, size_t& index, Status& result) override;
+    Status WaitAll(const std::vector<RunToken>& tokens, int32_t timeoutInMS, std::vector<Status>& results) override;
+
+    Status SetShapeGears(const std::vector<ShapeGear>& gears, const ShapeDispatchOptions& options) override;
+
 private:
     Status PrepareModelManagerListener(const std::shared_ptr<IModelManagerListener>& listener);
 
+    Status PrepareCompletionRing(const ModelInitOptions& options);
+
     Status PrepareModelManager(const ModelInitOptions& options, const std::shared_ptr<IBuiltModel>& builtModel);
 
+    Status PrepareAippInputConverter(const std::shared_ptr<IBuiltModel>& builtModel);
+
+#ifdef AI_SUPPORT_AIPP_API
+    // 调用者须已获准调度并持有modelManagerMutex_读锁
+    Status RunAippModel(const Context& context, HIAI_MR_NDTensorBuffer* cInputs[], size_t inputNum,
+        HIAI_MR_TensorAippPara* cAippParas[], size_t aippParaNum,
+        std::vector<std::shared_ptr<INDTensorBuffer>>& outputs, int32_t timeoutInMS);
+#endif
+
     void OnRunDone(const Context& context, Status errCode, std::vector<std::shared_ptr<INDTensorBuffer>>& outputs);
     void OnServiceDied();
 
@@ -82,9 +122,43 @@ private:
 
     void UnLoad();
 
+    // 调用者须已获准调度并持有modelManagerMutex_读锁
+    Status RunModel(const std::vector<std::shared_ptr<INDTensorBuffer>>& inputs,
+        std::vector<std::shared_ptr<INDTensorBuffer>>& outputs);
+
+    static Status BindTensors(const std::vector<std::shared_ptr<INDTensorBuffer>>& buffers,
+        const std::vector<NDTensorDesc>& descs, std::vector<HIAI_MR_NDTensorBuffer*>& cBuffers);
+
+    IOBindingImpl* GetBindingImpl(const std::shared_ptr<IIOBinding>& binding) const;
+
+    std::shared_ptr<CompletionRing> GetCompletionRing();
+
+    Status CreateRuntimeInstances(const ModelInitOptions& options, const std::shared_ptr<IBuiltModel>& builtModel);
+
+    void DestroyRuntimeInstances();
+
+    size_t AcquireRuntimeInstance();
+    void ReleaseRuntimeInstance(size_t index);
+
+    friend class RuntimeInstanceLease;
+
 private:
-    std::mutex modelManagerMutex_;
-    std::shared_ptr<HIAI_MR_ModelManager> modelManager_ {nullptr};
+    // 读锁: Run/RunAsync/RunAippModel/Cancel, 写锁: Init/SetPriority/DeInit
+    RWMutex modelManagerMutex_;
+    std::vector<std::shared_ptr<HIAI_MR_ModelManager>> modelManagers_;
+
+    // 空闲运行时实例, 每个实例同一时刻只执行一个请求
+    std::mutex idleMutex_;
+    std::condition_variable idleCond_;
+    std::vector<size_t> idleInstances_;
+
+    // 每次Init分配新值, IIOBinding按该值校验是否仍属于当前加载的模型
+    uint64_t generation_ {0};
+    std::vector<NDTensorDesc> inputTensorDescs_;
+    std::vector<NDTensorDesc> outputTensorDescs_;
+
+    // 进程级请求调度按该优先级排队
+    std::atomic<int32_t> priority_ {PRIORITY_MIDDLE};
 
     std::mutex listenerMutex_;
     std::shared_ptr<IModelManagerListener> listener_ {nullptr};
@@ -92,9 +166,21 @@ private:
 
     std::shared_ptr<ISharedMemAllocator> allocator_ {nullptr};
     std::shared_ptr<HIAI_ModelManagerSharedMemAllocator> cAllocator_ {nullptr};
-    std::vector<std::pair<HIAI_NativeHandle*, hiai::NativeHandle>> nativeHandle_;
+    // 已交给运行时的native handle, OnFree按指针查找; freeHandles_复用于每次Free的入参
+    std::mutex nativeHandleMutex_;
+    std::map<HIAI_NativeHandle*, hiai::NativeHandle> nativeHandles_;
+    std::vector<hiai::NativeHandle> freeHandles_;
+
+    std::unique_ptr<AippInputConverter> aippInputConverter_ {nullptr};
+
+    // RunAsync(binding)的完成槽及各槽对应的回调上下文, Init时按asyncSlotNum分配
+    // 运行时回调不持有modelManagerMutex_, 修改completionRing_时还需持有completionRingMutex_
+    std::mutex completionRingMutex_;
+    std::shared_ptr<CompletionRing> completionRing_ {nullptr};
+    std::vector<RunAsyncContext> slotContexts_;
 
-    CustomModelData customModelData_;
+    // SetShapeGears登记的档位分派, 卸载模型时清除
+    std::shared_ptr<ShapeDispatcher> shapeDispatcher_ {nullptr};
 };
 } // namespace hiai
 #endif // FRAMEWORK_INC_MODEL_MANAGER_MODEL_MANAGER_IMPL_H
@@ -18,6 +18,8 @@
 #include <dlfcn.h>
 #include <unistd.h>
 
+#include <chrono>
+
 #include "framework/infra/log/log.h"
 #include "infra/base/process_util.h"
 
@@ -29,53 +31,150 @@ static const char* libraryName = "/vendor/lib64/libai_client.so";
 static const char* libraryName = "/vendor/lib/libai_client.so";
 #endif
 
-Status OpenRequestStats::StatsRequest(const std::string& statsData)
+namespace {
+// 待上报的不同统计项个数上限, 相同统计项只累加次数
+const size_t MAX_PENDING_STATS_NUM = 64;
+const uint32_t STATS_FLUSH_INTERVAL_MS = 1000;
+
+StatsReporter::RecordRequestFunc ResolveRecordRequest(void*& handle)
 {
-    void* handle = dlopen(libraryName, RTLD_NOW | RTLD_LOCAL);
+    handle = dlopen(libraryName, RTLD_NOW | RTLD_LOCAL);
     if (handle == nullptr) {
         FMK_LOGW("dlopen failed, lib[%s], errmsg[%s]", libraryName, dlerror());
-        return hiai::FAILURE;
+        return nullptr;
     }
 
     const char* functionName = "StatsService_RecordRequest";
-    void* functionAddr = dlsym(handle, functionName);
-    if (functionAddr == nullptr) {
+    auto recordRequest = reinterpret_cast<StatsReporter::RecordRequestFunc>(dlsym(handle, functionName));
+    if (recordRequest == nullptr) {
         FMK_LOGE("dlsym failed, lib[%s], errmsg[%s]", functionName, dlerror());
         dlclose(handle);
-        return hiai::FAILURE;
+        handle = nullptr;
     }
+    return recordRequest;
+}
 
-    using FuncHandle = int (*)(const char*, uint32_t);
-    FuncHandle functionHandle = reinterpret_cast<FuncHandle>(functionAddr);
-    if (functionHandle == nullptr) {
-        FMK_LOGE("dlsym failed, lib[%s], errmsg[%s]", functionName, dlerror());
-        dlclose(handle);
-        return hiai::FAILURE;
+// 进程名需读取proc文件, 只获取一次
+const std::string& GetProcessNameStats()
+{
+    static const std::string processName = "processName=" + hiai::GetProcessName() + ",";
+    return processName;
+}
+} // namespace
+
+StatsReporter& StatsReporter::GetInstance()
+{
+    static StatsReporter instance(ResolveRecordRequest, STATS_FLUSH_INTERVAL_MS);
+    return instance;
+}
+
+StatsReporter::StatsReporter(const Resolver& resolver, uint32_t flushIntervalInMS)
+    : resolver_(resolver), flushIntervalInMS_(flushIntervalInMS)
+{
+}
+
+StatsReporter::~StatsReporter()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cond_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+    if (handle_ != nullptr) {
+        dlclose(handle_);
+    }
+}
+
+Status StatsReporter::Post(const std::string& statsData)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (unavailable_ || stopping_) {
+        return FAILURE;
+    }
+    auto it = pending_.find(statsData);
+    if (it != pending_.end()) {
+        it->second++;
+    } else if (pending_.size() < MAX_PENDING_STATS_NUM) {
+        pending_.emplace(statsData, 1);
+    } else {
+        FMK_LOGW("too many pending stats, drop it.");
+        return FAILURE;
     }
+    if (!worker_.joinable()) {
+        worker_ = std::thread(&StatsReporter::WorkLoop, this);
+    }
+    cond_.notify_all();
+    return SUCCESS;
+}
 
-    int ret = functionHandle(statsData.c_str(), statsData.length());
-    dlclose(handle);
-    return ret == 0 ? hiai::SUCCESS : hiai::FAILURE;
+bool StatsReporter::Resolve()
+{
+    if (recordRequest_ == nullptr) {
+        recordRequest_ = resolver_(handle_);
+    }
+    return recordRequest_ != nullptr;
+}
+
+void StatsReporter::Report(const std::map<std::string, uint32_t>& stats)
+{
+    if (!Resolve()) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        unavailable_ = true;
+        pending_.clear();
+        return;
+    }
+    for (const auto& item : stats) {
+        for (uint32_t i = 0; i < item.second; i++) {
+            (void)recordRequest_(item.first.c_str(), item.first.length());
+        }
+    }
+}
+
+void StatsReporter::WorkLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!unavailable_) {
+        cond_.wait(lock, [this] { return stopping_ || !pending_.empty(); });
+        // 攒一个周期再上报, 退出时立即上报
+        cond_.wait_for(lock, std::chrono::milliseconds(flushIntervalInMS_), [this] { return stopping_; });
+
+        std::map<std::string, uint32_t> stats;
+        stats.swap(pending_);
+        bool stopping = stopping_;
+        if (!stats.empty()) {
+            lock.unlock();
+            Report(stats);
+            lock.lock();
+        }
+        if (stopping) {
+            return;
+        }
+    }
+}
+
+Status OpenRequestStats::StatsRequest(const std::string& statsData)
+{
+    return StatsReporter::GetInstance().Post(statsData);
 }
 
 Status OpenRequestStats::CloudDdkVersionStats(const char* clientDdkVersion, const char* interfaceName, int result)
 {
-    std::string StatsData;
-    std::string uid = std::to_string(getpid());
-    StatsData += "uid=" + uid + ",";
-    std::size_t pos = std::string(clientDdkVersion).find_last_of(":");
+    std::string StatsData = "uid=" + std::to_string(getpid()) + ",";
+    std::string version(clientDdkVersion);
+    std::size_t pos = version.find_last_of(":");
     if (pos != std::string::npos) {
         constexpr int POS_OFFSET = 1;
-        StatsData += "interfaceName=" + std::string(interfaceName) + ";" +
-            std::string("clientDdkVersion:") + std::string(clientDdkVersion).substr(pos + POS_OFFSET) + ",";
+        StatsData += "interfaceName=" + std::string(interfaceName) + ";" + std::string("clientDdkVersion:") +
+            version.substr(pos + POS_OFFSET) + ",";
     } else {
         StatsData += "interfaceName=" + std::string(interfaceName) + ",";
     }
-    std::string processName = hiai::GetProcessName();
-    StatsData += "processName=" + processName + ",";
+    StatsData += GetProcessNameStats();
     StatsData += "engineType=1,";
-    std::string statsResult = std::to_string(result);
-    StatsData += "result=" + statsResult;
+    StatsData += "result=" + std::to_string(result);
     return StatsRequest(StatsData);
 }
-} // namespace hiai
\ No newline at end of file
+} // namespace hiai
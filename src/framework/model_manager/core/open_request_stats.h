@@ -16,10 +16,55 @@
 #ifndef FRAMEWORK_INC_OPEN_REQUEST_STATS_H
 #define FRAMEWORK_INC_OPEN_REQUEST_STATS_H
 
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
 #include <string>
+#include <thread>
 #include "base/error_types.h"
 
 namespace hiai {
+/*
+ * 后台上报统计, 调用方只入队不等待. 上报函数在首次上报时解析并常驻, 解析失败后不再入队;
+ * 每个上报周期合并一次, 析构时上报剩余统计.
+ */
+class StatsReporter {
+public:
+    using RecordRequestFunc = int (*)(const char*, uint32_t);
+    // 解析上报函数, 失败返回nullptr; handle为需要在析构时dlclose的库句柄, 没有则不设置
+    using Resolver = std::function<RecordRequestFunc(void*& handle)>;
+
+    static StatsReporter& GetInstance();
+
+    StatsReporter(const Resolver& resolver, uint32_t flushIntervalInMS);
+    ~StatsReporter();
+    StatsReporter(const StatsReporter&) = delete;
+    StatsReporter& operator=(const StatsReporter&) = delete;
+
+    Status Post(const std::string& statsData);
+
+private:
+    bool Resolve();
+    void Report(const std::map<std::string, uint32_t>& stats);
+    void WorkLoop();
+
+private:
+    Resolver resolver_;
+    uint32_t flushIntervalInMS_;
+
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::map<std::string, uint32_t> pending_;
+    bool unavailable_ {false};
+    bool stopping_ {false};
+    std::thread worker_;
+
+    // 只在上报线程中访问
+    void* handle_ {nullptr};
+    RecordRequestFunc recordRequest_ {nullptr};
+};
+
 class OpenRequestStats {
 public:
     static Status StatsRequest(const std::string& statsData);
@@ -0,0 +1,197 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pipeline_impl.h"
+
+
+#include "infra/base/assertion.h"
+#include "infra/base/securestl.h"
+#include "framework/infra/log/log.h"
+
+namespace hiai {
+namespace {
+// 每个输出最多缓存的空闲tensor数, 调用者长期持有输出时超出部分直接释放
+const size_t MAX_OUTPUT_POOL_SIZE = 16;
+} // namespace
+
+bool PipelineQueue::Push(PipelineFrame&& frame)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    notFull_.wait(lock, [this] { return closed_ || frames_.size() < capacity_; });
+    if (closed_) {
+        return false;
+    }
+    frames_.push_back(std::move(frame));
+    notEmpty_.notify_one();
+    return true;
+}
+
+bool PipelineQueue::Pop(PipelineFrame& frame)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    notEmpty_.wait(lock, [this] { return closed_ || !frames_.empty(); });
+    if (frames_.empty()) {
+        return false;
+    }
+    frame = std::move(frames_.front());
+    frames_.pop_front();
+    notFull_.notify_one();
+    return true;
+}
+
+void PipelineQueue::Close()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+    notFull_.notify_all();
+    notEmpty_.notify_all();
+}
+
+Status ModelPipelineStage::Process(const PipelineTensors& inputs, PipelineTensors& outputs)
+{
+    HIAI_EXPECT_EXEC(outputPool_->Acquire(outputs));
+    return modelManager_->Run(inputs, outputs);
+}
+
+Pipeline::~Pipeline()
+{
+    Stop();
+}
+
+Status Pipeline::AddStage(std::unique_ptr<PipelineStage> stage)
+{
+    HIAI_EXPECT_NOT_NULL_R(stage, MEMORY_EXCEPTION);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (started_) {
+        FMK_LOGE("can not add stage after pipeline started.");
+        return FAILURE;
+    }
+    stages_.push_back(std::move(stage));
+    return SUCCESS;
+}
+
+Status Pipeline::AddModelStage(
+    const std::shared_ptr<IModelManager>& modelManager, const std::shared_ptr<IBuiltModel>& builtModel)
+{
+    HIAI_EXPECT_NOT_NULL_R(modelManager, INVALID_PARAM);
+    HIAI_EXPECT_NOT_NULL_R(builtModel, INVALID_PARAM);
+    std::shared_ptr<TensorSetPool> outputPool =
+        make_shared_nothrow<TensorSetPool>(builtModel->GetOutputTensorDescs(), MAX_OUTPUT_POOL_SIZE);
+    HIAI_EXPECT_NOT_NULL_R(outputPool, MEMORY_EXCEPTION);
+    return AddStage(std::unique_ptr<PipelineStage>(new (std::nothrow) ModelPipelineStage(modelManager, outputPool)));
+}
+
+Status Pipeline::AddCpuStage(const PipelineCpuFunc& func)
+{
+    HIAI_EXPECT_TRUE_R(func != nullptr, INVALID_PARAM);
+    return AddStage(std::unique_ptr<PipelineStage>(new (std::nothrow) CpuPipelineStage(func)));
+}
+
+Status Pipeline::Start(const PipelineDoneFunc& done)
+{
+    HIAI_EXPECT_TRUE_R(done != nullptr, INVALID_PARAM);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (started_ || stages_.empty()) {
+        FMK_LOGE("pipeline is already started or has no stage.");
+        return FAILURE;
+    }
+
+    done_ = done;
+    for (size_t i = 0; i < stages_.size(); i++) {
+        std::unique_ptr<PipelineQueue> queue(new (std::nothrow) PipelineQueue(options_.queueDepth));
+        HIAI_EXPECT_NOT_NULL_R(queue, MEMORY_EXCEPTION);
+        queues_.push_back(std::move(queue));
+    }
+    for (size_t i = 0; i < stages_.size(); i++) {
+        threads_.emplace_back(&Pipeline::StageLoop, this, i);
+    }
+    started_ = true;
+    return SUCCESS;
+}
+
+Status Pipeline::Submit(uint64_t frameId, const PipelineTensors& inputs)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!started_ || stopped_) {
+            FMK_LOGE("pipeline is not running.");
+            return FAILURE;
+        }
+    }
+
+    PipelineFrame frame;
+    frame.id = frameId;
+    frame.tensors = inputs;
+    // Stop关闭队列后阻塞中的Push返回失败
+    return queues_[0]->Push(std::move(frame)) ? SUCCESS : FAILURE;
+}
+
+void Pipeline::StageLoop(size_t index)
+{
+    bool isLast = index + 1 == stages_.size();
+    PipelineFrame frame;
+    while (queues_[index]->Pop(frame)) {
+        if (frame.result == SUCCESS) {
+            PipelineTensors outputs;
+            Status ret = stages_[index]->Process(frame.tensors, outputs);
+            if (ret == SUCCESS) {
+                frame.tensors.swap(outputs);
+            } else {
+                FMK_LOGE("stage %zu of frame %llu failed.", index, static_cast<unsigned long long>(frame.id));
+                frame.result = ret;
+            }
+        }
+
+        if (isLast) {
+            done_(frame.id, frame.result, frame.tensors);
+        } else {
+            (void)queues_[index + 1]->Push(std::move(frame));
+        }
+        // 及时释放对本帧tensor的引用, 使上游的输出归还复用
+        frame = PipelineFrame();
+    }
+    if (!isLast) {
+        queues_[index + 1]->Close();
+    }
+}
+
+void Pipeline::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!started_ || stopped_) {
+            return;
+        }
+        stopped_ = true;
+    }
+    // 关闭第一级队列, 各级处理完剩余帧后依次关闭下一级
+    queues_[0]->Close();
+    for (auto& thread : threads_) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+}
+
+std::shared_ptr<IPipeline> CreatePipeline(const PipelineOptions& options)
+{
+    if (options.queueDepth == 0) {
+        FMK_LOGE("queueDepth is invalid.");
+        return nullptr;
+    }
+    return make_shared_nothrow<Pipeline>(options);
+}
+} // namespace hiai
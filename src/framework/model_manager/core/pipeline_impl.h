@@ -0,0 +1,124 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FRAMEWORK_MODEL_MANAGER_PIPELINE_IMPL_H
+#define FRAMEWORK_MODEL_MANAGER_PIPELINE_IMPL_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "model_manager/pipeline.h"
+#include "tensor_set_pool.h"
+
+namespace hiai {
+struct PipelineFrame {
+    uint64_t id {0};
+    Status result {SUCCESS};
+    PipelineTensors tensors;
+};
+
+// 有界阻塞队列, Close后Push失败, Pop取完剩余帧后失败
+class PipelineQueue {
+public:
+    explicit PipelineQueue(size_t capacity) : capacity_(capacity)
+    {
+    }
+
+    bool Push(PipelineFrame&& frame);
+    bool Pop(PipelineFrame& frame);
+    void Close();
+
+private:
+    std::mutex mutex_;
+    std::condition_variable notFull_;
+    std::condition_variable notEmpty_;
+    std::deque<PipelineFrame> frames_;
+    size_t capacity_;
+    bool closed_ {false};
+};
+
+class PipelineStage {
+public:
+    virtual ~PipelineStage() = default;
+    virtual Status Process(const PipelineTensors& inputs, PipelineTensors& outputs) = 0;
+};
+
+class ModelPipelineStage : public PipelineStage {
+public:
+    ModelPipelineStage(
+        const std::shared_ptr<IModelManager>& modelManager, const std::shared_ptr<TensorSetPool>& outputPool)
+        : modelManager_(modelManager), outputPool_(outputPool)
+    {
+    }
+
+    Status Process(const PipelineTensors& inputs, PipelineTensors& outputs) override;
+
+private:
+    std::shared_ptr<IModelManager> modelManager_;
+    // 输出被下游及调用者全部释放后归还复用
+    std::shared_ptr<TensorSetPool> outputPool_;
+};
+
+class CpuPipelineStage : public PipelineStage {
+public:
+    explicit CpuPipelineStage(const PipelineCpuFunc& func) : func_(func)
+    {
+    }
+
+    Status Process(const PipelineTensors& inputs, PipelineTensors& outputs) override
+    {
+        return func_(inputs, outputs);
+    }
+
+private:
+    PipelineCpuFunc func_;
+};
+
+class Pipeline : public IPipeline {
+public:
+    explicit Pipeline(const PipelineOptions& options) : options_(options)
+    {
+    }
+    ~Pipeline() override;
+
+    Status AddModelStage(
+        const std::shared_ptr<IModelManager>& modelManager, const std::shared_ptr<IBuiltModel>& builtModel) override;
+    Status AddCpuStage(const PipelineCpuFunc& func) override;
+    Status Start(const PipelineDoneFunc& done) override;
+    Status Submit(uint64_t frameId, const PipelineTensors& inputs) override;
+    void Stop() override;
+
+private:
+    Status AddStage(std::unique_ptr<PipelineStage> stage);
+    void StageLoop(size_t index);
+
+private:
+    PipelineOptions options_;
+    PipelineDoneFunc done_;
+
+    // 保护started_/stopped_及Start前的stages_
+    std::mutex mutex_;
+    bool started_ {false};
+    bool stopped_ {false};
+
+    // Start之后不再变化, queues_[i]为stages_[i]的输入
+    std::vector<std::unique_ptr<PipelineStage>> stages_;
+    std::vector<std::unique_ptr<PipelineQueue>> queues_;
+    std::vector<std::thread> threads_;
+};
+} // namespace hiai
+#endif // FRAMEWORK_MODEL_MANAGER_PIPELINE_IMPL_H
@@ -0,0 +1,260 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "request_scheduler_impl.h"
+
+#include <algorithm>
+
+#include "framework/infra/log/log.h"
+
+namespace hiai {
+namespace {
+const size_t STATS_WINDOW_SIZE = 1024;
+const uint32_t P99 = 99;
+// 有效优先级从1开始, 老化最多提升到最高的有效优先级, 与之同级时按排队先后执行
+const int64_t HIGHEST_SCHEDULE_LEVEL = 1;
+
+uint32_t ToLevel(ModelPriority priority)
+{
+    uint32_t level = static_cast<uint32_t>(priority);
+    return level < SCHEDULE_PRIORITY_LEVEL_NUM ? level : SCHEDULE_PRIORITY_LEVEL_NUM - 1;
+}
+
+uint64_t ElapsedUs(std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to)
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(to - from).count());
+}
+} // namespace
+
+void RequestScheduler::SampleWindow::Add(uint64_t value)
+{
+    if (samples.size() < STATS_WINDOW_SIZE) {
+        samples.push_back(value);
+        return;
+    }
+    samples[next] = value;
+    next = (next + 1) % STATS_WINDOW_SIZE;
+}
+
+uint64_t RequestScheduler::SampleWindow::Average() const
+{
+    if (samples.empty()) {
+        return 0;
+    }
+    uint64_t sum = 0;
+    for (uint64_t sample : samples) {
+        sum += sample;
+    }
+    return sum / samples.size();
+}
+
+uint64_t RequestScheduler::SampleWindow::Percentile(uint32_t percent) const
+{
+    if (samples.empty()) {
+        return 0;
+    }
+    std::vector<uint64_t> sorted = samples;
+    size_t index = (sorted.size() - 1) * percent / 100; // 100: 百分比
+    std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+    return sorted[index];
+}
+
+RequestScheduler& RequestScheduler::GetInstance()
+{
+    static RequestScheduler instance;
+    return instance;
+}
+
+void RequestScheduler::SetOptions(const RequestSchedulerOptions& options)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    options_ = options;
+    // 并发上限放宽后立即放行排队请求
+    Dispatch();
+}
+
+bool RequestScheduler::CanAdmit() const
+{
+    return options_.maxConcurrency == 0 || running_ < options_.maxConcurrency;
+}
+
+void RequestScheduler::Admit(ScheduleWaiter& waiter, std::chrono::steady_clock::time_point now)
+{
+    running_++;
+    waiter.admitted = true;
+    waiter.admitTime = now;
+
+    LevelStats& stats = stats_[waiter.level];
+    stats.requestNum++;
+    stats.queueDelays.Add(ElapsedUs(waiter.enqueueTime, now));
+}
+
+ScheduleWaiter* RequestScheduler::PopNext(std::chrono::steady_clock::time_point now)
+{
+    ScheduleWaiter* best = nullptr;
+    int64_t bestLevel = 0;
+    uint32_t bestQueue = 0;
+    // 每个队列的队首等待最久, 只需比较队首老化后的优先级
+    for (uint32_t i = 0; i < SCHEDULE_PRIORITY_LEVEL_NUM; i++) {
+        if (queues_[i].empty()) {
+            continue;
+        }
+        ScheduleWaiter* head = queues_[i].front();
+        int64_t level = static_cast<int64_t>(i);
+        if (options_.agingIntervalInMS != 0) {
+            int64_t waited = std::chrono::duration_cast<std::chrono::milliseconds>(now - head->enqueueTime).count();
+            level = std::max<int64_t>(HIGHEST_SCHEDULE_LEVEL, level - waited / options_.agingIntervalInMS);
+        }
+        if (best == nullptr || level < bestLevel || (level == bestLevel && head->enqueueTime < best->enqueueTime)) {
+            best = head;
+            bestLevel = level;
+            bestQueue = i;
+        }
+    }
+    if (best != nullptr) {
+        queues_[bestQueue].pop_front();
+    }
+    return best;
+}
+
+void RequestScheduler::Dispatch()
+{
+    auto now = std::chrono::steady_clock::now();
+    while (CanAdmit()) {
+        ScheduleWaiter* waiter = PopNext(now);
+        if (waiter == nullptr) {
+            return;
+        }
+        Admit(*waiter, now);
+        waiter->cond.notify_one();
+    }
+}
+
+Status RequestScheduler::Acquire(ScheduleWaiter& waiter)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    waiter.enqueueTime = std::chrono::steady_clock::now();
+    if (CanAdmit() && GetQueuedNumLocked() == 0) {
+        Admit(waiter, waiter.enqueueTime);
+        return SUCCESS;
+    }
+
+    queues_[waiter.level].push_back(&waiter);
+    waiter.cond.wait(lock, [&waiter] { return waiter.admitted || waiter.cancelled; });
+    if (waiter.cancelled) {
+        FMK_LOGW("queued request of priority %u is cancelled.", waiter.level);
+        return FAILURE;
+    }
+    return SUCCESS;
+}
+
+void RequestScheduler::Release(ScheduleWaiter& waiter)
+{
+    if (!waiter.admitted) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    running_--;
+    waiter.admitted = false;
+    stats_[waiter.level].latencies.Add(ElapsedUs(waiter.enqueueTime, std::chrono::steady_clock::now()));
+    Dispatch();
+}
+
+void RequestScheduler::CancelQueued(const void* owner)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (uint32_t i = 0; i < SCHEDULE_PRIORITY_LEVEL_NUM; i++) {
+        auto& queue = queues_[i];
+        for (auto it = queue.begin(); it != queue.end();) {
+            if ((*it)->owner != owner) {
+                ++it;
+                continue;
+            }
+            (*it)->cancelled = true;
+            (*it)->cond.notify_one();
+            stats_[i].cancelledNum++;
+            it = queue.erase(it);
+        }
+    }
+}
+
+Status RequestScheduler::GetStats(ModelPriority priority, RequestSchedulerStats& stats)
+{
+    uint32_t level = static_cast<uint32_t>(priority);
+    if (level == 0 || level >= SCHEDULE_PRIORITY_LEVEL_NUM) {
+        FMK_LOGE("priority %u is invalid.", level);
+        return INVALID_PARAM;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    const LevelStats& levelStats = stats_[level];
+    stats.requestNum = levelStats.requestNum;
+    stats.cancelledNum = levelStats.cancelledNum;
+    stats.avgQueueDelay = levelStats.queueDelays.Average();
+    stats.p99QueueDelay = levelStats.queueDelays.Percentile(P99);
+    stats.p99Latency = levelStats.latencies.Percentile(P99);
+    return SUCCESS;
+}
+
+void RequestScheduler::ResetStats()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& stats : stats_) {
+        stats = LevelStats();
+    }
+}
+
+size_t RequestScheduler::GetQueuedNumLocked() const
+{
+    size_t num = 0;
+    for (const auto& queue : queues_) {
+        num += queue.size();
+    }
+    return num;
+}
+
+size_t RequestScheduler::GetQueuedNum()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return GetQueuedNumLocked();
+}
+
+ScheduledRequest::ScheduledRequest(const void* owner, ModelPriority priority)
+{
+    waiter_.owner = owner;
+    waiter_.level = ToLevel(priority);
+}
+
+ScheduledRequest::~ScheduledRequest()
+{
+    RequestScheduler::GetInstance().Release(waiter_);
+}
+
+Status ScheduledRequest::Admit()
+{
+    return RequestScheduler::GetInstance().Acquire(waiter_);
+}
+
+void SetRequestSchedulerOptions(const RequestSchedulerOptions& options)
+{
+    RequestScheduler::GetInstance().SetOptions(options);
+}
+
+Status GetRequestSchedulerStats(ModelPriority priority, RequestSchedulerStats& stats)
+{
+    return RequestScheduler::GetInstance().GetStats(priority, stats);
+}
+} // namespace hiai
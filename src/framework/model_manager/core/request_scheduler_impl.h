@@ -0,0 +1,107 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FRAMEWORK_MODEL_MANAGER_REQUEST_SCHEDULER_IMPL_H
+#define FRAMEWORK_MODEL_MANAGER_REQUEST_SCHEDULER_IMPL_H
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#include "model_manager/request_scheduler.h"
+
+namespace hiai {
+// ModelPriority取值[1, 7], 数值越小优先级越高
+const uint32_t SCHEDULE_PRIORITY_LEVEL_NUM = 8;
+
+struct ScheduleWaiter {
+    const void* owner {nullptr};
+    uint32_t level {0};
+    std::chrono::steady_clock::time_point enqueueTime;
+    std::chrono::steady_clock::time_point admitTime;
+    bool admitted {false};
+    bool cancelled {false};
+    std::condition_variable cond;
+};
+
+class RequestScheduler {
+public:
+    static RequestScheduler& GetInstance();
+
+    void SetOptions(const RequestSchedulerOptions& options);
+
+    // 阻塞直到获准执行, owner的排队请求被取消时返回FAILURE
+    Status Acquire(ScheduleWaiter& waiter);
+    void Release(ScheduleWaiter& waiter);
+
+    // 取消owner所有尚在排队的请求
+    void CancelQueued(const void* owner);
+
+    Status GetStats(ModelPriority priority, RequestSchedulerStats& stats);
+    void ResetStats();
+
+    size_t GetQueuedNum();
+
+private:
+    RequestScheduler() = default;
+
+    // 保留最近STATS_WINDOW_SIZE个样本
+    struct SampleWindow {
+        std::vector<uint64_t> samples;
+        size_t next {0};
+
+        void Add(uint64_t value);
+        uint64_t Average() const;
+        uint64_t Percentile(uint32_t percent) const;
+    };
+
+    struct LevelStats {
+        uint64_t requestNum {0};
+        uint64_t cancelledNum {0};
+        SampleWindow queueDelays;
+        SampleWindow latencies;
+    };
+
+    bool CanAdmit() const;
+    void Admit(ScheduleWaiter& waiter, std::chrono::steady_clock::time_point now);
+    ScheduleWaiter* PopNext(std::chrono::steady_clock::time_point now);
+    void Dispatch();
+    size_t GetQueuedNumLocked() const;
+
+private:
+    std::mutex mutex_;
+    RequestSchedulerOptions options_;
+    uint32_t running_ {0};
+    std::deque<ScheduleWaiter*> queues_[SCHEDULE_PRIORITY_LEVEL_NUM];
+    LevelStats stats_[SCHEDULE_PRIORITY_LEVEL_NUM];
+};
+
+// 一次请求的调度: Admit阻塞直到获准执行, 析构时归还并发名额并记录时延
+class ScheduledRequest {
+public:
+    ScheduledRequest(const void* owner, ModelPriority priority);
+    ~ScheduledRequest();
+    ScheduledRequest(const ScheduledRequest&) = delete;
+    ScheduledRequest& operator=(const ScheduledRequest&) = delete;
+
+    Status Admit();
+
+private:
+    ScheduleWaiter waiter_;
+};
+} // namespace hiai
+#endif // FRAMEWORK_MODEL_MANAGER_REQUEST_SCHEDULER_IMPL_H
@@ -0,0 +1,247 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "shape_dispatcher.h"
+
+#include <algorithm>
+
+#include "securec.h"
+#include "infra/base/assertion.h"
+#include "infra/base/securestl.h"
+#include "model/built_model_ext.h"
+#include "framework/infra/log/log.h"
+
+namespace hiai {
+namespace {
+const size_t MAX_SHAPE_GEAR_NUM = 16;
+// 每个档位每个tensor最多缓存的空闲个数, 超出时按次创建
+const size_t MAX_POOLED_TENSOR_SETS = 4;
+const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+const uint64_t FNV_PRIME = 1099511628211ULL;
+
+uint64_t HashDims(uint64_t hash, const std::vector<int32_t>& dims)
+{
+    hash = (hash ^ dims.size()) * FNV_PRIME;
+    for (int32_t dim : dims) {
+        hash = (hash ^ static_cast<uint32_t>(dim)) * FNV_PRIME;
+    }
+    return hash;
+}
+
+size_t GetElementNum(const std::vector<int32_t>& dims)
+{
+    size_t num = 1;
+    for (int32_t dim : dims) {
+        num *= static_cast<size_t>(dim);
+    }
+    return num;
+}
+
+bool IsFixedShape(const std::vector<NDTensorDesc>& descs)
+{
+    for (const auto& desc : descs) {
+        if (desc.dims.empty()) {
+            return false;
+        }
+        for (int32_t dim : desc.dims) {
+            if (dim <= 0) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// 输入按行拷贝到dst左上角, 其余补零
+Status PadCopy(INDTensorBuffer& src, INDTensorBuffer& dst)
+{
+    const std::vector<int32_t>& srcDims = src.GetTensorDesc().dims;
+    const std::vector<int32_t>& dstDims = dst.GetTensorDesc().dims;
+    size_t srcNum = GetElementNum(srcDims);
+    HIAI_EXPECT_TRUE_R(srcNum != 0 && src.GetSize() % srcNum == 0, INVALID_PARAM);
+    size_t elementSize = src.GetSize() / srcNum;
+    HIAI_EXPECT_TRUE_R(dst.GetSize() == GetElementNum(dstDims) * elementSize, INVALID_PARAM);
+
+    uint8_t* to = static_cast<uint8_t*>(dst.GetData());
+    const uint8_t* from = static_cast<const uint8_t*>(src.GetData());
+    HIAI_EXPECT_TRUE_R(memset_s(to, dst.GetSize(), 0, dst.GetSize()) == EOK, FAILURE);
+
+    size_t rank = srcDims.size();
+    size_t rowBytes = static_cast<size_t>(srcDims[rank - 1]) * elementSize;
+    size_t rowNum = srcNum / static_cast<size_t>(srcDims[rank - 1]);
+    for (size_t row = 0; row < rowNum; row++) {
+        // 行号按src各维展开为下标, 再按dst的步长折算偏移
+        size_t remain = row;
+        size_t offset = 0;
+        size_t stride = static_cast<size_t>(dstDims[rank - 1]);
+        for (size_t d = rank - 1; d > 0; d--) {
+            size_t srcDim = static_cast<size_t>(srcDims[d - 1]);
+            offset += (remain % srcDim) * stride;
+            remain /= srcDim;
+            stride *= static_cast<size_t>(dstDims[d - 1]);
+        }
+        size_t dstOffset = offset * elementSize;
+        HIAI_EXPECT_TRUE_R(
+            memcpy_s(to + dstOffset, dst.GetSize() - dstOffset, from + row * rowBytes, rowBytes) == EOK, FAILURE);
+    }
+    return SUCCESS;
+}
+} // namespace
+
+Status ShapeDispatcher::Init(const std::vector<ShapeGear>& gears, const ShapeDispatchOptions& options)
+{
+    if (gears.empty() || gears.size() > MAX_SHAPE_GEAR_NUM) {
+        FMK_LOGE("gear num %zu is invalid.", gears.size());
+        return INVALID_PARAM;
+    }
+    options_ = options;
+    gears_.clear();
+    exactGears_.clear();
+
+    for (const auto& shape : gears) {
+        if (shape.inputDescs.empty() || shape.inputDescs.size() != gears[0].inputDescs.size() ||
+            !IsFixedShape(shape.inputDescs) || !IsFixedShape(shape.outputDescs)) {
+            FMK_LOGE("gear shape is invalid.");
+            return INVALID_PARAM;
+        }
+        Gear gear;
+        gear.shape = shape;
+        for (const auto& desc : shape.inputDescs) {
+            gear.elementNum += GetElementNum(desc.dims);
+        }
+        gear.inputPool = make_shared_nothrow<TensorSetPool>(shape.inputDescs, MAX_POOLED_TENSOR_SETS);
+        gear.outputPool = make_shared_nothrow<TensorSetPool>(shape.outputDescs, MAX_POOLED_TENSOR_SETS);
+        HIAI_EXPECT_NOT_NULL_R(gear.inputPool, MEMORY_EXCEPTION);
+        HIAI_EXPECT_NOT_NULL_R(gear.outputPool, MEMORY_EXCEPTION);
+        gears_.push_back(std::move(gear));
+    }
+    std::stable_sort(gears_.begin(), gears_.end(),
+        [](const Gear& lhs, const Gear& rhs) { return lhs.elementNum < rhs.elementNum; });
+
+    for (size_t i = 0; i < gears_.size(); i++) {
+        uint64_t hash = FNV_OFFSET_BASIS;
+        for (const auto& desc : gears_[i].shape.inputDescs) {
+            hash = HashDims(hash, desc.dims);
+        }
+        exactGears_.emplace(hash, i);
+    }
+    return SUCCESS;
+}
+
+size_t ShapeDispatcher::FindExactGear(const TensorBuffers& inputs) const
+{
+    uint64_t hash = FNV_OFFSET_BASIS;
+    for (const auto& input : inputs) {
+        hash = HashDims(hash, input->GetTensorDesc().dims);
+    }
+    auto range = exactGears_.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        const auto& descs = gears_[it->second].shape.inputDescs;
+        bool matched = descs.size() == inputs.size();
+        for (size_t i = 0; matched && i < inputs.size(); i++) {
+            matched = descs[i].dims == inputs[i]->GetTensorDesc().dims;
+        }
+        if (matched) {
+            return it->second;
+        }
+    }
+    return gears_.size();
+}
+
+size_t ShapeDispatcher::FindPaddingGear(const TensorBuffers& inputs) const
+{
+    for (size_t index = 0; index < gears_.size(); index++) {
+        const auto& descs = gears_[index].shape.inputDescs;
+        bool fit = descs.size() == inputs.size();
+        for (size_t i = 0; fit && i < inputs.size(); i++) {
+            const std::vector<int32_t>& dims = inputs[i]->GetTensorDesc().dims;
+            fit = !dims.empty() && dims.size() == descs[i].dims.size();
+            for (size_t d = 0; fit && d < dims.size(); d++) {
+                fit = dims[d] > 0 && dims[d] <= descs[i].dims[d];
+            }
+        }
+        if (fit) {
+            return index;
+        }
+    }
+    return gears_.size();
+}
+
+Status ShapeDispatcher::PadInputs(const TensorBuffers& inputs, Gear& gear, TensorBuffers& gearInputs)
+{
+    HIAI_EXPECT_EXEC(gear.inputPool->Acquire(gearInputs));
+    for (size_t i = 0; i < inputs.size(); i++) {
+        Status ret = PadCopy(*inputs[i], *gearInputs[i]);
+        if (ret != SUCCESS) {
+            FMK_LOGE("pad input %zu failed.", i);
+            gearInputs.clear();
+            return ret;
+        }
+    }
+    return SUCCESS;
+}
+
+Status ShapeDispatcher::Dispatch(const TensorBuffers& inputs, TensorBuffers& gearInputs, TensorBuffers& outputs)
+{
+    for (const auto& input : inputs) {
+        HIAI_EXPECT_NOT_NULL_R(input, INVALID_PARAM);
+    }
+
+    size_t index = FindExactGear(inputs);
+    bool needPad = false;
+    if (index == gears_.size() && options_.padToLargerGear) {
+        index = FindPaddingGear(inputs);
+        needPad = true;
+    }
+    if (index == gears_.size()) {
+        FMK_LOGE("input shape matches no gear.");
+        return INVALID_PARAM;
+    }
+
+    Gear& gear = gears_[index];
+    if (needPad) {
+        HIAI_EXPECT_EXEC(PadInputs(inputs, gear, gearInputs));
+    } else {
+        gearInputs.clear();
+    }
+    if (outputs.empty()) {
+        HIAI_EXPECT_EXEC(gear.outputPool->Acquire(outputs));
+    }
+    return SUCCESS;
+}
+
+Status GetShapeGears(const char* modelFile, std::vector<ShapeGear>& gears)
+{
+    HIAI_EXPECT_NOT_NULL_R(modelFile, INVALID_PARAM);
+    gears.clear();
+    for (size_t i = 0; i < MAX_SHAPE_GEAR_NUM; i++) {
+        std::shared_ptr<IBuiltModelExt> builtModel =
+            IBuiltModelExt::RestoreFromFile(modelFile, static_cast<uint8_t>(i));
+        if (builtModel == nullptr) {
+            break;
+        }
+        ShapeGear gear;
+        gear.inputDescs = builtModel->GetInputTensorDescs();
+        gear.outputDescs = builtModel->GetOutputTensorDescs();
+        gears.push_back(std::move(gear));
+    }
+    if (gears.empty()) {
+        FMK_LOGE("no gear restored from %s.", modelFile);
+        return FAILURE;
+    }
+    return SUCCESS;
+}
+} // namespace hiai
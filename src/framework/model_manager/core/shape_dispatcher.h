@@ -0,0 +1,65 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FRAMEWORK_MODEL_MANAGER_SHAPE_DISPATCHER_H
+#define FRAMEWORK_MODEL_MANAGER_SHAPE_DISPATCHER_H
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "model_manager/shape_gear.h"
+#include "tensor/nd_tensor_buffer.h"
+#include "tensor_set_pool.h"
+
+namespace hiai {
+using TensorBuffers = std::vector<std::shared_ptr<INDTensorBuffer>>;
+
+// 按输入shape选择档位, 档位查找表及各档位的输出在登记时准备好
+class ShapeDispatcher {
+public:
+    ShapeDispatcher() = default;
+    ~ShapeDispatcher() = default;
+
+    Status Init(const std::vector<ShapeGear>& gears, const ShapeDispatchOptions& options);
+
+    /*
+     * 选择档位, gearInputs为实际送入推理的输入(补零时为档位大小的拷贝, 否则即inputs);
+     * outputs为空时填入该档位的输出
+     */
+    Status Dispatch(const TensorBuffers& inputs, TensorBuffers& gearInputs, TensorBuffers& outputs);
+
+private:
+    struct Gear {
+        ShapeGear shape;
+        size_t elementNum {0};
+        // 补零输入及输出被调用者全部释放后归还复用, 池自带锁, 并发Run可直接取用
+        std::shared_ptr<TensorSetPool> inputPool;
+        std::shared_ptr<TensorSetPool> outputPool;
+    };
+
+    size_t FindExactGear(const TensorBuffers& inputs) const;
+    size_t FindPaddingGear(const TensorBuffers& inputs) const;
+    Status PadInputs(const TensorBuffers& inputs, Gear& gear, TensorBuffers& gearInputs);
+
+private:
+    ShapeDispatchOptions options_;
+    // 按元素总数升序, 补零时取第一个能容纳输入的档位
+    std::vector<Gear> gears_;
+    // 输入dims的哈希到档位下标, 查找时不分配内存, 命中后再逐维校验
+    std::multimap<uint64_t, size_t> exactGears_;
+};
+} // namespace hiai
+#endif // FRAMEWORK_MODEL_MANAGER_SHAPE_DISPATCHER_H
@@ -0,0 +1,160 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "shared_mem_pool_impl.h"
+
+#include <iterator>
+
+#include "infra/base/assertion.h"
+#include "infra/base/securestl.h"
+
+#include "framework/infra/log/log.h"
+
+namespace hiai {
+namespace {
+const size_t MIN_SIZE_CLASS = 4096;
+// 每个2的幂区间划分的档位数, 内部碎片不超过25%
+const size_t CLASSES_PER_DOUBLING = 4;
+
+std::pair<int, int> GetBlockKey(const std::vector<NativeHandle>& handles)
+{
+    return std::make_pair(handles[0].fd, handles[0].offset);
+}
+} // namespace
+
+SharedMemPool::SharedMemPool(
+    const std::shared_ptr<ISharedMemAllocator>& allocator, const SharedMemPoolOptions& options)
+    : allocator_(allocator), options_(options)
+{
+}
+
+SharedMemPool::~SharedMemPool()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    Trim(0);
+}
+
+size_t SharedMemPool::GetSizeClass(size_t size)
+{
+    if (size <= MIN_SIZE_CLASS) {
+        return MIN_SIZE_CLASS;
+    }
+    size_t power = MIN_SIZE_CLASS;
+    while (power * 2 < size) {
+        power *= 2;
+    }
+    size_t step = power / CLASSES_PER_DOUBLING;
+    return (size + step - 1) / step * step;
+}
+
+std::vector<NativeHandle> SharedMemPool::Allocate(size_t size)
+{
+    if (size == 0) {
+        return {};
+    }
+    size_t classSize = GetSizeClass(size);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.allocateNum++;
+    std::vector<NativeHandle> handles;
+    auto it = freeBlocks_.find(classSize);
+    if (it != freeBlocks_.end()) {
+        handles = std::move(it->second);
+        freeBlocks_.erase(it);
+        stats_.cachedBytes -= classSize;
+        stats_.cachedBlockNum--;
+        stats_.hitNum++;
+    } else {
+        handles = allocator_->Allocate(classSize);
+        if (handles.empty() && !freeBlocks_.empty()) {
+            // 其他档位的缓存可能占住了共享内存, 全部归还后重试
+            Trim(0);
+            handles = allocator_->Allocate(classSize);
+        }
+        if (handles.empty()) {
+            FMK_LOGE("allocate shared mem of %zu bytes failed.", classSize);
+            return {};
+        }
+    }
+
+    Block& block = inUse_[GetBlockKey(handles)];
+    block.classSize = classSize;
+    block.requestedSize = size;
+    block.handles = handles;
+    stats_.inUseBytes += classSize;
+    stats_.requestedBytes += size;
+    return handles;
+}
+
+void SharedMemPool::Free(std::vector<NativeHandle>& handles)
+{
+    if (handles.empty()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = inUse_.find(GetBlockKey(handles));
+    if (it == inUse_.end()) {
+        FMK_LOGW("shared mem is not allocated by pool, free directly.");
+        allocator_->Free(handles);
+        return;
+    }
+
+    Block& block = it->second;
+    stats_.inUseBytes -= block.classSize;
+    stats_.requestedBytes -= block.requestedSize;
+    stats_.cachedBytes += block.classSize;
+    stats_.cachedBlockNum++;
+    freeBlocks_.emplace(block.classSize, std::move(block.handles));
+    inUse_.erase(it);
+
+    if (options_.maxCachedBytes != 0) {
+        Trim(options_.maxCachedBytes);
+    }
+}
+
+void SharedMemPool::Trim(uint64_t limit)
+{
+    while (stats_.cachedBytes > limit && !freeBlocks_.empty()) {
+        auto largest = std::prev(freeBlocks_.end());
+        allocator_->Free(largest->second);
+        stats_.cachedBytes -= largest->first;
+        stats_.cachedBlockNum--;
+        freeBlocks_.erase(largest);
+    }
+}
+
+void SharedMemPool::GetStats(SharedMemPoolStats& stats)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats = stats_;
+}
+
+std::shared_ptr<ISharedMemAllocator> CreatePooledSharedMemAllocator(
+    const std::shared_ptr<ISharedMemAllocator>& allocator, const SharedMemPoolOptions& options)
+{
+    HIAI_EXPECT_NOT_NULL_R(allocator, nullptr);
+    return make_shared_nothrow<SharedMemPool>(allocator, options);
+}
+
+Status GetSharedMemPoolStats(const std::shared_ptr<ISharedMemAllocator>& allocator, SharedMemPoolStats& stats)
+{
+    SharedMemPool* pool = dynamic_cast<SharedMemPool*>(allocator.get());
+    HIAI_EXPECT_NOT_NULL_R(pool, INVALID_PARAM);
+    pool->GetStats(stats);
+    return SUCCESS;
+}
+} // namespace hiai
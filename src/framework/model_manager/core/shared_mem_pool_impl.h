@@ -0,0 +1,60 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FRAMEWORK_MODEL_MANAGER_SHARED_MEM_POOL_IMPL_H
+#define FRAMEWORK_MODEL_MANAGER_SHARED_MEM_POOL_IMPL_H
+
+#include <map>
+#include <mutex>
+#include <utility>
+
+#include "model_manager/shared_mem_pool.h"
+
+namespace hiai {
+class SharedMemPool : public ISharedMemAllocator {
+public:
+    SharedMemPool(const std::shared_ptr<ISharedMemAllocator>& allocator, const SharedMemPoolOptions& options);
+    ~SharedMemPool() override;
+
+    std::vector<NativeHandle> Allocate(size_t size) override;
+    void Free(std::vector<NativeHandle>& handles) override;
+
+    void GetStats(SharedMemPoolStats& stats);
+
+    static size_t GetSizeClass(size_t size);
+
+private:
+    struct Block {
+        size_t classSize {0};
+        size_t requestedSize {0};
+        std::vector<NativeHandle> handles;
+    };
+
+    // 归还缓存中最大的块, 直到缓存不超过limit
+    void Trim(uint64_t limit);
+
+private:
+    std::shared_ptr<ISharedMemAllocator> allocator_;
+    SharedMemPoolOptions options_;
+
+    std::mutex mutex_;
+    // 已分配出去的块, 按首个handle的(fd, offset)索引
+    std::map<std::pair<int, int>, Block> inUse_;
+    // 空闲块按档位大小索引
+    std::multimap<size_t, std::vector<NativeHandle>> freeBlocks_;
+    SharedMemPoolStats stats_;
+};
+} // namespace hiai
+#endif // FRAMEWORK_MODEL_MANAGER_SHARED_MEM_POOL_IMPL_H
@@ -0,0 +1,61 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "tensor_set_pool.h"
+
+#include "infra/base/assertion.h"
+
+namespace hiai {
+TensorSetPool::TensorSetPool(const std::vector<NDTensorDesc>& descs, size_t maxCached)
+    : descs_(descs), maxCached_(maxCached), freeBuffers_(descs.size())
+{
+}
+
+void TensorSetPool::Returner::operator()(INDTensorBuffer*)
+{
+    pool->Release(index, std::move(buffer));
+}
+
+Status TensorSetPool::Acquire(std::vector<std::shared_ptr<INDTensorBuffer>>& tensors)
+{
+    tensors.clear();
+    tensors.reserve(descs_.size());
+    for (size_t i = 0; i < descs_.size(); i++) {
+        std::shared_ptr<INDTensorBuffer> buffer = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!freeBuffers_[i].empty()) {
+                buffer = std::move(freeBuffers_[i].back());
+                freeBuffers_[i].pop_back();
+            }
+        }
+        if (buffer == nullptr) {
+            buffer = CreateNDTensorBuffer(descs_[i]);
+            HIAI_EXPECT_NOT_NULL_R(buffer, MEMORY_EXCEPTION);
+        }
+        INDTensorBuffer* raw = buffer.get();
+        tensors.push_back(std::shared_ptr<INDTensorBuffer>(raw, Returner {shared_from_this(), i, std::move(buffer)}));
+    }
+    return SUCCESS;
+}
+
+void TensorSetPool::Release(size_t index, std::shared_ptr<INDTensorBuffer>&& buffer)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (freeBuffers_[index].size() < maxCached_) {
+        freeBuffers_[index].push_back(std::move(buffer));
+    }
+}
+} // namespace hiai
@@ -0,0 +1,60 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FRAMEWORK_MODEL_MANAGER_TENSOR_SET_POOL_H
+#define FRAMEWORK_MODEL_MANAGER_TENSOR_SET_POOL_H
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "tensor/nd_tensor_buffer.h"
+#include "base/error_types.h"
+
+namespace hiai {
+/*
+ * 按一组描述分配tensor并缓存复用. 取出的tensor在最后一个引用释放时由删除器归还,
+ * 归还与取出在同一把锁下完成, 使用者在释放前的读写对下一次取出者可见.
+ * 池由取出的tensor共同持有, 可以晚于创建者析构.
+ */
+class TensorSetPool : public std::enable_shared_from_this<TensorSetPool> {
+public:
+    // maxCached为每个描述最多缓存的空闲tensor数
+    TensorSetPool(const std::vector<NDTensorDesc>& descs, size_t maxCached);
+    ~TensorSetPool() = default;
+    TensorSetPool(const TensorSetPool&) = delete;
+    TensorSetPool& operator=(const TensorSetPool&) = delete;
+
+    Status Acquire(std::vector<std::shared_ptr<INDTensorBuffer>>& tensors);
+
+private:
+    struct Returner {
+        std::shared_ptr<TensorSetPool> pool;
+        size_t index;
+        std::shared_ptr<INDTensorBuffer> buffer;
+        void operator()(INDTensorBuffer*);
+    };
+
+    void Release(size_t index, std::shared_ptr<INDTensorBuffer>&& buffer);
+
+private:
+    std::vector<NDTensorDesc> descs_;
+    size_t maxCached_;
+    std::mutex mutex_;
+    // 下标与descs_一一对应
+    std::vector<std::vector<std::shared_ptr<INDTensorBuffer>>> freeBuffers_;
+};
+} // namespace hiai
+#endif // FRAMEWORK_MODEL_MANAGER_TENSOR_SET_POOL_H
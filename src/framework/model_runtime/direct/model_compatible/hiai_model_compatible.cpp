@@ -32,11 +32,13 @@
 #include "framework/graph/core/cgraph/graph_bypasser.h"
 #include "framework/graph/core/node/node_spec.h"
 #include "framework/graph/core/node/node_walker.h"
+#include "framework/graph/core/node/node_sub_graph.h"
 #include "framework/graph/core/edge/edge.h"
 #include "framework/graph/utils/attr_utils.h"
 #include "framework/graph/utils/graph_utils.h"
 #include "framework/graph/utils/op_desc_utils.h"
 #include "framework/graph/utils/tensor_utils.h"
+#include "framework/graph/debug/ge_graph_attr_define.h"
 #include "framework/infra/log/log.h"
 #include "framework/c/hiai_version.h"
 #include "framework/c/hiai_error_types.h"
@@ -235,11 +237,26 @@ HIAI_Status RemakeUnmergedIrGraph(ge::ComputeGraphPtr graph, hiai::ModelPartitio
     };
     HIAI_EXPECT_EXEC(GraphUtils::WalkAllSubGraphNodes(*graph, visitor));
     (void)graph->DelAttr(WEIGHT_MERGED);
+    (void)graph->DelAttr(hiai::SRC_MERGED_WEIGHT_ADDR);
+    (void)graph->DelAttr(hiai::SRC_MERGED_WEIGHT_SIZE);
     IS_MERGED = false;
     return HIAI_SUCCESS;
 }
 
-static HIAI_Status UnmergedWeightGraph(const OmFileLoadHelper& omFileHelper, ge::ComputeGraphPtr graph, bool& isChanged)
+bool HasSubGraph(ge::ComputeGraphPtr graph)
+{
+    bool hasSubGraph = false;
+    auto visitor = [&hasSubGraph](ge::Node& node) {
+        if (node.ROLE(NodeSubGraph).SubGraphsSize() != 0) {
+            hasSubGraph = true;
+        }
+        return hiai::SUCCESS;
+    };
+    (void)graph->ROLE(GraphListWalker).WalkAllNodes(visitor);
+    return hasSubGraph;
+}
+
+static HIAI_Status SplitMergedWeight(const OmFileLoadHelper& omFileHelper, ge::ComputeGraphPtr graph, bool& isChanged)
 {
     hiai::ModelPartition partitionWeightData;
     HIAI_EXPECT_EXEC(omFileHelper.GetModelPartition(hiai::ModelPartitionType::WEIGHTS_DATA, partitionWeightData));
@@ -249,6 +266,44 @@ static HIAI_Status UnmergedWeightGraph(const OmFileLoadHelper& omFileHelper, ge:
     return HIAI_SUCCESS;
 }
 
+/*
+ * 100.320之外的ROM支持合并权重, 此时不立即拆分: Const仍通过merged_offset引用输入模型中的WEIGHTS_DATA,
+ * 仅记录合并权重的地址和大小. IRTransformer调用第一个算子转换函数前整图拆分, 没有算子需要转换时不拷贝权重.
+ */
+static HIAI_Status UnmergedWeightGraph(
+    const OmFileLoadHelper& omFileHelper, const std::string& version, ge::ComputeGraphPtr graph, bool& isChanged)
+{
+    if (IsNeedBuildUnmergedIrModel(version) || HasSubGraph(graph)) {
+        return SplitMergedWeight(omFileHelper, graph, isChanged);
+    }
+
+    hiai::ModelPartition partitionWeightData;
+    HIAI_EXPECT_EXEC(omFileHelper.GetModelPartition(hiai::ModelPartitionType::WEIGHTS_DATA, partitionWeightData));
+
+    (void)ge::AttrUtils::SetInt(graph, hiai::SRC_MERGED_WEIGHT_ADDR,
+        static_cast<int64_t>(reinterpret_cast<uintptr_t>(partitionWeightData.data)));
+    (void)ge::AttrUtils::SetInt(graph, hiai::SRC_MERGED_WEIGHT_SIZE, static_cast<int64_t>(partitionWeightData.size));
+    return HIAI_SUCCESS;
+}
+
+static void FinishUnmergedWeightGraph(ge::ComputeGraphPtr graph, bool& isChanged)
+{
+    if (!IS_MERGED) {
+        return;
+    }
+    if (graph->HasAttr(hiai::SRC_MERGED_WEIGHT_ADDR)) {
+        // 没有算子转换修改权重, 保留合并权重partition, 地址属性不能序列化到模型中
+        (void)graph->DelAttr(hiai::SRC_MERGED_WEIGHT_ADDR);
+        (void)graph->DelAttr(hiai::SRC_MERGED_WEIGHT_SIZE);
+        return;
+    }
+    if (!graph->HasAttr(WEIGHT_MERGED)) {
+        // 权重已在算子转换中按需拆分到各Const中
+        IS_MERGED = false;
+        isChanged = true;
+    }
+}
+
 static bool IsNeedForwardCompatible(const std::string& version)
 {
     if (version.compare(0, ROM_VERSION_CHIP_LEN, supportExtremeVersion, 0, ROM_VERSION_CHIP_LEN) <= 0 ||
@@ -519,7 +574,7 @@ HIAI_Status MakeModelCompatible(OmFileLoadHelper& omFileHelper, ge::Model& model
     }
 
     if (IsNeedUnmergedWeight(omFileHelper, romVersion, graph)) {
-        if (UnmergedWeightGraph(omFileHelper, graph, isChanged) != HIAI_SUCCESS) {
+        if (UnmergedWeightGraph(omFileHelper, romVersion, graph, isChanged) != HIAI_SUCCESS) {
             FMK_LOGE("UnmergedWeightGraph failed.");
             return HIAI_FAILURE;
         }
@@ -531,6 +586,12 @@ HIAI_Status MakeModelCompatible(OmFileLoadHelper& omFileHelper, ge::Model& model
     }
 
     if (isOneSideQuant) {
+        // 反量化会改写权重, 需先拆分合并权重
+        if (graph->HasAttr(hiai::SRC_MERGED_WEIGHT_ADDR) &&
+            SplitMergedWeight(omFileHelper, graph, isChanged) != HIAI_SUCCESS) {
+            FMK_LOGE("SplitMergedWeight failed.");
+            return HIAI_FAILURE;
+        }
         if (hiai::QuantizeUtil::DequantizeComputeGraph(*graph) != hiai::SUCCESS) {
             FMK_LOGE("dequant IR graph failed.");
             return HIAI_FAILURE;
@@ -542,6 +603,7 @@ HIAI_Status MakeModelCompatible(OmFileLoadHelper& omFileHelper, ge::Model& model
         FMK_LOGE("ForwardCompatible failed.");
         return HIAI_FAILURE;
     }
+    FinishUnmergedWeightGraph(graph, isChanged);
 
     // 设置main graph,并对main graph 进行序列化,返回buffer到 mainGraph_model_中
     model.SetGraph(ge::GraphUtils::CreateGraphFromComputeGraph(graph));
@@ -577,121 +639,109 @@ void DestroyBuffer(HIAI_MemBuffer* membuf)
     ((void (*)(HIAI_MemBuffer*))destroyFun)(membuf);
 }
 
-bool JointModelBuffer(const HIAI_MemBuffer* input, std::vector<hiai::ModelPartition>& partitions, size_t partitionNum,
-    size_t modelDefSize, HIAI_MemBuffer** output)
+// 兼容后保留的partition直接引用输入buffer中的数据, 仅在写出时拷贝一次
+void CollectReservedPartitions(const hiai::OmFileLoadHelper& omFileHelper, std::vector<hiai::ModelPartition>& partitions)
 {
-    if (partitionNum != partitions.size() + 1) {
-        return false;
-    }
-    size_t partTableSize = sizeof(uint32_t) + sizeof(hiai::ModelPartitionMemInfo) * partitionNum;
-    size_t headTotalSize = sizeof(hiai::ModelFileHeader) + partTableSize;
-    size_t partitionSize = modelDefSize;
-    for (auto& partition : partitions) {
-        partitionSize += partition.size;
-    }
-    size_t outBufferSize = headTotalSize + partitionSize;
-
-    HIAI_MemBuffer* outputBuffer = CreateBuffer(outBufferSize);
-    HIAI_EXPECT_NOT_NULL_R(outputBuffer, false);
-
-    // copy model header + parttable
-    if (memcpy_s(outputBuffer->data, headTotalSize, input->data, headTotalSize) != 0) {
-        FMK_LOGE("memcpy_s modelHead failed.");
-        DestroyBuffer(outputBuffer);
-        return false;
+    hiai::ModelPartition opDeviceCfgBuff;
+    if (omFileHelper.GetModelPartition(hiai::MODEL_CONFIG, opDeviceCfgBuff) == hiai::SUCCESS) {
+        FMK_LOGI("current model contain MODEL_CONFIG partition");
+        partitions.push_back(opDeviceCfgBuff);
     }
 
-    uintptr_t modelBasePtr = reinterpret_cast<uintptr_t>(outputBuffer->data);
-    // rewrite header info
-    hiai::ModelFileHeader* modelHeader = reinterpret_cast<hiai::ModelFileHeader*>(modelBasePtr);
-    if (modelHeader == nullptr) {
-        FMK_LOGE("modelHeader is nullptr.");
-        DestroyBuffer(outputBuffer);
-        return false;
+    if (IS_MERGED) {
+        hiai::ModelPartition weightMergedBuff;
+        if (omFileHelper.GetModelPartition(hiai::WEIGHTS_DATA, weightMergedBuff) == hiai::SUCCESS) {
+            partitions.push_back(weightMergedBuff);
+        }
     }
-    modelHeader->length = partitionSize + partTableSize;
+}
 
-    // rewrite parttable
-    hiai::ModelPartitionTable* partTable =
-        reinterpret_cast<hiai::ModelPartitionTable*>(modelBasePtr + sizeof(hiai::ModelFileHeader));
-    partTable->partition[0].memSize = modelDefSize;
-    if (partitionNum >= 2) {
-        size_t offset = partTable->partition[0].memOffset + partTable->partition[0].memSize;
-        uint8_t* newModelConfig = (uint8_t*)(outputBuffer->data) + modelDefSize + headTotalSize;
-
-        for (size_t index = 1; index < partitionNum; index++) {
-            partTable->partition[index].memOffset = offset;
-            partTable->partition[index].memSize = partitions[index - 1].size;
-            partTable->partition[index].type = partitions[index - 1].type;
-
-            if (memcpy_s((void*)newModelConfig, partitions[index - 1].size, partitions[index - 1].data,
-                partitions[index - 1].size) != 0) {
-                FMK_LOGE("memcpy_s modelconfig failed.");
-                DestroyBuffer(outputBuffer);
-                return false;
-            }
-            offset += partitions[index - 1].size;
-            newModelConfig += partitions[index - 1].size;
+bool WritePartitions(const std::vector<hiai::ModelPartition>& partitions, hiai::ModelPartitionTable* partTable,
+    uint8_t* dst, size_t dstSize, uint32_t offset)
+{
+    for (size_t index = 0; index < partitions.size(); index++) {
+        const hiai::ModelPartition& partition = partitions[index];
+        partTable->partition[index + 1].type = partition.type;
+        partTable->partition[index + 1].memOffset = offset;
+        partTable->partition[index + 1].memSize = partition.size;
+
+        if (partition.size == 0) {
+            continue;
+        }
+        if (memcpy_s(dst, dstSize, partition.data, partition.size) != 0) {
+            FMK_LOGE("memcpy_s partition %d failed.", partition.type);
+            return false;
         }
+        dst += partition.size;
+        dstSize -= partition.size;
+        offset += partition.size;
     }
-
-    partTable->num = partitionNum;
-    *output = outputBuffer;
     return true;
 }
 
-bool JointModel(
-    hiai::OmFileLoadHelper& omFileHelper, const HIAI_MemBuffer* input, const void* modelDef, HIAI_MemBuffer** output)
+/*
+ * 单次遍历生成兼容后的模型: 按最终布局一次性申请输出buffer, 重写模型头和partition表,
+ * MODEL_DEF直接序列化到目标位置, 其余partition从输入buffer原位拷贝, 不产生中间整模型拷贝.
+ */
+bool JointModel(hiai::OmFileLoadHelper& omFileHelper, const void* modelDef, HIAI_MemBuffer** output)
 {
-    size_t partitionNum = 1;
     std::vector<hiai::ModelPartition> partitions;
-    hiai::ModelPartition opDeviceCfgBuff;
-    Status status = omFileHelper.GetModelPartition(hiai::MODEL_CONFIG, opDeviceCfgBuff);
-    if (status == hiai::SUCCESS) {
-        FMK_LOGI("current model contain MODEL_CONFIG partition");
-        partitionNum++;
-        partitions.push_back(opDeviceCfgBuff);
-    }
-
-    if (IS_MERGED) {
-        hiai::ModelPartition weightMergedBuff;
-        status = omFileHelper.GetModelPartition(hiai::WEIGHTS_DATA, weightMergedBuff);
-        if (status == hiai::SUCCESS) {
-            partitionNum++;
-            partitions.push_back(weightMergedBuff);
-        }
-    }
+    CollectReservedPartitions(omFileHelper, partitions);
 
     hiai::ModelSerializeWrapper modelSerialize;
     size_t modelDefSize = 0;
-    bool ret = modelSerialize.GetModelDefBufferSize(modelDef, modelDefSize);
-    if (!ret) {
+    if (!modelSerialize.GetModelDefBufferSize(modelDef, modelDefSize)) {
         FMK_LOGE("GetModelDefBufferSize failed");
         return false;
     }
 
+    size_t partitionNum = partitions.size() + 1;
     size_t partTableSize = sizeof(uint32_t) + sizeof(hiai::ModelPartitionMemInfo) * partitionNum;
     size_t headTotalSize = sizeof(hiai::ModelFileHeader) + partTableSize;
-
-    if (!JointModelBuffer(input, partitions, partitionNum, modelDefSize, output)) {
-        FMK_LOGE("JointModelBuffer failed");
+    size_t partitionSize = modelDefSize;
+    for (const auto& partition : partitions) {
+        partitionSize += partition.size;
+    }
+    if (partitionSize + partTableSize > UINT32_MAX) {
+        FMK_LOGE("compatible model size is too large.");
         return false;
     }
 
+    HIAI_MemBuffer* outputBuffer = CreateBuffer(headTotalSize + partitionSize);
+    HIAI_EXPECT_NOT_NULL_R(outputBuffer, false);
+
+    uint8_t* modelBasePtr = static_cast<uint8_t*>(outputBuffer->data);
+    // rewrite header info
+    hiai::ModelFileHeader* modelHeader = reinterpret_cast<hiai::ModelFileHeader*>(modelBasePtr);
+    *modelHeader = *omFileHelper.GetModelFileHeader();
+    modelHeader->length = static_cast<uint32_t>(partitionSize + partTableSize);
+
+    // rewrite parttable
+    hiai::ModelPartitionTable* partTable =
+        reinterpret_cast<hiai::ModelPartitionTable*>(modelBasePtr + sizeof(hiai::ModelFileHeader));
+    partTable->num = static_cast<uint32_t>(partitionNum);
+    partTable->partition[0].type = hiai::MODEL_DEF;
+    partTable->partition[0].memOffset = 0;
+    partTable->partition[0].memSize = static_cast<uint32_t>(modelDefSize);
+
     // serialize modeldef to remaked-model buffer
-    ret = modelSerialize.SerializeModelDefToBuffer(modelDef,
-        reinterpret_cast<void*>(reinterpret_cast<uintptr_t>((*output)->data) + headTotalSize),
-        (*output)->size - headTotalSize);
-    if (!ret) {
+    if (!modelSerialize.SerializeModelDefToBuffer(modelDef, modelBasePtr + headTotalSize, modelDefSize)) {
         FMK_LOGE("SerializeModelDefToBuffer fail.");
-        DestroyBuffer(*output);
+        DestroyBuffer(outputBuffer);
         return false;
     }
+
+    if (!WritePartitions(partitions, partTable, modelBasePtr + headTotalSize + modelDefSize,
+        partitionSize - modelDefSize, static_cast<uint32_t>(modelDefSize))) {
+        DestroyBuffer(outputBuffer);
+        return false;
+    }
+
+    *output = outputBuffer;
     return true;
 }
 
-HIAI_Status SaveModel(
-    OmFileLoadHelper& omFileHelper, const HIAI_MemBuffer* input, ge::Model& model, HIAI_MemBuffer** output)
+HIAI_Status SaveModel(OmFileLoadHelper& omFileHelper, ge::Model& model, HIAI_MemBuffer** output)
 {
     ModelSerializeWrapper modelSerialize;
     void* modelDef = nullptr;
@@ -700,8 +750,10 @@ HIAI_Status SaveModel(
         FMK_LOGE("SaveModelToModelDef modelDef is nullptr");
         return HIAI_FAILURE;
     }
+    // graph的权重已序列化到modelDef中, 提前释放以降低峰值内存
+    model.SetGraph(ge::Graph());
 
-    ret = JointModel(omFileHelper, input, modelDef, output);
+    ret = JointModel(omFileHelper, modelDef, output);
     modelSerialize.ReleaseModelDef(modelDef);
     modelDef = nullptr;
     if (!ret) {
@@ -775,6 +827,9 @@ HIAI_Status MakeCompatibleIRAPI(const HIAI_MemBuffer* input, HIAI_MemBuffer** ou
         FMK_LOGE("SaveModelToModelDef modelDef is nullptr");
         return HIAI_FAILURE;
     }
+    // graph的权重已序列化到modelDef中, 提前释放以降低峰值内存
+    graph = nullptr;
+    irModel.SetGraph(ge::Graph());
 
     HIAI_Status ret = HIAI_FAILURE;
     do {
@@ -840,7 +895,7 @@ HIAI_Status HIAI_MakeDirectCompatibleModel(const HIAI_MemBuffer* input, HIAI_Mem
     }
 
     if (isChanged) {
-        if (SaveModel(omFileHelper, input, model, output) != HIAI_SUCCESS) {
+        if (SaveModel(omFileHelper, model, output) != HIAI_SUCCESS) {
             FMK_LOGE("SaveModel failed.");
             HIAI_Foundation_Deinit();
             return HIAI_FAILURE;
@@ -0,0 +1,555 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "tensor/aipp_cpu_executor.h"
+#include "aipp_cpu_executor_impl.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "aipp_cpu_kernel.h"
+#include "tensor/image/image_format_desc.h"
+#include "tensor/image/image_tensor_buffer_impl.h"
+#include "framework/infra/log/log.h"
+#include "infra/base/assertion.h"
+
+namespace hiai {
+namespace {
+const uint32_t AIPP_MAX_CHANNEL = 4;
+const uint32_t CSC_CHANNEL = 3;
+const int32_t CSC_SHIFT = 8;
+const int32_t CSC_ROUND = 1 << (CSC_SHIFT - 1);
+const int32_t PIXEL_MAX = 255;
+const uint32_t OUTPUT_DIM_NUM = 4;
+
+struct CscPlan {
+    bool enable {false};
+    int32_t matrix[CSC_CHANNEL][CSC_CHANNEL] {};
+    int32_t inBias[CSC_CHANNEL] {};
+    int32_t outBias[CSC_CHANNEL] {};
+};
+
+struct AippContext {
+    const uint8_t* planes[AIPP_CPU_MAX_PLANE] {nullptr, nullptr};
+    size_t strides[AIPP_CPU_MAX_PLANE] {0, 0};
+    ImageFormat format {ImageFormat::INVALID};
+    const ImageFormatDesc* desc {nullptr};
+    uint32_t width {0};
+    uint32_t height {0};
+    bool rbuvSwap {false};
+    bool axSwap {false};
+    CscPlan csc;
+};
+
+struct BatchPlan {
+    uint32_t regionX {0};
+    uint32_t regionY {0};
+    uint32_t regionW {0};
+    uint32_t regionH {0};
+    uint32_t resizeW {0};
+    uint32_t resizeH {0};
+    uint32_t top {0};
+    uint32_t left {0};
+    uint32_t outH {0};
+    uint32_t outW {0};
+    float dtcSub[AIPP_MAX_CHANNEL] {};
+    float dtcScale[AIPP_MAX_CHANNEL] {};
+    float padValue[AIPP_MAX_CHANNEL] {};
+};
+
+const HIAI_MR_TensorAippBatchPara& GetBatchPara(const HIAI_MR_TensorAippCommPara& commPara, uint32_t batchIndex)
+{
+    return *reinterpret_cast<const HIAI_MR_TensorAippBatchPara*>(reinterpret_cast<const char*>(&commPara) +
+        sizeof(HIAI_MR_TensorAippCommPara) + sizeof(HIAI_MR_TensorAippBatchPara) * batchIndex);
+}
+
+// 不依赖编译器_Float16支持, 按IEEE 754 binary16位域解析
+float HalfToFloat(uint16_t bits)
+{
+    const uint32_t sign = (bits >> 15) & 0x1;
+    const int32_t exponent = (bits >> 10) & 0x1F;
+    const uint32_t mantissa = bits & 0x3FF;
+    float value = 0.0f;
+    if (exponent == 0) {
+        value = std::ldexp(static_cast<float>(mantissa), -24);
+    } else if (exponent == 0x1F) {
+        value = mantissa == 0 ? std::numeric_limits<float>::infinity() : std::numeric_limits<float>::quiet_NaN();
+    } else {
+        value = std::ldexp(static_cast<float>(mantissa + 0x400), exponent - 25);
+    }
+    return sign != 0 ? -value : value;
+}
+
+Status CheckImagePlanes(const AippCpuImage& image, const ImageFormatDesc& desc)
+{
+    if (image.batch != 1) {
+        FMK_LOGE("image with external planes only supports batch 1, but got %d.", image.batch);
+        return FAILURE;
+    }
+    for (uint32_t i = 0; i < desc.planeNum; ++i) {
+        HIAI_EXPECT_NOT_NULL(image.planes[i]);
+        uint64_t rowBytes = GetPlaneRowBytes(desc, i, static_cast<uint64_t>(image.width));
+        if (image.strides[i] < rowBytes) {
+            FMK_LOGE("plane %u stride %zu is less than row bytes %zu.", i, image.strides[i],
+                static_cast<size_t>(rowBytes));
+            return FAILURE;
+        }
+    }
+    return SUCCESS;
+}
+
+bool IsSrcSizeMatched(const AippCpuImage& image, const HIAI_MR_TensorAippCommPara& commPara)
+{
+    if (commPara.srcImageSizeW == 0 ||
+        (commPara.srcImageSizeW == image.width && commPara.srcImageSizeH == image.height)) {
+        return true;
+    }
+    // 带行跨度的图片, 下发AIPP时srcImageSize为存储宽高, 有效区域由crop裁出
+    return image.storageWidth > 0 && commPara.srcImageSizeW == image.storageWidth &&
+        commPara.srcImageSizeH == image.storageHeight;
+}
+
+Status CheckImage(
+    const AippCpuImage& image, const HIAI_MR_TensorAippCommPara& commPara, const ImageFormatDesc*& desc)
+{
+    if (image.planes[0] == nullptr) {
+        HIAI_EXPECT_NOT_NULL(image.data);
+    }
+    desc = GetImageFormatDesc(image.format);
+    if (desc == nullptr || desc->aippInputFormat == 0) {
+        FMK_LOGE("image format %d is not supported by cpu aipp.", static_cast<int32_t>(image.format));
+        return FAILURE;
+    }
+    if (commPara.inputFormat != 0 && commPara.inputFormat != desc->aippInputFormat) {
+        FMK_LOGE("aipp input format %u mismatch with image format %d.", commPara.inputFormat,
+            static_cast<int32_t>(image.format));
+        return FAILURE;
+    }
+    if (image.batch <= 0 || image.height <= 0 || image.width <= 0) {
+        FMK_LOGE("invalid image shape [%d, %d, %d].", image.batch, image.height, image.width);
+        return FAILURE;
+    }
+    if (!IsSrcSizeMatched(image, commPara)) {
+        FMK_LOGE("aipp src size [%d, %d] mismatch with image [%d, %d].", commPara.srcImageSizeW,
+            commPara.srcImageSizeH, image.width, image.height);
+        return FAILURE;
+    }
+    // 半平面/YUYV格式的UV按2像素共享, 仅支持偶数宽(高)
+    bool evenWidth = desc->chromaSubW > 1;
+    bool evenHeight = desc->chromaSubH > 1;
+    if ((evenWidth && image.width % 2 != 0) || (evenHeight && image.height % 2 != 0)) {
+        FMK_LOGE("odd image size [%d, %d] is not supported for format %d.", image.width, image.height,
+            static_cast<int32_t>(image.format));
+        return FAILURE;
+    }
+    if (image.batch != 1 && image.batch != commPara.batchNum) {
+        FMK_LOGE("image batch %d mismatch with aipp batch %u.", image.batch, commPara.batchNum);
+        return FAILURE;
+    }
+    if (image.planes[0] != nullptr) {
+        return CheckImagePlanes(image, *desc);
+    }
+    size_t frameSize = static_cast<size_t>(GetImageSize(*desc, image.height, image.width));
+    if (image.size < frameSize * static_cast<size_t>(image.batch)) {
+        FMK_LOGE("image size %zu is less than required %zu.", image.size, frameSize * image.batch);
+        return FAILURE;
+    }
+    return SUCCESS;
+}
+
+void InitCscPlan(const HIAI_MR_TensorAippCommPara& commPara, CscPlan& csc)
+{
+    csc.enable = commPara.cscSwitch != 0;
+    const int16_t matrix[CSC_CHANNEL][CSC_CHANNEL] = {
+        {commPara.cscMatrixR0C0, commPara.cscMatrixR0C1, commPara.cscMatrixR0C2},
+        {commPara.cscMatrixR1C0, commPara.cscMatrixR1C1, commPara.cscMatrixR1C2},
+        {commPara.cscMatrixR2C0, commPara.cscMatrixR2C1, commPara.cscMatrixR2C2}};
+    for (uint32_t i = 0; i < CSC_CHANNEL; ++i) {
+        for (uint32_t j = 0; j < CSC_CHANNEL; ++j) {
+            csc.matrix[i][j] = matrix[i][j];
+        }
+    }
+    csc.inBias[0] = commPara.cscInputBiasR0;
+    csc.inBias[1] = commPara.cscInputBiasR1;
+    csc.inBias[2] = commPara.cscInputBiasR2;
+    csc.outBias[0] = commPara.cscOutputBiasR0;
+    csc.outBias[1] = commPara.cscOutputBiasR1;
+    csc.outBias[2] = commPara.cscOutputBiasR2;
+}
+
+Status InitBatchPlan(const HIAI_MR_TensorAippBatchPara& batchPara, const AippContext& ctx, BatchPlan& plan)
+{
+    if (batchPara.rotateSwitch != 0) {
+        FMK_LOGE("rotation is not supported by cpu aipp.");
+        return FAILURE;
+    }
+    plan.regionW = ctx.width;
+    plan.regionH = ctx.height;
+    if (batchPara.cropSwitch != 0) {
+        if (batchPara.cropSizeW == 0 || batchPara.cropSizeH == 0 || batchPara.cropSizeW > ctx.width ||
+            batchPara.cropSizeH > ctx.height || batchPara.cropStartPosW > ctx.width - batchPara.cropSizeW ||
+            batchPara.cropStartPosH > ctx.height - batchPara.cropSizeH) {
+            FMK_LOGE("crop [%u, %u, %u, %u] is out of image [%u, %u].", batchPara.cropStartPosW,
+                batchPara.cropStartPosH, batchPara.cropSizeW, batchPara.cropSizeH, ctx.width, ctx.height);
+            return FAILURE;
+        }
+        plan.regionX = batchPara.cropStartPosW;
+        plan.regionY = batchPara.cropStartPosH;
+        plan.regionW = batchPara.cropSizeW;
+        plan.regionH = batchPara.cropSizeH;
+    }
+
+    plan.resizeW = plan.regionW;
+    plan.resizeH = plan.regionH;
+    if (batchPara.scfSwitch != 0) {
+        if (static_cast<uint32_t>(batchPara.scfInputSizeW) != plan.regionW ||
+            static_cast<uint32_t>(batchPara.scfInputSizeH) != plan.regionH || batchPara.scfOutputSizeW == 0 ||
+            batchPara.scfOutputSizeH == 0) {
+            FMK_LOGE("invalid resize [%d, %d] -> [%u, %u].", batchPara.scfInputSizeW, batchPara.scfInputSizeH,
+                batchPara.scfOutputSizeW, batchPara.scfOutputSizeH);
+            return FAILURE;
+        }
+        plan.resizeW = batchPara.scfOutputSizeW;
+        plan.resizeH = batchPara.scfOutputSizeH;
+    }
+
+    plan.outH = plan.resizeH;
+    plan.outW = plan.resizeW;
+    if (batchPara.paddingSwitch != 0) {
+        plan.top = batchPara.paddingSizeTop;
+        plan.left = batchPara.paddingSizeLeft;
+        plan.outH += batchPara.paddingSizeTop + batchPara.paddingSizeBottom;
+        plan.outW += batchPara.paddingSizeLeft + batchPara.paddingSizeRight;
+    }
+
+    const int16_t mean[AIPP_MAX_CHANNEL] = {batchPara.dtcPixelMeanChn0, batchPara.dtcPixelMeanChn1,
+        batchPara.dtcPixelMeanChn2, batchPara.dtcPixelMeanChn3};
+    const uint16_t min[AIPP_MAX_CHANNEL] = {batchPara.dtcPixelMinChn0, batchPara.dtcPixelMinChn1,
+        batchPara.dtcPixelMinChn2, batchPara.dtcPixelMinChn3};
+    const uint16_t varReci[AIPP_MAX_CHANNEL] = {batchPara.dtcPixelVarReciChn0, batchPara.dtcPixelVarReciChn1,
+        batchPara.dtcPixelVarReciChn2, batchPara.dtcPixelVarReciChn3};
+    const uint16_t padValue[AIPP_MAX_CHANNEL] = {batchPara.paddingValueChn0, batchPara.paddingValueChn1,
+        batchPara.paddingValueChn2, batchPara.paddingValueChn3};
+    for (uint32_t c = 0; c < AIPP_MAX_CHANNEL; ++c) {
+        plan.dtcSub[c] = static_cast<float>(mean[c]) + HalfToFloat(min[c]);
+        plan.dtcScale[c] = HalfToFloat(varReci[c]);
+        plan.padValue[c] = HalfToFloat(padValue[c]);
+    }
+    return SUCCESS;
+}
+
+inline void ApplySwapAndCsc(const AippContext& ctx, int32_t (&px)[AIPP_MAX_CHANNEL])
+{
+    if (ctx.axSwap && ctx.desc->pixelBytes == AIPP_MAX_CHANNEL) {
+        std::rotate(px, px + 1, px + AIPP_MAX_CHANNEL);
+    }
+    if (ctx.rbuvSwap) {
+        if (ctx.desc->colorModel != ImageColorModel::RGB) {
+            std::swap(px[1], px[2]);
+        } else {
+            std::swap(px[0], px[2]);
+        }
+    }
+    if (!ctx.csc.enable) {
+        return;
+    }
+    int32_t in[CSC_CHANNEL] = {px[0] - ctx.csc.inBias[0], px[1] - ctx.csc.inBias[1], px[2] - ctx.csc.inBias[2]};
+    for (uint32_t i = 0; i < CSC_CHANNEL; ++i) {
+        int32_t sum = ctx.csc.matrix[i][0] * in[0] + ctx.csc.matrix[i][1] * in[1] + ctx.csc.matrix[i][2] * in[2];
+        // 算术右移向下取整, 先加半步长实现四舍五入
+        int32_t value = ((sum + CSC_ROUND) >> CSC_SHIFT) + ctx.csc.outBias[i];
+        px[i] = std::min(std::max(value, 0), PIXEL_MAX);
+    }
+}
+
+// 读取第y行[x0, x0 + width)的像素, 完成通道交换与CSC, 按通道平面存入dst(4 * width)
+template <typename FetchFunc>
+void ConvertRowWith(const AippContext& ctx, uint32_t x0, uint32_t width, float* dst, FetchFunc fetch)
+{
+    for (uint32_t i = 0; i < width; ++i) {
+        int32_t px[AIPP_MAX_CHANNEL] = {0, 0, 0, 0};
+        fetch(x0 + i, px);
+        ApplySwapAndCsc(ctx, px);
+        for (uint32_t c = 0; c < AIPP_MAX_CHANNEL; ++c) {
+            dst[c * width + i] = static_cast<float>(px[c]);
+        }
+    }
+}
+
+void ConvertRow(const AippContext& ctx, uint32_t y, uint32_t x0, uint32_t width, float* dst)
+{
+    const uint8_t* yRow = ctx.planes[0] + y * ctx.strides[0];
+    switch (ctx.format) {
+        case ImageFormat::YUV420SP:
+        case ImageFormat::YUV422SP: {
+            size_t uvRowIndex = y / ctx.desc->chromaSubH;
+            const uint8_t* uvRow = ctx.planes[1] + uvRowIndex * ctx.strides[1];
+            ConvertRowWith(ctx, x0, width, dst, [yRow, uvRow](uint32_t x, int32_t(&px)[AIPP_MAX_CHANNEL]) {
+                px[0] = yRow[x];
+                px[1] = uvRow[x & ~1U];
+                px[2] = uvRow[(x & ~1U) + 1];
+            });
+            break;
+        }
+        case ImageFormat::YUYV: {
+            ConvertRowWith(ctx, x0, width, dst, [yRow](uint32_t x, int32_t(&px)[AIPP_MAX_CHANNEL]) {
+                const uint8_t* pair = yRow + (x & ~1U) * 2;
+                px[0] = yRow[x * 2];
+                px[1] = pair[1];
+                px[2] = pair[3];
+            });
+            break;
+        }
+        case ImageFormat::YUV400:
+            ConvertRowWith(ctx, x0, width, dst, [yRow](uint32_t x, int32_t(&px)[AIPP_MAX_CHANNEL]) {
+                px[0] = yRow[x];
+            });
+            break;
+        default: {
+            const uint32_t channel = ctx.desc->pixelBytes;
+            ConvertRowWith(ctx, x0, width, dst, [yRow, channel](uint32_t x, int32_t(&px)[AIPP_MAX_CHANNEL]) {
+                const uint8_t* pixel = yRow + x * channel;
+                for (uint32_t c = 0; c < channel; ++c) {
+                    px[c] = pixel[c];
+                }
+            });
+            break;
+        }
+    }
+}
+
+// 半像素中心对齐的双线性采样坐标
+void ComputeLinearMap(uint32_t inSize, uint32_t outSize, std::vector<uint32_t>& index0,
+    std::vector<uint32_t>& index1, std::vector<float>& weight)
+{
+    index0.resize(outSize);
+    index1.resize(outSize);
+    weight.resize(outSize);
+    const float scale = static_cast<float>(inSize) / static_cast<float>(outSize);
+    for (uint32_t i = 0; i < outSize; ++i) {
+        float src = std::max((static_cast<float>(i) + 0.5f) * scale - 0.5f, 0.0f);
+        uint32_t i0 = std::min(static_cast<uint32_t>(src), inSize - 1);
+        index0[i] = i0;
+        index1[i] = std::min(i0 + 1, inSize - 1);
+        weight[i] = src - static_cast<float>(i0);
+    }
+}
+
+// 缓存最近两行已转换的源数据, 相邻输出行共享源行时无需重复转换
+class RowCache {
+public:
+    RowCache(const AippContext& ctx, const BatchPlan& plan)
+        : ctx_(ctx), plan_(plan), rowSize_(static_cast<size_t>(AIPP_MAX_CHANNEL) * plan.regionW)
+    {
+        for (uint32_t s = 0; s < SLOT_NUM; ++s) {
+            data_[s].resize(rowSize_);
+        }
+    }
+
+    const float* Get(uint32_t row, uint32_t keepRow)
+    {
+        int32_t keepSlot = Find(keepRow);
+        int32_t slot = Find(row);
+        if (slot < 0) {
+            slot = keepSlot == 0 ? 1 : 0;
+            ConvertRow(ctx_, plan_.regionY + row, plan_.regionX, plan_.regionW, data_[slot].data());
+            rows_[slot] = static_cast<int64_t>(row);
+        }
+        return data_[slot].data();
+    }
+
+private:
+    int32_t Find(uint32_t row) const
+    {
+        for (uint32_t s = 0; s < SLOT_NUM; ++s) {
+            if (rows_[s] == static_cast<int64_t>(row)) {
+                return static_cast<int32_t>(s);
+            }
+        }
+        return -1;
+    }
+
+    static const uint32_t SLOT_NUM = 2;
+    const AippContext& ctx_;
+    const BatchPlan& plan_;
+    size_t rowSize_;
+    std::vector<float> data_[SLOT_NUM];
+    int64_t rows_[SLOT_NUM] {-1, -1};
+};
+
+// 紧密排列的图片按格式推算各平面地址与行跨度, 外部平面直接使用
+void InitFramePlanes(const AippCpuImage& image, uint32_t frameIndex, AippContext& ctx)
+{
+    if (image.planes[0] != nullptr) {
+        for (uint32_t i = 0; i < AIPP_CPU_MAX_PLANE; ++i) {
+            ctx.planes[i] = image.planes[i];
+            ctx.strides[i] = image.strides[i];
+        }
+        return;
+    }
+    const size_t frameSize = static_cast<size_t>(GetImageSize(*ctx.desc, ctx.height, ctx.width));
+    ctx.planes[0] = image.data + frameSize * frameIndex;
+    ctx.strides[0] = static_cast<size_t>(GetPlaneRowBytes(*ctx.desc, 0, ctx.width));
+    ctx.planes[1] = ctx.planes[0] + ctx.strides[0] * ctx.height;
+    ctx.strides[1] = static_cast<size_t>(GetPlaneRowBytes(*ctx.desc, 1, ctx.width));
+}
+
+void ExecuteBatch(const AippContext& ctx, const BatchPlan& plan, uint32_t channel, float* output)
+{
+    const bool resize = plan.resizeW != plan.regionW || plan.resizeH != plan.regionH;
+    std::vector<uint32_t> xIndex0;
+    std::vector<uint32_t> xIndex1;
+    std::vector<float> xWeight;
+    std::vector<uint32_t> yIndex0;
+    std::vector<uint32_t> yIndex1;
+    std::vector<float> yWeight;
+    if (resize) {
+        ComputeLinearMap(plan.regionW, plan.resizeW, xIndex0, xIndex1, xWeight);
+        ComputeLinearMap(plan.regionH, plan.resizeH, yIndex0, yIndex1, yWeight);
+    }
+
+    RowCache cache(ctx, plan);
+    std::vector<float> blended(plan.regionW);
+    std::vector<float> resized(plan.resizeW);
+    const size_t planeSize = static_cast<size_t>(plan.outH) * plan.outW;
+    for (uint32_t oy = 0; oy < plan.outH; ++oy) {
+        if (oy < plan.top || oy >= plan.top + plan.resizeH) {
+            for (uint32_t c = 0; c < channel; ++c) {
+                float* dst = output + c * planeSize + static_cast<size_t>(oy) * plan.outW;
+                std::fill(dst, dst + plan.outW, plan.padValue[c]);
+            }
+            continue;
+        }
+        uint32_t ry = oy - plan.top;
+        uint32_t sy0 = resize ? yIndex0[ry] : ry;
+        uint32_t sy1 = resize ? yIndex1[ry] : ry;
+        float fy = resize ? yWeight[ry] : 0.0f;
+        const float* row0 = cache.Get(sy0, sy1);
+        const float* row1 = cache.Get(sy1, sy0);
+
+        for (uint32_t c = 0; c < channel; ++c) {
+            const float* src = row0 + static_cast<size_t>(c) * plan.regionW;
+            if (fy != 0.0f) {
+                AippBlendRows(src, row1 + static_cast<size_t>(c) * plan.regionW, fy, blended.data(), plan.regionW);
+                src = blended.data();
+            }
+            if (resize) {
+                for (uint32_t ox = 0; ox < plan.resizeW; ++ox) {
+                    float left = src[xIndex0[ox]];
+                    float right = src[xIndex1[ox]];
+                    resized[ox] = left + (right - left) * xWeight[ox];
+                }
+                src = resized.data();
+            }
+            float* dst = output + c * planeSize + static_cast<size_t>(oy) * plan.outW;
+            std::fill(dst, dst + plan.left, plan.padValue[c]);
+            AippNormalizeRow(src, plan.dtcSub[c], plan.dtcScale[c], dst + plan.left, plan.resizeW);
+            std::fill(dst + plan.left + plan.resizeW, dst + plan.outW, plan.padValue[c]);
+        }
+    }
+}
+} // namespace
+
+Status ExecuteAippOnCpu(
+    const HIAI_MR_TensorAippCommPara* commPara, size_t paraSize, const AippCpuImage& image, const AippCpuOutput& output)
+{
+    HIAI_EXPECT_NOT_NULL(commPara);
+    HIAI_EXPECT_NOT_NULL(output.data);
+    HIAI_EXPECT_TRUE(paraSize >= sizeof(HIAI_MR_TensorAippCommPara));
+    const uint32_t batchNum = commPara->batchNum;
+    if (batchNum == 0 ||
+        paraSize < sizeof(HIAI_MR_TensorAippCommPara) + sizeof(HIAI_MR_TensorAippBatchPara) * batchNum) {
+        FMK_LOGE("invalid aipp para, batchNum:%u, size:%zu.", batchNum, paraSize);
+        return FAILURE;
+    }
+
+    AippContext ctx;
+    HIAI_EXPECT_EXEC(CheckImage(image, *commPara, ctx.desc));
+    ctx.format = image.format;
+    ctx.width = static_cast<uint32_t>(image.width);
+    ctx.height = static_cast<uint32_t>(image.height);
+    ctx.rbuvSwap = commPara->rbuvSwapSwitch != 0;
+    ctx.axSwap = commPara->axSwapSwitch != 0;
+    InitCscPlan(*commPara, ctx.csc);
+
+    const std::vector<int32_t>& dims = output.dims;
+    if (dims.size() != OUTPUT_DIM_NUM || dims[0] != static_cast<int32_t>(batchNum) || dims[1] <= 0 ||
+        dims[1] > static_cast<int32_t>(AIPP_MAX_CHANNEL)) {
+        FMK_LOGE("output dims should be [%u, 1~4, H, W].", batchNum);
+        return FAILURE;
+    }
+    const uint32_t channel = static_cast<uint32_t>(dims[1]);
+
+    std::vector<BatchPlan> plans(batchNum);
+    for (uint32_t n = 0; n < batchNum; ++n) {
+        HIAI_EXPECT_EXEC(InitBatchPlan(GetBatchPara(*commPara, n), ctx, plans[n]));
+        if (static_cast<int64_t>(plans[n].outH) != dims[2] || static_cast<int64_t>(plans[n].outW) != dims[3]) {
+            FMK_LOGE("batch %u output [%u, %u] mismatch with output dims [%d, %d].", n, plans[n].outH,
+                plans[n].outW, dims[2], dims[3]);
+            return FAILURE;
+        }
+    }
+    const size_t batchSize = static_cast<size_t>(channel) * dims[2] * dims[3];
+    if (output.size < batchSize * batchNum * sizeof(float)) {
+        FMK_LOGE("output size %zu is less than required %zu.", output.size, batchSize * batchNum * sizeof(float));
+        return FAILURE;
+    }
+
+    for (uint32_t n = 0; n < batchNum; ++n) {
+        InitFramePlanes(image, image.batch == 1 ? 0 : n, ctx);
+        ExecuteBatch(ctx, plans[n], channel, output.data + batchSize * n);
+    }
+    return SUCCESS;
+}
+
+Status ExecuteAippOnCpu(const std::shared_ptr<IAIPPPara>& aippPara, const std::shared_ptr<IImageTensorBuffer>& image,
+    const std::shared_ptr<INDTensorBuffer>& output)
+{
+    HIAI_EXPECT_NOT_NULL(aippPara);
+    HIAI_EXPECT_NOT_NULL(image);
+    HIAI_EXPECT_NOT_NULL(output);
+    if (output->GetTensorDesc().dataType != DataType::FLOAT32) {
+        FMK_LOGE("cpu aipp only supports FLOAT32 output.");
+        return FAILURE;
+    }
+
+    AippCpuImage cpuImage;
+    cpuImage.data = static_cast<const uint8_t*>(image->GetData());
+    cpuImage.size = image->GetSize();
+    cpuImage.format = image->Format();
+    cpuImage.batch = image->Batch();
+    cpuImage.height = image->Height();
+    cpuImage.width = image->Width();
+    std::shared_ptr<ImageTensorBufferImpl> imageImpl = std::dynamic_pointer_cast<ImageTensorBufferImpl>(image);
+    if (imageImpl != nullptr && !imageImpl->GetPlaneLayout().planes.empty()) {
+        const ImagePlaneLayout& layout = imageImpl->GetPlaneLayout();
+        for (size_t i = 0; i < layout.planes.size() && i < AIPP_CPU_MAX_PLANE; ++i) {
+            cpuImage.planes[i] = static_cast<const uint8_t*>(layout.planes[i].data);
+            cpuImage.strides[i] = layout.planes[i].stride;
+        }
+        cpuImage.storageWidth = layout.storageWidth;
+        cpuImage.storageHeight = layout.storageHeight;
+    }
+
+    AippCpuOutput cpuOutput;
+    cpuOutput.data = static_cast<float*>(output->GetData());
+    cpuOutput.size = output->GetSize();
+    cpuOutput.dims = output->GetTensorDesc().dims;
+
+    return ExecuteAippOnCpu(static_cast<const HIAI_MR_TensorAippCommPara*>(aippPara->GetData()), aippPara->GetSize(),
+        cpuImage, cpuOutput);
+}
+} // namespace hiai
@@ -0,0 +1,60 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FRAMEWORK_TENSOR_AIPP_AIPP_CPU_EXECUTOR_IMPL_H
+#define FRAMEWORK_TENSOR_AIPP_AIPP_CPU_EXECUTOR_IMPL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "base/error_types.h"
+#include "tensor/image_format.h"
+#include "framework/c/hiai_tensor_aipp_para.h"
+
+namespace hiai {
+const uint32_t AIPP_CPU_MAX_PLANE = 2;
+
+struct AippCpuImage {
+    const uint8_t* data {nullptr};
+    size_t size {0};
+    ImageFormat format {ImageFormat::INVALID};
+    int32_t batch {0};
+    int32_t height {0};
+    int32_t width {0};
+    // 外部平面内存(仅单batch): planes[0]非空时按各平面地址与行跨度读取, 不使用data/size
+    const uint8_t* planes[AIPP_CPU_MAX_PLANE] {nullptr, nullptr};
+    size_t strides[AIPP_CPU_MAX_PLANE] {0, 0};
+    // 含行跨度填充的存储宽高, AIPP参数的srcImageSize也可取该值, 0表示无填充
+    int32_t storageWidth {0};
+    int32_t storageHeight {0};
+};
+
+struct AippCpuOutput {
+    float* data {nullptr};
+    size_t size {0};
+    std::vector<int32_t> dims; // NCHW
+};
+
+/*
+ * @brief 按HIAI_MR_TensorAippPara原始内存布局在CPU上执行AIPP
+ * @param [in] commPara AIPP公共参数, 其后紧跟batchNum个HIAI_MR_TensorAippBatchPara
+ * @param [in] paraSize commPara指向内存的大小
+ */
+Status ExecuteAippOnCpu(
+    const HIAI_MR_TensorAippCommPara* commPara, size_t paraSize, const AippCpuImage& image, const AippCpuOutput& output);
+} // namespace hiai
+
+#endif // FRAMEWORK_TENSOR_AIPP_AIPP_CPU_EXECUTOR_IMPL_H
@@ -0,0 +1,91 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "aipp_cpu_kernel.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(ARM_NEON) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#define AIPP_CPU_NEON
+#endif
+
+namespace hiai {
+void AippBlendRows(const float* top, const float* bottom, float bottomWeight, float* dst, size_t len)
+{
+    const float topWeight = 1.0f - bottomWeight;
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256 vTop = _mm256_set1_ps(topWeight);
+    const __m256 vBottom = _mm256_set1_ps(bottomWeight);
+    for (; i + 8 <= len; i += 8) {
+        __m256 t = _mm256_mul_ps(_mm256_loadu_ps(top + i), vTop);
+        __m256 b = _mm256_mul_ps(_mm256_loadu_ps(bottom + i), vBottom);
+        _mm256_storeu_ps(dst + i, _mm256_add_ps(t, b));
+    }
+#elif defined(__SSE2__)
+    const __m128 vTop = _mm_set1_ps(topWeight);
+    const __m128 vBottom = _mm_set1_ps(bottomWeight);
+    for (; i + 4 <= len; i += 4) {
+        __m128 t = _mm_mul_ps(_mm_loadu_ps(top + i), vTop);
+        __m128 b = _mm_mul_ps(_mm_loadu_ps(bottom + i), vBottom);
+        _mm_storeu_ps(dst + i, _mm_add_ps(t, b));
+    }
+#elif defined(AIPP_CPU_NEON)
+    const float32x4_t vTop = vdupq_n_f32(topWeight);
+    const float32x4_t vBottom = vdupq_n_f32(bottomWeight);
+    for (; i + 4 <= len; i += 4) {
+        float32x4_t t = vmulq_f32(vld1q_f32(top + i), vTop);
+        float32x4_t b = vmulq_f32(vld1q_f32(bottom + i), vBottom);
+        vst1q_f32(dst + i, vaddq_f32(t, b));
+    }
+#endif
+    for (; i < len; ++i) {
+        float t = top[i] * topWeight;
+        float b = bottom[i] * bottomWeight;
+        dst[i] = t + b;
+    }
+}
+
+void AippNormalizeRow(const float* src, float sub, float scale, float* dst, size_t len)
+{
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256 vSub = _mm256_set1_ps(sub);
+    const __m256 vScale = _mm256_set1_ps(scale);
+    for (; i + 8 <= len; i += 8) {
+        _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(src + i), vSub), vScale));
+    }
+#elif defined(__SSE2__)
+    const __m128 vSub = _mm_set1_ps(sub);
+    const __m128 vScale = _mm_set1_ps(scale);
+    for (; i + 4 <= len; i += 4) {
+        _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(src + i), vSub), vScale));
+    }
+#elif defined(AIPP_CPU_NEON)
+    const float32x4_t vSub = vdupq_n_f32(sub);
+    const float32x4_t vScale = vdupq_n_f32(scale);
+    for (; i + 4 <= len; i += 4) {
+        vst1q_f32(dst + i, vmulq_f32(vsubq_f32(vld1q_f32(src + i), vSub), vScale));
+    }
+#endif
+    for (; i < len; ++i) {
+        float diff = src[i] - sub;
+        dst[i] = diff * scale;
+    }
+}
+} // namespace hiai
@@ -0,0 +1,34 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FRAMEWORK_TENSOR_AIPP_AIPP_CPU_KERNEL_H
+#define FRAMEWORK_TENSOR_AIPP_AIPP_CPU_KERNEL_H
+
+#include <cstddef>
+
+namespace hiai {
+/*
+ * CPU AIPP行内核, 按编译目标选择AVX2/SSE2/NEON实现, 其余平台使用标量实现.
+ * 各实现均按 mul, mul, add / sub, mul 的顺序计算, 结果与标量实现一致.
+ */
+
+// dst[i] = top[i] * (1 - bottomWeight) + bottom[i] * bottomWeight
+void AippBlendRows(const float* top, const float* bottom, float bottomWeight, float* dst, size_t len);
+
+// dst[i] = (src[i] - sub) * scale, 即DTC: (pixel - mean - min) * varReci
+void AippNormalizeRow(const float* src, float sub, float scale, float* dst, size_t len);
+} // namespace hiai
+
+#endif // FRAMEWORK_TENSOR_AIPP_AIPP_CPU_KERNEL_H
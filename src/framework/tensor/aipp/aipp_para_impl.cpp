@@ -15,14 +15,24 @@
  */
 #include "aipp_para_impl.h"
 
-#include <map>
-#include <set>
-#include <string>
+#include <algorithm>
+#include <vector>
 
 #include "framework/infra/log/log.h"
 #include "framework/c/hiai_tensor_aipp_para.h"
+#include "securec.h"
 #include "infra/base/securestl.h"
 #include "infra/base/assertion.h"
+#include "tensor/image/image_csc_table.h"
+#include "tensor/image/image_format_desc.h"
+
+#if defined(__F16C__) && defined(__AVX__)
+#include <immintrin.h>
+#define AIPP_FP16_F16C
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define AIPP_FP16_NEON
+#endif
 
 namespace {
 
@@ -32,26 +42,6 @@ const float kFloat16Max = 65504;
 const float kFloat16Lowest = -kFloat16Max;
 const uint8_t maxBatchNum = 127;
 
-const static int YUV_TO_RGB[4][3][3] = {{{256, 0, 359}, {256, -88, -183}, {256, 454, 0}},
-    {{298, 0, 409}, {298, -100, -208}, {298, 516, 0}}, {{256, 0, 359}, {256, -88, -183}, {256, 454, 0}},
-    {{298, 0, 460}, {298, -55, -137}, {298, 541, 0}}};
-const static int RGB_TO_YUV[4][3][3] = {{{77, 150, 29}, {-43, -85, 128}, {128, -107, -21}},
-    {{66, 129, 25}, {-38, -74, 112}, {112, -94, -18}}, {{77, 150, 29}, {-43, -85, 128}, {128, -107, -21}},
-    {{47, 157, 16}, {-26, -87, 112}, {112, -102, -10}}};
-enum CceAippInputFormat {
-    CCE_YUV420SP_U8 = 1,
-    CCE_XRGB8888_U8,
-    CCE_NC1HWC0DI_FP16,
-    CCE_NC1HWC0DI_S8,
-    CCE_RGB888_U8,
-    CCE_ARGB8888_U8,
-    CCE_YUYV_U8,
-    CCE_YUV422SP_U8,
-    CCE_AYUV444_U8,
-    CCE_YUV400_U8,
-    CCE_RESERVED
-};
-
 static Status CheckBatchNum(uint8_t batchNum)
 {
     if (batchNum < 1 || batchNum > maxBatchNum) {
@@ -77,107 +67,89 @@ static _Float16 SaveUint16ToFp16(uint16_t num)
     return *uintAddr;
 }
 
-static const string& FormatToStr(ImageFormat format)
-{
-    const static map<ImageFormat, string> strMap = {
-        {ImageFormat::YUV420SP, "YUV420SP_U8"},
-        {ImageFormat::XRGB8888, "XRGB8888_U8"},
-        {ImageFormat::YUV400, "YUV400_U8"},
-        {ImageFormat::ARGB8888, "ARGB8888_U8"},
-        {ImageFormat::YUYV, "YUYV_U8"},
-        {ImageFormat::YUV422SP, "YUV422SP_U8"},
-        {ImageFormat::AYUV444, "AYUV444_U8"},
-        {ImageFormat::RGB888, "RGB888_U8"},
-        {ImageFormat::BGR888, "BGR888_U8"},
-        {ImageFormat::YUV444SP, "YUV444SP_U8"},
-        {ImageFormat::YVU444SP, "YVU444SP_U8"},
-    };
-    const static string undefinedStr = "undefined";
-    if (strMap.find(format) != strMap.end()) {
-        return strMap.at(format);
-    }
-    return undefinedStr;
+static const char* FormatToStr(ImageFormat format)
+{
+    const ImageFormatDesc* formatDesc = GetImageFormatDesc(format);
+    return formatDesc != nullptr ? formatDesc->name : "undefined";
 }
 
-static Status InitCscMatrixToRGB(ImageFormat inputFormat, ImageFormat targetFormat, vector<int32_t>& cscValues,
-    vector<uint8_t>& inputBiasValues, ImageColorSpace imageType)
-{
-    if (inputFormat == ImageFormat::XRGB8888 || inputFormat == ImageFormat::RGB888 ||
-        inputFormat == ImageFormat::ARGB8888 || inputFormat == ImageFormat::BGR888 ||
-        inputFormat == ImageFormat::YUV400) {
-        FMK_LOGE("Set SetCscPara failed, can not convert from %s image to %s by CSC", FormatToStr(inputFormat).c_str(),
-            FormatToStr(targetFormat).c_str());
-        return FAILURE;
-    }
-    const static map<ImageFormat, vector<uint32_t>> idxMap1 = {
-        {ImageFormat::RGB888, {0, 1, 2}}, {ImageFormat::BGR888, {2, 1, 0}}};
-    uint32_t step = 0;
-    for (uint32_t idx : idxMap1.at(targetFormat)) {
-        for (uint32_t j = 0; j < 3; ++j) {
-            cscValues[step++] = YUV_TO_RGB[static_cast<uint32_t>(imageType)][idx][j];
+// 色域转换参数模板, 与HIAI_MR_TensorAippCommPara中csc相关字段一一对应
+struct CscParaTemplate {
+    bool valid {false};
+    int32_t matrix[9] {0};
+    uint8_t inputBias[3] {0};
+    uint8_t outputBias[3] {0};
+};
+
+const size_t COLOR_SPACE_NUM = static_cast<size_t>(ImageColorSpace::BT_709_NARROW) + 1;
+
+// YUV输入转RGB/BGR, RGB输入转YUV444SP/YVU444SP, 非灰度输入转YUV400, 其余组合不支持
+static void InitCscParaTemplate(const ImageFormatDesc& inputDesc, const ImageFormatDesc& targetDesc,
+    ImageColorSpace colorSpace, CscParaTemplate& cscTemplate)
+{
+    const uint32_t space = static_cast<uint32_t>(colorSpace);
+    if (targetDesc.colorModel == ImageColorModel::GRAY) {
+        if (inputDesc.colorModel == ImageColorModel::YUV) {
+            cscTemplate.matrix[0] = 256;
+        } else if (inputDesc.colorModel == ImageColorModel::RGB) {
+            cscTemplate.matrix[0] = 76;
+            cscTemplate.matrix[1] = 150;
+            cscTemplate.matrix[2] = 30;
+        } else {
+            return;
         }
+        cscTemplate.valid = true;
+        return;
     }
-    if (inputBiasValues.size() < 3) {
-        FMK_LOGE("inputBiasValues size less than 3,get: %zu", inputBiasValues.size());
-        return FAILURE;
-    }
-    inputBiasValues[0] = imageType == ImageColorSpace::JPEG ? 0 : 16;
-    inputBiasValues[1] = 128;
-    inputBiasValues[2] = 128;
-    return SUCCESS;
-}
 
-static Status InitCscMatrixToYUV(ImageFormat inputFormat, ImageFormat targetFormat, vector<int32_t>& cscValues,
-    vector<uint8_t>& outputBiasValues, ImageColorSpace imageType)
-{
-    if (inputFormat == ImageFormat::YUV420SP || inputFormat == ImageFormat::YUV422SP ||
-        inputFormat == ImageFormat::YUYV || inputFormat == ImageFormat::AYUV444 || inputFormat == ImageFormat::YUV400) {
-        FMK_LOGE("Set SetCscPara failed, can not convert from %s image to %s by CSC", FormatToStr(inputFormat).c_str(),
-            FormatToStr(targetFormat).c_str());
-        return FAILURE;
+    bool toRgb = targetDesc.colorModel == ImageColorModel::RGB;
+    if (inputDesc.colorModel != (toRgb ? ImageColorModel::YUV : ImageColorModel::RGB)) {
+        return;
     }
-    const static map<ImageFormat, vector<uint32_t>> idxMap2 = {
-        {ImageFormat::YUV444SP, {0, 1, 2}}, {ImageFormat::YVU444SP, {0, 2, 1}}};
     uint32_t step = 0;
-    for (uint32_t idx : idxMap2.at(targetFormat)) {
+    for (uint32_t idx : targetDesc.cscRowOrder) {
         for (uint32_t j = 0; j < 3; ++j) {
-            cscValues[step++] = RGB_TO_YUV[static_cast<uint32_t>(imageType)][idx][j];
+            cscTemplate.matrix[step++] = toRgb ? YUV_TO_RGB[space][idx][j] : RGB_TO_YUV[space][idx][j];
         }
     }
-    if (outputBiasValues.size() < 3) {
-        FMK_LOGE("outputBiasValues size less than 3,size:%zu", outputBiasValues.size());
-        return FAILURE;
-    }
-
-    outputBiasValues[0] = imageType == ImageColorSpace::JPEG ? 0 : 16;
-    outputBiasValues[1] = 128;
-    outputBiasValues[2] = 128;
-    return SUCCESS;
-}
-
-static Status InitCscMatrixToGray(ImageFormat inputFormat, vector<int32_t>& cscValues)
-{
-    if (inputFormat == ImageFormat::YUV400) {
-        FMK_LOGE("Set SetCscPara failed, can not convert from %s image to YUV400_U8 by CSC",
-            FormatToStr(inputFormat).c_str());
-        return FAILURE;
-    } else if (inputFormat == ImageFormat::YUV420SP || inputFormat == ImageFormat::YUV422SP ||
-        inputFormat == ImageFormat::YUYV || inputFormat == ImageFormat::AYUV444) { // YUV images
-        if (cscValues.empty()) {
-            FMK_LOGE("cscValues can not be empty");
-            return FAILURE;
+    uint8_t* bias = toRgb ? cscTemplate.inputBias : cscTemplate.outputBias;
+    bias[0] = static_cast<uint8_t>(GetCscYBias(colorSpace));
+    bias[1] = CSC_UV_BIAS;
+    bias[2] = CSC_UV_BIAS;
+    cscTemplate.valid = true;
+}
+
+// 全部(输入格式, 目标格式, 色域)组合的CSC参数只在首次使用时计算一次, 之后只读
+static const CscParaTemplate& GetCscParaTemplate(
+    ImageFormat inputFormat, ImageFormat targetFormat, ImageColorSpace colorSpace)
+{
+    struct CscParaTemplates {
+        CscParaTemplates()
+        {
+            for (size_t input = 0; input < IMAGE_FORMAT_NUM; ++input) {
+                for (size_t target = 0; target < IMAGE_FORMAT_NUM; ++target) {
+                    if (!IMAGE_FORMAT_DESCS[target].cscOutputSupported) {
+                        continue;
+                    }
+                    for (size_t space = 0; space < COLOR_SPACE_NUM; ++space) {
+                        InitCscParaTemplate(IMAGE_FORMAT_DESCS[input], IMAGE_FORMAT_DESCS[target],
+                            static_cast<ImageColorSpace>(space), templates[input][target][space]);
+                    }
+                }
+            }
         }
-        cscValues[0] = 256;
-    } else { // RGB images
-        if (cscValues.size() < 3) {
-            FMK_LOGE("cscValues size less than 3,get :%zu", cscValues.size());
-            return FAILURE;
-        }
-        cscValues[0] = 76;
-        cscValues[1] = 150;
-        cscValues[2] = 30;
+        CscParaTemplate templates[IMAGE_FORMAT_NUM][IMAGE_FORMAT_NUM][COLOR_SPACE_NUM];
+    };
+    static const CscParaTemplates cscParaTemplates;
+    static const CscParaTemplate invalidTemplate;
+
+    size_t input = static_cast<size_t>(inputFormat);
+    size_t target = static_cast<size_t>(targetFormat);
+    size_t space = static_cast<size_t>(colorSpace);
+    if (input >= IMAGE_FORMAT_NUM || target >= IMAGE_FORMAT_NUM || space >= COLOR_SPACE_NUM) {
+        return invalidTemplate;
     }
-    return SUCCESS;
+    return cscParaTemplates.templates[input][target][space];
 }
 
 static uint16_t SaveFp16ToUint16(_Float16 num)
@@ -222,50 +194,112 @@ static void UpdateResizePara(HIAI_MR_TensorAippCommPara* commPara, uint32_t batc
     batchPara->scfOutputSizeH = resizePara.resizeOutputSizeH;
 }
 
-static void UpdatePaddingPara(HIAI_MR_TensorAippCommPara* commPara, uint32_t batchIndex, const PadPara& paddingPara)
+// 批量将float截断到fp16范围后转换为fp16位模式, 支持F16C/NEON时按向量处理
+// 与标量std::min/std::max一致, NaN不参与截断: x86 min/max遇NaN返回第二个操作数, 故输入放在第二个
+static void ConvertToFp16(const float* src, uint16_t* dst, size_t count)
 {
-    HIAI_MR_TensorAippBatchPara* batchPara = GetBatchPara(commPara, batchIndex);
+    size_t i = 0;
+#if defined(AIPP_FP16_F16C)
+    const __m256 maxValue = _mm256_set1_ps(kFloat16Max);
+    const __m256 lowestValue = _mm256_set1_ps(kFloat16Lowest);
+    for (; i + 8 <= count; i += 8) {
+        __m256 value = _mm256_max_ps(lowestValue, _mm256_min_ps(maxValue, _mm256_loadu_ps(src + i)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm256_cvtps_ph(value, _MM_FROUND_TO_NEAREST_INT));
+    }
+#elif defined(AIPP_FP16_NEON)
+    const float32x4_t maxValue = vdupq_n_f32(kFloat16Max);
+    const float32x4_t lowestValue = vdupq_n_f32(kFloat16Lowest);
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t value = vmaxq_f32(vminq_f32(vld1q_f32(src + i), maxValue), lowestValue);
+        vst1_u16(dst + i, vreinterpret_u16_f16(vcvt_f16_f32(value)));
+    }
+#endif
+    for (; i < count; ++i) {
+        dst[i] = SaveFp16ToUint16(std::max(std::min(src[i], kFloat16Max), kFloat16Lowest));
+    }
+}
 
+const size_t PADDING_FP16_VALUE_NUM = 4; // paddingValueChn0~3
+const size_t DTC_FP16_VALUE_NUM = 8; // pixelMinChn0~3, pixelVarReciChn0~3
+
+static void PackPaddingValues(const PadPara& paddingPara, float* values)
+{
+    values[0] = paddingPara.paddingValueChn0;
+    values[1] = paddingPara.paddingValueChn1;
+    values[2] = paddingPara.paddingValueChn2;
+    values[3] = paddingPara.paddingValueChn3;
+}
+
+static void PackDtcValues(const DtcPara& dtcPara, float* values)
+{
+    values[0] = dtcPara.pixelMinChn0;
+    values[1] = dtcPara.pixelMinChn1;
+    values[2] = dtcPara.pixelMinChn2;
+    values[3] = dtcPara.pixelMinChn3;
+    values[4] = dtcPara.pixelVarReciChn0;
+    values[5] = dtcPara.pixelVarReciChn1;
+    values[6] = dtcPara.pixelVarReciChn2;
+    values[7] = dtcPara.pixelVarReciChn3;
+}
+
+// fp16Values为PackPaddingValues转换后的结果
+static void WritePaddingPara(
+    HIAI_MR_TensorAippBatchPara* batchPara, const PadPara& paddingPara, const uint16_t* fp16Values)
+{
     batchPara->paddingSwitch = true;
     batchPara->paddingSizeTop = paddingPara.paddingSizeTop;
     batchPara->paddingSizeBottom = paddingPara.paddingSizeBottom;
     batchPara->paddingSizeLeft = paddingPara.paddingSizeLeft;
     batchPara->paddingSizeRight = paddingPara.paddingSizeRight;
-
-    float value = std::max(std::min(paddingPara.paddingValueChn0, kFloat16Max), kFloat16Lowest);
-    batchPara->paddingValueChn0 = SaveFp16ToUint16(value);
-    value = std::max(std::min(paddingPara.paddingValueChn1, kFloat16Max), kFloat16Lowest);
-    batchPara->paddingValueChn1 = SaveFp16ToUint16(value);
-    value = std::max(std::min(paddingPara.paddingValueChn2, kFloat16Max), kFloat16Lowest);
-    batchPara->paddingValueChn2 = SaveFp16ToUint16(value);
-    value = std::max(std::min(paddingPara.paddingValueChn3, kFloat16Max), kFloat16Lowest);
-    batchPara->paddingValueChn3 = SaveFp16ToUint16(value);
+    batchPara->paddingValueChn0 = fp16Values[0];
+    batchPara->paddingValueChn1 = fp16Values[1];
+    batchPara->paddingValueChn2 = fp16Values[2];
+    batchPara->paddingValueChn3 = fp16Values[3];
 }
 
-static void UpdateDtcPara(HIAI_MR_TensorAippCommPara* commPara, uint32_t batchIndex, const DtcPara& dtcPara)
+// fp16Values为PackDtcValues转换后的结果
+static void WriteDtcPara(HIAI_MR_TensorAippBatchPara* batchPara, const DtcPara& dtcPara, const uint16_t* fp16Values)
 {
-    HIAI_MR_TensorAippBatchPara* batchPara = GetBatchPara(commPara, batchIndex);
-
     batchPara->dtcPixelMeanChn0 = dtcPara.pixelMeanChn0;
     batchPara->dtcPixelMeanChn1 = dtcPara.pixelMeanChn1;
     batchPara->dtcPixelMeanChn2 = dtcPara.pixelMeanChn2;
     batchPara->dtcPixelMeanChn3 = dtcPara.pixelMeanChn3;
-    float value = std::max(std::min(dtcPara.pixelMinChn0, kFloat16Max), kFloat16Lowest);
-    batchPara->dtcPixelMinChn0 = SaveFp16ToUint16(value);
-    value = std::max(std::min(dtcPara.pixelMinChn1, kFloat16Max), kFloat16Lowest);
-    batchPara->dtcPixelMinChn1 = SaveFp16ToUint16(value);
-    value = std::max(std::min(dtcPara.pixelMinChn2, kFloat16Max), kFloat16Lowest);
-    batchPara->dtcPixelMinChn2 = SaveFp16ToUint16(value);
-    value = std::max(std::min(dtcPara.pixelMinChn3, kFloat16Max), kFloat16Lowest);
-    batchPara->dtcPixelMinChn3 = SaveFp16ToUint16(value);
-    value = std::max(std::min(dtcPara.pixelVarReciChn0, kFloat16Max), kFloat16Lowest);
-    batchPara->dtcPixelVarReciChn0 = SaveFp16ToUint16(value);
-    value = std::max(std::min(dtcPara.pixelVarReciChn1, kFloat16Max), kFloat16Lowest);
-    batchPara->dtcPixelVarReciChn1 = SaveFp16ToUint16(value);
-    value = std::max(std::min(dtcPara.pixelVarReciChn2, kFloat16Max), kFloat16Lowest);
-    batchPara->dtcPixelVarReciChn2 = SaveFp16ToUint16(value);
-    value = std::max(std::min(dtcPara.pixelVarReciChn3, kFloat16Max), kFloat16Lowest);
-    batchPara->dtcPixelVarReciChn3 = SaveFp16ToUint16(value);
+    batchPara->dtcPixelMinChn0 = fp16Values[0];
+    batchPara->dtcPixelMinChn1 = fp16Values[1];
+    batchPara->dtcPixelMinChn2 = fp16Values[2];
+    batchPara->dtcPixelMinChn3 = fp16Values[3];
+    batchPara->dtcPixelVarReciChn0 = fp16Values[4];
+    batchPara->dtcPixelVarReciChn1 = fp16Values[5];
+    batchPara->dtcPixelVarReciChn2 = fp16Values[6];
+    batchPara->dtcPixelVarReciChn3 = fp16Values[7];
+}
+
+static Status CheckBatchParaNum(size_t paraNum, uint32_t batchNum)
+{
+    if (paraNum != batchNum) {
+        FMK_LOGE("para num [%zu] is not equal to batchNum [%u].", paraNum, batchNum);
+        return FAILURE;
+    }
+    return SUCCESS;
+}
+
+static Status CheckCropPara(const HIAI_MR_TensorAippCommPara* commPara, const CropPara& cropPara)
+{
+    if (cropPara.cropSizeW == 0 || cropPara.cropSizeH == 0) {
+        FMK_LOGE("crop size [%u, %u] is invalid.", cropPara.cropSizeW, cropPara.cropSizeH);
+        return FAILURE;
+    }
+    // 未设置输入图片大小时无法校验越界, 交由执行时检查
+    if (commPara->srcImageSizeW > 0 && commPara->srcImageSizeH > 0 &&
+        (static_cast<uint64_t>(cropPara.cropStartPosW) + cropPara.cropSizeW >
+            static_cast<uint64_t>(commPara->srcImageSizeW) ||
+            static_cast<uint64_t>(cropPara.cropStartPosH) + cropPara.cropSizeH >
+                static_cast<uint64_t>(commPara->srcImageSizeH))) {
+        FMK_LOGE("crop [%u, %u, %u, %u] is out of image [%d, %d].", cropPara.cropStartPosW, cropPara.cropStartPosH,
+            cropPara.cropSizeW, cropPara.cropSizeH, commPara->srcImageSizeW, commPara->srcImageSizeH);
+        return FAILURE;
+    }
+    return SUCCESS;
 }
 } // namespace
 
@@ -469,45 +503,36 @@ Status AIPPParaImpl::SetCscPara(ImageFormat targetFormat, ImageColorSpace colorS
         return FAILURE;
     }
 
-    std::set<ImageFormat> validFormat = {
-        ImageFormat::YVU444SP, ImageFormat::YUV444SP, ImageFormat::RGB888, ImageFormat::BGR888, ImageFormat::YUV400};
-    if (validFormat.find(targetFormat) == validFormat.end()) {
+    const ImageFormatDesc* targetDesc = GetImageFormatDesc(targetFormat);
+    if (targetDesc == nullptr || !targetDesc->cscOutputSupported) {
         FMK_LOGE(
             "targetFormat is invalid, valid targetFormat in range of [ YVU444SP, YUV444SP, RGB888, BGR888, YUV400 ]");
         return FAILURE;
     }
 
-    vector<int32_t> cscValues(9, 0);
-    vector<uint8_t> inputBiasValues(3, 0);
-    vector<uint8_t> outputBiasValues(3, 0);
-    Status ret = FAILURE;
-    if (targetFormat == ImageFormat::RGB888 || targetFormat == ImageFormat::BGR888) {
-        ret = InitCscMatrixToRGB(inputFormat, targetFormat, cscValues, inputBiasValues, colorSpace);
-    } else if (targetFormat == ImageFormat::YUV444SP || targetFormat == ImageFormat::YVU444SP) {
-        ret = InitCscMatrixToYUV(inputFormat, targetFormat, cscValues, outputBiasValues, colorSpace);
-    } else {
-        ret = InitCscMatrixToGray(inputFormat, cscValues);
-    }
-    if (ret != SUCCESS) {
-        return ret;
+    const CscParaTemplate& cscTemplate = GetCscParaTemplate(inputFormat, targetFormat, colorSpace);
+    if (!cscTemplate.valid) {
+        FMK_LOGE("Set SetCscPara failed, can not convert from %s image to %s by CSC", FormatToStr(inputFormat),
+            FormatToStr(targetFormat));
+        return FAILURE;
     }
 
     para.first->cscSwitch = true;
-    para.first->cscMatrixR0C0 = cscValues[0];
-    para.first->cscMatrixR0C1 = cscValues[1];
-    para.first->cscMatrixR0C2 = cscValues[2];
-    para.first->cscMatrixR1C0 = cscValues[3];
-    para.first->cscMatrixR1C1 = cscValues[4];
-    para.first->cscMatrixR1C2 = cscValues[5];
-    para.first->cscMatrixR2C0 = cscValues[6];
-    para.first->cscMatrixR2C1 = cscValues[7];
-    para.first->cscMatrixR2C2 = cscValues[8];
-    para.first->cscInputBiasR0 = inputBiasValues[0];
-    para.first->cscInputBiasR1 = inputBiasValues[1];
-    para.first->cscInputBiasR2 = inputBiasValues[2];
-    para.first->cscOutputBiasR0 = outputBiasValues[0];
-    para.first->cscOutputBiasR1 = outputBiasValues[1];
-    para.first->cscOutputBiasR2 = outputBiasValues[2];
+    para.first->cscMatrixR0C0 = cscTemplate.matrix[0];
+    para.first->cscMatrixR0C1 = cscTemplate.matrix[1];
+    para.first->cscMatrixR0C2 = cscTemplate.matrix[2];
+    para.first->cscMatrixR1C0 = cscTemplate.matrix[3];
+    para.first->cscMatrixR1C1 = cscTemplate.matrix[4];
+    para.first->cscMatrixR1C2 = cscTemplate.matrix[5];
+    para.first->cscMatrixR2C0 = cscTemplate.matrix[6];
+    para.first->cscMatrixR2C1 = cscTemplate.matrix[7];
+    para.first->cscMatrixR2C2 = cscTemplate.matrix[8];
+    para.first->cscInputBiasR0 = cscTemplate.inputBias[0];
+    para.first->cscInputBiasR1 = cscTemplate.inputBias[1];
+    para.first->cscInputBiasR2 = cscTemplate.inputBias[2];
+    para.first->cscOutputBiasR0 = cscTemplate.outputBias[0];
+    para.first->cscOutputBiasR1 = cscTemplate.outputBias[1];
+    para.first->cscOutputBiasR2 = cscTemplate.outputBias[2];
     return SUCCESS;
 }
 
@@ -654,12 +679,27 @@ ResizePara AIPPParaImpl::GetResizePara(uint32_t batchIndex)
 
 Status AIPPParaImpl::SetPaddingPara(PadPara&& paddingPara)
 {
-    return SetAippFuncPara(paddingPara, UpdatePaddingPara);
+    // fp16转换与batch无关, 只转换一次后写入全部batch
+    float values[PADDING_FP16_VALUE_NUM];
+    uint16_t fp16Values[PADDING_FP16_VALUE_NUM];
+    PackPaddingValues(paddingPara, values);
+    ConvertToFp16(values, fp16Values, PADDING_FP16_VALUE_NUM);
+    return SetAippFuncPara(paddingPara,
+        [&fp16Values](HIAI_MR_TensorAippCommPara* commPara, uint32_t batchIndex, const PadPara& para) {
+            WritePaddingPara(GetBatchPara(commPara, batchIndex), para, fp16Values);
+        });
 }
 
 Status AIPPParaImpl::SetPaddingPara(uint32_t batchIndex, PadPara&& paddingPara)
 {
-    return SetAippFuncPara(batchIndex, paddingPara, UpdatePaddingPara);
+    float values[PADDING_FP16_VALUE_NUM];
+    uint16_t fp16Values[PADDING_FP16_VALUE_NUM];
+    PackPaddingValues(paddingPara, values);
+    ConvertToFp16(values, fp16Values, PADDING_FP16_VALUE_NUM);
+    return SetAippFuncPara(batchIndex, paddingPara,
+        [&fp16Values](HIAI_MR_TensorAippCommPara* commPara, uint32_t index, const PadPara& para) {
+            WritePaddingPara(GetBatchPara(commPara, index), para, fp16Values);
+        });
 }
 
 PadPara AIPPParaImpl::GetPaddingPara(uint32_t batchIndex)
@@ -685,12 +725,27 @@ PadPara AIPPParaImpl::GetPaddingPara(uint32_t batchIndex)
 
 Status AIPPParaImpl::SetDtcPara(DtcPara&& dtcPara)
 {
-    return SetAippFuncPara(dtcPara, UpdateDtcPara);
+    // fp16转换与batch无关, 只转换一次后写入全部batch
+    float values[DTC_FP16_VALUE_NUM];
+    uint16_t fp16Values[DTC_FP16_VALUE_NUM];
+    PackDtcValues(dtcPara, values);
+    ConvertToFp16(values, fp16Values, DTC_FP16_VALUE_NUM);
+    return SetAippFuncPara(dtcPara,
+        [&fp16Values](HIAI_MR_TensorAippCommPara* commPara, uint32_t batchIndex, const DtcPara& para) {
+            WriteDtcPara(GetBatchPara(commPara, batchIndex), para, fp16Values);
+        });
 }
 
 Status AIPPParaImpl::SetDtcPara(uint32_t batchIndex, DtcPara&& dtcPara)
 {
-    return SetAippFuncPara(batchIndex, dtcPara, UpdateDtcPara);
+    float values[DTC_FP16_VALUE_NUM];
+    uint16_t fp16Values[DTC_FP16_VALUE_NUM];
+    PackDtcValues(dtcPara, values);
+    ConvertToFp16(values, fp16Values, DTC_FP16_VALUE_NUM);
+    return SetAippFuncPara(batchIndex, dtcPara,
+        [&fp16Values](HIAI_MR_TensorAippCommPara* commPara, uint32_t index, const DtcPara& para) {
+            WriteDtcPara(GetBatchPara(commPara, index), para, fp16Values);
+        });
 }
 
 DtcPara AIPPParaImpl::GetDtcPara(uint32_t batchIndex)
@@ -717,49 +772,101 @@ DtcPara AIPPParaImpl::GetDtcPara(uint32_t batchIndex)
     return dtcPara;
 }
 
+Status AIPPParaImpl::SetCropParas(const std::vector<CropPara>& cropParas)
+{
+    auto para = GetTensorAippCommPara();
+    HIAI_EXPECT_NOT_NULL(para.first);
+    HIAI_EXPECT_EXEC(CheckBatchParaNum(cropParas.size(), para.second));
+    for (const CropPara& cropPara : cropParas) {
+        HIAI_EXPECT_EXEC(CheckCropPara(para.first, cropPara));
+    }
+
+    for (uint32_t index = 0; index < para.second; ++index) {
+        UpdateCropPara(para.first, index, cropParas[index]);
+    }
+    return SUCCESS;
+}
+
+Status AIPPParaImpl::SetResizeParas(const std::vector<ResizePara>& resizeParas)
+{
+    auto para = GetTensorAippCommPara();
+    HIAI_EXPECT_NOT_NULL(para.first);
+    HIAI_EXPECT_EXEC(CheckBatchParaNum(resizeParas.size(), para.second));
+    for (const ResizePara& resizePara : resizeParas) {
+        if (resizePara.resizeOutputSizeW == 0 || resizePara.resizeOutputSizeH == 0) {
+            FMK_LOGE("resize output size [%u, %u] is invalid.", resizePara.resizeOutputSizeW,
+                resizePara.resizeOutputSizeH);
+            return FAILURE;
+        }
+    }
+
+    for (uint32_t index = 0; index < para.second; ++index) {
+        UpdateResizePara(para.first, index, resizeParas[index]);
+    }
+    return SUCCESS;
+}
+
+Status AIPPParaImpl::SetPaddingParas(const std::vector<PadPara>& paddingParas)
+{
+    auto para = GetTensorAippCommPara();
+    HIAI_EXPECT_NOT_NULL(para.first);
+    HIAI_EXPECT_EXEC(CheckBatchParaNum(paddingParas.size(), para.second));
+
+    std::vector<float> values(paddingParas.size() * PADDING_FP16_VALUE_NUM);
+    for (size_t index = 0; index < paddingParas.size(); ++index) {
+        PackPaddingValues(paddingParas[index], &values[index * PADDING_FP16_VALUE_NUM]);
+    }
+    std::vector<uint16_t> fp16Values(values.size());
+    ConvertToFp16(values.data(), fp16Values.data(), values.size());
+
+    for (uint32_t index = 0; index < para.second; ++index) {
+        WritePaddingPara(
+            GetBatchPara(para.first, index), paddingParas[index], &fp16Values[index * PADDING_FP16_VALUE_NUM]);
+    }
+    return SUCCESS;
+}
+
+Status AIPPParaImpl::SetDtcParas(const std::vector<DtcPara>& dtcParas)
+{
+    auto para = GetTensorAippCommPara();
+    HIAI_EXPECT_NOT_NULL(para.first);
+    HIAI_EXPECT_EXEC(CheckBatchParaNum(dtcParas.size(), para.second));
+
+    std::vector<float> values(dtcParas.size() * DTC_FP16_VALUE_NUM);
+    for (size_t index = 0; index < dtcParas.size(); ++index) {
+        PackDtcValues(dtcParas[index], &values[index * DTC_FP16_VALUE_NUM]);
+    }
+    std::vector<uint16_t> fp16Values(values.size());
+    ConvertToFp16(values.data(), fp16Values.data(), values.size());
+
+    for (uint32_t index = 0; index < para.second; ++index) {
+        WriteDtcPara(GetBatchPara(para.first, index), dtcParas[index], &fp16Values[index * DTC_FP16_VALUE_NUM]);
+    }
+    return SUCCESS;
+}
+
 ImageFormat AIPPParaImpl::GetInputFormat(HIAI_MR_TensorAippCommPara* commPara)
 {
     HIAI_EXPECT_NOT_NULL_R(commPara, ImageFormat::INVALID);
 
-    static const std::map<uint8_t, ImageFormat> cceToUserFormat = {
-        {CCE_YUV420SP_U8, ImageFormat::YUV420SP},
-        {CCE_XRGB8888_U8, ImageFormat::XRGB8888},
-        {CCE_NC1HWC0DI_FP16, ImageFormat::INVALID},
-        {CCE_NC1HWC0DI_S8, ImageFormat::INVALID},
-        {CCE_RGB888_U8, ImageFormat::RGB888},
-        {CCE_ARGB8888_U8, ImageFormat::ARGB8888},
-        {CCE_YUYV_U8, ImageFormat::YUYV},
-        {CCE_YUV422SP_U8, ImageFormat::YUV422SP},
-        {CCE_AYUV444_U8, ImageFormat::AYUV444},
-        {CCE_YUV400_U8, ImageFormat::YUV400},
-    };
-    if (cceToUserFormat.find(commPara->inputFormat) == cceToUserFormat.end()) {
+    ImageFormat format = GetImageFormatByAippInput(commPara->inputFormat);
+    if (format == ImageFormat::INVALID) {
         FMK_LOGE("GetInputFormat failed, inputFormat is unknown!");
-        return ImageFormat::INVALID;
     }
-    return cceToUserFormat.at(commPara->inputFormat);
+    return format;
 }
 
 Status AIPPParaImpl::SetInputFormat(ImageFormat inputFormat)
 {
-    static std::map<ImageFormat, CceAippInputFormat> inputFormatMap = {
-        {ImageFormat::YUV420SP, CCE_YUV420SP_U8},
-        {ImageFormat::XRGB8888, CCE_XRGB8888_U8},
-        {ImageFormat::ARGB8888, CCE_ARGB8888_U8},
-        {ImageFormat::YUYV, CCE_YUYV_U8},
-        {ImageFormat::YUV422SP, CCE_YUV422SP_U8},
-        {ImageFormat::AYUV444, CCE_AYUV444_U8},
-        {ImageFormat::YUV400, CCE_YUV400_U8},
-        {ImageFormat::RGB888, CCE_RGB888_U8},
-    };
-    if (inputFormatMap.find(inputFormat) == inputFormatMap.end()) {
+    const ImageFormatDesc* formatDesc = GetImageFormatDesc(inputFormat);
+    if (formatDesc == nullptr || formatDesc->aippInputFormat == 0) {
         FMK_LOGE("SetInputFormat failed, inputFormat: %d is not supported on Lite currently", inputFormat);
         return FAILURE;
     }
     auto para = GetTensorAippCommPara();
     HIAI_EXPECT_NOT_NULL(para.first);
 
-    para.first->inputFormat = inputFormatMap[inputFormat];
+    para.first->inputFormat = formatDesc->aippInputFormat;
     return SUCCESS;
 }
 
@@ -794,6 +901,41 @@ Status AIPPParaImpl::SetInputShape(std::vector<int32_t>& shape)
     return SUCCESS;
 }
 
+Status AIPPParaImpl::SetInputShape(const std::vector<int32_t>& shape, const std::vector<int32_t>& storageShape)
+{
+    if (shape.size() != 2 || storageShape.size() != 2 || shape[0] <= 0 || shape[1] <= 0 ||
+        storageShape[0] < shape[0] || storageShape[1] < shape[1]) {
+        FMK_LOGE("shape or storage shape invalid!");
+        return FAILURE;
+    }
+
+    auto para = GetTensorAippCommPara();
+    HIAI_EXPECT_NOT_NULL(para.first);
+
+    para.first->srcImageSizeW = storageShape[0];
+    para.first->srcImageSizeH = storageShape[1];
+    if (storageShape == shape) {
+        return SUCCESS;
+    }
+
+    CropPara validRegion;
+    validRegion.cropSizeW = static_cast<uint32_t>(shape[0]);
+    validRegion.cropSizeH = static_cast<uint32_t>(shape[1]);
+    for (uint32_t index = 0; index < para.second; ++index) {
+        HIAI_MR_TensorAippBatchPara* batchPara = GetBatchPara(para.first, index);
+        if (batchPara->cropSwitch == 0) {
+            UpdateCropPara(para.first, index, validRegion);
+        } else if (static_cast<uint64_t>(batchPara->cropStartPosW) + batchPara->cropSizeW >
+                static_cast<uint64_t>(shape[0]) ||
+            static_cast<uint64_t>(batchPara->cropStartPosH) + batchPara->cropSizeH > static_cast<uint64_t>(shape[1])) {
+            // 填充区域不是有效像素, 不允许crop到有效区域之外
+            FMK_LOGE("crop of batch %u is out of image [%d, %d].", index, shape[0], shape[1]);
+            return FAILURE;
+        }
+    }
+    return SUCCESS;
+}
+
 Status AIPPParaImpl::GetAippParaBufferImpl(std::shared_ptr<AIPPParaBufferImpl>& aippParaImpl)
 {
     aippParaImpl = make_shared_nothrow<AIPPParaBufferImpl>();
@@ -808,6 +950,36 @@ HIAI_MR_TensorAippPara* AIPPParaImpl::GetParaBuffer()
     return paraBuff_;
 }
 
+Status AIPPParaImpl::SaveSnapshot(AIPPParaSnapshot& snapshot)
+{
+    HIAI_EXPECT_NOT_NULL(GetTensorAippCommPara().first);
+    const uint8_t* data = static_cast<const uint8_t*>(GetData());
+    snapshot.rawData.assign(data, data + GetSize());
+    snapshot.inputIndex = AIPPParaBufferImpl::GetInputIndex(paraBuff_);
+    snapshot.inputAippIndex = AIPPParaBufferImpl::GetInputAippIndex(paraBuff_);
+    return SUCCESS;
+}
+
+Status AIPPParaImpl::LoadSnapshot(const AIPPParaSnapshot& snapshot)
+{
+    void* data = GetData();
+    HIAI_EXPECT_NOT_NULL(data);
+    size_t size = GetSize();
+    if (snapshot.rawData.size() != size) {
+        FMK_LOGE("snapshot size [%zu] is not equal to para size [%zu].", snapshot.rawData.size(), size);
+        return FAILURE;
+    }
+    HIAI_EXPECT_TRUE(memcpy_s(data, size, snapshot.rawData.data(), size) == EOK);
+
+    if (snapshot.inputIndex >= 0) {
+        AIPPParaBufferImpl::SetInputIndex(paraBuff_, static_cast<uint32_t>(snapshot.inputIndex));
+    }
+    if (snapshot.inputAippIndex >= 0) {
+        AIPPParaBufferImpl::SetInputAippIndex(paraBuff_, static_cast<uint32_t>(snapshot.inputAippIndex));
+    }
+    return SUCCESS;
+}
+
 bool AIPPParaImpl::GetEnableCrop(uint32_t batchIndex)
 {
     auto para = GetTensorAippCommPara();
@@ -859,9 +1031,66 @@ std::shared_ptr<IAIPPPara> CreateAIPPPara(uint32_t batchCount)
     }
     return aippPara;
 }
-HIAI_MR_TensorAippPara* GetTensorAippParaFromAippPara(const std::shared_ptr<IAIPPPara>& aippPara)
+template <typename T>
+static Status SetBatchParas(const std::shared_ptr<IAIPPPara>& aippPara, const std::vector<T>& paras,
+    Status (AIPPParaImpl::*setParas)(const std::vector<T>&))
+{
+    std::shared_ptr<AIPPParaImpl> aippParaImpl = std::dynamic_pointer_cast<AIPPParaImpl>(aippPara);
+    if (aippParaImpl == nullptr) {
+        FMK_LOGE("invalid aippPara");
+        return FAILURE;
+    }
+    return (aippParaImpl.get()->*setParas)(paras);
+}
+
+Status SetBatchCropPara(const std::shared_ptr<IAIPPPara>& aippPara, const std::vector<CropPara>& cropParas)
+{
+    return SetBatchParas(aippPara, cropParas, &AIPPParaImpl::SetCropParas);
+}
+
+Status SetBatchResizePara(const std::shared_ptr<IAIPPPara>& aippPara, const std::vector<ResizePara>& resizeParas)
+{
+    return SetBatchParas(aippPara, resizeParas, &AIPPParaImpl::SetResizeParas);
+}
+
+Status SetBatchPaddingPara(const std::shared_ptr<IAIPPPara>& aippPara, const std::vector<PadPara>& paddingParas)
 {
+    return SetBatchParas(aippPara, paddingParas, &AIPPParaImpl::SetPaddingParas);
+}
+
+Status SetBatchDtcPara(const std::shared_ptr<IAIPPPara>& aippPara, const std::vector<DtcPara>& dtcParas)
+{
+    return SetBatchParas(aippPara, dtcParas, &AIPPParaImpl::SetDtcParas);
+}
+
+std::shared_ptr<const AIPPParaSnapshot> CreateAIPPParaSnapshot(const std::shared_ptr<IAIPPPara>& aippPara)
+{
+    std::shared_ptr<AIPPParaImpl> aippParaImpl = std::dynamic_pointer_cast<AIPPParaImpl>(aippPara);
+    if (aippParaImpl == nullptr) {
+        FMK_LOGE("invalid aippPara");
+        return nullptr;
+    }
+    std::shared_ptr<AIPPParaSnapshot> snapshot = make_shared_nothrow<AIPPParaSnapshot>();
+    HIAI_EXPECT_NOT_NULL_R(snapshot, nullptr);
+    HIAI_EXPECT_EXEC_R(aippParaImpl->SaveSnapshot(*snapshot), nullptr);
+    return snapshot;
+}
+
+Status ApplyAIPPParaSnapshot(
+    const std::shared_ptr<const AIPPParaSnapshot>& snapshot, const std::shared_ptr<IAIPPPara>& aippPara)
+{
+    HIAI_EXPECT_NOT_NULL(snapshot);
     std::shared_ptr<AIPPParaImpl> aippParaImpl = std::dynamic_pointer_cast<AIPPParaImpl>(aippPara);
+    if (aippParaImpl == nullptr) {
+        FMK_LOGE("invalid aippPara");
+        return FAILURE;
+    }
+    return aippParaImpl->LoadSnapshot(*snapshot);
+}
+
+HIAI_MR_TensorAippPara* GetTensorAippParaFromAippPara(const std::shared_ptr<IAIPPPara>& aippPara)
+{
+    AIPPParaImpl* aippParaImpl = dynamic_cast<AIPPParaImpl*>(aippPara.get());
     if (aippParaImpl == nullptr) {
         FMK_LOGE("invalid aippPara");
         return nullptr;
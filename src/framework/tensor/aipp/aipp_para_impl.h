@@ -15,10 +15,19 @@
  */
 #ifndef FRAMEWORK_TENSOR_AIPP_PARA_IMPL_H
 #define FRAMEWORK_TENSOR_AIPP_PARA_IMPL_H
+#include <vector>
+
 #include "tensor/aipp_para.h"
 #include "framework/c/hiai_tensor_aipp_para.h"
 
 namespace hiai {
+class AIPPParaSnapshot {
+public:
+    std::vector<uint8_t> rawData; // HIAI_MR_TensorAippPara原始参数内存
+    int32_t inputIndex {-1};
+    int32_t inputAippIndex {-1};
+};
+
 using TensorAippCommPara = std::pair<HIAI_MR_TensorAippCommPara*, uint8_t>;
 
 class AIPPParaBufferImpl {
@@ -74,11 +83,19 @@ public:
     Status SetDtcPara(uint32_t batchIndex, DtcPara&& dtcPara) override;
     DtcPara GetDtcPara(uint32_t batchIndex) override;
 
+    // 批量设置全部batch的参数, 先统一校验再写入, paras个数需与batch数一致
+    Status SetCropParas(const std::vector<CropPara>& cropParas);
+    Status SetResizeParas(const std::vector<ResizePara>& resizeParas);
+    Status SetPaddingParas(const std::vector<PadPara>& paddingParas);
+    Status SetDtcParas(const std::vector<DtcPara>& dtcParas);
+
     // internel
     Status SetInputFormat(ImageFormat inputFormat) override;
     ImageFormat GetInputFormat() override;
     std::vector<int32_t> GetInputShape() override;
     Status SetInputShape(std::vector<int32_t>& shape) override;
+    // 带行跨度填充的输入图片: srcImageSize取存储宽高, 未开启crop的batch裁剪出shape指定的有效区域
+    Status SetInputShape(const std::vector<int32_t>& shape, const std::vector<int32_t>& storageShape);
 
     void* GetData() override;
 
@@ -86,6 +103,9 @@ public:
 
     HIAI_TENSOR_API_EXPORT HIAI_MR_TensorAippPara* GetParaBuffer();
 
+    Status SaveSnapshot(AIPPParaSnapshot& snapshot);
+    Status LoadSnapshot(const AIPPParaSnapshot& snapshot);
+
 public:
     bool GetEnableCrop(uint32_t batchIndex);
 
@@ -16,6 +16,7 @@
 #include "nd_tensor_buffer_impl.h"
 #include "framework/c/hiai_nd_tensor_buffer.h"
 #include "hiai_nd_tensor_buffer_def.h"
+#include "hiai_nd_tensor_buffer_util.h"
 #include "infra/base/securestl.h"
 #include "securec.h"
 #include "framework/infra/log/log.h"
@@ -143,6 +144,20 @@ HIAI_MR_NDTensorBuffer* CreateHIAINDTensorBuffer(const NDTensorDesc& tensorDesc,
     return ndTensor;
 }
 
+HIAI_MR_NDTensorBuffer* CreateHIAINDTensorBufferNoCopy(const NDTensorDesc& tensorDesc, void* data, size_t dataSize)
+{
+    if (data == nullptr || dataSize == 0) {
+        FMK_LOGE("create nd tensor buffer no copy: data is null or size is 0.");
+        return nullptr;
+    }
+    std::shared_ptr<HIAI_NDTensorDesc> cTensorDesc = Convert2CTensorDesc(tensorDesc);
+    if (cTensorDesc == nullptr) {
+        FMK_LOGE("create nd tensor buffer no copy: Convert2CTensorDesc failed.");
+        return nullptr;
+    }
+    return HIAI_MR_NDTensorBuffer_Create(cTensorDesc.get(), data, dataSize, nullptr, false, false);
+}
+
 std::shared_ptr<INDTensorBuffer> CreateNDTensorBuffer(const NDTensorDesc& tensorDesc, const NativeHandle& handle)
 {
     H_LOG_INTERFACE_FILTER(ITF_COUNT);
@@ -155,7 +170,8 @@ std::shared_ptr<INDTensorBuffer> CreateNDTensorBuffer(const NDTensorDesc& tensor
 
 HIAI_MR_NDTensorBuffer* GetRawBufferFromNDTensorBuffer(const std::shared_ptr<INDTensorBuffer>& buffer)
 {
-    std::shared_ptr<NDTensorBufferImpl> bufferImpl = std::dynamic_pointer_cast<NDTensorBufferImpl>(buffer);
+    // 推理路径上逐输入调用, 直接转换裸指针, 不增减引用计数
+    NDTensorBufferImpl* bufferImpl = dynamic_cast<NDTensorBufferImpl*>(buffer.get());
     if (bufferImpl == nullptr) {
         FMK_LOGE("invalid buffer");
         return nullptr;
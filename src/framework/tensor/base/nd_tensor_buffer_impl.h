@@ -52,6 +52,8 @@ HIAI_MR_NDTensorBuffer* CreateHIAINDTensorBuffer(
 std::shared_ptr<INDTensorBuffer> CreateNDTensorBuffer(
     const NDTensorDesc& tensorDesc, size_t dataSize, HIAI_ImageFormat format);
 HIAI_MR_NDTensorBuffer* CreateHIAINDTensorBuffer(const NDTensorDesc& tensorDesc, const NativeHandle& handle);
+// 引用外部内存, 不校验dataSize与desc是否匹配, 析构时不释放data
+HIAI_MR_NDTensorBuffer* CreateHIAINDTensorBufferNoCopy(const NDTensorDesc& tensorDesc, void* data, size_t dataSize);
 HIAI_TENSOR_API_EXPORT HIAI_MR_NDTensorBuffer* GetRawBufferFromNDTensorBuffer(
     const std::shared_ptr<INDTensorBuffer>& buffer);
 } // namespace hiai
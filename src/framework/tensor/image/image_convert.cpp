@@ -0,0 +1,252 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "tensor/image_convert.h"
+
+#include "image_convert_kernel.h"
+#include "tensor/image/image_csc_table.h"
+#include "tensor/image/image_format_desc.h"
+#include "framework/infra/log/log.h"
+#include "infra/base/assertion.h"
+
+namespace hiai {
+namespace {
+struct ImageDims {
+    size_t batch {0};
+    size_t height {0};
+    size_t width {0};
+};
+
+RgbLayout MakeRgbLayout(uint32_t channel, uint32_t rIdx, uint32_t gIdx, uint32_t bIdx, int32_t xIdx)
+{
+    RgbLayout layout;
+    layout.channel = channel;
+    layout.rIdx = rIdx;
+    layout.gIdx = gIdx;
+    layout.bIdx = bIdx;
+    layout.xIdx = xIdx;
+    return layout;
+}
+
+Status GetRgbLayout(ImageFormat format, RgbLayout& layout)
+{
+    switch (format) {
+        case ImageFormat::RGB888:
+            layout = MakeRgbLayout(3, 0, 1, 2, -1);
+            return SUCCESS;
+        case ImageFormat::BGR888:
+            layout = MakeRgbLayout(3, 2, 1, 0, -1);
+            return SUCCESS;
+        case ImageFormat::XRGB8888:
+        case ImageFormat::ARGB8888:
+            layout = MakeRgbLayout(4, 1, 2, 3, 0);
+            return SUCCESS;
+        default:
+            FMK_LOGE("format %d is not a interleaved rgb format.", static_cast<int32_t>(format));
+            return FAILURE;
+    }
+}
+
+Status GetCscCoeff(ImageColorSpace colorSpace, const int32_t (&table)[4][3][3], CscCoeff& coeff)
+{
+    if (colorSpace < ImageColorSpace::JPEG || colorSpace > ImageColorSpace::BT_709_NARROW) {
+        FMK_LOGE("colorSpace %d is invalid.", static_cast<int32_t>(colorSpace));
+        return FAILURE;
+    }
+    const auto& matrix = table[static_cast<uint32_t>(colorSpace)];
+    for (uint32_t i = 0; i < 3; ++i) {
+        for (uint32_t j = 0; j < 3; ++j) {
+            coeff.matrix[i][j] = static_cast<int16_t>(matrix[i][j]);
+        }
+    }
+    coeff.yBias = static_cast<int16_t>(GetCscYBias(colorSpace));
+    return SUCCESS;
+}
+
+Status GetImageDims(const std::shared_ptr<IImageTensorBuffer>& image, ImageFormat expectFormat, ImageDims& dims)
+{
+    HIAI_EXPECT_NOT_NULL(image);
+    HIAI_EXPECT_NOT_NULL(image->GetData());
+    if (expectFormat != ImageFormat::INVALID && image->Format() != expectFormat) {
+        FMK_LOGE("image format %d is not supported, expect %d.", static_cast<int32_t>(image->Format()),
+            static_cast<int32_t>(expectFormat));
+        return FAILURE;
+    }
+    if (image->Batch() <= 0 || image->Height() <= 0 || image->Width() <= 0) {
+        FMK_LOGE("image shape [%d, %d, %d] is invalid.", image->Batch(), image->Height(), image->Width());
+        return FAILURE;
+    }
+    dims.batch = static_cast<size_t>(image->Batch());
+    dims.height = static_cast<size_t>(image->Height());
+    dims.width = static_cast<size_t>(image->Width());
+    return SUCCESS;
+}
+
+// format需为已校验过的格式
+size_t GetFormatImageSize(ImageFormat format, const ImageDims& dims)
+{
+    return static_cast<size_t>(GetImageSize(*GetImageFormatDesc(format), dims.height, dims.width));
+}
+
+Status CheckEvenSize(const ImageDims& dims, bool checkHeight)
+{
+    if ((dims.width % 2) != 0 || (checkHeight && (dims.height % 2) != 0)) {
+        FMK_LOGE("image size [%zu, %zu] should be even.", dims.height, dims.width);
+        return FAILURE;
+    }
+    return SUCCESS;
+}
+
+Status CheckBufferSize(const void* data, size_t size, size_t expectSize, const char* name)
+{
+    HIAI_EXPECT_NOT_NULL(data);
+    if (size != expectSize) {
+        FMK_LOGE("%s size %zu is not equal to %zu.", name, size, expectSize);
+        return FAILURE;
+    }
+    return SUCCESS;
+}
+} // namespace
+
+Status ConvertYuv420SPToRgb(const uint8_t* src, size_t srcSize, YuvSemiPlanarOrder order,
+    ImageColorSpace colorSpace, const std::shared_ptr<IImageTensorBuffer>& dst)
+{
+    ImageDims dims;
+    HIAI_EXPECT_EXEC(GetImageDims(dst, ImageFormat::INVALID, dims));
+    RgbLayout layout;
+    HIAI_EXPECT_EXEC(GetRgbLayout(dst->Format(), layout));
+    HIAI_EXPECT_TRUE(dst->Format() != ImageFormat::ARGB8888);
+    HIAI_EXPECT_EXEC(CheckEvenSize(dims, true));
+    CscCoeff coeff;
+    HIAI_EXPECT_EXEC(GetCscCoeff(colorSpace, YUV_TO_RGB, coeff));
+
+    const size_t planeSize = dims.height * dims.width;
+    const size_t srcImageSize = GetFormatImageSize(ImageFormat::YUV420SP, dims);
+    const size_t dstImageSize = GetFormatImageSize(dst->Format(), dims);
+    HIAI_EXPECT_EXEC(CheckBufferSize(src, srcSize, srcImageSize * dims.batch, "src"));
+    HIAI_EXPECT_EXEC(CheckBufferSize(dst->GetData(), dst->GetSize(), dstImageSize * dims.batch, "dst"));
+
+    uint8_t* dstData = static_cast<uint8_t*>(dst->GetData());
+    const bool vuOrder = order == YuvSemiPlanarOrder::NV21;
+    for (size_t n = 0; n < dims.batch; ++n) {
+        const uint8_t* y = src + n * srcImageSize;
+        const uint8_t* uv = y + planeSize;
+        uint8_t* image = dstData + n * dstImageSize;
+        for (size_t h = 0; h < dims.height; ++h) {
+            ConvertYuv420SPRowToRgb(y + h * dims.width, uv + (h / 2) * dims.width, vuOrder, coeff, layout,
+                image + h * dims.width * layout.channel, dims.width);
+        }
+    }
+    return SUCCESS;
+}
+
+Status ConvertRgbToYuv420SP(const uint8_t* src, size_t srcSize, ImageFormat srcFormat, YuvSemiPlanarOrder order,
+    const std::shared_ptr<IImageTensorBuffer>& dst)
+{
+    ImageDims dims;
+    HIAI_EXPECT_EXEC(GetImageDims(dst, ImageFormat::YUV420SP, dims));
+    RgbLayout layout;
+    HIAI_EXPECT_EXEC(GetRgbLayout(srcFormat, layout));
+    HIAI_EXPECT_TRUE(srcFormat != ImageFormat::ARGB8888);
+    HIAI_EXPECT_EXEC(CheckEvenSize(dims, true));
+    CscCoeff coeff;
+    HIAI_EXPECT_EXEC(GetCscCoeff(dst->ColorSpace(), RGB_TO_YUV, coeff));
+
+    const size_t planeSize = dims.height * dims.width;
+    const size_t srcImageSize = GetFormatImageSize(srcFormat, dims);
+    const size_t dstImageSize = GetFormatImageSize(ImageFormat::YUV420SP, dims);
+    HIAI_EXPECT_EXEC(CheckBufferSize(src, srcSize, srcImageSize * dims.batch, "src"));
+    HIAI_EXPECT_EXEC(CheckBufferSize(dst->GetData(), dst->GetSize(), dstImageSize * dims.batch, "dst"));
+
+    uint8_t* dstData = static_cast<uint8_t*>(dst->GetData());
+    const bool vuOrder = order == YuvSemiPlanarOrder::NV21;
+    const size_t srcStride = dims.width * layout.channel;
+    for (size_t n = 0; n < dims.batch; ++n) {
+        const uint8_t* image = src + n * srcImageSize;
+        uint8_t* y = dstData + n * dstImageSize;
+        uint8_t* uv = y + planeSize;
+        for (size_t h = 0; h < dims.height; ++h) {
+            ConvertRgbRowToY(image + h * srcStride, layout, coeff, y + h * dims.width, dims.width);
+        }
+        for (size_t h = 0; h < dims.height; h += 2) {
+            ConvertRgbRowsToUV(image + h * srcStride, image + (h + 1) * srcStride, layout, coeff, vuOrder,
+                uv + (h / 2) * dims.width, dims.width);
+        }
+    }
+    return SUCCESS;
+}
+
+Status ConvertYuyvToYuv422SP(const uint8_t* src, size_t srcSize, const std::shared_ptr<IImageTensorBuffer>& dst)
+{
+    ImageDims dims;
+    HIAI_EXPECT_EXEC(GetImageDims(dst, ImageFormat::YUV422SP, dims));
+    HIAI_EXPECT_EXEC(CheckEvenSize(dims, false));
+
+    const size_t planeSize = dims.height * dims.width;
+    const size_t imageSize = GetFormatImageSize(ImageFormat::YUV422SP, dims);
+    HIAI_EXPECT_EXEC(CheckBufferSize(src, srcSize, imageSize * dims.batch, "src"));
+    HIAI_EXPECT_EXEC(CheckBufferSize(dst->GetData(), dst->GetSize(), imageSize * dims.batch, "dst"));
+
+    uint8_t* dstData = static_cast<uint8_t*>(dst->GetData());
+    for (size_t n = 0; n < dims.batch; ++n) {
+        uint8_t* y = dstData + n * imageSize;
+        // YUYV与YUV422SP的UV行宽度相同, 整张图片可按一行处理
+        ConvertYuyvRowToYuv422SP(src + n * imageSize, y, y + planeSize, planeSize);
+    }
+    return SUCCESS;
+}
+
+Status ConvertPlanarToInterleaved(const uint8_t* src, size_t srcSize, const std::shared_ptr<IImageTensorBuffer>& dst)
+{
+    ImageDims dims;
+    HIAI_EXPECT_EXEC(GetImageDims(dst, ImageFormat::INVALID, dims));
+    RgbLayout layout;
+    HIAI_EXPECT_EXEC(GetRgbLayout(dst->Format(), layout));
+
+    const size_t planeSize = dims.height * dims.width;
+    const size_t imageSize = GetFormatImageSize(dst->Format(), dims);
+    HIAI_EXPECT_EXEC(CheckBufferSize(src, srcSize, imageSize * dims.batch, "src"));
+    HIAI_EXPECT_EXEC(CheckBufferSize(dst->GetData(), dst->GetSize(), imageSize * dims.batch, "dst"));
+
+    uint8_t* dstData = static_cast<uint8_t*>(dst->GetData());
+    for (size_t n = 0; n < dims.batch; ++n) {
+        const uint8_t* image = src + n * imageSize;
+        const uint8_t* planes[4] = {image, image + planeSize, image + planeSize * 2, image + planeSize * 3};
+        InterleavePlanes(planes, layout.channel, dstData + n * imageSize, planeSize);
+    }
+    return SUCCESS;
+}
+
+Status ConvertInterleavedToPlanar(const std::shared_ptr<IImageTensorBuffer>& src, uint8_t* dst, size_t dstSize)
+{
+    ImageDims dims;
+    HIAI_EXPECT_EXEC(GetImageDims(src, ImageFormat::INVALID, dims));
+    RgbLayout layout;
+    HIAI_EXPECT_EXEC(GetRgbLayout(src->Format(), layout));
+
+    const size_t planeSize = dims.height * dims.width;
+    const size_t imageSize = GetFormatImageSize(src->Format(), dims);
+    HIAI_EXPECT_EXEC(CheckBufferSize(src->GetData(), src->GetSize(), imageSize * dims.batch, "src"));
+    HIAI_EXPECT_EXEC(CheckBufferSize(dst, dstSize, imageSize * dims.batch, "dst"));
+
+    const uint8_t* srcData = static_cast<const uint8_t*>(src->GetData());
+    for (size_t n = 0; n < dims.batch; ++n) {
+        uint8_t* image = dst + n * imageSize;
+        uint8_t* planes[4] = {image, image + planeSize, image + planeSize * 2, image + planeSize * 3};
+        DeinterleavePlanes(srcData + n * imageSize, layout.channel, planes, planeSize);
+    }
+    return SUCCESS;
+}
+} // namespace hiai
@@ -0,0 +1,515 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "image_convert_kernel.h"
+
+#include "tensor/image/image_csc_table.h"
+
+#if defined(__SSE2__)
+#if defined(__AVX2__)
+#include <immintrin.h>
+#else
+#include <emmintrin.h>
+#endif
+#elif defined(ARM_NEON) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#define IMAGE_CONVERT_NEON
+#endif
+
+namespace hiai {
+namespace {
+constexpr int32_t CSC_SHIFT = 8;
+constexpr int32_t CSC_ROUND = 1 << (CSC_SHIFT - 1);
+
+inline uint8_t ClampToU8(int32_t value)
+{
+    return static_cast<uint8_t>(value < 0 ? 0 : (value > UINT8_MAX ? UINT8_MAX : value));
+}
+
+inline int32_t CscDot(const int16_t (&row)[3], int32_t a, int32_t b, int32_t c)
+{
+    return (row[0] * a + row[1] * b + row[2] * c + CSC_ROUND) >> CSC_SHIFT;
+}
+
+#if defined(__SSE2__)
+constexpr size_t SSE_PIXELS = 16;
+
+// 两个int16系数按(lo, hi)组合, 供_mm_madd_epi16使用
+inline int32_t PairCoeff(int16_t lo, int16_t hi)
+{
+    return static_cast<int32_t>(static_cast<uint32_t>(static_cast<uint16_t>(lo)) |
+        (static_cast<uint32_t>(static_cast<uint16_t>(hi)) << 16));
+}
+
+// 8个像素: (c0 * a + c1 * b + c2 * c + 128) >> 8, ab为(c0, c1), cr为(c2, 128)
+inline __m128i CscMadd8(__m128i a, __m128i b, __m128i c, __m128i ab, __m128i cr)
+{
+    const __m128i one = _mm_set1_epi16(1);
+    __m128i lo = _mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(a, b), ab),
+        _mm_madd_epi16(_mm_unpacklo_epi16(c, one), cr));
+    __m128i hi = _mm_add_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(a, b), ab),
+        _mm_madd_epi16(_mm_unpackhi_epi16(c, one), cr));
+    return _mm_packs_epi32(_mm_srai_epi32(lo, CSC_SHIFT), _mm_srai_epi32(hi, CSC_SHIFT));
+}
+
+// even为a, b的偶数字节, odd为奇数字节
+inline void SplitEvenOdd(__m128i a, __m128i b, __m128i& even, __m128i& odd)
+{
+    const __m128i lowMask = _mm_set1_epi16(0x00FF);
+    even = _mm_packus_epi16(_mm_and_si128(a, lowMask), _mm_and_si128(b, lowMask));
+    odd = _mm_packus_epi16(_mm_srli_epi16(a, 8), _mm_srli_epi16(b, 8));
+}
+
+inline void Deinterleave4x16(const uint8_t* src, __m128i (&planes)[4])
+{
+    __m128i even0;
+    __m128i odd0;
+    __m128i even1;
+    __m128i odd1;
+    SplitEvenOdd(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src)),
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 16)), even0, odd0);
+    SplitEvenOdd(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 32)),
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 48)), even1, odd1);
+    SplitEvenOdd(even0, even1, planes[0], planes[2]);
+    SplitEvenOdd(odd0, odd1, planes[1], planes[3]);
+}
+
+inline void Interleave4x16(const __m128i (&planes)[4], uint8_t* dst)
+{
+    __m128i p01Lo = _mm_unpacklo_epi8(planes[0], planes[1]);
+    __m128i p01Hi = _mm_unpackhi_epi8(planes[0], planes[1]);
+    __m128i p23Lo = _mm_unpacklo_epi8(planes[2], planes[3]);
+    __m128i p23Hi = _mm_unpackhi_epi8(planes[2], planes[3]);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_unpacklo_epi16(p01Lo, p23Lo));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 16), _mm_unpackhi_epi16(p01Lo, p23Lo));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 32), _mm_unpacklo_epi16(p01Hi, p23Hi));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 48), _mm_unpackhi_epi16(p01Hi, p23Hi));
+}
+
+// count个像素的R/G/B平面写入dst, 4通道且count为16的倍数时按向量交织
+void StoreRgb(const uint8_t* r, const uint8_t* g, const uint8_t* b, const RgbLayout& layout, uint8_t* dst,
+    size_t count)
+{
+    size_t i = 0;
+    if (layout.channel == 4 && layout.xIdx >= 0) {
+        __m128i planes[4];
+        for (; i + SSE_PIXELS <= count; i += SSE_PIXELS) {
+            planes[layout.rIdx] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r + i));
+            planes[layout.gIdx] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(g + i));
+            planes[layout.bIdx] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+            planes[layout.xIdx] = _mm_set1_epi8(static_cast<char>(UINT8_MAX));
+            Interleave4x16(planes, dst + i * layout.channel);
+        }
+    }
+    for (; i < count; ++i) {
+        uint8_t* px = dst + i * layout.channel;
+        px[layout.rIdx] = r[i];
+        px[layout.gIdx] = g[i];
+        px[layout.bIdx] = b[i];
+        if (layout.xIdx >= 0) {
+            px[layout.xIdx] = UINT8_MAX;
+        }
+    }
+}
+#endif
+
+#if defined(__AVX2__)
+constexpr size_t AVX_PIXELS = 32;
+
+// 与CscMadd8相同, unpack/pack均在128位lane内进行, 像素顺序保持不变
+inline __m256i CscMadd16(__m256i a, __m256i b, __m256i c, __m256i ab, __m256i cr)
+{
+    const __m256i one = _mm256_set1_epi16(1);
+    __m256i lo = _mm256_add_epi32(_mm256_madd_epi16(_mm256_unpacklo_epi16(a, b), ab),
+        _mm256_madd_epi16(_mm256_unpacklo_epi16(c, one), cr));
+    __m256i hi = _mm256_add_epi32(_mm256_madd_epi16(_mm256_unpackhi_epi16(a, b), ab),
+        _mm256_madd_epi16(_mm256_unpackhi_epi16(c, one), cr));
+    return _mm256_packs_epi32(_mm256_srai_epi32(lo, CSC_SHIFT), _mm256_srai_epi32(hi, CSC_SHIFT));
+}
+#endif
+
+#if defined(IMAGE_CONVERT_NEON)
+constexpr size_t NEON_PIXELS = 16;
+
+// 8个像素: (c0 * a + c1 * b + c2 * c + 128) >> 8
+inline int16x8_t CscMac8(int16x8_t a, int16x8_t b, int16x8_t c, const int16_t (&row)[3])
+{
+    int32x4_t lo = vdupq_n_s32(CSC_ROUND);
+    lo = vmlal_n_s16(lo, vget_low_s16(a), row[0]);
+    lo = vmlal_n_s16(lo, vget_low_s16(b), row[1]);
+    lo = vmlal_n_s16(lo, vget_low_s16(c), row[2]);
+    int32x4_t hi = vdupq_n_s32(CSC_ROUND);
+    hi = vmlal_n_s16(hi, vget_high_s16(a), row[0]);
+    hi = vmlal_n_s16(hi, vget_high_s16(b), row[1]);
+    hi = vmlal_n_s16(hi, vget_high_s16(c), row[2]);
+    return vcombine_s16(vqmovn_s32(vshrq_n_s32(lo, CSC_SHIFT)), vqmovn_s32(vshrq_n_s32(hi, CSC_SHIFT)));
+}
+
+inline int16x8_t WidenU8(uint8x8_t value)
+{
+    return vreinterpretq_s16_u16(vmovl_u8(value));
+}
+#endif
+} // namespace
+
+void ConvertYuv420SPRowToRgbScalar(const uint8_t* y, const uint8_t* uv, bool vuOrder, const CscCoeff& coeff,
+    const RgbLayout& layout, uint8_t* dst, size_t width)
+{
+    const size_t uIdx = vuOrder ? 1 : 0;
+    for (size_t x = 0; x < width; ++x) {
+        const uint8_t* uvPair = uv + (x & ~static_cast<size_t>(1));
+        int32_t yValue = y[x] - coeff.yBias;
+        int32_t uValue = uvPair[uIdx] - CSC_UV_BIAS;
+        int32_t vValue = uvPair[1 - uIdx] - CSC_UV_BIAS;
+        uint8_t* px = dst + x * layout.channel;
+        px[layout.rIdx] = ClampToU8(CscDot(coeff.matrix[0], yValue, uValue, vValue));
+        px[layout.gIdx] = ClampToU8(CscDot(coeff.matrix[1], yValue, uValue, vValue));
+        px[layout.bIdx] = ClampToU8(CscDot(coeff.matrix[2], yValue, uValue, vValue));
+        if (layout.xIdx >= 0) {
+            px[layout.xIdx] = UINT8_MAX;
+        }
+    }
+}
+
+void ConvertYuv420SPRowToRgb(const uint8_t* y, const uint8_t* uv, bool vuOrder, const CscCoeff& coeff,
+    const RgbLayout& layout, uint8_t* dst, size_t width)
+{
+    size_t x = 0;
+#if defined(__AVX2__)
+    {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i yBias = _mm256_set1_epi16(coeff.yBias);
+        const __m256i uvBias = _mm256_set1_epi16(CSC_UV_BIAS);
+        const __m256i lowMask = _mm256_set1_epi16(0x00FF);
+        __m256i coeffYU[3];
+        __m256i coeffV[3];
+        for (uint32_t k = 0; k < 3; ++k) {
+            coeffYU[k] = _mm256_set1_epi32(PairCoeff(coeff.matrix[k][0], coeff.matrix[k][1]));
+            coeffV[k] = _mm256_set1_epi32(PairCoeff(coeff.matrix[k][2], CSC_ROUND));
+        }
+        alignas(32) uint8_t rgb[3][AVX_PIXELS];
+        for (; x + AVX_PIXELS <= width; x += AVX_PIXELS) {
+            __m256i yRaw = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(y + x));
+            __m256i uvRaw = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(uv + x));
+            __m256i yLo = _mm256_sub_epi16(_mm256_unpacklo_epi8(yRaw, zero), yBias);
+            __m256i yHi = _mm256_sub_epi16(_mm256_unpackhi_epi8(yRaw, zero), yBias);
+            __m256i first = _mm256_sub_epi16(_mm256_and_si256(uvRaw, lowMask), uvBias);
+            __m256i second = _mm256_sub_epi16(_mm256_srli_epi16(uvRaw, 8), uvBias);
+            __m256i u = vuOrder ? second : first;
+            __m256i v = vuOrder ? first : second;
+            // 每个UV对应两个像素
+            __m256i uLo = _mm256_unpacklo_epi16(u, u);
+            __m256i uHi = _mm256_unpackhi_epi16(u, u);
+            __m256i vLo = _mm256_unpacklo_epi16(v, v);
+            __m256i vHi = _mm256_unpackhi_epi16(v, v);
+            for (uint32_t k = 0; k < 3; ++k) {
+                __m256i lo = CscMadd16(yLo, uLo, vLo, coeffYU[k], coeffV[k]);
+                __m256i hi = CscMadd16(yHi, uHi, vHi, coeffYU[k], coeffV[k]);
+                _mm256_store_si256(reinterpret_cast<__m256i*>(rgb[k]), _mm256_packus_epi16(lo, hi));
+            }
+            StoreRgb(rgb[0], rgb[1], rgb[2], layout, dst + x * layout.channel, AVX_PIXELS);
+        }
+    }
+#endif
+#if defined(__SSE2__)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i yBias = _mm_set1_epi16(coeff.yBias);
+        const __m128i uvBias = _mm_set1_epi16(CSC_UV_BIAS);
+        const __m128i lowMask = _mm_set1_epi16(0x00FF);
+        __m128i coeffYU[3];
+        __m128i coeffV[3];
+        for (uint32_t k = 0; k < 3; ++k) {
+            coeffYU[k] = _mm_set1_epi32(PairCoeff(coeff.matrix[k][0], coeff.matrix[k][1]));
+            coeffV[k] = _mm_set1_epi32(PairCoeff(coeff.matrix[k][2], CSC_ROUND));
+        }
+        alignas(16) uint8_t rgb[3][SSE_PIXELS];
+        for (; x + SSE_PIXELS <= width; x += SSE_PIXELS) {
+            __m128i yRaw = _mm_loadu_si128(reinterpret_cast<const __m128i*>(y + x));
+            __m128i uvRaw = _mm_loadu_si128(reinterpret_cast<const __m128i*>(uv + x));
+            __m128i yLo = _mm_sub_epi16(_mm_unpacklo_epi8(yRaw, zero), yBias);
+            __m128i yHi = _mm_sub_epi16(_mm_unpackhi_epi8(yRaw, zero), yBias);
+            __m128i first = _mm_sub_epi16(_mm_and_si128(uvRaw, lowMask), uvBias);
+            __m128i second = _mm_sub_epi16(_mm_srli_epi16(uvRaw, 8), uvBias);
+            __m128i u = vuOrder ? second : first;
+            __m128i v = vuOrder ? first : second;
+            __m128i uLo = _mm_unpacklo_epi16(u, u);
+            __m128i uHi = _mm_unpackhi_epi16(u, u);
+            __m128i vLo = _mm_unpacklo_epi16(v, v);
+            __m128i vHi = _mm_unpackhi_epi16(v, v);
+            for (uint32_t k = 0; k < 3; ++k) {
+                __m128i lo = CscMadd8(yLo, uLo, vLo, coeffYU[k], coeffV[k]);
+                __m128i hi = CscMadd8(yHi, uHi, vHi, coeffYU[k], coeffV[k]);
+                _mm_store_si128(reinterpret_cast<__m128i*>(rgb[k]), _mm_packus_epi16(lo, hi));
+            }
+            StoreRgb(rgb[0], rgb[1], rgb[2], layout, dst + x * layout.channel, SSE_PIXELS);
+        }
+    }
+#elif defined(IMAGE_CONVERT_NEON)
+    {
+        const int16x8_t yBias = vdupq_n_s16(coeff.yBias);
+        const int16x8_t uvBias = vdupq_n_s16(CSC_UV_BIAS);
+        for (; x + NEON_PIXELS <= width; x += NEON_PIXELS) {
+            uint8x16_t yRaw = vld1q_u8(y + x);
+            uint8x8x2_t uvRaw = vld2_u8(uv + x);
+            uint8x8_t uRaw = vuOrder ? uvRaw.val[1] : uvRaw.val[0];
+            uint8x8_t vRaw = vuOrder ? uvRaw.val[0] : uvRaw.val[1];
+            // 每个UV对应两个像素, val[0]为前8个像素, val[1]为后8个像素
+            uint8x8x2_t uDup = vzip_u8(uRaw, uRaw);
+            uint8x8x2_t vDup = vzip_u8(vRaw, vRaw);
+            uint8x8_t yHalf[2] = {vget_low_u8(yRaw), vget_high_u8(yRaw)};
+            uint8x8_t rgb[3][2];
+            for (uint32_t h = 0; h < 2; ++h) {
+                int16x8_t yValue = vsubq_s16(WidenU8(yHalf[h]), yBias);
+                int16x8_t uValue = vsubq_s16(WidenU8(uDup.val[h]), uvBias);
+                int16x8_t vValue = vsubq_s16(WidenU8(vDup.val[h]), uvBias);
+                for (uint32_t k = 0; k < 3; ++k) {
+                    rgb[k][h] = vqmovun_s16(CscMac8(yValue, uValue, vValue, coeff.matrix[k]));
+                }
+            }
+            uint8x16_t r = vcombine_u8(rgb[0][0], rgb[0][1]);
+            uint8x16_t g = vcombine_u8(rgb[1][0], rgb[1][1]);
+            uint8x16_t b = vcombine_u8(rgb[2][0], rgb[2][1]);
+            if (layout.channel == 4 && layout.xIdx >= 0) {
+                uint8x16x4_t out;
+                out.val[layout.rIdx] = r;
+                out.val[layout.gIdx] = g;
+                out.val[layout.bIdx] = b;
+                out.val[layout.xIdx] = vdupq_n_u8(UINT8_MAX);
+                vst4q_u8(dst + x * layout.channel, out);
+            } else {
+                uint8x16x3_t out;
+                out.val[layout.rIdx] = r;
+                out.val[layout.gIdx] = g;
+                out.val[layout.bIdx] = b;
+                vst3q_u8(dst + x * layout.channel, out);
+            }
+        }
+    }
+#endif
+    ConvertYuv420SPRowToRgbScalar(y + x, uv + x, vuOrder, coeff, layout, dst + x * layout.channel, width - x);
+}
+
+void ConvertRgbRowToYScalar(
+    const uint8_t* rgb, const RgbLayout& layout, const CscCoeff& coeff, uint8_t* y, size_t width)
+{
+    for (size_t x = 0; x < width; ++x) {
+        const uint8_t* px = rgb + x * layout.channel;
+        y[x] = ClampToU8(CscDot(coeff.matrix[0], px[layout.rIdx], px[layout.gIdx], px[layout.bIdx]) + coeff.yBias);
+    }
+}
+
+void ConvertRgbRowToY(const uint8_t* rgb, const RgbLayout& layout, const CscCoeff& coeff, uint8_t* y, size_t width)
+{
+    size_t x = 0;
+#if defined(__SSE2__)
+    // 3通道交织数据SSE2下无高效的拆分方式, 仅4通道走向量实现
+    if (layout.channel == 4) {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i yBias = _mm_set1_epi16(coeff.yBias);
+        const __m128i coeffRG = _mm_set1_epi32(PairCoeff(coeff.matrix[0][0], coeff.matrix[0][1]));
+        const __m128i coeffB = _mm_set1_epi32(PairCoeff(coeff.matrix[0][2], CSC_ROUND));
+        __m128i planes[4];
+        for (; x + SSE_PIXELS <= width; x += SSE_PIXELS) {
+            Deinterleave4x16(rgb + x * layout.channel, planes);
+            __m128i r = planes[layout.rIdx];
+            __m128i g = planes[layout.gIdx];
+            __m128i b = planes[layout.bIdx];
+            __m128i lo = CscMadd8(_mm_unpacklo_epi8(r, zero), _mm_unpacklo_epi8(g, zero),
+                _mm_unpacklo_epi8(b, zero), coeffRG, coeffB);
+            __m128i hi = CscMadd8(_mm_unpackhi_epi8(r, zero), _mm_unpackhi_epi8(g, zero),
+                _mm_unpackhi_epi8(b, zero), coeffRG, coeffB);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(y + x),
+                _mm_packus_epi16(_mm_add_epi16(lo, yBias), _mm_add_epi16(hi, yBias)));
+        }
+    }
+#elif defined(IMAGE_CONVERT_NEON)
+    const int16x8_t yBias = vdupq_n_s16(coeff.yBias);
+    for (; x + NEON_PIXELS <= width; x += NEON_PIXELS) {
+        uint8x16_t r;
+        uint8x16_t g;
+        uint8x16_t b;
+        if (layout.channel == 4) {
+            uint8x16x4_t px = vld4q_u8(rgb + x * layout.channel);
+            r = px.val[layout.rIdx];
+            g = px.val[layout.gIdx];
+            b = px.val[layout.bIdx];
+        } else {
+            uint8x16x3_t px = vld3q_u8(rgb + x * layout.channel);
+            r = px.val[layout.rIdx];
+            g = px.val[layout.gIdx];
+            b = px.val[layout.bIdx];
+        }
+        int16x8_t lo = CscMac8(
+            WidenU8(vget_low_u8(r)), WidenU8(vget_low_u8(g)), WidenU8(vget_low_u8(b)), coeff.matrix[0]);
+        int16x8_t hi = CscMac8(
+            WidenU8(vget_high_u8(r)), WidenU8(vget_high_u8(g)), WidenU8(vget_high_u8(b)), coeff.matrix[0]);
+        vst1q_u8(y + x, vcombine_u8(vqmovun_s16(vaddq_s16(lo, yBias)), vqmovun_s16(vaddq_s16(hi, yBias))));
+    }
+#endif
+    ConvertRgbRowToYScalar(rgb + x * layout.channel, layout, coeff, y + x, width - x);
+}
+
+void ConvertRgbRowsToUV(const uint8_t* row0, const uint8_t* row1, const RgbLayout& layout, const CscCoeff& coeff,
+    bool vuOrder, uint8_t* uv, size_t width)
+{
+    const size_t uIdx = vuOrder ? 1 : 0;
+    const size_t step = layout.channel;
+    for (size_t x = 0; x + 1 < width; x += 2) {
+        const uint8_t* p00 = row0 + x * step;
+        const uint8_t* p01 = p00 + step;
+        const uint8_t* p10 = row1 + x * step;
+        const uint8_t* p11 = p10 + step;
+        int32_t r = (p00[layout.rIdx] + p01[layout.rIdx] + p10[layout.rIdx] + p11[layout.rIdx] + 2) >> 2;
+        int32_t g = (p00[layout.gIdx] + p01[layout.gIdx] + p10[layout.gIdx] + p11[layout.gIdx] + 2) >> 2;
+        int32_t b = (p00[layout.bIdx] + p01[layout.bIdx] + p10[layout.bIdx] + p11[layout.bIdx] + 2) >> 2;
+        uv[x + uIdx] = ClampToU8(CscDot(coeff.matrix[1], r, g, b) + CSC_UV_BIAS);
+        uv[x + 1 - uIdx] = ClampToU8(CscDot(coeff.matrix[2], r, g, b) + CSC_UV_BIAS);
+    }
+}
+
+void ConvertYuyvRowToYuv422SPScalar(const uint8_t* src, uint8_t* y, uint8_t* uv, size_t width)
+{
+    for (size_t x = 0; x < width; ++x) {
+        y[x] = src[x * 2];
+        uv[x] = src[x * 2 + 1];
+    }
+}
+
+void ConvertYuyvRowToYuv422SP(const uint8_t* src, uint8_t* y, uint8_t* uv, size_t width)
+{
+    size_t x = 0;
+#if defined(__AVX2__)
+    {
+        const __m256i lowMask = _mm256_set1_epi16(0x00FF);
+        for (; x + AVX_PIXELS <= width; x += AVX_PIXELS) {
+            __m256i s0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + x * 2));
+            __m256i s1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + x * 2 + AVX_PIXELS));
+            // packus按lane交错, 需将64位块恢复为s0低, s0高, s1低, s1高的顺序
+            __m256i even = _mm256_packus_epi16(_mm256_and_si256(s0, lowMask), _mm256_and_si256(s1, lowMask));
+            __m256i odd = _mm256_packus_epi16(_mm256_srli_epi16(s0, 8), _mm256_srli_epi16(s1, 8));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(y + x), _mm256_permute4x64_epi64(even, 0xD8));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(uv + x), _mm256_permute4x64_epi64(odd, 0xD8));
+        }
+    }
+#endif
+#if defined(__SSE2__)
+    for (; x + SSE_PIXELS <= width; x += SSE_PIXELS) {
+        __m128i even;
+        __m128i odd;
+        SplitEvenOdd(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x * 2)),
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x * 2 + SSE_PIXELS)), even, odd);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(y + x), even);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(uv + x), odd);
+    }
+#elif defined(IMAGE_CONVERT_NEON)
+    for (; x + NEON_PIXELS <= width; x += NEON_PIXELS) {
+        uint8x16x2_t px = vld2q_u8(src + x * 2);
+        vst1q_u8(y + x, px.val[0]);
+        vst1q_u8(uv + x, px.val[1]);
+    }
+#endif
+    ConvertYuyvRowToYuv422SPScalar(src + x * 2, y + x, uv + x, width - x);
+}
+
+void InterleavePlanesScalar(const uint8_t* const* planes, uint32_t channel, uint8_t* dst, size_t len)
+{
+    for (size_t i = 0; i < len; ++i) {
+        for (uint32_t c = 0; c < channel; ++c) {
+            dst[i * channel + c] = planes[c][i];
+        }
+    }
+}
+
+void InterleavePlanes(const uint8_t* const* planes, uint32_t channel, uint8_t* dst, size_t len)
+{
+    size_t i = 0;
+#if defined(__SSE2__)
+    if (channel == 4) {
+        __m128i value[4];
+        for (; i + SSE_PIXELS <= len; i += SSE_PIXELS) {
+            for (uint32_t c = 0; c < 4; ++c) {
+                value[c] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(planes[c] + i));
+            }
+            Interleave4x16(value, dst + i * channel);
+        }
+    }
+#elif defined(IMAGE_CONVERT_NEON)
+    if (channel == 4) {
+        for (; i + NEON_PIXELS <= len; i += NEON_PIXELS) {
+            uint8x16x4_t value = {{vld1q_u8(planes[0] + i), vld1q_u8(planes[1] + i), vld1q_u8(planes[2] + i),
+                vld1q_u8(planes[3] + i)}};
+            vst4q_u8(dst + i * channel, value);
+        }
+    } else if (channel == 3) {
+        for (; i + NEON_PIXELS <= len; i += NEON_PIXELS) {
+            uint8x16x3_t value = {{vld1q_u8(planes[0] + i), vld1q_u8(planes[1] + i), vld1q_u8(planes[2] + i)}};
+            vst3q_u8(dst + i * channel, value);
+        }
+    }
+#endif
+    const uint8_t* rest[4] = {nullptr, nullptr, nullptr, nullptr};
+    for (uint32_t c = 0; c < channel && c < 4; ++c) {
+        rest[c] = planes[c] + i;
+    }
+    InterleavePlanesScalar(rest, channel, dst + i * channel, len - i);
+}
+
+void DeinterleavePlanesScalar(const uint8_t* src, uint32_t channel, uint8_t* const* planes, size_t len)
+{
+    for (size_t i = 0; i < len; ++i) {
+        for (uint32_t c = 0; c < channel; ++c) {
+            planes[c][i] = src[i * channel + c];
+        }
+    }
+}
+
+void DeinterleavePlanes(const uint8_t* src, uint32_t channel, uint8_t* const* planes, size_t len)
+{
+    size_t i = 0;
+#if defined(__SSE2__)
+    if (channel == 4) {
+        __m128i value[4];
+        for (; i + SSE_PIXELS <= len; i += SSE_PIXELS) {
+            Deinterleave4x16(src + i * channel, value);
+            for (uint32_t c = 0; c < 4; ++c) {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(planes[c] + i), value[c]);
+            }
+        }
+    }
+#elif defined(IMAGE_CONVERT_NEON)
+    if (channel == 4) {
+        for (; i + NEON_PIXELS <= len; i += NEON_PIXELS) {
+            uint8x16x4_t value = vld4q_u8(src + i * channel);
+            for (uint32_t c = 0; c < 4; ++c) {
+                vst1q_u8(planes[c] + i, value.val[c]);
+            }
+        }
+    } else if (channel == 3) {
+        for (; i + NEON_PIXELS <= len; i += NEON_PIXELS) {
+            uint8x16x3_t value = vld3q_u8(src + i * channel);
+            for (uint32_t c = 0; c < 3; ++c) {
+                vst1q_u8(planes[c] + i, value.val[c]);
+            }
+        }
+    }
+#endif
+    uint8_t* rest[4] = {nullptr, nullptr, nullptr, nullptr};
+    for (uint32_t c = 0; c < channel && c < 4; ++c) {
+        rest[c] = planes[c] + i;
+    }
+    DeinterleavePlanesScalar(src + i * channel, channel, rest, len - i);
+}
+} // namespace hiai
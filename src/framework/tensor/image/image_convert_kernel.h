@@ -0,0 +1,71 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FRAMEWORK_TENSOR_IMAGE_IMAGE_CONVERT_KERNEL_H
+#define FRAMEWORK_TENSOR_IMAGE_IMAGE_CONVERT_KERNEL_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace hiai {
+/*
+ * 图像格式转换行内核, 按编译目标选择AVX2/SSE2/NEON实现, 剩余像素及不支持的平台使用Scalar实现.
+ * 色域转换均为定点计算: ((c0 * a + c1 * b + c2 * c + 128) >> 8) + outputBias, 各实现结果逐位一致.
+ */
+
+// 交织RGB类格式中各分量的字节偏移, xIdx < 0表示无X/A通道
+struct RgbLayout {
+    uint32_t channel {3};
+    uint32_t rIdx {0};
+    uint32_t gIdx {1};
+    uint32_t bIdx {2};
+    int32_t xIdx {-1};
+};
+
+// matrix[输出通道][输入通道], yBias为Y分量的偏置(YUV->RGB为输入偏置, RGB->YUV为输出偏置)
+struct CscCoeff {
+    int16_t matrix[3][3] {};
+    int16_t yBias {0};
+};
+
+// 一行YUV420SP转换为RGB, width需为偶数, X/A通道填充255
+void ConvertYuv420SPRowToRgb(const uint8_t* y, const uint8_t* uv, bool vuOrder, const CscCoeff& coeff,
+    const RgbLayout& layout, uint8_t* dst, size_t width);
+void ConvertYuv420SPRowToRgbScalar(const uint8_t* y, const uint8_t* uv, bool vuOrder, const CscCoeff& coeff,
+    const RgbLayout& layout, uint8_t* dst, size_t width);
+
+// 一行RGB转换为Y分量
+void ConvertRgbRowToY(const uint8_t* rgb, const RgbLayout& layout, const CscCoeff& coeff, uint8_t* y, size_t width);
+void ConvertRgbRowToYScalar(
+    const uint8_t* rgb, const RgbLayout& layout, const CscCoeff& coeff, uint8_t* y, size_t width);
+
+// 两行RGB按2x2均值转换为一行交织的UV分量, width需为偶数
+void ConvertRgbRowsToUV(const uint8_t* row0, const uint8_t* row1, const RgbLayout& layout, const CscCoeff& coeff,
+    bool vuOrder, uint8_t* uv, size_t width);
+
+// 一行YUYV拆分为Y行和UV行, width需为偶数
+void ConvertYuyvRowToYuv422SP(const uint8_t* src, uint8_t* y, uint8_t* uv, size_t width);
+void ConvertYuyvRowToYuv422SPScalar(const uint8_t* src, uint8_t* y, uint8_t* uv, size_t width);
+
+// channel个平面交织为HWC, channel取3或4
+void InterleavePlanes(const uint8_t* const* planes, uint32_t channel, uint8_t* dst, size_t len);
+void InterleavePlanesScalar(const uint8_t* const* planes, uint32_t channel, uint8_t* dst, size_t len);
+
+// HWC拆分为channel个平面, channel取3或4
+void DeinterleavePlanes(const uint8_t* src, uint32_t channel, uint8_t* const* planes, size_t len);
+void DeinterleavePlanesScalar(const uint8_t* src, uint32_t channel, uint8_t* const* planes, size_t len);
+} // namespace hiai
+
+#endif // FRAMEWORK_TENSOR_IMAGE_IMAGE_CONVERT_KERNEL_H
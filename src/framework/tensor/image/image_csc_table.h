@@ -0,0 +1,43 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FRAMEWORK_TENSOR_IMAGE_IMAGE_CSC_TABLE_H
+#define FRAMEWORK_TENSOR_IMAGE_IMAGE_CSC_TABLE_H
+
+#include <cstdint>
+
+#include "tensor/image_format.h"
+
+namespace hiai {
+// 定点(Q8)色域转换系数, 按ImageColorSpace索引, AIPP CSC与主机侧图像转换共用
+// YUV_TO_RGB: 行为R/G/B, 列为Y/U/V
+constexpr int32_t YUV_TO_RGB[4][3][3] = {{{256, 0, 359}, {256, -88, -183}, {256, 454, 0}},
+    {{298, 0, 409}, {298, -100, -208}, {298, 516, 0}}, {{256, 0, 359}, {256, -88, -183}, {256, 454, 0}},
+    {{298, 0, 460}, {298, -55, -137}, {298, 541, 0}}};
+// RGB_TO_YUV: 行为Y/U/V, 列为R/G/B
+constexpr int32_t RGB_TO_YUV[4][3][3] = {{{77, 150, 29}, {-43, -85, 128}, {128, -107, -21}},
+    {{66, 129, 25}, {-38, -74, 112}, {112, -94, -18}}, {{77, 150, 29}, {-43, -85, 128}, {128, -107, -21}},
+    {{47, 157, 16}, {-26, -87, 112}, {112, -102, -10}}};
+
+constexpr int32_t CSC_UV_BIAS = 128;
+
+// JPEG为全范围, 其他色域Y分量有16的偏置
+constexpr int32_t GetCscYBias(ImageColorSpace colorSpace)
+{
+    return colorSpace == ImageColorSpace::JPEG ? 0 : 16;
+}
+} // namespace hiai
+
+#endif // FRAMEWORK_TENSOR_IMAGE_IMAGE_CSC_TABLE_H
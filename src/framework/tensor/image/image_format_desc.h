@@ -0,0 +1,121 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FRAMEWORK_TENSOR_IMAGE_IMAGE_FORMAT_DESC_H
+#define FRAMEWORK_TENSOR_IMAGE_IMAGE_FORMAT_DESC_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "tensor/image_format.h"
+
+namespace hiai {
+enum class ImageColorModel : uint8_t {
+    YUV,
+    RGB,
+    GRAY,
+};
+
+/*
+ * 图像格式描述, 按ImageFormat枚举值索引.
+ * 单张图片大小 = height * width * pixelBytes + chromaBytes * ceil(width / chromaSubW) * ceil(height / chromaSubH)
+ */
+struct ImageFormatDesc {
+    ImageFormat format;
+    const char* name;
+    uint8_t channel; // NCHW中的C
+    uint8_t planeNum;
+    uint8_t pixelBytes; // 每像素的字节数, 不含下采样的色度分量
+    uint8_t chromaBytes; // 每个下采样色度采样点的字节数(UV交织), 无下采样色度时为0
+    uint8_t chromaSubW;
+    uint8_t chromaSubH;
+    ImageColorModel colorModel; // 决定CSC的输入方向: YUV->RGB/GRAY, RGB->YUV/GRAY
+    uint8_t aippInputFormat; // HIAI_MR_TensorAippCommPara::inputFormat取值, 0表示AIPP不支持该输入
+    bool imageBufferSupported; // 可创建ImageTensorBuffer
+    bool cscOutputSupported; // 可作为SetCscPara的目标格式
+    uint8_t cscRowOrder[3]; // 作为CSC目标格式时, 各输出通道对应的系数矩阵行
+};
+
+constexpr ImageFormatDesc IMAGE_FORMAT_DESCS[] = {
+    {ImageFormat::YUV420SP, "YUV420SP_U8", 3, 2, 1, 2, 2, 2, ImageColorModel::YUV, 1, true, false, {0, 1, 2}},
+    {ImageFormat::XRGB8888, "XRGB8888_U8", 4, 1, 4, 0, 1, 1, ImageColorModel::RGB, 2, true, false, {0, 1, 2}},
+    {ImageFormat::YUV400, "YUV400_U8", 1, 1, 1, 0, 1, 1, ImageColorModel::GRAY, 10, true, true, {0, 1, 2}},
+    {ImageFormat::ARGB8888, "ARGB8888_U8", 4, 1, 4, 0, 1, 1, ImageColorModel::RGB, 6, true, false, {0, 1, 2}},
+    {ImageFormat::YUYV, "YUYV_U8", 3, 1, 1, 2, 2, 1, ImageColorModel::YUV, 7, true, false, {0, 1, 2}},
+    {ImageFormat::YUV422SP, "YUV422SP_U8", 3, 2, 1, 2, 2, 1, ImageColorModel::YUV, 8, true, false, {0, 1, 2}},
+    {ImageFormat::AYUV444, "AYUV444_U8", 4, 1, 4, 0, 1, 1, ImageColorModel::YUV, 9, true, false, {0, 1, 2}},
+    {ImageFormat::RGB888, "RGB888_U8", 3, 1, 3, 0, 1, 1, ImageColorModel::RGB, 5, true, true, {0, 1, 2}},
+    {ImageFormat::BGR888, "BGR888_U8", 3, 1, 3, 0, 1, 1, ImageColorModel::RGB, 0, true, true, {2, 1, 0}},
+    {ImageFormat::YUV444SP, "YUV444SP_U8", 3, 2, 1, 2, 1, 1, ImageColorModel::YUV, 0, false, true, {0, 1, 2}},
+    {ImageFormat::YVU444SP, "YVU444SP_U8", 3, 2, 1, 2, 1, 1, ImageColorModel::YUV, 0, false, true, {0, 2, 1}},
+};
+constexpr size_t IMAGE_FORMAT_NUM = sizeof(IMAGE_FORMAT_DESCS) / sizeof(IMAGE_FORMAT_DESCS[0]);
+
+// 按HIAI_MR_TensorAippCommPara::inputFormat索引
+constexpr ImageFormat AIPP_INPUT_IMAGE_FORMATS[] = {ImageFormat::INVALID, ImageFormat::YUV420SP,
+    ImageFormat::XRGB8888, ImageFormat::INVALID, ImageFormat::INVALID, ImageFormat::RGB888, ImageFormat::ARGB8888,
+    ImageFormat::YUYV, ImageFormat::YUV422SP, ImageFormat::AYUV444, ImageFormat::YUV400};
+constexpr size_t AIPP_INPUT_FORMAT_NUM = sizeof(AIPP_INPUT_IMAGE_FORMATS) / sizeof(AIPP_INPUT_IMAGE_FORMATS[0]);
+
+// 不支持的格式返回nullptr
+constexpr const ImageFormatDesc* GetImageFormatDesc(ImageFormat format)
+{
+    return static_cast<size_t>(format) < IMAGE_FORMAT_NUM ? &IMAGE_FORMAT_DESCS[static_cast<size_t>(format)] :
+                                                             nullptr;
+}
+
+constexpr ImageFormat GetImageFormatByAippInput(uint32_t aippInputFormat)
+{
+    return aippInputFormat < AIPP_INPUT_FORMAT_NUM ? AIPP_INPUT_IMAGE_FORMATS[aippInputFormat] : ImageFormat::INVALID;
+}
+
+// 色度采样点数向上取整, 奇数宽高的YUV420SP等格式不会截断
+constexpr uint64_t GetImageSize(const ImageFormatDesc& desc, uint64_t height, uint64_t width)
+{
+    return height * width * desc.pixelBytes +
+        desc.chromaBytes * ((width + desc.chromaSubW - 1) / desc.chromaSubW) *
+        ((height + desc.chromaSubH - 1) / desc.chromaSubH);
+}
+
+// 单平面格式的色度与亮度交织在同一行(YUYV), 半平面格式的色度单独存放在planes[1]
+constexpr uint64_t GetPlaneRowBytes(const ImageFormatDesc& desc, uint32_t plane, uint64_t width)
+{
+    return (plane == 0 ? width * desc.pixelBytes : 0) +
+        ((plane == 0) == (desc.planeNum == 1) ? desc.chromaBytes * ((width + desc.chromaSubW - 1) / desc.chromaSubW) :
+                                               0);
+}
+
+constexpr uint64_t GetPlaneRows(const ImageFormatDesc& desc, uint32_t plane, uint64_t height)
+{
+    return plane == 0 ? height : (height + desc.chromaSubH - 1) / desc.chromaSubH;
+}
+
+constexpr bool CheckImageFormatDescs(size_t index)
+{
+    return index >= IMAGE_FORMAT_NUM ||
+        (static_cast<size_t>(IMAGE_FORMAT_DESCS[index].format) == index &&
+            (IMAGE_FORMAT_DESCS[index].aippInputFormat == 0 ||
+                GetImageFormatByAippInput(IMAGE_FORMAT_DESCS[index].aippInputFormat) ==
+                    IMAGE_FORMAT_DESCS[index].format) &&
+            CheckImageFormatDescs(index + 1));
+}
+static_assert(CheckImageFormatDescs(0), "IMAGE_FORMAT_DESCS must be ordered by ImageFormat and match aipp formats");
+static_assert(GetImageSize(IMAGE_FORMAT_DESCS[0], 3, 3) == 17, "odd YUV420SP size must round chroma up");
+static_assert(GetPlaneRowBytes(IMAGE_FORMAT_DESCS[static_cast<size_t>(ImageFormat::YUYV)], 0, 4) == 8 &&
+        GetPlaneRowBytes(IMAGE_FORMAT_DESCS[0], 1, 4) == 4 && GetPlaneRowBytes(IMAGE_FORMAT_DESCS[0], 0, 4) == 4,
+    "plane row bytes must cover interleaved chroma");
+} // namespace hiai
+
+#endif // FRAMEWORK_TENSOR_IMAGE_IMAGE_FORMAT_DESC_H
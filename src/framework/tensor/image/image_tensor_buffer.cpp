@@ -65,4 +65,30 @@ std::shared_ptr<IImageTensorBuffer> CreateImageTensorBufferFromHandle(const Nati
     imageTensor->SetColorSpace(colorSpace);
     return std::static_pointer_cast<IImageTensorBuffer>(imageTensor);
 }
+
+std::shared_ptr<IImageTensorBuffer> CreateImageTensorBufferFromPlanes(const std::vector<ImagePlane>& planes, int32_t h,
+    int32_t w, ImageFormat format, ImageColorSpace colorSpace, int32_t rotation, const std::function<void()>& release)
+{
+    ImageTensorBufferInfo bufferInfo;
+    ImagePlaneLayout layout;
+    NDTensorDesc desc;
+    HIAI_MR_NDTensorBuffer* ndTensor = nullptr;
+
+    Status ret = ImageBufferInit(planes, h, w, format, bufferInfo, layout, desc, &ndTensor);
+    if (ret != SUCCESS) {
+        FMK_LOGE("HIAI_CreateImageBuffer ImageBufferInit failed");
+        return nullptr;
+    }
+    std::shared_ptr<ImageTensorBufferImpl> imageTensor = nullptr;
+    imageTensor = make_shared_nothrow<ImageTensorBufferImpl>(bufferInfo, ndTensor, desc);
+    if (imageTensor == nullptr) {
+        FMK_LOGE("HIAI_CreateImageBuffer create imageTensor failed");
+        HIAI_MR_NDTensorBuffer_Destroy(&ndTensor);
+        return nullptr;
+    }
+    imageTensor->SetRotation(rotation);
+    imageTensor->SetColorSpace(colorSpace);
+    imageTensor->SetPlaneLayout(layout, release);
+    return std::static_pointer_cast<IImageTensorBuffer>(imageTensor);
+}
 } // namespace hiai
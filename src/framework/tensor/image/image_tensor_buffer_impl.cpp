@@ -15,97 +15,39 @@
  */
 #include "image_tensor_buffer_impl.h"
 
-#include <map>
+#include <algorithm>
+#include <cinttypes>
+
+#include "image_format_desc.h"
 #include "framework/infra/log/log.h"
+#include "infra/base/assertion.h"
 
 namespace hiai {
 
-static const std::map<ImageFormat, uint32_t> sizeScaleMap = {
-    {ImageFormat::YUV420SP, 3},
-    {ImageFormat::XRGB8888, 4},
-    {ImageFormat::YUV400, 1},
-    {ImageFormat::ARGB8888, 4},
-    {ImageFormat::YUYV, 2},
-    {ImageFormat::YUV422SP, 2},
-    {ImageFormat::AYUV444, 4},
-    {ImageFormat::RGB888, 3},
-    {ImageFormat::BGR888, 3},
-};
-static const std::map<ImageFormat, int32_t> channelMap = {
-    {ImageFormat::YUV420SP, 3},
-    {ImageFormat::XRGB8888, 4},
-    {ImageFormat::YUV400, 1},
-    {ImageFormat::ARGB8888, 4},
-    {ImageFormat::YUYV, 3},
-    {ImageFormat::YUV422SP, 3},
-    {ImageFormat::AYUV444, 4},
-    {ImageFormat::RGB888, 3},
-    {ImageFormat::BGR888, 3},
-};
-
-static Status GetChannelSizeForFormat(const ImageFormat format, int32_t& channel)
-{
-    auto iter = channelMap.find(format);
-    if (iter == channelMap.end()) {
-        FMK_LOGE("GetChannelSizeForFormat failed: ImageForamt %d is not supported.", format);
-        return FAILURE;
-    }
-    channel = iter->second;
-    return SUCCESS;
-}
-
-static Status GetSizeScaleForFormat(const ImageFormat format, uint32_t& sizeScale)
-{
-    auto iter = sizeScaleMap.find(format);
-    if (iter == sizeScaleMap.end()) {
-        FMK_LOGE("GetSizeScaleForFormat failed: ImageForamt %d is not supported.", format);
-        return FAILURE;
-    }
-    sizeScale = iter->second;
-    return SUCCESS;
-}
-
-static bool CheckInputOverflow(
-    const uint32_t& number, const uint32_t& size, const uint32_t& h, const uint32_t& w, const uint32_t& formatSize)
-{
-    if (number > 0 && size > 0 && h > 0 && w > 0 && formatSize > 0) {
-        if (number > (INT32_MAX / size / h / w / formatSize)) {
-            return false;
-        }
-        return true;
-    } else {
-        return false;
-    }
-}
-
 static Status InitTensorInfo(const int32_t b, const int32_t h, const int32_t w, const ImageFormat format,
     ImageTensorBufferInfo& bufferInfo, size_t& size)
 {
-    int32_t channel;
-    if (GetChannelSizeForFormat(format, channel) != SUCCESS) {
-        FMK_LOGE("GetChannelSizeForFormat failed");
+    const ImageFormatDesc* formatDesc = GetImageFormatDesc(format);
+    if (formatDesc == nullptr || !formatDesc->imageBufferSupported) {
+        FMK_LOGE("InitTensorInfo failed: ImageForamt %d is not supported.", format);
         return FAILURE;
     }
-    uint32_t sizeScale = 1;
-    if (GetSizeScaleForFormat(format, sizeScale) != SUCCESS) {
-        FMK_LOGE("GetSizeScaleForFormat failed");
+    if (b <= 0 || h <= 0 || w <= 0 || static_cast<uint64_t>(h) * static_cast<uint64_t>(w) > INT32_MAX) {
+        FMK_LOGE("CheckInputOveflow failed");
         return FAILURE;
     }
-    if (!CheckInputOverflow(b, sizeScale, h, w, 1)) {
+    uint64_t imageSize = GetImageSize(*formatDesc, static_cast<uint64_t>(h), static_cast<uint64_t>(w));
+    if (imageSize > static_cast<uint64_t>(INT32_MAX / b)) {
         FMK_LOGE("CheckInputOveflow failed");
         return FAILURE;
     }
-
-    size = static_cast<size_t>(b * h * w * sizeScale);
-    if (format == ImageFormat::YUV420SP) {
-        size = size / 2;
-    }
+    size = static_cast<size_t>(imageSize * static_cast<uint64_t>(b));
 
     bufferInfo.batch = b;
     bufferInfo.height = h;
     bufferInfo.width = w;
     bufferInfo.format = format;
-    bufferInfo.channel = channel;
+    bufferInfo.channel = formatDesc->channel;
     return SUCCESS;
 }
 
@@ -156,4 +98,109 @@ Status ImageBufferInit(const int32_t b, const int32_t h, const int32_t w, const
 
     return SUCCESS;
 }
-} // namespace hiai
\ No newline at end of file
+
+// Y平面行跨度按整像素对齐, 且UV平面以相同行跨度紧跟在对齐后的Y平面之后时, AIPP可把整段内存当作更大的图片读取
+static void InitStorageShape(const ImageFormatDesc& formatDesc, const std::vector<ImagePlane>& planes, int32_t h,
+    ImagePlaneLayout& layout)
+{
+    const uint64_t stride = planes[0].stride;
+    const uint64_t pixelBytes = GetPlaneRowBytes(formatDesc, 0, formatDesc.chromaSubW) / formatDesc.chromaSubW;
+    const uint64_t storageWidth = stride / pixelBytes;
+    if (storageWidth % formatDesc.chromaSubW != 0 || GetPlaneRowBytes(formatDesc, 0, storageWidth) != stride) {
+        return;
+    }
+    uint64_t storageHeight = static_cast<uint64_t>(h);
+    if (planes.size() > 1) {
+        uintptr_t yAddr = reinterpret_cast<uintptr_t>(planes[0].data);
+        uintptr_t uvAddr = reinterpret_cast<uintptr_t>(planes[1].data);
+        if (uvAddr < yAddr || (uvAddr - yAddr) % stride != 0 ||
+            planes[1].stride != GetPlaneRowBytes(formatDesc, 1, storageWidth)) {
+            return;
+        }
+        storageHeight = (uvAddr - yAddr) / stride;
+        if (storageHeight < static_cast<uint64_t>(h) || storageHeight % formatDesc.chromaSubH != 0) {
+            return;
+        }
+    }
+    if (GetImageSize(formatDesc, storageHeight, storageWidth) > INT32_MAX) {
+        return;
+    }
+    layout.storageWidth = static_cast<int32_t>(storageWidth);
+    layout.storageHeight = static_cast<int32_t>(storageHeight);
+}
+
+// 从首平面起始地址到各平面最后一行有效数据结束的字节数, 不含存储高度多出的行和末行行跨度的填充
+static uint64_t GetPlanesExtent(
+    const ImageFormatDesc& formatDesc, const std::vector<ImagePlane>& planes, size_t planeNum, int32_t h, int32_t w)
+{
+    const uintptr_t base = reinterpret_cast<uintptr_t>(planes[0].data);
+    uint64_t extent = 0;
+    for (size_t i = 0; i < planeNum; ++i) {
+        uint64_t rows = (i == 0) ? static_cast<uint64_t>(h) :
+                                   (static_cast<uint64_t>(h) + formatDesc.chromaSubH - 1) / formatDesc.chromaSubH;
+        uint64_t end = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(planes[i].data) - base) +
+            static_cast<uint64_t>(planes[i].stride) * (rows - 1) +
+            GetPlaneRowBytes(formatDesc, static_cast<uint32_t>(i), static_cast<uint64_t>(w));
+        extent = std::max(extent, end);
+    }
+    return extent;
+}
+
+static Status InitPlaneLayout(const std::vector<ImagePlane>& planes, const int32_t h, const int32_t w,
+    const ImageFormat format, ImagePlaneLayout& layout, size_t& size)
+{
+    const ImageFormatDesc* formatDesc = GetImageFormatDesc(format);
+    HIAI_EXPECT_NOT_NULL(formatDesc);
+    if (planes.size() != formatDesc->planeNum) {
+        FMK_LOGE("format %s needs %u planes, but got %zu.", formatDesc->name, formatDesc->planeNum, planes.size());
+        return FAILURE;
+    }
+    for (uint32_t i = 0; i < planes.size(); ++i) {
+        uint64_t rowBytes = GetPlaneRowBytes(*formatDesc, i, static_cast<uint64_t>(w));
+        if (planes[i].data == nullptr || planes[i].stride < rowBytes || planes[i].stride > INT32_MAX) {
+            FMK_LOGE("plane %u is invalid, stride:%zu, row bytes:%" PRIu64 ".", i, planes[i].stride, rowBytes);
+            return FAILURE;
+        }
+    }
+    layout.planes = planes;
+    InitStorageShape(*formatDesc, planes, h, layout);
+
+    // 连续平面覆盖到最后一个平面的有效行为止, 否则只覆盖Y平面; 存储高度只用于AIPP寻址, 不代表调用方内存大小
+    size_t planeNum = (layout.storageWidth > 0) ? planes.size() : 1;
+    uint64_t planeSize = GetPlanesExtent(*formatDesc, planes, planeNum, h, w);
+    if (planeSize > INT32_MAX) {
+        FMK_LOGE("plane size %" PRIu64 " is too large.", planeSize);
+        return FAILURE;
+    }
+    size = static_cast<size_t>(planeSize);
+    return SUCCESS;
+}
+
+Status ImageBufferInit(const std::vector<ImagePlane>& planes, const int32_t h, const int32_t w, const ImageFormat format,
+    ImageTensorBufferInfo& bufferInfo, ImagePlaneLayout& layout, NDTensorDesc& desc, HIAI_MR_NDTensorBuffer** tensor)
+{
+    size_t size = 0;
+    if (InitTensorInfo(1, h, w, format, bufferInfo, size) != SUCCESS) {
+        FMK_LOGE("init tensor info failed.");
+        return FAILURE;
+    }
+    if (InitPlaneLayout(planes, h, w, format, layout, size) != SUCCESS) {
+        FMK_LOGE("init plane layout failed.");
+        return FAILURE;
+    }
+
+    desc.dims = {1, bufferInfo.channel, h, w};
+    desc.dataType = DataType::UINT8;
+    desc.format = hiai::Format::NCHW;
+
+    HIAI_MR_NDTensorBuffer* ndTensor = CreateHIAINDTensorBufferNoCopy(desc, planes[0].data, size);
+    if (ndTensor == nullptr) {
+        FMK_LOGE("ndTensor is nullptr");
+        return FAILURE;
+    }
+
+    *tensor = ndTensor;
+
+    return SUCCESS;
+}
+} // namespace hiai
@@ -16,6 +16,9 @@
 #ifndef TENSOR_IMAGE_BUFFER_IMPL_H
 #define TENSOR_IMAGE_BUFFER_IMPL_H
 
+#include <functional>
+#include <vector>
+
 #include "tensor/image_tensor_buffer.h"
 #include "tensor/base/nd_tensor_buffer_impl.h"
 #include "framework/infra/log/log.h"
@@ -33,6 +36,14 @@ struct ImageTensorBufferInfo {
     ImageColorSpace colorSpace {ImageColorSpace::BT_601_NARROW};
 };
 
+// 外部平面内存的布局, 仅CreateImageTensorBufferFromPlanes创建的图片非空
+struct ImagePlaneLayout {
+    std::vector<ImagePlane> planes;
+    // 各平面连续存放时AIPP可见的存储宽高(含行跨度与平面对齐的填充), 不连续时为0
+    int32_t storageWidth {0};
+    int32_t storageHeight {0};
+};
+
 class ImageTensorBufferImpl : public IImageTensorBuffer, public NDTensorBufferImpl {
 public:
     ImageTensorBufferImpl(ImageTensorBufferInfo& bufferInfo, HIAI_MR_NDTensorBuffer* impl) : NDTensorBufferImpl(impl)
@@ -58,6 +69,9 @@ public:
 
     ~ImageTensorBufferImpl() override
     {
+        if (release_) {
+            release_();
+        }
     }
 
     int32_t Batch() const override
@@ -124,13 +138,28 @@ public:
         return NDTensorBufferImpl::GetTensorDesc();
     }
 
+    void SetPlaneLayout(const ImagePlaneLayout& layout, const std::function<void()>& release)
+    {
+        planeLayout_ = layout;
+        release_ = release;
+    }
+
+    const ImagePlaneLayout& GetPlaneLayout() const
+    {
+        return planeLayout_;
+    }
+
 private:
     ImageTensorBufferInfo bufferInfo_;
+    ImagePlaneLayout planeLayout_;
+    std::function<void()> release_;
 };
 
 Status ImageBufferInit(const int32_t b, const int32_t h, const int32_t w, const ImageFormat format,
     ImageTensorBufferInfo& bufferInfo, NDTensorDesc& desc, HIAI_MR_NDTensorBuffer** tensor);
 Status ImageBufferInit(const int32_t b, const int32_t h, const int32_t w, const ImageFormat format,
     const NativeHandle& handle, ImageTensorBufferInfo& bufferInfo, NDTensorDesc& desc, HIAI_MR_NDTensorBuffer** tensor);
+Status ImageBufferInit(const std::vector<ImagePlane>& planes, const int32_t h, const int32_t w, const ImageFormat format,
+    ImageTensorBufferInfo& bufferInfo, ImagePlaneLayout& layout, NDTensorDesc& desc, HIAI_MR_NDTensorBuffer** tensor);
 } // namespace hiai
 #endif // TENSOR_IMAGE_BUFFER_IMPL_H
\ No newline at end of file
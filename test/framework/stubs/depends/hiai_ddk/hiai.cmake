@@ -8,6 +8,14 @@ set(HIAI_SRC_FILES
     ${FRAMEWORK_BASE_DIR_FOR_INC_DIRS}/model_builder/om/model_build_options_util.cpp
     ${FRAMEWORK_BASE_DIR_FOR_INC_DIRS}/model_builder/om/model_builder_impl.cpp
     ${FRAMEWORK_BASE_DIR_FOR_INC_DIRS}/model_manager/core/model_manager_impl.cpp
+    ${FRAMEWORK_BASE_DIR_FOR_INC_DIRS}/model_manager/core/batching_model_manager_impl.cpp
+    ${FRAMEWORK_BASE_DIR_FOR_INC_DIRS}/model_manager/core/request_scheduler_impl.cpp
+    ${FRAMEWORK_BASE_DIR_FOR_INC_DIRS}/model_manager/core/completion_ring.cpp
+    ${FRAMEWORK_BASE_DIR_FOR_INC_DIRS}/model_manager/core/pipeline_impl.cpp
+    ${FRAMEWORK_BASE_DIR_FOR_INC_DIRS}/model_manager/core/tensor_set_pool.cpp
+    ${FRAMEWORK_BASE_DIR_FOR_INC_DIRS}/model_manager/core/model_cache_impl.cpp
+    ${FRAMEWORK_BASE_DIR_FOR_INC_DIRS}/model_manager/core/shape_dispatcher.cpp
+    ${FRAMEWORK_BASE_DIR_FOR_INC_DIRS}/model_manager/core/shared_mem_pool_impl.cpp
     ${FRAMEWORK_BASE_DIR_FOR_INC_DIRS}/model_manager/core/open_request_stats.cpp
     ${FRAMEWORK_BASE_DIR_FOR_INC_DIRS}/infra/buffer/local_buffer.cpp
     ${FRAMEWORK_BASE_DIR_FOR_INC_DIRS}/infra/buffer/base_buffer.cpp
@@ -72,10 +80,14 @@ set(HIAI_SRC_FILES
 
     ${FRAMEWORK_BASE_DIR_FOR_INC_DIRS}/model/built_model/customdata_util.cpp
     ${FRAMEWORK_BASE_DIR_FOR_INC_DIRS}/model/aipp/aipp_input_converter.cpp
+    ${FRAMEWORK_BASE_DIR_FOR_INC_DIRS}/tensor/aipp/aipp_cpu_executor.cpp
+    ${FRAMEWORK_BASE_DIR_FOR_INC_DIRS}/tensor/aipp/aipp_cpu_kernel.cpp
     ${FRAMEWORK_BASE_DIR_FOR_INC_DIRS}/tensor/aipp/aipp_para_impl.cpp
     ${FRAMEWORK_BASE_DIR_FOR_INC_DIRS}/tensor/aipp/hiai_tensor_aipp_para_legacy.c
     ${FRAMEWORK_BASE_DIR_FOR_INC_DIRS}/tensor/aipp/hiai_tensor_aipp_para_local.c
     ${FRAMEWORK_BASE_DIR_FOR_INC_DIRS}/tensor/aipp/hiai_tensor_aipp_para.c
+    ${FRAMEWORK_BASE_DIR_FOR_INC_DIRS}/tensor/image/image_convert.cpp
+    ${FRAMEWORK_BASE_DIR_FOR_INC_DIRS}/tensor/image/image_convert_kernel.cpp
     ${FRAMEWORK_BASE_DIR_FOR_INC_DIRS}/tensor/image/image_tensor_buffer.cpp
     ${FRAMEWORK_BASE_DIR_FOR_INC_DIRS}/tensor/image/image_tensor_buffer_impl.cpp
     ${FRAMEWORK_BASE_DIR_FOR_INC_DIRS}/model_runtime/direct/direct_built_model_aipp.cpp
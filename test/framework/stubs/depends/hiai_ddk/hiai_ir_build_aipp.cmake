@@ -2,6 +2,7 @@ set(LOCAL_SRC_FILES
     ${FRAMEWORK_BASE_DIR_FOR_INC_DIRS}/model_builder/ir/aipp/converter/aipp_param_info_converter.cpp
     ${FRAMEWORK_BASE_DIR_FOR_INC_DIRS}/model_builder/ir/aipp/compatible/hiai_ir_aipp_compatible.cpp
     ${FRAMEWORK_BASE_DIR_FOR_INC_DIRS}/model_builder/ir/aipp/infershape/aipp_infershape_util.cpp
+    ${FRAMEWORK_BASE_DIR_FOR_INC_DIRS}/model_builder/ir/aipp/lowering/aipp_static_lowering.cpp
 )
 
 set(CMAKE_SHARED_LINKER_FLAGS "-Wl,--gc-sections")
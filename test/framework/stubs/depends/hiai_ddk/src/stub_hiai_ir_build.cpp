@@ -271,7 +271,7 @@ bool IsSupportNewAipp()
     return false;
 }
 
-static hiai::Status MakeAippCompatible(ExtendedCompatibleModel& extendedModel)
+static hiai::Status MakeAippCompatible(ExtendedCompatibleModel& extendedModel, StaticAippMode staticAippMode)
 {
     if (IsSupportNewAipp()) {
         return hiai::SUCCESS;
@@ -289,8 +289,9 @@ static hiai::Status MakeAippCompatible(ExtendedCompatibleModel& extendedModel)
         FMK_LOGE("Create DynamicLoadHelper fail!");
         return hiai::FAILURE;
     }
-    auto func = reinterpret_cast<Status (*)(ge::ComputeGraph&, std::string&)>(
-        dlsym(handle, "GenerateAippCompatibleInfoAdapter"));
+    const char* adapterName = staticAippMode == StaticAippMode::LOWER_TO_OPS ? "LowerStaticAippAdapter" :
+                                                                             "GenerateAippCompatibleInfoAdapter";
+    auto func = reinterpret_cast<Status (*)(ge::ComputeGraph&, std::string&)>(dlsym(handle, adapterName));
     if (func == nullptr) {
         FMK_LOGE("func is nullptr");
         return hiai::FAILURE;
@@ -298,7 +299,8 @@ static hiai::Status MakeAippCompatible(ExtendedCompatibleModel& extendedModel)
     return func(*graph, extendedModel.aippConfig_);
 }
 
-static std::unique_ptr<ExtendedCompatibleModel> MakeCompatibleModel(const std::shared_ptr<ge::Model>& model)
+static std::unique_ptr<ExtendedCompatibleModel> MakeCompatibleModel(
+    const std::shared_ptr<ge::Model>& model, StaticAippMode staticAippMode)
 {
     (void)ge::AttrUtils::SetInt(&*model, "stream_num", 1);
     std::unique_ptr<ExtendedCompatibleModel> compatibleModel = ge::make_unique<ExtendedCompatibleModel>(model.get());
@@ -313,7 +315,7 @@ static std::unique_ptr<ExtendedCompatibleModel> MakeCompatibleModel(const std::s
         return nullptr;
     }
 
-    if (MakeAippCompatible(*compatibleModel.get()) != hiai::SUCCESS) {
+    if (MakeAippCompatible(*compatibleModel.get(), staticAippMode) != hiai::SUCCESS) {
         FMK_LOGE("MakeAippCompatible failed.");
         return nullptr;
     }
@@ -340,7 +342,7 @@ static std::shared_ptr<hiai::IBuiltModel> BuildCompatibleModel(const hiai::Model
 GRAPH_API_EXPORT Status HiaiIrBuild::Build(const hiai::ModelBuildOptions& options, const std::string& modelName,
     const std::shared_ptr<ge::Model>& model, std::shared_ptr<hiai::IBuiltModel>& builtModel)
 {
-    auto compatibleModel = MakeCompatibleModel(model);
+    auto compatibleModel = MakeCompatibleModel(model, options.staticAippMode);
     if (compatibleModel == nullptr) {
         FMK_LOGE("MakeCompatibleModel falied");
         return hiai::FAILURE;
@@ -0,0 +1,181 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "graph/tensor.h"
+#include "graph/op/array_defs.h"
+#include "graph/op/const_defs.h"
+#include "graph/op/detection_defs.h"
+#include "graph/op/math_defs.h"
+#include "framework/graph/core/cgraph/compute_graph.h"
+#include "framework/graph/core/cgraph/graph_finder.h"
+#include "framework/graph/core/cgraph/graph_modifier.h"
+#include "framework/graph/core/cgraph/graph_spec.h"
+#include "framework/graph/core/node/node.h"
+#include "framework/graph/core/node/node_spec.h"
+#include "framework/graph/core/node/node_walker.h"
+#include "framework/graph/core/edge/endpoint.h"
+#include "framework/graph/core/op/op_desc.h"
+#include "framework/graph/utils/attr_utils.h"
+#include "framework/graph/utils/op_desc_utils.h"
+#include "framework/graph/utils/optimizer/constant_folding_optimizer.h"
+#include "framework/graph/debug/ge_graph_attr_define.h"
+
+using namespace std;
+using namespace ge;
+
+class ge_test_constant_folding_optimizer : public testing::Test {
+protected:
+    void SetUp()
+    {
+        graph_ = ComputeGraph::Make("constant_folding");
+        OpDescPtr dataDesc = std::make_shared<OpDesc>("data", "Data");
+        dataDesc->AddOutputDesc(TensorDesc(Shape({1, 6}), FORMAT_NCHW, DT_FLOAT));
+        data_ = graph_->ROLE(GraphModifier).AddNode(dataDesc);
+    }
+
+    void TearDown()
+    {
+        graph_ = nullptr;
+    }
+
+    template <typename T>
+    Node* AddConst(const string& name, const vector<int64_t>& dims, const vector<T>& value, DataType dataType)
+    {
+        TensorDesc desc(Shape(dims), FORMAT_NCHW, dataType);
+        TensorPtr weight = std::make_shared<Tensor>(desc);
+        weight->SetData(reinterpret_cast<const uint8_t*>(value.data()), value.size() * sizeof(T));
+
+        OpDescPtr opDesc = std::make_shared<OpDesc>(name, hiai::op::Const::TYPE);
+        opDesc->AddOutputDesc(desc);
+        AttrUtils::SetTensor(opDesc, hiai::ATTR_NAME_WEIGHTS, weight);
+        return graph_->ROLE(GraphModifier).AddNode(opDesc);
+    }
+
+    Node* AddOp(const string& name, const string& type, const vector<Node*>& inputs)
+    {
+        OpDescPtr opDesc = std::make_shared<OpDesc>(name, type);
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            opDesc->AddInputDesc(TensorDesc());
+        }
+        opDesc->AddOutputDesc(TensorDesc());
+        Node* node = graph_->ROLE(GraphModifier).AddNode(opDesc);
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            EXPECT_EQ(graph_->ROLE(GraphModifier).AddEdge({*inputs[i], 0}, {*node, static_cast<int>(i)}),
+                hiai::SUCCESS);
+        }
+        return node;
+    }
+
+    TensorPtr GetFoldedWeight(const string& name)
+    {
+        Node* node = graph_->ROLE(GraphFinder).FindNode(name);
+        if (node == nullptr) {
+            return nullptr;
+        }
+        EXPECT_EQ(node->ROLE(NodeSpec).Type(), hiai::op::Const::TYPE);
+        vector<TensorPtr> weights = OpDescUtils::MutableWeights(*node);
+        return weights.empty() ? nullptr : weights[0];
+    }
+
+protected:
+    ComputeGraphPtr graph_;
+    Node* data_ {nullptr};
+};
+
+TEST_F(ge_test_constant_folding_optimizer, fold_const_chain)
+{
+    Node* w = AddConst<float>("w", {2, 3}, {1, 2, 3, 4, 5, 6}, DT_FLOAT);
+    Node* permute = AddOp("permute", hiai::op::Permute::TYPE, {w});
+    AttrUtils::SetListInt(permute->ROLE(NodeSpec).OpDesc(), hiai::op::Permute::order, vector<int64_t> {1, 0});
+    Node* scale = AddConst<float>("scale", {}, {2}, DT_FLOAT);
+    Node* mul = AddOp("mul", hiai::op::Mul::TYPE, {permute, scale});
+    Node* shape = AddConst<int32_t>("shape", {2}, {1, -1}, DT_INT32);
+    Node* reshape = AddOp("reshape", hiai::op::Reshape::TYPE, {mul, shape});
+    AddOp("add", hiai::op::Add::TYPE, {data_, reshape});
+
+    uint32_t foldedNum = 0;
+    EXPECT_EQ(ConstantFoldingOptimizer::Optimize(*graph_, foldedNum), hiai::SUCCESS);
+    EXPECT_EQ(foldedNum, 3U);
+    EXPECT_EQ(graph_->ROLE(GraphSpec).NodesNum(), 3U);
+
+    TensorPtr weight = GetFoldedWeight("reshape");
+    ASSERT_NE(weight, nullptr);
+    EXPECT_EQ(weight->GetTensorDesc().GetShape().GetDims(), (vector<int64_t> {1, 6}));
+    const float* data = reinterpret_cast<const float*>(weight->GetData().GetData());
+    vector<float> expect = {2, 8, 4, 10, 6, 12};
+    EXPECT_EQ(vector<float>(data, data + expect.size()), expect);
+}
+
+TEST_F(ge_test_constant_folding_optimizer, fold_cast)
+{
+    Node* w = AddConst<float>("w", {3}, {-1.5f, 0.0f, 300.0f}, DT_FLOAT);
+    Node* cast = AddOp("cast", hiai::op::CastT::TYPE, {w});
+    AttrUtils::SetInt(cast->ROLE(NodeSpec).OpDesc(), hiai::op::CastT::dst_dtype, static_cast<int64_t>(DT_UINT8));
+    AddOp("add", hiai::op::Add::TYPE, {data_, cast});
+
+    uint32_t foldedNum = 0;
+    EXPECT_EQ(ConstantFoldingOptimizer::Optimize(*graph_, foldedNum), hiai::SUCCESS);
+    EXPECT_EQ(foldedNum, 1U);
+
+    TensorPtr weight = GetFoldedWeight("cast");
+    ASSERT_NE(weight, nullptr);
+    EXPECT_EQ(weight->GetTensorDesc().GetDataType(), DT_UINT8);
+    const uint8_t* data = weight->GetData().GetData();
+    EXPECT_EQ(vector<uint8_t>(data, data + 3), (vector<uint8_t> {0, 0, 255}));
+}
+
+TEST_F(ge_test_constant_folding_optimizer, keep_non_const_input)
+{
+    Node* w = AddConst<float>("w", {1, 6}, {1, 2, 3, 4, 5, 6}, DT_FLOAT);
+    Node* add = AddOp("add", hiai::op::Add::TYPE, {data_, w});
+    Node* shape = AddConst<int32_t>("shape", {2}, {0, 6}, DT_INT32);
+    AddOp("reshape", hiai::op::Reshape::TYPE, {add, shape});
+
+    uint32_t foldedNum = 0;
+    EXPECT_EQ(ConstantFoldingOptimizer::Optimize(*graph_, foldedNum), hiai::SUCCESS);
+    EXPECT_EQ(foldedNum, 0U);
+    EXPECT_EQ(graph_->ROLE(GraphSpec).NodesNum(), 5U);
+}
+
+TEST_F(ge_test_constant_folding_optimizer, fold_broadcast_scalar_rank)
+{
+    Node* scale = AddConst<float>("scale", {1, 1, 1}, {2}, DT_FLOAT);
+    Node* w = AddConst<float>("w", {3}, {1, 2, 3}, DT_FLOAT);
+    Node* mul = AddOp("mul", hiai::op::Mul::TYPE, {scale, w});
+    AddOp("add", hiai::op::Add::TYPE, {data_, mul});
+    Node* one = AddConst<float>("one", {1}, {1}, DT_FLOAT);
+    Node* bias = AddConst<float>("bias", {1, 1}, {3}, DT_FLOAT);
+    Node* sub = AddOp("sub", hiai::op::Sub::TYPE, {one, bias});
+    AddOp("add_sub", hiai::op::Add::TYPE, {data_, sub});
+
+    uint32_t foldedNum = 0;
+    EXPECT_EQ(ConstantFoldingOptimizer::Optimize(*graph_, foldedNum), hiai::SUCCESS);
+    EXPECT_EQ(foldedNum, 2U);
+
+    TensorPtr weight = GetFoldedWeight("mul");
+    ASSERT_NE(weight, nullptr);
+    EXPECT_EQ(weight->GetTensorDesc().GetShape().GetDims(), (vector<int64_t> {1, 1, 3}));
+    const float* data = reinterpret_cast<const float*>(weight->GetData().GetData());
+    EXPECT_EQ(vector<float>(data, data + 3), (vector<float> {2, 4, 6}));
+
+    weight = GetFoldedWeight("sub");
+    ASSERT_NE(weight, nullptr);
+    EXPECT_EQ(weight->GetTensorDesc().GetShape().GetDims(), (vector<int64_t> {1, 1}));
+    EXPECT_EQ(*reinterpret_cast<const float*>(weight->GetData().GetData()), -2.0f);
+}
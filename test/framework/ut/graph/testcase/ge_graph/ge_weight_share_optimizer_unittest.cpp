@@ -0,0 +1,132 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "graph/tensor.h"
+#include "graph/op/const_defs.h"
+#include "framework/graph/core/cgraph/compute_graph.h"
+#include "framework/graph/core/cgraph/graph_finder.h"
+#include "framework/graph/core/cgraph/graph_modifier.h"
+#include "framework/graph/core/cgraph/graph_spec.h"
+#include "framework/graph/core/node/node.h"
+#include "framework/graph/core/node/node_spec.h"
+#include "framework/graph/core/node/node_walker.h"
+#include "framework/graph/core/edge/endpoint.h"
+#include "framework/graph/core/op/op_desc.h"
+#include "framework/graph/utils/attr_utils.h"
+#include "framework/graph/utils/optimizer/weight_share_optimizer.h"
+#include "framework/graph/debug/ge_graph_attr_define.h"
+
+using namespace std;
+using namespace ge;
+
+class ge_test_weight_share_optimizer : public testing::Test {
+protected:
+    void SetUp()
+    {
+        graph_ = ComputeGraph::Make("weight_share");
+        OpDescPtr dataDesc = std::make_shared<OpDesc>("data", "Data");
+        dataDesc->AddOutputDesc(TensorDesc(Shape({1, 4}), FORMAT_NCHW, DT_FLOAT));
+        data_ = graph_->ROLE(GraphModifier).AddNode(dataDesc);
+    }
+
+    void TearDown()
+    {
+        graph_ = nullptr;
+    }
+
+    Node* AddConst(const string& name, const string& type, const vector<float>& value, DataType dataType = DT_FLOAT)
+    {
+        TensorDesc desc(Shape({static_cast<int64_t>(value.size())}), FORMAT_NCHW, dataType);
+        TensorPtr weight = std::make_shared<Tensor>(desc);
+        weight->SetData(reinterpret_cast<const uint8_t*>(value.data()), value.size() * sizeof(float));
+
+        OpDescPtr opDesc = std::make_shared<OpDesc>(name, type);
+        opDesc->AddOutputDesc(desc);
+        AttrUtils::SetTensor(opDesc, hiai::ATTR_NAME_WEIGHTS, weight);
+        return graph_->ROLE(GraphModifier).AddNode(opDesc);
+    }
+
+    Node* AddConsumer(const string& name, Node* weight)
+    {
+        OpDescPtr opDesc = std::make_shared<OpDesc>(name, "Add");
+        opDesc->AddInputDesc(TensorDesc(Shape({1, 4}), FORMAT_NCHW, DT_FLOAT));
+        opDesc->AddInputDesc(weight->ROLE(NodeSpec).OpDesc().GetOutputDesc(0));
+        opDesc->AddOutputDesc(TensorDesc(Shape({1, 4}), FORMAT_NCHW, DT_FLOAT));
+        Node* node = graph_->ROLE(GraphModifier).AddNode(opDesc);
+        EXPECT_EQ(graph_->ROLE(GraphModifier).AddEdge({*data_, 0}, {*node, 0}), hiai::SUCCESS);
+        EXPECT_EQ(graph_->ROLE(GraphModifier).AddEdge({*weight, 0}, {*node, 1}), hiai::SUCCESS);
+        return node;
+    }
+
+protected:
+    ComputeGraphPtr graph_;
+    Node* data_ {nullptr};
+};
+
+TEST_F(ge_test_weight_share_optimizer, share_identical_const)
+{
+    Node* w1 = AddConst("w1", hiai::op::Const::TYPE, {1.0f, 2.0f, 3.0f, 4.0f});
+    Node* w2 = AddConst("w2", hiai::op::Const::TYPE, {1.0f, 2.0f, 3.0f, 4.0f});
+    Node* w3 = AddConst("w3", hiai::op::Const::TYPE, {1.0f, 2.0f, 3.0f, 5.0f});
+    AddConsumer("add1", w1);
+    Node* add2 = AddConsumer("add2", w2);
+    AddConsumer("add3", w3);
+
+    uint64_t savedBytes = 0;
+    EXPECT_EQ(WeightShareOptimizer::Optimize(*graph_, savedBytes), hiai::SUCCESS);
+    EXPECT_EQ(savedBytes, 4 * sizeof(float));
+    EXPECT_EQ(graph_->ROLE(GraphFinder).FindNode("w2"), nullptr);
+    EXPECT_NE(graph_->ROLE(GraphFinder).FindNode("w3"), nullptr);
+    EXPECT_EQ(add2->ROLE(NodeWalker).InDataNode(1), w1);
+    EXPECT_EQ(w1->ROLE(NodeSpec).OutDataEdgeSize(), 2U);
+}
+
+TEST_F(ge_test_weight_share_optimizer, keep_different_desc)
+{
+    Node* w1 = AddConst("w1", hiai::op::Const::TYPE, {1.0f, 2.0f});
+    Node* w2 = AddConst("w2", hiai::op::Const::TYPE, {1.0f, 2.0f}, DT_INT32);
+    Node* w3 = AddConst("w3", hiai::op::QuantizedConst::TYPE, {1.0f, 2.0f});
+    AddConsumer("add1", w1);
+    AddConsumer("add2", w2);
+    AddConsumer("add3", w3);
+
+    uint64_t savedBytes = 0;
+    EXPECT_EQ(WeightShareOptimizer::Optimize(*graph_, savedBytes), hiai::SUCCESS);
+    EXPECT_EQ(savedBytes, 0U);
+    EXPECT_EQ(graph_->ROLE(GraphSpec).NodesNum(), 7U);
+}
+
+TEST_F(ge_test_weight_share_optimizer, keep_different_quantize_params)
+{
+    Node* w1 = AddConst("w1", hiai::op::QuantizedConst::TYPE, {1.0f, 2.0f});
+    Node* w2 = AddConst("w2", hiai::op::QuantizedConst::TYPE, {1.0f, 2.0f});
+    Node* w3 = AddConst("w3", hiai::op::QuantizedConst::TYPE, {1.0f, 2.0f});
+    AttrUtils::SetListFloat(w1->ROLE(NodeSpec).OpDesc(), hiai::op::QuantizedConst::scale, {0.1f});
+    AttrUtils::SetListFloat(w2->ROLE(NodeSpec).OpDesc(), hiai::op::QuantizedConst::scale, {0.2f});
+    AttrUtils::SetListFloat(w3->ROLE(NodeSpec).OpDesc(), hiai::op::QuantizedConst::scale, {0.1f});
+    AddConsumer("add1", w1);
+    AddConsumer("add2", w2);
+    AddConsumer("add3", w3);
+
+    uint64_t savedBytes = 0;
+    EXPECT_EQ(WeightShareOptimizer::Optimize(*graph_, savedBytes), hiai::SUCCESS);
+    EXPECT_EQ(savedBytes, 2 * sizeof(float));
+    EXPECT_NE(graph_->ROLE(GraphFinder).FindNode("w2"), nullptr);
+    EXPECT_EQ(graph_->ROLE(GraphFinder).FindNode("w3"), nullptr);
+}
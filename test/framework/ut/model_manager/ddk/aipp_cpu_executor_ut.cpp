@@ -0,0 +1,300 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "tensor/aipp_cpu_executor.h"
+#include "tensor/aipp/aipp_para_impl.h"
+#include "tensor/aipp_para.h"
+#include "tensor/image_tensor_buffer.h"
+#include "tensor/nd_tensor_buffer.h"
+#include "framework/c/hiai_tensor_aipp_para.h"
+
+using namespace std;
+using namespace hiai;
+
+namespace {
+const uint16_t FP16_ONE = 0x3C00;
+const uint16_t FP16_HALF = 0x3800;
+const uint16_t FP16_MINUS_ONE = 0xBC00;
+} // namespace
+
+class AippCpuExecutor_UTest : public testing::Test {
+protected:
+    static HIAI_MR_TensorAippCommPara* GetCommPara(const shared_ptr<IAIPPPara>& aippPara)
+    {
+        return static_cast<HIAI_MR_TensorAippCommPara*>(aippPara->GetData());
+    }
+
+    static HIAI_MR_TensorAippBatchPara* GetBatchPara(const shared_ptr<IAIPPPara>& aippPara, uint32_t batchIndex)
+    {
+        return reinterpret_cast<HIAI_MR_TensorAippBatchPara*>(static_cast<uint8_t*>(aippPara->GetData()) +
+            sizeof(HIAI_MR_TensorAippCommPara) + sizeof(HIAI_MR_TensorAippBatchPara) * batchIndex);
+    }
+
+    // UT中_Float16被定义为uint16_t, DTC参数直接按fp16位模式写入
+    static void SetDtc(HIAI_MR_TensorAippBatchPara* batchPara, int16_t mean, uint16_t varReci)
+    {
+        batchPara->dtcPixelMeanChn0 = mean;
+        batchPara->dtcPixelMeanChn1 = mean;
+        batchPara->dtcPixelMeanChn2 = mean;
+        batchPara->dtcPixelMeanChn3 = mean;
+        batchPara->dtcPixelMinChn0 = 0;
+        batchPara->dtcPixelMinChn1 = 0;
+        batchPara->dtcPixelMinChn2 = 0;
+        batchPara->dtcPixelMinChn3 = 0;
+        batchPara->dtcPixelVarReciChn0 = varReci;
+        batchPara->dtcPixelVarReciChn1 = varReci;
+        batchPara->dtcPixelVarReciChn2 = varReci;
+        batchPara->dtcPixelVarReciChn3 = varReci;
+    }
+
+    static shared_ptr<IImageTensorBuffer> CreateImage(
+        int32_t h, int32_t w, ImageFormat format, const vector<uint8_t>& data)
+    {
+        shared_ptr<IImageTensorBuffer> image = CreateImageTensorBuffer(1, h, w, format, ImageColorSpace::JPEG, 0);
+        EXPECT_NE(image, nullptr);
+        EXPECT_EQ(image->GetSize(), data.size());
+        uint8_t* dst = static_cast<uint8_t*>(image->GetData());
+        for (size_t i = 0; i < data.size(); ++i) {
+            dst[i] = data[i];
+        }
+        return image;
+    }
+
+    static shared_ptr<INDTensorBuffer> CreateOutput(const vector<int32_t>& dims)
+    {
+        NDTensorDesc desc;
+        desc.dims = dims;
+        desc.dataType = DataType::FLOAT32;
+        desc.format = Format::NCHW;
+        return CreateNDTensorBuffer(desc);
+    }
+
+    // 按行跨度拷贝紧密排列的平面, 行尾填充0xFF
+    static void CopyRows(const uint8_t* src, size_t rowBytes, size_t rows, uint8_t* dst, size_t stride)
+    {
+        for (size_t y = 0; y < rows; ++y) {
+            for (size_t x = 0; x < stride; ++x) {
+                dst[y * stride + x] = x < rowBytes ? src[y * rowBytes + x] : 0xFF;
+            }
+        }
+    }
+
+    static vector<float> ToVector(const shared_ptr<INDTensorBuffer>& output)
+    {
+        const float* data = static_cast<const float*>(output->GetData());
+        return vector<float>(data, data + output->GetSize() / sizeof(float));
+    }
+};
+
+/*
+ * 测试用例标题：ExecuteAippOnCpu_crop_dtc_multi_batch
+ * 测试用例描述：RGB888单张图片, 两个batch分别crop不同区域并做DTC
+ * 预期结果：输出与手工计算的(pixel - mean) * varReci一致
+ */
+TEST_F(AippCpuExecutor_UTest, ExecuteAippOnCpu_crop_dtc_multi_batch)
+{
+    // 4x4图片, R = 10 * (y * 4 + x), G = R + 1, B = R + 2
+    vector<uint8_t> pixels;
+    for (uint8_t i = 0; i < 16; ++i) {
+        pixels.push_back(i * 10);
+        pixels.push_back(i * 10 + 1);
+        pixels.push_back(i * 10 + 2);
+    }
+    shared_ptr<IImageTensorBuffer> image = CreateImage(4, 4, ImageFormat::RGB888, pixels);
+
+    shared_ptr<IAIPPPara> aippPara = CreateAIPPPara(2);
+    ASSERT_NE(aippPara, nullptr);
+    const uint32_t cropStart[2][2] = {{1, 1}, {2, 0}};
+    for (uint32_t n = 0; n < 2; ++n) {
+        HIAI_MR_TensorAippBatchPara* batchPara = GetBatchPara(aippPara, n);
+        batchPara->cropSwitch = 1;
+        batchPara->cropStartPosW = cropStart[n][0];
+        batchPara->cropStartPosH = cropStart[n][1];
+        batchPara->cropSizeW = 2;
+        batchPara->cropSizeH = 2;
+        SetDtc(batchPara, 10, n == 0 ? FP16_ONE : FP16_HALF);
+    }
+
+    shared_ptr<INDTensorBuffer> output = CreateOutput({2, 3, 2, 2});
+    ASSERT_EQ(ExecuteAippOnCpu(aippPara, image, output), SUCCESS);
+
+    vector<float> expect;
+    for (uint32_t n = 0; n < 2; ++n) {
+        float scale = n == 0 ? 1.0f : 0.5f;
+        for (uint32_t c = 0; c < 3; ++c) {
+            for (uint32_t y = 0; y < 2; ++y) {
+                for (uint32_t x = 0; x < 2; ++x) {
+                    uint32_t index = (cropStart[n][1] + y) * 4 + cropStart[n][0] + x;
+                    expect.push_back((static_cast<float>(index * 10 + c) - 10.0f) * scale);
+                }
+            }
+        }
+    }
+    EXPECT_EQ(ToVector(output), expect);
+}
+
+/*
+ * 测试用例标题：ExecuteAippOnCpu_yuv420sp_to_rgb
+ * 测试用例描述：YUV420SP(NV21, 开启uv交换)经SetCscPara配置的JPEG矩阵转换到RGB888
+ * 预期结果：输出与按定点矩阵计算的RGB值一致
+ */
+TEST_F(AippCpuExecutor_UTest, ExecuteAippOnCpu_yuv420sp_to_rgb)
+{
+    // 2x2, Y = 100, 内存中为VU顺序: V = 138, U = 128
+    shared_ptr<IImageTensorBuffer> image = CreateImage(2, 2, ImageFormat::YUV420SP, {100, 100, 100, 100, 138, 128});
+
+    shared_ptr<IAIPPPara> aippPara = CreateAIPPPara(1);
+    ASSERT_NE(aippPara, nullptr);
+    ASSERT_EQ(aippPara->SetInputFormat(ImageFormat::YUV420SP), SUCCESS);
+    ASSERT_EQ(aippPara->SetCscPara(ImageFormat::RGB888, ImageColorSpace::JPEG), SUCCESS);
+    GetCommPara(aippPara)->rbuvSwapSwitch = 1;
+    SetDtc(GetBatchPara(aippPara, 0), 0, FP16_ONE);
+
+    shared_ptr<INDTensorBuffer> output = CreateOutput({1, 3, 2, 2});
+    ASSERT_EQ(ExecuteAippOnCpu(aippPara, image, output), SUCCESS);
+
+    // R = (256 * 100 + 359 * 10 + 128) >> 8, G = (256 * 100 - 183 * 10 + 128) >> 8, B = 100
+    vector<float> expect = {114, 114, 114, 114, 93, 93, 93, 93, 100, 100, 100, 100};
+    EXPECT_EQ(ToVector(output), expect);
+}
+
+/*
+ * 测试用例标题：ExecuteAippOnCpu_resize_padding
+ * 测试用例描述：2x2图片双线性放大到4x4, 并在上/左/右填充-1
+ * 预期结果：有效区域为100 * (ty + sx), 填充区域为填充值
+ */
+TEST_F(AippCpuExecutor_UTest, ExecuteAippOnCpu_resize_padding)
+{
+    shared_ptr<IImageTensorBuffer> image =
+        CreateImage(2, 2, ImageFormat::RGB888, {0, 0, 0, 100, 0, 0, 100, 0, 0, 200, 0, 0});
+
+    shared_ptr<IAIPPPara> aippPara = CreateAIPPPara(1);
+    ASSERT_NE(aippPara, nullptr);
+    HIAI_MR_TensorAippBatchPara* batchPara = GetBatchPara(aippPara, 0);
+    batchPara->scfSwitch = 1;
+    batchPara->scfInputSizeW = 2;
+    batchPara->scfInputSizeH = 2;
+    batchPara->scfOutputSizeW = 4;
+    batchPara->scfOutputSizeH = 4;
+    batchPara->paddingSwitch = 1;
+    batchPara->paddingSizeTop = 1;
+    batchPara->paddingSizeLeft = 1;
+    batchPara->paddingSizeRight = 1;
+    batchPara->paddingValueChn0 = FP16_MINUS_ONE;
+    SetDtc(batchPara, 0, FP16_ONE);
+
+    shared_ptr<INDTensorBuffer> output = CreateOutput({1, 1, 5, 6});
+    ASSERT_EQ(ExecuteAippOnCpu(aippPara, image, output), SUCCESS);
+
+    const float coord[4] = {0.0f, 0.25f, 0.75f, 1.0f};
+    vector<float> expect(6, -1.0f);
+    for (uint32_t y = 0; y < 4; ++y) {
+        expect.push_back(-1.0f);
+        for (uint32_t x = 0; x < 4; ++x) {
+            expect.push_back(100.0f * (coord[y] + coord[x]));
+        }
+        expect.push_back(-1.0f);
+    }
+    vector<float> result = ToVector(output);
+    ASSERT_EQ(result.size(), expect.size());
+    for (size_t i = 0; i < expect.size(); ++i) {
+        EXPECT_NEAR(result[i], expect[i], 1e-4);
+    }
+}
+
+/*
+ * 测试用例标题：ExecuteAippOnCpu_invalid_para
+ * 测试用例描述：输出shape与AIPP配置不一致、开启旋转、crop越界
+ * 预期结果：返回FAILURE
+ */
+TEST_F(AippCpuExecutor_UTest, ExecuteAippOnCpu_invalid_para)
+{
+    shared_ptr<IImageTensorBuffer> image = CreateImage(2, 2, ImageFormat::YUV400, {1, 2, 3, 4});
+    shared_ptr<IAIPPPara> aippPara = CreateAIPPPara(1);
+    ASSERT_NE(aippPara, nullptr);
+
+    EXPECT_NE(ExecuteAippOnCpu(aippPara, image, CreateOutput({1, 1, 3, 2})), SUCCESS);
+    EXPECT_NE(ExecuteAippOnCpu(aippPara, image, CreateOutput({2, 1, 2, 2})), SUCCESS);
+
+    HIAI_MR_TensorAippBatchPara* batchPara = GetBatchPara(aippPara, 0);
+    batchPara->rotateSwitch = 1;
+    EXPECT_NE(ExecuteAippOnCpu(aippPara, image, CreateOutput({1, 1, 2, 2})), SUCCESS);
+
+    batchPara->rotateSwitch = 0;
+    batchPara->cropSwitch = 1;
+    batchPara->cropStartPosW = 1;
+    batchPara->cropSizeW = 2;
+    batchPara->cropSizeH = 2;
+    EXPECT_NE(ExecuteAippOnCpu(aippPara, image, CreateOutput({1, 1, 2, 2})), SUCCESS);
+}
+
+/*
+ * 测试用例标题：ExecuteAippOnCpu_strided_planes
+ * 测试用例描述：带行跨度填充的外部帧内存(Y/UV分开存放、连续存放)直接执行AIPP, 连续存放时srcImageSize取存储宽高
+ * 预期结果：输出与紧密排列图片一致
+ */
+TEST_F(AippCpuExecutor_UTest, ExecuteAippOnCpu_strided_planes)
+{
+    // 2x4, Y = 10 * i, 内存中为VU顺序
+    const vector<uint8_t> packed = {0, 10, 20, 30, 40, 50, 60, 70, 138, 128, 118, 148};
+    shared_ptr<IAIPPPara> aippPara = CreateAIPPPara(1);
+    ASSERT_NE(aippPara, nullptr);
+    ASSERT_EQ(aippPara->SetInputFormat(ImageFormat::YUV420SP), SUCCESS);
+    ASSERT_EQ(aippPara->SetCscPara(ImageFormat::RGB888, ImageColorSpace::JPEG), SUCCESS);
+    GetCommPara(aippPara)->rbuvSwapSwitch = 1;
+    SetDtc(GetBatchPara(aippPara, 0), 0, FP16_ONE);
+    shared_ptr<INDTensorBuffer> expect = CreateOutput({1, 3, 2, 4});
+    ASSERT_EQ(ExecuteAippOnCpu(aippPara, CreateImage(2, 4, ImageFormat::YUV420SP, packed), expect), SUCCESS);
+
+    // Y/UV分开存放, 行跨度6
+    vector<uint8_t> yPlane(6 * 2);
+    vector<uint8_t> uvPlane(6);
+    CopyRows(packed.data(), 4, 2, yPlane.data(), 6);
+    CopyRows(packed.data() + 8, 4, 1, uvPlane.data(), 6);
+    vector<ImagePlane> planes(2);
+    planes[0].data = yPlane.data();
+    planes[0].stride = 6;
+    planes[1].data = uvPlane.data();
+    planes[1].stride = 6;
+    shared_ptr<IImageTensorBuffer> image =
+        CreateImageTensorBufferFromPlanes(planes, 2, 4, ImageFormat::YUV420SP, ImageColorSpace::JPEG, 0, nullptr);
+    ASSERT_NE(image, nullptr);
+    shared_ptr<INDTensorBuffer> output = CreateOutput({1, 3, 2, 4});
+    ASSERT_EQ(ExecuteAippOnCpu(aippPara, image, output), SUCCESS);
+    EXPECT_EQ(ToVector(output), ToVector(expect));
+
+    // 连续存放, Y平面按4行对齐后紧跟UV平面, AIPP按存储宽高[6, 4]读取并裁剪出有效区域
+    vector<uint8_t> frame(6 * 4 + 6, 0xFF);
+    CopyRows(packed.data(), 4, 2, frame.data(), 6);
+    CopyRows(packed.data() + 8, 4, 1, frame.data() + 6 * 4, 6);
+    planes[0].data = frame.data();
+    planes[1].data = frame.data() + 6 * 4;
+    image = CreateImageTensorBufferFromPlanes(planes, 2, 4, ImageFormat::YUV420SP, ImageColorSpace::JPEG, 0, nullptr);
+    ASSERT_NE(image, nullptr);
+    EXPECT_EQ(image->GetSize(), 6 * 4 + 4U);
+    shared_ptr<AIPPParaImpl> paraImpl = dynamic_pointer_cast<AIPPParaImpl>(aippPara);
+    ASSERT_NE(paraImpl, nullptr);
+    ASSERT_EQ(paraImpl->SetInputShape({4, 2}, {6, 4}), SUCCESS);
+    EXPECT_EQ(aippPara->GetInputShape(), vector<int32_t>({6, 4}));
+    EXPECT_EQ(aippPara->GetCropPara(0).cropSizeW, 4U);
+    EXPECT_EQ(aippPara->GetCropPara(0).cropSizeH, 2U);
+    output = CreateOutput({1, 3, 2, 4});
+    ASSERT_EQ(ExecuteAippOnCpu(aippPara, image, output), SUCCESS);
+    EXPECT_EQ(ToVector(output), ToVector(expect));
+}
@@ -19,6 +19,9 @@
 
 #include <iostream>
 #include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <limits>
 #include <dlfcn.h>
 
 #include "tensor/aipp/aipp_para_impl.h"
@@ -849,4 +852,179 @@ TEST_F(AippPara_v2_ut, GetSize_001)
 {
     auto ret = aippPara_->GetSize();
     EXPECT_NE(0, ret);
-}
\ No newline at end of file
+}
+/*
+ * 测试用例标题：SetBatchPara_001
+ * 测试用例描述：批量接口与逐batch接口设置相同参数
+ * 预置条件：
+ *           1. 创建两个batch数为3的AippPara对象
+ * 操作步骤：
+ *           2. 一个调用SetBatchCropPara/SetBatchResizePara/SetBatchPaddingPara/SetBatchDtcPara
+ *           3. 另一个逐batch调用SetCropPara/SetResizePara/SetPaddingPara/SetDtcPara
+ *           4. 检查结果
+ * 预期结果：
+ *          1.两者的参数内存完全一致, NaN的padding值仍为NaN
+ */
+TEST_F(AippPara_v2_ut, SetBatchPara_001)
+{
+    const uint32_t BATCH_COUNT = 3;
+    InitAippPara(BATCH_COUNT);
+    std::shared_ptr<IAIPPPara> expectPara = CreateAIPPPara(BATCH_COUNT);
+    ASSERT_NE(nullptr, expectPara);
+
+    std::vector<CropPara> cropParas(BATCH_COUNT);
+    std::vector<ResizePara> resizeParas(BATCH_COUNT);
+    std::vector<PadPara> paddingParas(BATCH_COUNT);
+    std::vector<DtcPara> dtcParas(BATCH_COUNT);
+    for (uint32_t i = 0; i < BATCH_COUNT; ++i) {
+        cropParas[i].cropStartPosW = i;
+        cropParas[i].cropStartPosH = i + 1;
+        cropParas[i].cropSizeW = 16 + i;
+        cropParas[i].cropSizeH = 8 + i;
+        resizeParas[i].resizeOutputSizeW = 32 + i;
+        resizeParas[i].resizeOutputSizeH = 24 + i;
+        paddingParas[i].paddingSizeTop = i;
+        paddingParas[i].paddingSizeRight = i + 2;
+        paddingParas[i].paddingValueChn0 = i;
+        paddingParas[i].paddingValueChn1 = std::numeric_limits<float>::quiet_NaN(); // NaN不截断
+        paddingParas[i].paddingValueChn3 = 100000; // 超过fp16范围, 截断
+        dtcParas[i].pixelMeanChn0 = 10 + i;
+        dtcParas[i].pixelMeanChn2 = 20 + i;
+        dtcParas[i].pixelMinChn1 = i;
+        dtcParas[i].pixelVarReciChn0 = 1;
+        dtcParas[i].pixelVarReciChn3 = -100000;
+
+        EXPECT_EQ(SUCCESS, expectPara->SetCropPara(i, CropPara(cropParas[i])));
+        EXPECT_EQ(SUCCESS, expectPara->SetResizePara(i, ResizePara(resizeParas[i])));
+        EXPECT_EQ(SUCCESS, expectPara->SetPaddingPara(i, PadPara(paddingParas[i])));
+        EXPECT_EQ(SUCCESS, expectPara->SetDtcPara(i, DtcPara(dtcParas[i])));
+    }
+
+    EXPECT_EQ(SUCCESS, SetBatchCropPara(aippPara_, cropParas));
+    EXPECT_EQ(SUCCESS, SetBatchResizePara(aippPara_, resizeParas));
+    EXPECT_EQ(SUCCESS, SetBatchPaddingPara(aippPara_, paddingParas));
+    EXPECT_EQ(SUCCESS, SetBatchDtcPara(aippPara_, dtcParas));
+
+    ASSERT_EQ(expectPara->GetSize(), aippPara_->GetSize());
+    EXPECT_EQ(0, memcmp(expectPara->GetData(), aippPara_->GetData(), aippPara_->GetSize()));
+    for (uint32_t i = 0; i < BATCH_COUNT; ++i) {
+        EXPECT_TRUE(std::isnan(aippPara_->GetPaddingPara(i).paddingValueChn1));
+    }
+}
+
+/*
+ * 测试用例标题：SetBatchPara_fail_001
+ * 测试用例描述：批量接口参数个数与batch数不一致、crop越界、resize输出为0
+ * 预置条件：
+ *           1. 创建batch数为2的AippPara对象, 设置输入图片大小
+ * 操作步骤：
+ *           2. 调用批量接口设置非法参数
+ *           3. 检查结果
+ * 预期结果：
+ *          1.返回FAILURE, 且参数内存未被修改
+ */
+TEST_F(AippPara_v2_ut, SetBatchPara_fail_001)
+{
+    const uint32_t BATCH_COUNT = 2;
+    InitAippPara(BATCH_COUNT);
+    std::vector<int32_t> shape = {16, 16}; // W, H
+    ASSERT_EQ(SUCCESS, aippPara_->SetInputShape(shape));
+    std::vector<uint8_t> origin(static_cast<uint8_t*>(aippPara_->GetData()),
+        static_cast<uint8_t*>(aippPara_->GetData()) + aippPara_->GetSize());
+
+    EXPECT_EQ(FAILURE, SetBatchDtcPara(aippPara_, std::vector<DtcPara>(BATCH_COUNT + 1)));
+    EXPECT_EQ(FAILURE, SetBatchResizePara(aippPara_, std::vector<ResizePara>(BATCH_COUNT)));
+
+    std::vector<CropPara> cropParas(BATCH_COUNT);
+    for (CropPara& cropPara : cropParas) {
+        cropPara.cropSizeW = 8;
+        cropPara.cropSizeH = 8;
+    }
+    cropParas[1].cropStartPosW = 9;
+    EXPECT_EQ(FAILURE, SetBatchCropPara(aippPara_, cropParas));
+    EXPECT_EQ(FAILURE, SetBatchCropPara(nullptr, cropParas));
+    EXPECT_EQ(0, memcmp(origin.data(), aippPara_->GetData(), origin.size()));
+}
+
+/*
+ * 测试用例标题：SetCscPara_Repeat_001
+ * 测试用例描述：不同输入格式间反复切换SetCscPara, 参数与首次设置一致
+ * 预置条件：
+ *           1. 创建AippPara对象
+ * 操作步骤：
+ *           2. 依次设置YUV420SP->RGB888, RGB888->YVU444SP, RGB888->YUV400, 再切回YUV420SP->RGB888
+ *           3. 检查结果
+ * 预期结果：
+ *          1.最后一次的CSC参数与第一次完全一致, 非法组合返回FAILURE
+ */
+TEST_F(AippPara_v2_ut, SetCscPara_Repeat_001)
+{
+    ASSERT_EQ(SUCCESS, aippPara_->SetInputFormat(ImageFormat::YUV420SP));
+    ASSERT_EQ(SUCCESS, aippPara_->SetCscPara(ImageFormat::RGB888, ImageColorSpace::BT_601_NARROW));
+    CscMatrixPara expectPara = aippPara_->GetCscPara();
+    EXPECT_EQ(298, expectPara.matrixR0C0);
+    EXPECT_EQ(409, expectPara.matrixR0C2);
+    EXPECT_EQ(16, expectPara.inputBias0);
+    EXPECT_EQ(128, expectPara.inputBias2);
+    EXPECT_EQ(0, expectPara.outputBias0);
+
+    ASSERT_EQ(SUCCESS, aippPara_->SetInputFormat(ImageFormat::RGB888));
+    ASSERT_EQ(SUCCESS, aippPara_->SetCscPara(ImageFormat::YVU444SP, ImageColorSpace::JPEG));
+    CscMatrixPara yuvPara = aippPara_->GetCscPara();
+    EXPECT_EQ(77, yuvPara.matrixR0C0);
+    EXPECT_EQ(128, yuvPara.matrixR1C0); // YVU输出第二行为V
+    EXPECT_EQ(0, yuvPara.outputBias0);
+    EXPECT_EQ(128, yuvPara.outputBias1);
+    EXPECT_EQ(FAILURE, aippPara_->SetCscPara(ImageFormat::BGR888, ImageColorSpace::JPEG));
+    EXPECT_EQ(FAILURE, aippPara_->SetCscPara(ImageFormat::RGB888, static_cast<ImageColorSpace>(4)));
+    ASSERT_EQ(SUCCESS, aippPara_->SetCscPara(ImageFormat::YUV400));
+    EXPECT_EQ(150, aippPara_->GetCscPara().matrixR0C1);
+
+    ASSERT_EQ(SUCCESS, aippPara_->SetInputFormat(ImageFormat::YUV420SP));
+    ASSERT_EQ(SUCCESS, aippPara_->SetCscPara(ImageFormat::RGB888, ImageColorSpace::BT_601_NARROW));
+    CscMatrixPara cscPara = aippPara_->GetCscPara();
+    EXPECT_EQ(0, memcmp(&expectPara, &cscPara, sizeof(CscMatrixPara)));
+}
+
+/*
+ * 测试用例标题：AIPPParaSnapshot_001
+ * 测试用例描述：生成AippPara快照并写入另一个batch数相同的AippPara
+ * 预置条件：
+ *           1. 创建batch数为2的AippPara对象并设置参数
+ * 操作步骤：
+ *           2. 调用CreateAIPPParaSnapshot生成快照
+ *           3. 修改原AippPara后, 调用ApplyAIPPParaSnapshot写入新AippPara
+ *           4. 检查结果
+ * 预期结果：
+ *          1.新AippPara的参数内存与生成快照时一致, batch数不同时返回FAILURE
+ */
+TEST_F(AippPara_v2_ut, AIPPParaSnapshot_001)
+{
+    const uint32_t BATCH_COUNT = 2;
+    InitAippPara(BATCH_COUNT);
+    ASSERT_EQ(SUCCESS, aippPara_->SetInputFormat(ImageFormat::YUV420SP));
+    ASSERT_EQ(SUCCESS, aippPara_->SetCscPara(ImageFormat::BGR888));
+    DtcPara dtcPara;
+    dtcPara.pixelMeanChn0 = 10;
+    dtcPara.pixelVarReciChn1 = 0.5;
+    ASSERT_EQ(SUCCESS, aippPara_->SetDtcPara(DtcPara(dtcPara)));
+    ASSERT_EQ(SUCCESS, aippPara_->SetInputIndex(1));
+    std::vector<uint8_t> expect(static_cast<uint8_t*>(aippPara_->GetData()),
+        static_cast<uint8_t*>(aippPara_->GetData()) + aippPara_->GetSize());
+
+    std::shared_ptr<const AIPPParaSnapshot> snapshot = CreateAIPPParaSnapshot(aippPara_);
+    ASSERT_NE(nullptr, snapshot);
+    ASSERT_EQ(SUCCESS, aippPara_->SetCropPara(CropPara()));
+
+    std::shared_ptr<IAIPPPara> aippPara = CreateAIPPPara(BATCH_COUNT);
+    ASSERT_NE(nullptr, aippPara);
+    ASSERT_EQ(SUCCESS, ApplyAIPPParaSnapshot(snapshot, aippPara));
+    ASSERT_EQ(expect.size(), aippPara->GetSize());
+    EXPECT_EQ(0, memcmp(expect.data(), aippPara->GetData(), expect.size()));
+    EXPECT_EQ(1, aippPara->GetInputIndex());
+    EXPECT_EQ(0.5, aippPara->GetDtcPara(1).pixelVarReciChn1);
+
+    EXPECT_EQ(FAILURE, ApplyAIPPParaSnapshot(snapshot, CreateAIPPPara(BATCH_COUNT + 1)));
+    EXPECT_EQ(FAILURE, ApplyAIPPParaSnapshot(nullptr, aippPara));
+    EXPECT_EQ(nullptr, CreateAIPPParaSnapshot(nullptr));
+}
@@ -0,0 +1,269 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <vector>
+
+#include "tensor/image_convert.h"
+#include "tensor/image/image_convert_kernel.h"
+#include "tensor/image/image_csc_table.h"
+
+using namespace std;
+using namespace hiai;
+
+namespace {
+// 覆盖AVX2(32)/SSE2(16)/NEON(16)向量段及标量尾部
+const size_t TEST_WIDTH = 70;
+
+vector<uint8_t> RandomData(size_t size, unsigned int seed)
+{
+    srand(seed);
+    vector<uint8_t> data(size);
+    for (auto& value : data) {
+        value = static_cast<uint8_t>(rand() % 256);
+    }
+    return data;
+}
+
+vector<RgbLayout> TestLayouts()
+{
+    // RGB888, BGR888, XRGB8888
+    const uint32_t idx[3][5] = {{3, 0, 1, 2, 0}, {3, 2, 1, 0, 0}, {4, 1, 2, 3, 0}};
+    vector<RgbLayout> layouts(3);
+    for (size_t i = 0; i < layouts.size(); ++i) {
+        layouts[i].channel = idx[i][0];
+        layouts[i].rIdx = idx[i][1];
+        layouts[i].gIdx = idx[i][2];
+        layouts[i].bIdx = idx[i][3];
+        layouts[i].xIdx = layouts[i].channel == 4 ? 0 : -1;
+    }
+    return layouts;
+}
+
+CscCoeff MakeCoeff(const int32_t (&table)[4][3][3], ImageColorSpace colorSpace)
+{
+    CscCoeff coeff;
+    for (uint32_t i = 0; i < 3; ++i) {
+        for (uint32_t j = 0; j < 3; ++j) {
+            coeff.matrix[i][j] = static_cast<int16_t>(table[static_cast<uint32_t>(colorSpace)][i][j]);
+        }
+    }
+    coeff.yBias = static_cast<int16_t>(GetCscYBias(colorSpace));
+    return coeff;
+}
+
+const ImageColorSpace COLOR_SPACES[] = {ImageColorSpace::JPEG, ImageColorSpace::BT_601_NARROW,
+    ImageColorSpace::BT_601_FULL, ImageColorSpace::BT_709_NARROW};
+} // namespace
+
+class ImageConvert_UTest : public testing::Test {
+protected:
+    static shared_ptr<IImageTensorBuffer> CreateImage(int32_t b, int32_t h, int32_t w, ImageFormat format)
+    {
+        shared_ptr<IImageTensorBuffer> image = CreateImageTensorBuffer(b, h, w, format, ImageColorSpace::JPEG, 0);
+        EXPECT_NE(image, nullptr);
+        return image;
+    }
+
+    static vector<uint8_t> ToVector(const shared_ptr<IImageTensorBuffer>& image)
+    {
+        const uint8_t* data = static_cast<const uint8_t*>(image->GetData());
+        return vector<uint8_t>(data, data + image->GetSize());
+    }
+};
+
+/*
+ * 测试用例标题：ConvertKernel_yuv_to_rgb_bit_exact
+ * 测试用例描述：随机YUV420SP数据按各色域/UV顺序/RGB格式转换, 向量实现与标量实现对比
+ * 预期结果：结果逐字节一致
+ */
+TEST_F(ImageConvert_UTest, ConvertKernel_yuv_to_rgb_bit_exact)
+{
+    vector<uint8_t> y = RandomData(TEST_WIDTH, 1);
+    vector<uint8_t> uv = RandomData(TEST_WIDTH, 2);
+    for (ImageColorSpace colorSpace : COLOR_SPACES) {
+        CscCoeff coeff = MakeCoeff(YUV_TO_RGB, colorSpace);
+        for (const RgbLayout& layout : TestLayouts()) {
+            for (bool vuOrder : {false, true}) {
+                vector<uint8_t> expect(TEST_WIDTH * layout.channel);
+                vector<uint8_t> result(TEST_WIDTH * layout.channel);
+                ConvertYuv420SPRowToRgbScalar(y.data(), uv.data(), vuOrder, coeff, layout, expect.data(), TEST_WIDTH);
+                ConvertYuv420SPRowToRgb(y.data(), uv.data(), vuOrder, coeff, layout, result.data(), TEST_WIDTH);
+                EXPECT_EQ(expect, result);
+            }
+        }
+    }
+}
+
+/*
+ * 测试用例标题：ConvertKernel_rgb_to_y_bit_exact
+ * 测试用例描述：随机RGB数据按各色域/RGB格式转换为Y, 向量实现与标量实现对比
+ * 预期结果：结果逐字节一致
+ */
+TEST_F(ImageConvert_UTest, ConvertKernel_rgb_to_y_bit_exact)
+{
+    vector<uint8_t> rgb = RandomData(TEST_WIDTH * 4, 3);
+    for (ImageColorSpace colorSpace : COLOR_SPACES) {
+        CscCoeff coeff = MakeCoeff(RGB_TO_YUV, colorSpace);
+        for (const RgbLayout& layout : TestLayouts()) {
+            vector<uint8_t> expect(TEST_WIDTH);
+            vector<uint8_t> result(TEST_WIDTH);
+            ConvertRgbRowToYScalar(rgb.data(), layout, coeff, expect.data(), TEST_WIDTH);
+            ConvertRgbRowToY(rgb.data(), layout, coeff, result.data(), TEST_WIDTH);
+            EXPECT_EQ(expect, result);
+        }
+    }
+}
+
+/*
+ * 测试用例标题：ConvertKernel_repack_bit_exact
+ * 测试用例描述：YUYV拆分, 3/4通道交织与拆分, 向量实现与标量实现对比
+ * 预期结果：结果逐字节一致, 交织后拆分还原原始数据
+ */
+TEST_F(ImageConvert_UTest, ConvertKernel_repack_bit_exact)
+{
+    vector<uint8_t> yuyv = RandomData(TEST_WIDTH * 2, 4);
+    vector<uint8_t> expect(TEST_WIDTH * 2);
+    vector<uint8_t> result(TEST_WIDTH * 2);
+    ConvertYuyvRowToYuv422SPScalar(yuyv.data(), expect.data(), expect.data() + TEST_WIDTH, TEST_WIDTH);
+    ConvertYuyvRowToYuv422SP(yuyv.data(), result.data(), result.data() + TEST_WIDTH, TEST_WIDTH);
+    EXPECT_EQ(expect, result);
+
+    for (uint32_t channel : {3U, 4U}) {
+        vector<uint8_t> planar = RandomData(TEST_WIDTH * channel, channel);
+        const uint8_t* planes[4] = {};
+        for (uint32_t c = 0; c < channel; ++c) {
+            planes[c] = planar.data() + c * TEST_WIDTH;
+        }
+        vector<uint8_t> expectPacked(planar.size());
+        vector<uint8_t> packed(planar.size());
+        InterleavePlanesScalar(planes, channel, expectPacked.data(), TEST_WIDTH);
+        InterleavePlanes(planes, channel, packed.data(), TEST_WIDTH);
+        EXPECT_EQ(expectPacked, packed);
+
+        vector<uint8_t> unpacked(planar.size());
+        uint8_t* outPlanes[4] = {};
+        for (uint32_t c = 0; c < channel; ++c) {
+            outPlanes[c] = unpacked.data() + c * TEST_WIDTH;
+        }
+        DeinterleavePlanes(packed.data(), channel, outPlanes, TEST_WIDTH);
+        EXPECT_EQ(planar, unpacked);
+    }
+}
+
+/*
+ * 测试用例标题：ConvertYuv420SPToRgb_001
+ * 测试用例描述：NV12/NV21 2x2图片转换为RGB888/XRGB8888
+ * 预期结果：输出与按定点矩阵计算的RGB值一致, NV21与交换UV后的NV12结果相同
+ */
+TEST_F(ImageConvert_UTest, ConvertYuv420SPToRgb_001)
+{
+    // Y = 100, U = 128, V = 138
+    vector<uint8_t> nv12 = {100, 100, 100, 100, 128, 138};
+    vector<uint8_t> nv21 = {100, 100, 100, 100, 138, 128};
+
+    shared_ptr<IImageTensorBuffer> rgb = CreateImage(1, 2, 2, ImageFormat::RGB888);
+    ASSERT_EQ(SUCCESS,
+        ConvertYuv420SPToRgb(nv12.data(), nv12.size(), YuvSemiPlanarOrder::NV12, ImageColorSpace::JPEG, rgb));
+    // R = (256 * 100 + 359 * 10 + 128) >> 8, G = (256 * 100 - 183 * 10 + 128) >> 8, B = 100
+    vector<uint8_t> expect = {114, 93, 100, 114, 93, 100, 114, 93, 100, 114, 93, 100};
+    EXPECT_EQ(expect, ToVector(rgb));
+
+    shared_ptr<IImageTensorBuffer> xrgb = CreateImage(1, 2, 2, ImageFormat::XRGB8888);
+    ASSERT_EQ(SUCCESS,
+        ConvertYuv420SPToRgb(nv21.data(), nv21.size(), YuvSemiPlanarOrder::NV21, ImageColorSpace::JPEG, xrgb));
+    expect = {255, 114, 93, 100, 255, 114, 93, 100, 255, 114, 93, 100, 255, 114, 93, 100};
+    EXPECT_EQ(expect, ToVector(xrgb));
+}
+
+/*
+ * 测试用例标题：ConvertRgbToYuv420SP_001
+ * 测试用例描述：灰色BGR888图片转换为NV21
+ * 预期结果：Y为灰度值, UV为128
+ */
+TEST_F(ImageConvert_UTest, ConvertRgbToYuv420SP_001)
+{
+    vector<uint8_t> bgr(2 * 4 * 3, 50);
+    shared_ptr<IImageTensorBuffer> yuv = CreateImage(1, 2, 4, ImageFormat::YUV420SP);
+    ASSERT_EQ(SUCCESS, ConvertRgbToYuv420SP(bgr.data(), bgr.size(), ImageFormat::BGR888, YuvSemiPlanarOrder::NV21, yuv));
+
+    // Y = (256 * 50 + 128) >> 8, UV = 128
+    vector<uint8_t> expect = {50, 50, 50, 50, 50, 50, 50, 50, 128, 128, 128, 128};
+    EXPECT_EQ(expect, ToVector(yuv));
+}
+
+/*
+ * 测试用例标题：ConvertYuyvToYuv422SP_001
+ * 测试用例描述：两张2x2 YUYV图片重排为YUV422SP
+ * 预期结果：每张图片Y平面后紧跟交织的UV平面
+ */
+TEST_F(ImageConvert_UTest, ConvertYuyvToYuv422SP_001)
+{
+    vector<uint8_t> yuyv;
+    for (uint8_t i = 0; i < 8; ++i) {
+        yuyv.push_back(i);       // Y
+        yuyv.push_back(100 + i); // U/V
+    }
+    shared_ptr<IImageTensorBuffer> yuv = CreateImage(2, 2, 2, ImageFormat::YUV422SP);
+    ASSERT_EQ(SUCCESS, ConvertYuyvToYuv422SP(yuyv.data(), yuyv.size(), yuv));
+
+    vector<uint8_t> expect = {0, 1, 2, 3, 100, 101, 102, 103, 4, 5, 6, 7, 104, 105, 106, 107};
+    EXPECT_EQ(expect, ToVector(yuv));
+}
+
+/*
+ * 测试用例标题：ConvertPlanarToInterleaved_001
+ * 测试用例描述：平面数据交织为RGB888后再拆分为平面
+ * 预期结果：交织结果正确, 拆分后还原原始数据
+ */
+TEST_F(ImageConvert_UTest, ConvertPlanarToInterleaved_001)
+{
+    vector<uint8_t> planar = {1, 2, 3, 4, 11, 12, 13, 14, 21, 22, 23, 24};
+    shared_ptr<IImageTensorBuffer> rgb = CreateImage(1, 2, 2, ImageFormat::RGB888);
+    ASSERT_EQ(SUCCESS, ConvertPlanarToInterleaved(planar.data(), planar.size(), rgb));
+    vector<uint8_t> expect = {1, 11, 21, 2, 12, 22, 3, 13, 23, 4, 14, 24};
+    EXPECT_EQ(expect, ToVector(rgb));
+
+    vector<uint8_t> result(planar.size());
+    ASSERT_EQ(SUCCESS, ConvertInterleavedToPlanar(rgb, result.data(), result.size()));
+    EXPECT_EQ(planar, result);
+}
+
+/*
+ * 测试用例标题：ConvertImage_invalid_para
+ * 测试用例描述：源数据大小不匹配、目标格式不支持、YUV420SP尺寸为奇数、空指针
+ * 预期结果：返回FAILURE
+ */
+TEST_F(ImageConvert_UTest, ConvertImage_invalid_para)
+{
+    vector<uint8_t> src(64, 0);
+    shared_ptr<IImageTensorBuffer> rgb = CreateImage(1, 2, 2, ImageFormat::RGB888);
+    EXPECT_NE(SUCCESS, ConvertYuv420SPToRgb(src.data(), 5, YuvSemiPlanarOrder::NV12, ImageColorSpace::JPEG, rgb));
+    EXPECT_NE(SUCCESS, ConvertYuv420SPToRgb(nullptr, 6, YuvSemiPlanarOrder::NV12, ImageColorSpace::JPEG, rgb));
+    EXPECT_NE(SUCCESS, ConvertYuv420SPToRgb(src.data(), 6, YuvSemiPlanarOrder::NV12, ImageColorSpace::JPEG, nullptr));
+
+    shared_ptr<IImageTensorBuffer> yuv400 = CreateImage(1, 2, 2, ImageFormat::YUV400);
+    EXPECT_NE(SUCCESS, ConvertYuv420SPToRgb(src.data(), 6, YuvSemiPlanarOrder::NV12, ImageColorSpace::JPEG, yuv400));
+    EXPECT_NE(SUCCESS, ConvertPlanarToInterleaved(src.data(), 4, yuv400));
+
+    shared_ptr<IImageTensorBuffer> oddRgb = CreateImage(1, 3, 2, ImageFormat::RGB888);
+    EXPECT_NE(SUCCESS, ConvertYuv420SPToRgb(src.data(), 9, YuvSemiPlanarOrder::NV12, ImageColorSpace::JPEG, oddRgb));
+
+    shared_ptr<IImageTensorBuffer> yuv = CreateImage(1, 2, 2, ImageFormat::YUV420SP);
+    EXPECT_NE(SUCCESS, ConvertRgbToYuv420SP(src.data(), 12, ImageFormat::YUV400, YuvSemiPlanarOrder::NV12, yuv));
+    EXPECT_NE(SUCCESS, ConvertYuyvToYuv422SP(src.data(), 8, yuv));
+}
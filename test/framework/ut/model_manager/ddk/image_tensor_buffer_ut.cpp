@@ -17,6 +17,7 @@
 #include <mockcpp/mockable.h>
 #include <gtest/gtest.h>
 #include <limits.h>
+#include <vector>
 #include "tensor/aipp_para.h"
 #include "tensor/image_tensor_buffer.h"
 
@@ -100,6 +101,39 @@ TEST_F(imageBufferUTest, CreateImageTensorBuffer_fail_003)
     EXPECT_TRUE(imageBuffer == nullptr);
 }
 
+/**
+ * 测试用例描述：CreateImageTensorBuffer奇数宽高, 色度采样点数向上取整, 各格式大小与通道数正确
+ **/
+TEST_F(imageBufferUTest, CreateImageTensorBuffer_size_001)
+{
+    printf("---CreateImageTensorBuffer_size_001 start----\n");
+    const struct {
+        ImageFormat format;
+        int32_t height;
+        int32_t width;
+        size_t size;
+        int32_t channel;
+    } cases[] = {
+        {ImageFormat::YUV420SP, 4, 6, 36, 3},
+        {ImageFormat::YUV420SP, 3, 5, 27, 3}, // 15 + 2 * 3 * 2
+        {ImageFormat::YUV422SP, 3, 5, 33, 3}, // 15 + 2 * 3 * 3
+        {ImageFormat::YUYV, 2, 4, 16, 3},
+        {ImageFormat::YUV400, 3, 5, 15, 1},
+        {ImageFormat::RGB888, 3, 5, 45, 3},
+        {ImageFormat::AYUV444, 3, 5, 60, 4},
+    };
+    for (const auto& testCase : cases) {
+        std::shared_ptr<IImageTensorBuffer> imageBuffer =
+            CreateImageTensorBuffer(b, testCase.height, testCase.width, testCase.format, colorSpace, rotation);
+        ASSERT_TRUE(imageBuffer != nullptr);
+        EXPECT_EQ(testCase.size * b, imageBuffer->GetSize());
+        EXPECT_EQ(testCase.channel, imageBuffer->GetTensorDesc().dims[1]);
+    }
+
+    // 仅可作为CSC目标格式, 不支持创建ImageTensorBuffer
+    EXPECT_TRUE(CreateImageTensorBuffer(b, h, w, ImageFormat::YUV444SP, colorSpace, rotation) == nullptr);
+}
+
 /**
  * 测试用例描述：CreateImageTensorBufferFromHandle成功
  **/
@@ -161,3 +195,65 @@ TEST_F(imageBufferUTest, CreateImageTensorBufferFromHandle_fail_003)
     CreateImageTensorBufferFromHandle(handle, b, h, w, formatInvalid, colorSpace, rotation);
     EXPECT_TRUE(imageBuffer == nullptr);
 }
+
+/**
+ * 测试用例描述：CreateImageTensorBufferFromPlanes引用外部内存, 连续平面覆盖到UV平面最后一行有效数据, 析构时调用release
+ **/
+TEST_F(imageBufferUTest, CreateImageTensorBufferFromPlanes_succ_001)
+{
+    // 4x6的YUV420SP, 行跨度8, Y平面按6行对齐后紧跟UV平面, 调用方只保证ceil(4/2)行UV
+    vector<uint8_t> frame(8 * 6 + 8 * 2);
+    int32_t releaseCount = 0;
+    vector<ImagePlane> planes(2);
+    planes[0].data = frame.data();
+    planes[0].stride = 8;
+    planes[1].data = frame.data() + 8 * 6;
+    planes[1].stride = 8;
+    std::shared_ptr<IImageTensorBuffer> imageBuffer = CreateImageTensorBufferFromPlanes(
+        planes, 4, 6, format, colorSpace, rotation, [&releaseCount]() { releaseCount++; });
+    ASSERT_TRUE(imageBuffer != nullptr);
+    EXPECT_EQ(imageBuffer->GetData(), frame.data());
+    // 大小按实际平面范围计算, 而非存储高度6对应的3行UV
+    EXPECT_EQ(imageBuffer->GetSize(), 8 * 6 + 8 + 6U);
+    EXPECT_LE(imageBuffer->GetSize(), frame.size());
+    EXPECT_EQ(imageBuffer->Batch(), 1);
+    EXPECT_EQ(imageBuffer->Height(), 4);
+    EXPECT_EQ(imageBuffer->Width(), 6);
+    EXPECT_EQ(imageBuffer->Rotation(), rotation);
+    imageBuffer = nullptr;
+    EXPECT_EQ(releaseCount, 1);
+
+    // Y/UV分开存放时只覆盖Y平面
+    vector<uint8_t> yPlane(8 * 4);
+    vector<uint8_t> uvPlane(8 * 2);
+    planes[0].data = yPlane.data();
+    planes[1].data = uvPlane.data();
+    imageBuffer = CreateImageTensorBufferFromPlanes(planes, 4, 6, format, colorSpace, rotation, nullptr);
+    ASSERT_TRUE(imageBuffer != nullptr);
+    EXPECT_EQ(imageBuffer->GetData(), yPlane.data());
+    EXPECT_EQ(imageBuffer->GetSize(), 8 * 3 + 6U);
+}
+
+/**
+ * 测试用例描述：CreateImageTensorBufferFromPlanes失败, 平面个数不匹配、行跨度过小、地址为空
+ **/
+TEST_F(imageBufferUTest, CreateImageTensorBufferFromPlanes_fail_001)
+{
+    vector<uint8_t> frame(8 * 6 + 8 * 3);
+    int32_t releaseCount = 0;
+    auto release = [&releaseCount]() { releaseCount++; };
+    vector<ImagePlane> planes(1);
+    planes[0].data = frame.data();
+    planes[0].stride = 8;
+    EXPECT_TRUE(CreateImageTensorBufferFromPlanes(planes, 4, 6, format, colorSpace, rotation, release) == nullptr);
+
+    planes.resize(2);
+    planes[1].data = frame.data() + 8 * 6;
+    planes[1].stride = 4;
+    EXPECT_TRUE(CreateImageTensorBufferFromPlanes(planes, 4, 6, format, colorSpace, rotation, release) == nullptr);
+
+    planes[1].stride = 8;
+    planes[0].data = nullptr;
+    EXPECT_TRUE(CreateImageTensorBufferFromPlanes(planes, 4, 6, format, colorSpace, rotation, release) == nullptr);
+    EXPECT_EQ(releaseCount, 0);
+}
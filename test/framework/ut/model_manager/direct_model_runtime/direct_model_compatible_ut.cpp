@@ -0,0 +1,150 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <mockcpp/mockcpp.hpp>
+#include <vector>
+
+#include "compatible/transformer_utils.h"
+#include "framework/compatible/ir_transformer.h"
+#include "framework/graph/core/cgraph/compute_graph.h"
+#include "framework/graph/core/cgraph/graph_modifier.h"
+#include "framework/graph/core/node/node.h"
+#include "framework/graph/core/node/node_spec.h"
+#include "framework/graph/core/op/op_desc.h"
+#include "framework/graph/utils/attr_utils.h"
+#include "framework/graph/utils/tensor_utils.h"
+#include "framework/graph/debug/ge_graph_attr_define.h"
+#include "graph/op/const_defs.h"
+#include "graph/op/math_defs.h"
+
+using namespace std;
+using namespace hiai;
+
+namespace {
+const int64_t WEIGHT_ELEMENT_NUM = 2;
+const uint32_t WEIGHT_BYTES = WEIGHT_ELEMENT_NUM * sizeof(float);
+} // namespace
+
+/*
+ * 与MakeModelCompatible在支持合并权重的ROM上的处理一致: Const只记录merged_offset,
+ * 图上记录合并权重的地址和大小, 由IRTransformer在调用算子转换函数前拆分
+ */
+class DirectModelCompatible_UTest : public testing::Test {
+public:
+    void SetUp()
+    {
+        merged_ = {1.0f, 2.0f, 3.0f, 4.0f};
+        graph_ = ge::ComputeGraph::Make("merged_weight");
+
+        ge::OpDescPtr dataDesc = std::make_shared<ge::OpDesc>("data", "Data");
+        dataDesc->AddOutputDesc(ge::TensorDesc(ge::Shape({1, WEIGHT_ELEMENT_NUM}), ge::FORMAT_NCHW, ge::DT_FLOAT));
+        (void)ge::AttrUtils::SetInt(dataDesc, OP_VERSION, VESION_VALUE_FIVE);
+        ge::Node* data = graph_->ROLE(GraphModifier).AddNode(dataDesc);
+
+        ge::Node* w1 = AddMergedConst("w1", 0);
+        w2_ = AddMergedConst("w2", WEIGHT_BYTES);
+
+        ge::OpDescPtr matMulDesc = std::make_shared<ge::OpDesc>("matmul", hiai::op::MatMul::TYPE);
+        matMulDesc->AddInputDesc(dataDesc->GetOutputDesc(0));
+        matMulDesc->AddInputDesc(w1->ROLE(NodeSpec).OpDesc().GetOutputDesc(0));
+        matMulDesc->AddOutputDesc(ge::TensorDesc(ge::Shape({1, 1}), ge::FORMAT_NCHW, ge::DT_FLOAT));
+        (void)ge::AttrUtils::SetInt(matMulDesc, OP_VERSION, VESION_VALUE_FIVE);
+        matMul_ = graph_->ROLE(GraphModifier).AddNode(matMulDesc);
+        EXPECT_EQ(graph_->ROLE(GraphModifier).AddEdge({*data, 0}, {*matMul_, 0}), hiai::SUCCESS);
+        EXPECT_EQ(graph_->ROLE(GraphModifier).AddEdge({*w1, 0}, {*matMul_, 1}), hiai::SUCCESS);
+
+        (void)ge::AttrUtils::SetBool(graph_, WEIGHT_MERGED, true);
+        (void)ge::AttrUtils::SetInt(
+            graph_, SRC_MERGED_WEIGHT_ADDR, static_cast<int64_t>(reinterpret_cast<uintptr_t>(merged_.data())));
+        (void)ge::AttrUtils::SetInt(graph_, SRC_MERGED_WEIGHT_SIZE, static_cast<int64_t>(merged_.size() * sizeof(float)));
+    }
+
+    void TearDown()
+    {
+        graph_ = nullptr;
+        GlobalMockObject::verify();
+    }
+
+    ge::Node* AddMergedConst(const string& name, int64_t offset)
+    {
+        ge::TensorDesc desc(ge::Shape({WEIGHT_ELEMENT_NUM}), ge::FORMAT_NCHW, ge::DT_FLOAT);
+        ge::TensorPtr weight = std::make_shared<ge::Tensor>(desc);
+        (void)ge::AttrUtils::SetInt(weight->MutableTensorDesc(), "merged_offset", offset);
+        ge::TensorUtils::SetWeightSize(weight->MutableTensorDesc(), WEIGHT_BYTES);
+
+        ge::OpDescPtr opDesc = std::make_shared<ge::OpDesc>(name, hiai::op::Const::TYPE);
+        opDesc->AddOutputDesc(desc);
+        (void)ge::AttrUtils::SetTensor(opDesc, ATTR_NAME_WEIGHTS, weight);
+        return graph_->ROLE(GraphModifier).AddNode(opDesc);
+    }
+
+    static vector<float> GetWeight(ge::Node* node)
+    {
+        ge::TensorPtr weight = nullptr;
+        (void)ge::AttrUtils::MutableTensor(node->ROLE(NodeSpec).OpDesc(), ATTR_NAME_WEIGHTS, weight);
+        if (weight == nullptr) {
+            return {};
+        }
+        const float* data = reinterpret_cast<const float*>(weight->GetData().GetData());
+        return vector<float>(data, data + weight->GetData().GetSize() / sizeof(float));
+    }
+
+public:
+    vector<float> merged_;
+    ge::ComputeGraphPtr graph_;
+    ge::Node* matMul_ {nullptr};
+    ge::Node* w2_ {nullptr};
+};
+
+/*
+ * 测试用例名称: TestCase_Direct_Model_Compatible_Merged_Weight_001
+ * 测试用例描述: 合并权重未拆分, ROM支持版本5的IR, 没有算子需要转换
+ * 预期结果 :权重仍通过merged_offset引用合并权重, 合并权重地址属性保留
+ */
+TEST_F(DirectModelCompatible_UTest, Merged_Weight_001)
+{
+    bool isChanged = false;
+    EXPECT_TRUE(IRTransformer::TransferToTargetVersion(graph_, "100.600.010.010", isChanged));
+
+    EXPECT_FALSE(isChanged);
+    ge::TensorPtr weight = nullptr;
+    (void)ge::AttrUtils::MutableTensor(w2_->ROLE(NodeSpec).OpDesc(), ATTR_NAME_WEIGHTS, weight);
+    ASSERT_NE(nullptr, weight);
+    EXPECT_TRUE(weight->GetTensorDesc().HasAttr("merged_offset"));
+    EXPECT_TRUE(graph_->HasAttr(SRC_MERGED_WEIGHT_ADDR));
+    EXPECT_TRUE(graph_->HasAttr(WEIGHT_MERGED));
+}
+
+/*
+ * 测试用例名称: TestCase_Direct_Model_Compatible_Merged_Weight_002
+ * 测试用例描述: 合并权重未拆分, 版本5的MatMul在旧ROM上执行算子转换, 转换后修改合并权重再转换一次
+ * 预期结果 :调用转换函数前按merged_offset拆分全部Const, 再次转换不再拆分
+ */
+TEST_F(DirectModelCompatible_UTest, Merged_Weight_002)
+{
+    bool isChanged = false;
+    EXPECT_TRUE(IRTransformer::TransferToTargetVersion(graph_, "100.330.010.010", isChanged));
+    EXPECT_TRUE(isChanged);
+    EXPECT_EQ(vector<float>({3.0f, 4.0f}), GetWeight(w2_));
+    EXPECT_FALSE(graph_->HasAttr(SRC_MERGED_WEIGHT_ADDR));
+    EXPECT_FALSE(graph_->HasAttr(SRC_MERGED_WEIGHT_SIZE));
+    EXPECT_FALSE(graph_->HasAttr(WEIGHT_MERGED));
+
+    merged_[2] = 0.0f;
+    EXPECT_TRUE(IRTransformer::TransferToTargetVersion(graph_, "100.330.010.010", isChanged));
+    EXPECT_EQ(vector<float>({3.0f, 4.0f}), GetWeight(w2_));
+}
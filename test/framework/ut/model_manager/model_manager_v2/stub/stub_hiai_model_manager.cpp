@@ -102,6 +102,11 @@ HIAI_Status HIAI_MR_ModelManager_Run(HIAI_MR_ModelManager* manager, HIAI_MR_NDTe
 HIAI_Status HIAI_MR_ModelManager_RunAsync(HIAI_MR_ModelManager* manager, HIAI_MR_NDTensorBuffer* input[],
     int32_t inputNum, HIAI_MR_NDTensorBuffer* output[], int32_t outputNum, int32_t timeoutInMS, void* userData)
 {
+    auto iter = g_StubListener.find(manager);
+    if (iter != g_StubListener.end() && iter->second != nullptr) {
+        std::thread runDoneThd(iter->second->onRunDone, userData, HIAI_SUCCESS, output, outputNum);
+        runDoneThd.detach();
+    }
     return HIAI_SUCCESS;
 }
 
@@ -0,0 +1,321 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <mockcpp/mockcpp.hpp>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+
+#include "model_manager/batching_model_manager.h"
+
+using namespace std;
+using namespace hiai;
+
+namespace {
+const int32_t SAMPLE_ELEMENT_NUM = 4;
+
+class StubBuiltModel : public IBuiltModel {
+public:
+    explicit StubBuiltModel(int32_t batch) : batch_(batch)
+    {
+    }
+
+    Status SaveToExternalBuffer(std::shared_ptr<IBuffer>& buffer, size_t& realSize) const override
+    {
+        return FAILURE;
+    }
+    Status SaveToBuffer(std::shared_ptr<IBuffer>& buffer) const override
+    {
+        return FAILURE;
+    }
+    Status RestoreFromBuffer(const std::shared_ptr<IBuffer>& buffer) override
+    {
+        return FAILURE;
+    }
+    Status SaveToFile(const char* file) const override
+    {
+        return FAILURE;
+    }
+    Status RestoreFromFile(const char* file) override
+    {
+        return FAILURE;
+    }
+    Status CheckCompatibility(bool& compatible) const override
+    {
+        compatible = true;
+        return SUCCESS;
+    }
+    std::string GetName() const override
+    {
+        return "batching";
+    }
+    void SetName(const std::string& name) override
+    {
+    }
+    std::vector<NDTensorDesc> GetInputTensorDescs() const override
+    {
+        NDTensorDesc desc;
+        desc.dims = {batch_, 1, 2, 2};
+        return {desc};
+    }
+    std::vector<NDTensorDesc> GetOutputTensorDescs() const override
+    {
+        return GetInputTensorDescs();
+    }
+    void SetCustomData(const CustomModelData& customModelData) override
+    {
+    }
+    const CustomModelData& GetCustomData() override
+    {
+        return customData_;
+    }
+
+private:
+    int32_t batch_;
+    CustomModelData customData_;
+};
+
+// 输出为输入乘2, 并记录每次执行的batch
+class StubModelManager : public IModelManager {
+public:
+    Status Init(const ModelInitOptions& options, const std::shared_ptr<IBuiltModel>& builtModel,
+        const std::shared_ptr<IModelManagerListener>& listener) override
+    {
+        return SUCCESS;
+    }
+    Status SetPriority(ModelPriority priority) override
+    {
+        return SUCCESS;
+    }
+    Status Run(const std::vector<std::shared_ptr<INDTensorBuffer>>& inputs,
+        std::vector<std::shared_ptr<INDTensorBuffer>>& outputs) override
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        batches_.push_back(inputs[0]->GetTensorDesc().dims[0]);
+        const float* src = static_cast<const float*>(inputs[0]->GetData());
+        float* dst = static_cast<float*>(outputs[0]->GetData());
+        for (size_t i = 0; i < inputs[0]->GetSize() / sizeof(float); i++) {
+            dst[i] = src[i] * 2;
+        }
+        lastInput_.assign(src, src + inputs[0]->GetSize() / sizeof(float));
+        return SUCCESS;
+    }
+    Status RunAsync(const Context& context, const std::vector<std::shared_ptr<INDTensorBuffer>>& inputs,
+        std::vector<std::shared_ptr<INDTensorBuffer>>& outputs, int32_t timeout) override
+    {
+        return FAILURE;
+    }
+    Status Cancel() override
+    {
+        return SUCCESS;
+    }
+    void DeInit() override
+    {
+    }
+
+public:
+    std::mutex mutex_;
+    std::vector<int32_t> batches_;
+    std::vector<float> lastInput_;
+};
+
+std::shared_ptr<INDTensorBuffer> CreateSample(float value)
+{
+    std::vector<float> data(SAMPLE_ELEMENT_NUM, value);
+    NDTensorDesc desc;
+    desc.dims = {1, 1, 2, 2};
+    return CreateNDTensorBuffer(desc, data.data(), data.size() * sizeof(float));
+}
+} // namespace
+
+class BatchingModelManagerUt : public testing::Test {
+public:
+    void SetUp()
+    {
+        stubManager_ = std::make_shared<StubModelManager>();
+    }
+
+    void TearDown()
+    {
+        GlobalMockObject::verify();
+    }
+
+    void RunConcurrently(const std::shared_ptr<IModelManager>& manager, int threadNum)
+    {
+        std::vector<std::thread> threads;
+        results_.assign(threadNum, 0.0f);
+        for (int i = 0; i < threadNum; i++) {
+            threads.emplace_back([this, manager, i] {
+                std::vector<std::shared_ptr<INDTensorBuffer>> inputs = {CreateSample(static_cast<float>(i + 1))};
+                std::vector<std::shared_ptr<INDTensorBuffer>> outputs;
+                if (manager->Run(inputs, outputs) == SUCCESS && outputs.size() == 1) {
+                    results_[i] = static_cast<float*>(outputs[0]->GetData())[SAMPLE_ELEMENT_NUM - 1];
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+public:
+    std::shared_ptr<StubModelManager> stubManager_;
+    std::vector<float> results_;
+};
+
+/*
+ * 测试用例名称: TestCase_Batching_Model_Manager_Run_001
+ * 测试用例描述: 固定batch为4的模型, 4个线程并发Run
+ * 预期结果 :合并为一次执行, 各请求拿到自己的输出
+ */
+TEST_F(BatchingModelManagerUt, Batching_Model_Manager_Run_001)
+{
+    BatchingOptions options;
+    options.maxBatchSize = 8;
+    options.maxDelayInUS = 1000000;
+    std::shared_ptr<IModelManager> manager = CreateBatchingModelManager(stubManager_, options);
+    ASSERT_NE(nullptr, manager);
+    ModelInitOptions initOptions;
+    ASSERT_EQ(SUCCESS, manager->Init(initOptions, std::make_shared<StubBuiltModel>(4), nullptr));
+
+    RunConcurrently(manager, 4);
+    for (size_t i = 0; i < results_.size(); i++) {
+        EXPECT_EQ(static_cast<float>((i + 1) * 2), results_[i]);
+    }
+    ASSERT_EQ(1U, stubManager_->batches_.size());
+    EXPECT_EQ(4, stubManager_->batches_[0]);
+    manager->DeInit();
+}
+
+/*
+ * 测试用例名称: TestCase_Batching_Model_Manager_Run_002
+ * 测试用例描述: 固定batch模型, 不等待凑批的单个请求
+ * 预期结果 :成功, 未凑满部分补零
+ */
+TEST_F(BatchingModelManagerUt, Batching_Model_Manager_Run_002)
+{
+    BatchingOptions options;
+    options.maxDelayInUS = 0;
+    std::shared_ptr<IModelManager> manager = CreateBatchingModelManager(stubManager_, options);
+    ModelInitOptions initOptions;
+    ASSERT_EQ(SUCCESS, manager->Init(initOptions, std::make_shared<StubBuiltModel>(2), nullptr));
+
+    RunConcurrently(manager, 1);
+    EXPECT_EQ(2.0f, results_[0]);
+    ASSERT_EQ(2U * SAMPLE_ELEMENT_NUM, stubManager_->lastInput_.size());
+    EXPECT_EQ(1.0f, stubManager_->lastInput_[0]);
+    EXPECT_EQ(0.0f, stubManager_->lastInput_[SAMPLE_ELEMENT_NUM]);
+
+    // 输入个数及大小非法
+    std::vector<std::shared_ptr<INDTensorBuffer>> inputs;
+    std::vector<std::shared_ptr<INDTensorBuffer>> outputs;
+    EXPECT_EQ(INVALID_PARAM, manager->Run(inputs, outputs));
+    NDTensorDesc desc;
+    desc.dims = {2, 1, 2, 2};
+    inputs.push_back(CreateNDTensorBuffer(desc));
+    EXPECT_EQ(INVALID_PARAM, manager->Run(inputs, outputs));
+
+    manager->DeInit();
+    inputs[0] = CreateSample(1.0f);
+    EXPECT_NE(SUCCESS, manager->Run(inputs, outputs));
+}
+
+/*
+ * 测试用例名称: TestCase_Batching_Model_Manager_Run_003
+ * 测试用例描述: 动态batch模型, 最大batch为3, 6个线程并发Run
+ * 预期结果 :按实际请求数执行, 每次batch不超过3, 各请求拿到自己的输出
+ */
+TEST_F(BatchingModelManagerUt, Batching_Model_Manager_Run_003)
+{
+    BatchingOptions options;
+    options.maxBatchSize = 3;
+    options.maxDelayInUS = 1000;
+    std::shared_ptr<IModelManager> manager = CreateBatchingModelManager(stubManager_, options);
+    ModelInitOptions initOptions;
+    ASSERT_EQ(SUCCESS, manager->Init(initOptions, std::make_shared<StubBuiltModel>(-1), nullptr));
+    EXPECT_NE(SUCCESS, manager->Init(initOptions, std::make_shared<StubBuiltModel>(-1), nullptr));
+
+    RunConcurrently(manager, 6);
+    for (size_t i = 0; i < results_.size(); i++) {
+        EXPECT_EQ(static_cast<float>((i + 1) * 2), results_[i]);
+    }
+    int32_t total = 0;
+    for (auto batch : stubManager_->batches_) {
+        EXPECT_LE(batch, 3);
+        total += batch;
+    }
+    EXPECT_EQ(6, total);
+}
+
+/*
+ * 测试用例名称: TestCase_Batching_Model_Manager_Cancel_001
+ * 测试用例描述: 固定batch为4的模型, 单个请求等待凑批期间Cancel
+ * 预期结果 :排队中的请求立即以失败返回, 不再下发执行
+ */
+TEST_F(BatchingModelManagerUt, Batching_Model_Manager_Cancel_001)
+{
+    BatchingOptions options;
+    options.maxBatchSize = 4;
+    options.maxDelayInUS = 10000000;
+    std::shared_ptr<IModelManager> manager = CreateBatchingModelManager(stubManager_, options);
+    ModelInitOptions initOptions;
+    ASSERT_EQ(SUCCESS, manager->Init(initOptions, std::make_shared<StubBuiltModel>(4), nullptr));
+
+    std::atomic<bool> done(false);
+    Status ret = SUCCESS;
+    std::thread runThread([&manager, &done, &ret] {
+        std::vector<std::shared_ptr<INDTensorBuffer>> inputs = {CreateSample(1.0f)};
+        std::vector<std::shared_ptr<INDTensorBuffer>> outputs;
+        ret = manager->Run(inputs, outputs);
+        done = true;
+    });
+    // 请求入队时机不确定, 反复Cancel直到Run返回, 远早于凑批等待超时
+    auto start = std::chrono::steady_clock::now();
+    while (!done) {
+        EXPECT_EQ(SUCCESS, manager->Cancel());
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    runThread.join();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+    EXPECT_NE(SUCCESS, ret);
+    EXPECT_TRUE(stubManager_->batches_.empty());
+    manager->DeInit();
+}
+
+/*
+ * 测试用例名称: TestCase_Batching_Model_Manager_Create_001
+ * 测试用例描述: 非法参数创建, 异步推理未设置listener
+ * 预期结果 :创建失败, RunAsync返回UNSUPPORTED
+ */
+TEST_F(BatchingModelManagerUt, Batching_Model_Manager_Create_001)
+{
+    BatchingOptions options;
+    EXPECT_EQ(nullptr, CreateBatchingModelManager(nullptr, options));
+    options.maxBatchSize = 0;
+    EXPECT_EQ(nullptr, CreateBatchingModelManager(stubManager_, options));
+
+    options.maxBatchSize = 2;
+    std::shared_ptr<IModelManager> manager = CreateBatchingModelManager(stubManager_, options);
+    ModelInitOptions initOptions;
+    EXPECT_NE(SUCCESS, manager->Init(initOptions, std::make_shared<StubBuiltModel>(0), nullptr));
+    ASSERT_EQ(SUCCESS, manager->Init(initOptions, std::make_shared<StubBuiltModel>(2), nullptr));
+
+    Context context;
+    std::vector<std::shared_ptr<INDTensorBuffer>> inputs = {CreateSample(1.0f)};
+    std::vector<std::shared_ptr<INDTensorBuffer>> outputs;
+    EXPECT_EQ(UNSUPPORTED, manager->RunAsync(context, inputs, outputs, 1000));
+}
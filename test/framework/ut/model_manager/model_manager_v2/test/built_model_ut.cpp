@@ -407,6 +407,48 @@ TEST_F(BuiltModelUt, Built_Model_inputDesc_002)
     ASSERT_EQ(255, desc[0].dims[3]);
 }
 
+/*
+ * 测试用例名称: TestCase_Built_Model_inputDesc_003
+ * 测试用例描述: GetInputTensorDescs, 重复查询返回缓存结果, 修改customData后重新计算
+ * 预期结果 :成功
+ */
+TEST_F(BuiltModelUt, Built_Model_inputDesc_003)
+{
+    const char* file = "bin/llt/framework/domi/modelmanager/om/tf_softmax_hcs_cpucl.om";
+    EXPECT_EQ(SUCCESS, builtModel_->RestoreFromFile(file));
+    ASSERT_EQ(2, builtModel_->GetInputTensorDescs().size());
+    size_t outputNum = builtModel_->GetOutputTensorDescs().size();
+
+    AippPreprocessConfig aippPreprocessConfig;
+    aippPreprocessConfig.graphDataIdx = 0;
+    aippPreprocessConfig.tensorDataIdx = 0;
+    aippPreprocessConfig.configDataCnt = 1;
+    aippPreprocessConfig.configDataInfo[0].idx = 1;
+    aippPreprocessConfig.configDataInfo[0].type = 0; // AIPP_FUNC_IMAGE_CROP_V2
+
+    std::vector<AippPreprocessConfig> aippConfigList;
+    aippConfigList.push_back(aippPreprocessConfig);
+    CustomModelData customModelData {AIPP_PREPROCESS_TYPE,
+        {reinterpret_cast<char*>(aippConfigList.data()), aippConfigList.size() * sizeof(AippPreprocessConfig)}};
+    builtModel_->SetCustomData(customModelData);
+
+    std::vector<NDTensorDesc> desc = builtModel_->GetInputTensorDescs();
+    ASSERT_EQ(3, desc.size());
+    ASSERT_EQ(4, desc[1].dims.size());
+    EXPECT_EQ(static_cast<int32_t>(sizeof(CropPara)), desc[1].dims[1]);
+
+    std::vector<NDTensorDesc> cachedDesc = builtModel_->GetInputTensorDescs();
+    ASSERT_EQ(desc.size(), cachedDesc.size());
+    for (size_t i = 0; i < desc.size(); i++) {
+        EXPECT_EQ(desc[i].dims, cachedDesc[i].dims);
+        EXPECT_EQ(desc[i].dataType, cachedDesc[i].dataType);
+    }
+    EXPECT_EQ(outputNum, builtModel_->GetOutputTensorDescs().size());
+
+    builtModel_->SetCustomData(CustomModelData());
+    EXPECT_EQ(2, builtModel_->GetInputTensorDescs().size());
+}
+
 /*
  * 测试用例名称: TestCase_Built_Model_getaippinfo_001
  * 测试用例描述: 获取AIPP参数
@@ -0,0 +1,125 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <mockcpp/mockcpp.hpp>
+#include <thread>
+#include <vector>
+
+#include "model_manager/core/completion_ring.h"
+
+using namespace std;
+using namespace hiai;
+
+class CompletionRingUt : public testing::Test {
+public:
+    void TearDown()
+    {
+        GlobalMockObject::verify();
+    }
+};
+
+/*
+ * 测试用例名称: TestCase_Completion_Ring_001
+ * 测试用例描述: WaitAll/WaitAny传入重复token
+ * 预期结果 :返回INVALID_PARAM, token仍可正常等待
+ */
+TEST_F(CompletionRingUt, Completion_Ring_001)
+{
+    CompletionRing ring(2);
+    RunToken token;
+    ASSERT_TRUE(ring.Acquire(nullptr, nullptr, token));
+    ring.Complete(token.slot, FAILURE);
+
+    vector<Status> results;
+    EXPECT_EQ(INVALID_PARAM, ring.WaitAll({token, token}, 0, results));
+    size_t index = 0;
+    Status result = SUCCESS;
+    EXPECT_EQ(INVALID_PARAM, ring.WaitAny({token, token}, 0, index, result));
+
+    EXPECT_EQ(SUCCESS, ring.Wait(token, 0, result));
+    EXPECT_EQ(FAILURE, result);
+}
+
+/*
+ * 测试用例名称: TestCase_Completion_Ring_002
+ * 测试用例描述: 两个线程等待同一token, 完成后槽立即被新请求复用并完成
+ * 预期结果 :只有一个等待者取到结果, 另一个返回INVALID_PARAM, 不会取走新请求的结果
+ */
+TEST_F(CompletionRingUt, Completion_Ring_002)
+{
+    const int32_t WAIT_TIMEOUT_MS = 5000;
+    CompletionRing ring(1);
+    RunToken token;
+    ASSERT_TRUE(ring.Acquire(nullptr, nullptr, token));
+
+    Status rets[2] = {TIMEOUT, TIMEOUT};
+    Status results[2] = {SUCCESS, SUCCESS};
+    vector<thread> waiters;
+    for (size_t i = 0; i < 2; i++) {
+        waiters.emplace_back([&ring, &token, &rets, &results, i, WAIT_TIMEOUT_MS] {
+            rets[i] = ring.Wait(token, WAIT_TIMEOUT_MS, results[i]);
+        });
+    }
+    ring.Complete(token.slot, FAILURE);
+
+    // 结果被取走后槽空闲, 立即复用给新请求并完成
+    RunToken reused;
+    while (!ring.Acquire(nullptr, nullptr, reused)) {
+        this_thread::yield();
+    }
+    ring.Complete(reused.slot, UNSUPPORTED);
+    for (auto& waiter : waiters) {
+        waiter.join();
+    }
+
+    size_t successIndex = rets[0] == SUCCESS ? 0 : 1;
+    EXPECT_EQ(SUCCESS, rets[successIndex]);
+    EXPECT_EQ(FAILURE, results[successIndex]);
+    EXPECT_EQ(INVALID_PARAM, rets[1 - successIndex]);
+
+    Status result = SUCCESS;
+    EXPECT_EQ(SUCCESS, ring.Wait(reused, 0, result));
+    EXPECT_EQ(UNSUPPORTED, result);
+}
+
+/*
+ * 测试用例名称: TestCase_Completion_Ring_003
+ * 测试用例描述: 一个请求不限时等待, 一个请求注册回调, 均在执行中时关闭完成槽, 之后运行时再完成
+ * 预期结果 :等待者被唤醒并取到FAILURE, 回调以FAILURE调用一次, 关闭后的完成被忽略
+ */
+TEST_F(CompletionRingUt, Completion_Ring_003)
+{
+    CompletionRing ring(2);
+    RunToken waited;
+    ASSERT_TRUE(ring.Acquire(nullptr, nullptr, waited));
+    vector<Status> callbackResults;
+    RunToken called;
+    ASSERT_TRUE(ring.Acquire(
+        [](void* userData, Status result) { static_cast<vector<Status>*>(userData)->push_back(result); },
+        &callbackResults, called));
+
+    Status ret = TIMEOUT;
+    Status result = SUCCESS;
+    thread waiter([&ring, &waited, &ret, &result] { ret = ring.Wait(waited, -1, result); });
+    ring.Close(FAILURE);
+    waiter.join();
+    EXPECT_EQ(SUCCESS, ret);
+    EXPECT_EQ(FAILURE, result);
+
+    ring.Complete(called.slot, SUCCESS);
+    ASSERT_EQ(1U, callbackResults.size());
+    EXPECT_EQ(FAILURE, callbackResults[0]);
+}
@@ -26,6 +26,12 @@
 #include "tensor/image_format.h"
 #include "tensor/image_process_config_types.h"
 #include "base/error_types.h"
+#include "framework/graph/utils/graph_utils.h"
+#include "framework/graph/op/internal_defs.h"
+#include "framework/graph/core/cgraph/compute_graph.h"
+#include "framework/graph/core/cgraph/graph_list_walker.h"
+#include "framework/graph/core/node/node.h"
+#include "framework/graph/core/node/node_spec.h"
 
 using namespace std;
 using namespace hiai;
@@ -39,13 +45,12 @@ public:
         MOCKER(&dlopen).stubs().will(returnValue(handle_));
     }
 
-    Status BuildIRAPIModel(Graph& graph)
+    Status BuildIRAPIModel(Graph& graph, const ModelBuildOptions& options = ModelBuildOptions())
     {
         shared_ptr<Model> model = make_shared<Model>("model", "ir_model");
         model->SetGraph(graph);
 
         HiaiIrBuild builder;
-        ModelBuildOptions options;
         std::shared_ptr<IBuiltModel> builtModel = nullptr;
         auto ret = builder.Build(options, "ir_model", model, builtModel);
         EXPECT_TRUE(builtModel != nullptr);
@@ -135,4 +140,97 @@ TEST_F(HiaiIRBuildUt, model_mannger_build_ir_model_aipp_dynamic_crop)
 
     auto ret = BuildIRAPIModel(graph);
     EXPECT_EQ(hiai::SUCCESS, ret);
-}
\ No newline at end of file
+}
+/*
+ * 测试用例名称   : model_mannger_build_ir_model_aipp_static_lowering
+ * 测试用例描述: ir api 构建模型进行编译, 静态crop/dtc在编译时展开为普通算子
+ * 预置条件 :ir api 构建模型, staticAippMode为LOWER_TO_OPS
+ * 操作步骤:
+ * 预期结果 :构建模型成功, 图中无Aipp节点, crop展开为Slice
+ * 修改历史 :
+ */
+TEST_F(HiaiIRBuildUt, model_mannger_build_ir_model_aipp_static_lowering)
+{
+    ge::Graph graph("graph_defalut");
+    Shape shape({1, 3, 256, 256});
+    hiai::op::Data data = CreateData(shape, "data");
+
+    CropPara cropPara;
+    cropPara.imageFormat = ImageFormat::RGB888;
+    cropPara.cropSizeW = 224;
+    cropPara.cropSizeH = 224;
+    hiai::op::Const cropConst = CreateConfigConst(cropPara, "cropConst");
+    auto imagecropv2 = hiai::op::ImageCropV2("imagecropv2").set_input_x(data).set_input_param(cropConst);
+
+    DtcPara dtcPara;
+    dtcPara.pixelMeanChn0 = 104;
+    dtcPara.pixelMeanChn1 = 117;
+    dtcPara.pixelMeanChn2 = 123;
+    hiai::op::Const dtcConst = CreateConfigConst(dtcPara, "dtcConst");
+    auto imagedtcv2 =
+        hiai::op::ImageDataTypeConvertionV2("imagedtcv2").set_input_x(imagecropv2).set_input_param(dtcConst);
+
+    std::vector<Operator> inputs {data};
+    std::vector<Operator> outputs {imagedtcv2};
+    graph.SetInputs(inputs);
+    graph.SetOutputs(outputs);
+
+    shared_ptr<Model> model = make_shared<Model>("model", "ir_model");
+    model->SetGraph(graph);
+    ModelBuildOptions options;
+    options.staticAippMode = StaticAippMode::LOWER_TO_OPS;
+    std::shared_ptr<IBuiltModel> builtModel = nullptr;
+    HiaiIrBuild builder;
+    EXPECT_EQ(hiai::SUCCESS, builder.Build(options, "ir_model", model, builtModel));
+
+    ComputeGraphPtr computeGraph = GraphUtils::GetComputeGraph(model->GetGraph());
+    ASSERT_TRUE(computeGraph != nullptr);
+    int aippNum = 0;
+    int sliceNum = 0;
+    (void)computeGraph->ROLE(GraphListWalker).WalkAllNodes([&aippNum, &sliceNum](ge::Node& node) {
+        aippNum += node.ROLE(NodeSpec).Type() == hiai::op::Aipp::TYPE ? 1 : 0;
+        sliceNum += node.ROLE(NodeSpec).Type() == hiai::op::Slice::TYPE ? 1 : 0;
+        return hiai::SUCCESS;
+    });
+    EXPECT_EQ(0, aippNum);
+    EXPECT_EQ(1, sliceNum);
+}
+
+/*
+ * 测试用例名称   : model_mannger_build_ir_model_aipp_static_lowering_without_lib
+ * 测试用例描述: staticAippMode为LOWER_TO_OPS, 加载libhiai_ir_build_aipp.so失败
+ * 预置条件 :ir api 构建模型, dlopen返回空
+ * 操作步骤:
+ * 预期结果 :构建模型失败, 不会保留硬件Aipp节点继续编译
+ * 修改历史 :
+ */
+TEST_F(HiaiIRBuildUt, model_mannger_build_ir_model_aipp_static_lowering_without_lib)
+{
+    GlobalMockObject::verify();
+    MOCKER(&dlopen).stubs().will(returnValue((void*)nullptr));
+
+    ge::Graph graph("graph_defalut");
+    Shape shape({1, 3, 256, 256});
+    hiai::op::Data data = CreateData(shape, "data");
+
+    CropPara cropPara;
+    cropPara.imageFormat = ImageFormat::RGB888;
+    cropPara.cropSizeW = 224;
+    cropPara.cropSizeH = 224;
+    hiai::op::Const cropConst = CreateConfigConst(cropPara, "cropConst");
+    auto imagecropv2 = hiai::op::ImageCropV2("imagecropv2").set_input_x(data).set_input_param(cropConst);
+
+    std::vector<Operator> inputs {data};
+    std::vector<Operator> outputs {imagecropv2};
+    graph.SetInputs(inputs);
+    graph.SetOutputs(outputs);
+
+    shared_ptr<Model> model = make_shared<Model>("model", "ir_model");
+    model->SetGraph(graph);
+    ModelBuildOptions options;
+    options.staticAippMode = StaticAippMode::LOWER_TO_OPS;
+    std::shared_ptr<IBuiltModel> builtModel = nullptr;
+    HiaiIrBuild builder;
+    EXPECT_NE(hiai::SUCCESS, builder.Build(options, "ir_model", model, builtModel));
+    EXPECT_EQ(nullptr, builtModel);
+}
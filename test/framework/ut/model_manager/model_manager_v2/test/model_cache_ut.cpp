@@ -0,0 +1,146 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <mockcpp/mockcpp.hpp>
+
+#include "model_manager/model_cache.h"
+
+using namespace std;
+using namespace hiai;
+
+namespace {
+const char* CPUCL_MODEL = "bin/llt/framework/domi/modelmanager/om/tf_softmax_hcs_cpucl.om";
+const char* NPUCL_MODEL = "bin/llt/framework/domi/modelmanager/om/tf_softmax_hcs_npucl.om";
+const uint64_t CPUCL_MODEL_SIZE = 2264;
+const uint64_t NPUCL_MODEL_SIZE = 8122;
+} // namespace
+
+class ModelCacheUt : public testing::Test {
+public:
+    void SetUp()
+    {
+        ClearModelCache();
+        SetModelCacheOptions(ModelCacheOptions());
+    }
+
+    void TearDown()
+    {
+        ClearModelCache();
+        SetModelCacheOptions(ModelCacheOptions());
+        GlobalMockObject::verify();
+    }
+};
+
+/*
+ * 测试用例名称: TestCase_Model_Cache_001
+ * 测试用例描述: 同一模型及选项重复获取, 不同选项获取, 加载不存在的模型
+ * 预期结果 :重复获取命中同一模型管理器, 不同选项分别缓存, 加载失败不缓存
+ */
+TEST_F(ModelCacheUt, Model_Cache_001)
+{
+    ModelInitOptions options;
+    std::shared_ptr<IModelManager> first;
+    ASSERT_EQ(SUCCESS, GetCachedModelManager(CPUCL_MODEL, options, first));
+    ASSERT_NE(nullptr, first);
+    std::shared_ptr<IModelManager> second;
+    ASSERT_EQ(SUCCESS, GetCachedModelManager(CPUCL_MODEL, options, second));
+    EXPECT_EQ(first, second);
+
+    options.perfMode = PerfMode::HIGH;
+    std::shared_ptr<IModelManager> high;
+    ASSERT_EQ(SUCCESS, GetCachedModelManager(CPUCL_MODEL, options, high));
+    EXPECT_NE(first, high);
+
+    std::shared_ptr<IModelManager> invalid;
+    EXPECT_NE(SUCCESS, GetCachedModelManager("bin/llt/not_exist.om", options, invalid));
+
+    ModelCacheStats stats;
+    EXPECT_EQ(SUCCESS, GetModelCacheStats(stats));
+    EXPECT_EQ(1U, stats.hitNum);
+    EXPECT_EQ(3U, stats.missNum);
+    EXPECT_EQ(2U, stats.cachedModelNum);
+    EXPECT_EQ(2 * CPUCL_MODEL_SIZE, stats.usedMemory);
+    EXPECT_GE(stats.maxLoadTime, stats.avgLoadTime);
+
+    ClearModelCache();
+    EXPECT_EQ(SUCCESS, GetModelCacheStats(stats));
+    EXPECT_EQ(0U, stats.cachedModelNum);
+    EXPECT_EQ(0U, stats.usedMemory);
+}
+
+/*
+ * 测试用例名称: TestCase_Model_Cache_002
+ * 测试用例描述: 内存预算小于两个模型之和, 依次加载两个模型
+ * 预期结果 :未被持有的最久未使用模型被淘汰, 被持有的模型不淘汰
+ */
+TEST_F(ModelCacheUt, Model_Cache_002)
+{
+    ModelCacheOptions cacheOptions;
+    cacheOptions.memoryBudget = CPUCL_MODEL_SIZE + NPUCL_MODEL_SIZE - 1;
+    cacheOptions.warmUp = false;
+    SetModelCacheOptions(cacheOptions);
+
+    ModelInitOptions options;
+    std::shared_ptr<IModelManager> cpucl;
+    ASSERT_EQ(SUCCESS, GetCachedModelManager(CPUCL_MODEL, options, cpucl));
+    cpucl.reset();
+    std::shared_ptr<IModelManager> npucl;
+    ASSERT_EQ(SUCCESS, GetCachedModelManager(NPUCL_MODEL, options, npucl));
+
+    ModelCacheStats stats;
+    EXPECT_EQ(SUCCESS, GetModelCacheStats(stats));
+    EXPECT_EQ(1U, stats.evictNum);
+    EXPECT_EQ(1U, stats.cachedModelNum);
+    EXPECT_EQ(NPUCL_MODEL_SIZE, stats.usedMemory);
+
+    // 两个模型均被持有, 超出预算也不淘汰
+    ASSERT_EQ(SUCCESS, GetCachedModelManager(CPUCL_MODEL, options, cpucl));
+    EXPECT_EQ(SUCCESS, GetModelCacheStats(stats));
+    EXPECT_EQ(1U, stats.evictNum);
+    EXPECT_EQ(2U, stats.cachedModelNum);
+
+    // 释放后调小预算, 淘汰最久未使用的npucl
+    cpucl.reset();
+    npucl.reset();
+    cacheOptions.memoryBudget = CPUCL_MODEL_SIZE;
+    SetModelCacheOptions(cacheOptions);
+    EXPECT_EQ(SUCCESS, GetModelCacheStats(stats));
+    EXPECT_EQ(2U, stats.evictNum);
+    EXPECT_EQ(CPUCL_MODEL_SIZE, stats.usedMemory);
+}
+
+/*
+ * 测试用例名称: TestCase_Model_Cache_003
+ * 测试用例描述: 预加载模型后获取, 重复预加载
+ * 预期结果 :获取命中预加载的模型, 重复预加载不重复加载
+ */
+TEST_F(ModelCacheUt, Model_Cache_003)
+{
+    ModelInitOptions options;
+    EXPECT_EQ(SUCCESS, PrefetchModel(CPUCL_MODEL, options));
+    EXPECT_EQ(SUCCESS, PrefetchModel(CPUCL_MODEL, options));
+
+    std::shared_ptr<IModelManager> modelManager;
+    ASSERT_EQ(SUCCESS, GetCachedModelManager(CPUCL_MODEL, options, modelManager));
+    ASSERT_NE(nullptr, modelManager);
+
+    ModelCacheStats stats;
+    EXPECT_EQ(SUCCESS, GetModelCacheStats(stats));
+    EXPECT_EQ(1U, stats.prefetchNum);
+    EXPECT_EQ(1U, stats.hitNum);
+    EXPECT_EQ(0U, stats.missNum);
+    EXPECT_EQ(1U, stats.cachedModelNum);
+}
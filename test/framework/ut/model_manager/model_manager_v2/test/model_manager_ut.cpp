@@ -17,8 +17,11 @@
 #include <mockcpp/mockcpp.hpp>
 #include <mockcpp/mockable.h>
 #include <dlfcn.h>
+#include <thread>
+#include <atomic>
 
 #include "model_manager/model_manager.h"
+#include "model_manager/model_manager_ext.h"
 #include "model/built_model_aipp.h"
 #include "tensor/image_config_tensor_util.h"
 #include "tensor/image_tensor_buffer.h"
@@ -215,3 +218,234 @@ TEST_F(ModelManagerUt, Model_Manager_Run_003)
     std::vector<std::shared_ptr<INDTensorBuffer>> outputs;
     EXPECT_EQ(SUCCESS, modelManager_->Run(inputs, outputs));
 }
+
+/*
+ * 测试用例名称: TestCase_Model_Manager_Run_004
+ * 测试用例描述: Run, 同步推理，Aipp,全部为静态参数, 多次推理及输入图片规格变化
+ * 预期结果 :成功
+ */
+TEST_F(ModelManagerUt, Model_Manager_Run_004)
+{
+    AippPreprocessConfig aippPreprocessConfig;
+    aippPreprocessConfig.graphDataIdx = 0;
+    aippPreprocessConfig.tensorDataIdx = 0;
+    aippPreprocessConfig.configDataCnt = 0;
+    aippPreprocessConfig.aippParamInfo.enableCrop = true;
+    aippPreprocessConfig.aippParamInfo.cropPara.cropSizeW = 160;
+    aippPreprocessConfig.aippParamInfo.cropPara.cropSizeH = 160;
+    aippPreprocessConfig.aippParamInfo.enableResize = true;
+    aippPreprocessConfig.aippParamInfo.resizePara.resizeOutputSizeW = 100;
+    aippPreprocessConfig.aippParamInfo.resizePara.resizeOutputSizeH = 100;
+
+    SetCustomData(aippPreprocessConfig);
+
+    ModelInitOptions options;
+    EXPECT_EQ(SUCCESS, modelManager_->Init(options, builtModel_, nullptr));
+
+    std::vector<std::shared_ptr<INDTensorBuffer>> outputs;
+    std::vector<std::shared_ptr<INDTensorBuffer>> inputs;
+    inputs.push_back(CreateImageTensorBuffer(1, 255, 255, ImageFormat::AYUV444, ImageColorSpace::BT_601_NARROW, 0));
+    EXPECT_EQ(SUCCESS, modelManager_->Run(inputs, outputs));
+    EXPECT_EQ(SUCCESS, modelManager_->Run(inputs, outputs));
+
+    inputs[0] = CreateImageTensorBuffer(1, 500, 500, ImageFormat::AYUV444, ImageColorSpace::BT_601_NARROW, 0);
+    EXPECT_EQ(SUCCESS, modelManager_->Run(inputs, outputs));
+}
+
+/*
+ * 测试用例名称: TestCase_Model_Manager_Run_005
+ * 测试用例描述: Run, 同步推理，Aipp, 输入个数与模型输入个数一致时使用加载时生成的索引表, 不一致时临时生成
+ * 预期结果 :输入个数合法时成功
+ */
+TEST_F(ModelManagerUt, Model_Manager_Run_005)
+{
+    AippPreprocessConfig aippPreprocessConfig;
+    aippPreprocessConfig.graphDataIdx = 0;
+    aippPreprocessConfig.tensorDataIdx = 0;
+    aippPreprocessConfig.configDataCnt = 0;
+    aippPreprocessConfig.aippParamInfo.enableCrop = true;
+    aippPreprocessConfig.aippParamInfo.cropPara.cropSizeW = 160;
+    aippPreprocessConfig.aippParamInfo.cropPara.cropSizeH = 160;
+
+    SetCustomData(aippPreprocessConfig);
+
+    ModelInitOptions options;
+    EXPECT_EQ(SUCCESS, modelManager_->Init(options, builtModel_, nullptr));
+
+    std::vector<std::shared_ptr<INDTensorBuffer>> outputs;
+    std::vector<std::shared_ptr<INDTensorBuffer>> inputs;
+    EXPECT_NE(SUCCESS, modelManager_->Run(inputs, outputs));
+
+    // 模型有两个输入, 第二个输入透传
+    inputs.push_back(CreateImageTensorBuffer(1, 255, 255, ImageFormat::AYUV444, ImageColorSpace::BT_601_NARROW, 0));
+    inputs.push_back(CreateImageTensorBuffer(1, 255, 255, ImageFormat::AYUV444, ImageColorSpace::BT_601_NARROW, 0));
+    EXPECT_EQ(SUCCESS, modelManager_->Run(inputs, outputs));
+    EXPECT_EQ(SUCCESS, modelManager_->Run(inputs, outputs));
+
+    inputs.pop_back();
+    EXPECT_EQ(SUCCESS, modelManager_->Run(inputs, outputs));
+}
+
+/*
+ * 测试用例名称: TestCase_Model_Manager_Run_006
+ * 测试用例描述: 多运行时实例, 多线程并发Run
+ * 预期结果 :非法实例个数初始化失败, 并发Run均成功
+ */
+TEST_F(ModelManagerUt, Model_Manager_Run_006)
+{
+    ModelInitOptions options;
+    options.runtimeInstanceNum = 0;
+    EXPECT_NE(SUCCESS, modelManager_->Init(options, builtModel_, nullptr));
+    options.runtimeInstanceNum = 17;
+    EXPECT_NE(SUCCESS, modelManager_->Init(options, builtModel_, nullptr));
+
+    options.runtimeInstanceNum = 2;
+    EXPECT_EQ(SUCCESS, modelManager_->Init(options, builtModel_, nullptr));
+    EXPECT_EQ(SUCCESS, modelManager_->SetPriority(ModelPriority::PRIORITY_HIGH));
+
+    const int threadNum = 4;
+    const int loopNum = 10;
+    std::atomic<int> successNum {0};
+    std::vector<std::thread> threads;
+    for (int i = 0; i < threadNum; i++) {
+        threads.emplace_back([this, &successNum, loopNum] {
+            for (int j = 0; j < loopNum; j++) {
+                std::vector<std::shared_ptr<INDTensorBuffer>> inputs;
+                std::vector<std::shared_ptr<INDTensorBuffer>> outputs;
+                if (modelManager_->Run(inputs, outputs) == SUCCESS) {
+                    successNum++;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(threadNum * loopNum, successNum.load());
+
+    modelManager_->DeInit();
+    std::vector<std::shared_ptr<INDTensorBuffer>> inputs;
+    std::vector<std::shared_ptr<INDTensorBuffer>> outputs;
+    EXPECT_NE(SUCCESS, modelManager_->Run(inputs, outputs));
+}
+
+/*
+ * 测试用例名称: TestCase_Model_Manager_IOBinding_001
+ * 测试用例描述: 绑定输入输出后重复Run, 绑定个数或shape非法, 重新Init后使用旧绑定
+ * 预期结果 :合法绑定Run成功, 非法绑定创建失败, 旧绑定Run失败
+ */
+TEST_F(ModelManagerUt, Model_Manager_IOBinding_001)
+{
+    std::shared_ptr<IModelManagerExt> modelManager = IModelManagerExt::CreateModelManagerExt();
+    ASSERT_NE(nullptr, modelManager);
+
+    std::vector<std::shared_ptr<INDTensorBuffer>> inputs;
+    for (const auto& desc : builtModel_->GetInputTensorDescs()) {
+        inputs.push_back(CreateNDTensorBuffer(desc));
+    }
+    std::vector<std::shared_ptr<INDTensorBuffer>> outputs;
+    for (const auto& desc : builtModel_->GetOutputTensorDescs()) {
+        outputs.push_back(CreateNDTensorBuffer(desc));
+    }
+    EXPECT_EQ(nullptr, modelManager->CreateIOBinding(inputs, outputs));
+
+    ModelInitOptions options;
+    ASSERT_EQ(SUCCESS, modelManager->Init(options, builtModel_, nullptr));
+
+    std::shared_ptr<IIOBinding> binding = modelManager->CreateIOBinding(inputs, outputs);
+    ASSERT_NE(nullptr, binding);
+    EXPECT_EQ(inputs.size(), binding->GetInputs().size());
+    EXPECT_EQ(SUCCESS, modelManager->Run(binding));
+    EXPECT_EQ(SUCCESS, modelManager->Run(binding));
+
+    std::vector<std::shared_ptr<INDTensorBuffer>> lessInputs(inputs.begin(), inputs.end() - 1);
+    EXPECT_EQ(nullptr, modelManager->CreateIOBinding(lessInputs, outputs));
+
+    NDTensorDesc desc = inputs[0]->GetTensorDesc();
+    desc.dims[0] += 1;
+    std::vector<std::shared_ptr<INDTensorBuffer>> invalidInputs = inputs;
+    invalidInputs[0] = CreateNDTensorBuffer(desc);
+    EXPECT_EQ(nullptr, modelManager->CreateIOBinding(invalidInputs, outputs));
+    EXPECT_NE(SUCCESS, modelManager->Run(std::shared_ptr<IIOBinding>(nullptr)));
+
+    modelManager->DeInit();
+    ASSERT_EQ(SUCCESS, modelManager->Init(options, builtModel_, nullptr));
+    EXPECT_EQ(INVALID_PARAM, modelManager->Run(binding));
+    modelManager->DeInit();
+}
+
+namespace {
+void CountRunDone(void* userData, Status result)
+{
+    if (result == SUCCESS) {
+        (*static_cast<std::atomic<int>*>(userData))++;
+    }
+}
+} // namespace
+
+/*
+ * 测试用例名称: TestCase_Model_Manager_RunAsync_001
+ * 测试用例描述: 未设置listener, 通过完成槽异步推理, WaitAll/WaitAny/回调获取结果, 完成槽用尽
+ * 预期结果 :未设置asyncSlotNum时不支持; 在途请求超过完成槽个数时下发失败; 结果取走或回调返回后token失效
+ */
+TEST_F(ModelManagerUt, Model_Manager_RunAsync_001)
+{
+    std::shared_ptr<IModelManagerExt> modelManager = IModelManagerExt::CreateModelManagerExt();
+    ASSERT_NE(nullptr, modelManager);
+
+    std::vector<std::shared_ptr<INDTensorBuffer>> inputs;
+    for (const auto& desc : builtModel_->GetInputTensorDescs()) {
+        inputs.push_back(CreateNDTensorBuffer(desc));
+    }
+    std::vector<std::shared_ptr<INDTensorBuffer>> outputs;
+    for (const auto& desc : builtModel_->GetOutputTensorDescs()) {
+        outputs.push_back(CreateNDTensorBuffer(desc));
+    }
+
+    ModelInitOptions options;
+    ASSERT_EQ(SUCCESS, modelManager->Init(options, builtModel_, nullptr));
+    std::shared_ptr<IIOBinding> binding = modelManager->CreateIOBinding(inputs, outputs);
+    ASSERT_NE(nullptr, binding);
+    RunToken token;
+    EXPECT_EQ(UNSUPPORTED, modelManager->RunAsync(binding, 1000, token));
+    modelManager->DeInit();
+
+    options.asyncSlotNum = 2;
+    ASSERT_EQ(SUCCESS, modelManager->Init(options, builtModel_, nullptr));
+    binding = modelManager->CreateIOBinding(inputs, outputs);
+    ASSERT_NE(nullptr, binding);
+
+    std::vector<RunToken> tokens(2);
+    EXPECT_EQ(SUCCESS, modelManager->RunAsync(binding, 1000, tokens[0]));
+    EXPECT_EQ(SUCCESS, modelManager->RunAsync(binding, 1000, tokens[1]));
+    EXPECT_EQ(FAILURE, modelManager->RunAsync(binding, 1000, token));
+
+    std::vector<Status> results;
+    ASSERT_EQ(SUCCESS, modelManager->WaitAll(tokens, -1, results));
+    ASSERT_EQ(2U, results.size());
+    EXPECT_EQ(SUCCESS, results[0]);
+    EXPECT_EQ(SUCCESS, results[1]);
+    Status result = FAILURE;
+    EXPECT_EQ(INVALID_PARAM, modelManager->Wait(tokens[0], 0, result));
+
+    ASSERT_EQ(SUCCESS, modelManager->RunAsync(binding, 1000, tokens[0]));
+    size_t index = 1;
+    EXPECT_EQ(SUCCESS, modelManager->WaitAny({tokens[0]}, 1000, index, result));
+    EXPECT_EQ(0U, index);
+    EXPECT_EQ(SUCCESS, result);
+
+    std::atomic<int> doneNum {0};
+    ASSERT_EQ(SUCCESS, modelManager->RunAsync(binding, 1000, token, CountRunDone, &doneNum));
+    EXPECT_EQ(INVALID_PARAM, modelManager->Wait(token, 0, result));
+    while (doneNum.load() == 0) {
+        std::this_thread::yield();
+    }
+    // 回调返回后完成槽归还, 两个槽可同时再被占用
+    ASSERT_EQ(SUCCESS, modelManager->RunAsync(binding, 1000, tokens[0]));
+    while (modelManager->RunAsync(binding, 1000, tokens[1]) != SUCCESS) {
+        std::this_thread::yield();
+    }
+    EXPECT_EQ(SUCCESS, modelManager->WaitAll(tokens, 1000, results));
+    modelManager->DeInit();
+    EXPECT_EQ(UNSUPPORTED, modelManager->Wait(token, 0, result));
+}
@@ -0,0 +1,200 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <mockcpp/mockcpp.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "model_manager/core/open_request_stats.h"
+
+using namespace std;
+using namespace hiai;
+
+namespace {
+const uint32_t NEVER_FLUSH_MS = 60 * 1000;
+const int32_t WAIT_TIMEOUT_MS = 5000;
+
+// 桩上报函数记录每条统计的上报次数; gateOpen为false时阻塞, 模拟上报缓慢
+std::mutex g_mutex;
+std::condition_variable g_cond;
+std::map<string, uint32_t> g_records;
+bool g_gateOpen = true;
+bool g_blocked = false;
+std::atomic<int> g_resolveNum {0};
+
+int StubRecordRequest(const char* data, uint32_t len)
+{
+    std::unique_lock<std::mutex> lock(g_mutex);
+    g_blocked = !g_gateOpen;
+    g_cond.notify_all();
+    (void)g_cond.wait_for(lock, std::chrono::milliseconds(WAIT_TIMEOUT_MS), [] { return g_gateOpen; });
+    g_blocked = false;
+    g_records[string(data, len)]++;
+    return 0;
+}
+
+StatsReporter::RecordRequestFunc ResolveStub(void*& handle)
+{
+    (void)handle;
+    g_resolveNum++;
+    return StubRecordRequest;
+}
+
+StatsReporter::RecordRequestFunc ResolveFailed(void*& handle)
+{
+    (void)handle;
+    g_resolveNum++;
+    return nullptr;
+}
+} // namespace
+
+class OpenRequestStatsUt : public testing::Test {
+public:
+    void SetUp()
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        g_records.clear();
+        g_gateOpen = true;
+        g_blocked = false;
+        g_resolveNum = 0;
+    }
+
+    void TearDown()
+    {
+        GlobalMockObject::verify();
+    }
+
+    static map<string, uint32_t> GetRecords()
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        return g_records;
+    }
+};
+
+/*
+ * 测试用例名称: TestCase_Open_Request_Stats_001
+ * 测试用例描述: 上报周期内重复上报相同统计, 析构前不到上报周期
+ * 预期结果 :相同统计合并计数, 析构时全部上报, 次数与Post次数一致
+ */
+TEST_F(OpenRequestStatsUt, Open_Request_Stats_001)
+{
+    std::unique_ptr<StatsReporter> reporter(new StatsReporter(ResolveStub, NEVER_FLUSH_MS));
+    for (int i = 0; i < 3; i++) {
+        EXPECT_EQ(SUCCESS, reporter->Post("a"));
+    }
+    EXPECT_EQ(SUCCESS, reporter->Post("b"));
+    {
+        std::lock_guard<std::mutex> lock(reporter->mutex_);
+        EXPECT_EQ(2U, reporter->pending_.size());
+    }
+    EXPECT_TRUE(GetRecords().empty());
+
+    reporter.reset();
+    map<string, uint32_t> records = GetRecords();
+    EXPECT_EQ(2U, records.size());
+    EXPECT_EQ(3U, records["a"]);
+    EXPECT_EQ(1U, records["b"]);
+    EXPECT_EQ(1, g_resolveNum.load());
+}
+
+/*
+ * 测试用例名称: TestCase_Open_Request_Stats_002
+ * 测试用例描述: 待上报的不同统计达到64个后继续上报新统计和已有统计
+ * 预期结果 :新统计被丢弃返回FAILURE, 已有统计仍可累加, 析构时只上报64个统计
+ */
+TEST_F(OpenRequestStatsUt, Open_Request_Stats_002)
+{
+    const size_t maxPendingNum = 64;
+    std::unique_ptr<StatsReporter> reporter(new StatsReporter(ResolveStub, NEVER_FLUSH_MS));
+    for (size_t i = 0; i < maxPendingNum; i++) {
+        EXPECT_EQ(SUCCESS, reporter->Post(to_string(i)));
+    }
+    EXPECT_EQ(FAILURE, reporter->Post("overflow"));
+    EXPECT_EQ(SUCCESS, reporter->Post("0"));
+
+    reporter.reset();
+    map<string, uint32_t> records = GetRecords();
+    EXPECT_EQ(maxPendingNum, records.size());
+    EXPECT_EQ(0U, records.count("overflow"));
+    EXPECT_EQ(2U, records["0"]);
+}
+
+/*
+ * 测试用例名称: TestCase_Open_Request_Stats_003
+ * 测试用例描述: 上报函数解析失败
+ * 预期结果 :首次上报后不再入队, 后续Post返回FAILURE, 只解析一次
+ */
+TEST_F(OpenRequestStatsUt, Open_Request_Stats_003)
+{
+    std::unique_ptr<StatsReporter> reporter(new StatsReporter(ResolveFailed, 0));
+    EXPECT_EQ(SUCCESS, reporter->Post("a"));
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(WAIT_TIMEOUT_MS);
+    while (std::chrono::steady_clock::now() < deadline) {
+        {
+            std::lock_guard<std::mutex> lock(reporter->mutex_);
+            if (reporter->unavailable_) {
+                break;
+            }
+        }
+        std::this_thread::yield();
+    }
+    EXPECT_EQ(FAILURE, reporter->Post("b"));
+
+    reporter.reset();
+    EXPECT_TRUE(GetRecords().empty());
+    EXPECT_EQ(1, g_resolveNum.load());
+}
+
+/*
+ * 测试用例名称: TestCase_Open_Request_Stats_004
+ * 测试用例描述: 上报函数阻塞期间继续Post
+ * 预期结果 :Post不等待上报完成, 立即返回SUCCESS; 放开后析构时上报剩余统计
+ */
+TEST_F(OpenRequestStatsUt, Open_Request_Stats_004)
+{
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        g_gateOpen = false;
+    }
+    std::unique_ptr<StatsReporter> reporter(new StatsReporter(ResolveStub, 0));
+    EXPECT_EQ(SUCCESS, reporter->Post("a"));
+    {
+        std::unique_lock<std::mutex> lock(g_mutex);
+        ASSERT_TRUE(g_cond.wait_for(lock, std::chrono::milliseconds(WAIT_TIMEOUT_MS), [] { return g_blocked; }));
+    }
+
+    for (int i = 0; i < 10; i++) {
+        EXPECT_EQ(SUCCESS, reporter->Post("b"));
+    }
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        EXPECT_TRUE(g_blocked);
+        g_gateOpen = true;
+        g_cond.notify_all();
+    }
+
+    reporter.reset();
+    map<string, uint32_t> records = GetRecords();
+    EXPECT_EQ(1U, records["a"]);
+    EXPECT_EQ(10U, records["b"]);
+}
@@ -0,0 +1,334 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <mockcpp/mockcpp.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <thread>
+
+#include "model_manager/pipeline.h"
+
+using namespace std;
+using namespace hiai;
+
+namespace {
+const int32_t ELEMENT_NUM = 4;
+
+NDTensorDesc GetTensorDesc()
+{
+    NDTensorDesc desc;
+    desc.dims = {1, 1, 2, 2};
+    return desc;
+}
+
+class StubBuiltModel : public IBuiltModel {
+public:
+    Status SaveToExternalBuffer(std::shared_ptr<IBuffer>& buffer, size_t& realSize) const override
+    {
+        return FAILURE;
+    }
+    Status SaveToBuffer(std::shared_ptr<IBuffer>& buffer) const override
+    {
+        return FAILURE;
+    }
+    Status RestoreFromBuffer(const std::shared_ptr<IBuffer>& buffer) override
+    {
+        return FAILURE;
+    }
+    Status SaveToFile(const char* file) const override
+    {
+        return FAILURE;
+    }
+    Status RestoreFromFile(const char* file) override
+    {
+        return FAILURE;
+    }
+    Status CheckCompatibility(bool& compatible) const override
+    {
+        compatible = true;
+        return SUCCESS;
+    }
+    std::string GetName() const override
+    {
+        return "pipeline";
+    }
+    void SetName(const std::string& name) override
+    {
+    }
+    std::vector<NDTensorDesc> GetInputTensorDescs() const override
+    {
+        return {GetTensorDesc()};
+    }
+    std::vector<NDTensorDesc> GetOutputTensorDescs() const override
+    {
+        return {GetTensorDesc()};
+    }
+    void SetCustomData(const CustomModelData& customModelData) override
+    {
+    }
+    const CustomModelData& GetCustomData() override
+    {
+        return customData_;
+    }
+
+private:
+    CustomModelData customData_;
+};
+
+// 全部参与者到达后一起返回, 用于确认各级在同一时刻处于执行中; 超时未到齐返回false
+class Latch {
+public:
+    explicit Latch(int count) : count_(count)
+    {
+    }
+
+    bool ArriveAndWait()
+    {
+        const int timeoutInMS = 5000;
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (--count_ == 0) {
+            cond_.notify_all();
+        }
+        return cond_.wait_for(lock, std::chrono::milliseconds(timeoutInMS), [this] { return count_ <= 0; });
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    int count_;
+};
+
+// 输入首元素为arriveValue时在latch上等待, 记录是否等到其余参与者
+struct LatchPoint {
+    std::shared_ptr<Latch> latch;
+    float arriveValue {0.0f};
+    std::shared_ptr<std::atomic<int>> arrivedNum;
+
+    void Arrive(float value) const
+    {
+        if (latch != nullptr && value == arriveValue && latch->ArriveAndWait()) {
+            (*arrivedNum)++;
+        }
+    }
+};
+
+// 输出为输入乘2, 每次执行耗时runTimeInMS
+class StubModelManager : public IModelManager {
+public:
+    explicit StubModelManager(int runTimeInMS = 0) : runTimeInMS_(runTimeInMS)
+    {
+    }
+    explicit StubModelManager(const LatchPoint& latchPoint) : runTimeInMS_(0), latchPoint_(latchPoint)
+    {
+    }
+
+    Status Init(const ModelInitOptions& options, const std::shared_ptr<IBuiltModel>& builtModel,
+        const std::shared_ptr<IModelManagerListener>& listener) override
+    {
+        return SUCCESS;
+    }
+    Status SetPriority(ModelPriority priority) override
+    {
+        return SUCCESS;
+    }
+    Status Run(const std::vector<std::shared_ptr<INDTensorBuffer>>& inputs,
+        std::vector<std::shared_ptr<INDTensorBuffer>>& outputs) override
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(runTimeInMS_));
+        const float* src = static_cast<const float*>(inputs[0]->GetData());
+        latchPoint_.Arrive(src[0]);
+        float* dst = static_cast<float*>(outputs[0]->GetData());
+        for (int32_t i = 0; i < ELEMENT_NUM; i++) {
+            dst[i] = src[i] * 2;
+        }
+        return SUCCESS;
+    }
+    Status RunAsync(const Context& context, const std::vector<std::shared_ptr<INDTensorBuffer>>& inputs,
+        std::vector<std::shared_ptr<INDTensorBuffer>>& outputs, int32_t timeout) override
+    {
+        return FAILURE;
+    }
+    Status Cancel() override
+    {
+        return SUCCESS;
+    }
+    void DeInit() override
+    {
+    }
+
+private:
+    int runTimeInMS_;
+    LatchPoint latchPoint_;
+};
+
+std::shared_ptr<INDTensorBuffer> CreateFrame(float value)
+{
+    std::vector<float> data(ELEMENT_NUM, value);
+    return CreateNDTensorBuffer(GetTensorDesc(), data.data(), data.size() * sizeof(float));
+}
+
+float GetValue(const PipelineTensors& tensors)
+{
+    return static_cast<const float*>(tensors[0]->GetData())[0];
+}
+
+// 输出为输入加1, 每次执行耗时runTimeInMS
+PipelineCpuFunc AddOne(int runTimeInMS = 0, const LatchPoint& latchPoint = LatchPoint())
+{
+    return [runTimeInMS, latchPoint](const PipelineTensors& inputs, PipelineTensors& outputs) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(runTimeInMS));
+        latchPoint.Arrive(GetValue(inputs));
+        outputs = {CreateFrame(GetValue(inputs) + 1)};
+        return outputs[0] != nullptr ? SUCCESS : FAILURE;
+    };
+}
+} // namespace
+
+class PipelineUt : public testing::Test {
+public:
+    void TearDown()
+    {
+        GlobalMockObject::verify();
+    }
+
+    PipelineDoneFunc Collect()
+    {
+        return [this](uint64_t frameId, Status result, const PipelineTensors& outputs) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            frameIds_.push_back(frameId);
+            results_.push_back(result);
+            values_.push_back(GetValue(outputs));
+            outputBuffers_.insert(outputs[0].get());
+        };
+    }
+
+public:
+    std::mutex mutex_;
+    std::vector<uint64_t> frameIds_;
+    std::vector<Status> results_;
+    std::vector<float> values_;
+    std::set<INDTensorBuffer*> outputBuffers_;
+};
+
+/*
+ * 测试用例名称: TestCase_Pipeline_001
+ * 测试用例描述: CPU前处理 -> 模型推理两级流水线, 连续送入20帧
+ * 预期结果 :按送入顺序完成, 结果正确, 模型为最后一级, 输出在完成回调后归还, 始终复用同一个tensor
+ */
+TEST_F(PipelineUt, Pipeline_001)
+{
+    std::shared_ptr<IPipeline> pipeline = CreatePipeline(PipelineOptions());
+    ASSERT_NE(nullptr, pipeline);
+    ASSERT_EQ(SUCCESS, pipeline->AddCpuStage(AddOne()));
+    ASSERT_EQ(SUCCESS,
+        pipeline->AddModelStage(std::make_shared<StubModelManager>(), std::make_shared<StubBuiltModel>()));
+    ASSERT_EQ(SUCCESS, pipeline->Start(Collect()));
+
+    const uint64_t frameNum = 20;
+    for (uint64_t i = 0; i < frameNum; i++) {
+        ASSERT_EQ(SUCCESS, pipeline->Submit(i, {CreateFrame(static_cast<float>(i))}));
+    }
+    pipeline->Stop();
+
+    ASSERT_EQ(frameNum, frameIds_.size());
+    for (uint64_t i = 0; i < frameNum; i++) {
+        EXPECT_EQ(i, frameIds_[i]);
+        EXPECT_EQ(SUCCESS, results_[i]);
+        EXPECT_EQ(static_cast<float>((i + 1) * 2), values_[i]);
+    }
+    EXPECT_EQ(1U, outputBuffers_.size());
+    EXPECT_NE(SUCCESS, pipeline->Submit(frameNum, {CreateFrame(0.0f)}));
+}
+
+/*
+ * 测试用例名称: TestCase_Pipeline_002
+ * 测试用例描述: 前处理/推理/后处理三级流水线, 第2帧前处理、第1帧推理、第0帧后处理时输入值均为2,
+ *              三级在该值上互相等待
+ * 预期结果 :三级同时处于执行中, 等待均未超时, 结果正确
+ */
+TEST_F(PipelineUt, Pipeline_002)
+{
+    const uint64_t frameNum = 12;
+    LatchPoint latchPoint;
+    latchPoint.latch = std::make_shared<Latch>(3);
+    latchPoint.arriveValue = 2.0f;
+    latchPoint.arrivedNum = std::make_shared<std::atomic<int>>(0);
+    std::shared_ptr<IPipeline> pipeline = CreatePipeline(PipelineOptions());
+    ASSERT_NE(nullptr, pipeline);
+    ASSERT_EQ(SUCCESS, pipeline->AddCpuStage(AddOne(0, latchPoint)));
+    ASSERT_EQ(SUCCESS,
+        pipeline->AddModelStage(std::make_shared<StubModelManager>(latchPoint), std::make_shared<StubBuiltModel>()));
+    ASSERT_EQ(SUCCESS, pipeline->AddCpuStage(AddOne(0, latchPoint)));
+    ASSERT_EQ(SUCCESS, pipeline->Start(Collect()));
+
+    for (uint64_t i = 0; i < frameNum; i++) {
+        ASSERT_EQ(SUCCESS, pipeline->Submit(i, {CreateFrame(static_cast<float>(i))}));
+    }
+    pipeline->Stop();
+
+    EXPECT_EQ(3, latchPoint.arrivedNum->load());
+    ASSERT_EQ(frameNum, values_.size());
+    for (uint64_t i = 0; i < frameNum; i++) {
+        EXPECT_EQ(static_cast<float>((i + 1) * 2 + 1), values_[i]);
+    }
+}
+
+/*
+ * 测试用例名称: TestCase_Pipeline_003
+ * 测试用例描述: 非法参数, 未Start时Submit, Start后增加stage, 中间级失败
+ * 预期结果 :失败的帧不再进入后续各级, 完成回调收到错误码
+ */
+TEST_F(PipelineUt, Pipeline_003)
+{
+    PipelineOptions options;
+    options.queueDepth = 0;
+    EXPECT_EQ(nullptr, CreatePipeline(options));
+
+    std::shared_ptr<IPipeline> pipeline = CreatePipeline(PipelineOptions());
+    ASSERT_NE(nullptr, pipeline);
+    EXPECT_NE(SUCCESS, pipeline->Start(Collect()));
+    EXPECT_NE(SUCCESS, pipeline->AddModelStage(nullptr, std::make_shared<StubBuiltModel>()));
+    EXPECT_NE(SUCCESS, pipeline->AddCpuStage(nullptr));
+
+    std::atomic<int> lastStageNum {0};
+    ASSERT_EQ(SUCCESS, pipeline->AddCpuStage([](const PipelineTensors& inputs, PipelineTensors& outputs) {
+        outputs = inputs;
+        return GetValue(inputs) < 0 ? FAILURE : SUCCESS;
+    }));
+    ASSERT_EQ(SUCCESS, pipeline->AddCpuStage([&lastStageNum](const PipelineTensors& inputs, PipelineTensors& outputs) {
+        lastStageNum++;
+        outputs = inputs;
+        return SUCCESS;
+    }));
+    EXPECT_NE(SUCCESS, pipeline->Submit(0, {CreateFrame(1.0f)}));
+    ASSERT_EQ(SUCCESS, pipeline->Start(Collect()));
+    EXPECT_NE(SUCCESS, pipeline->AddCpuStage(AddOne()));
+    EXPECT_NE(SUCCESS, pipeline->Start(Collect()));
+
+    ASSERT_EQ(SUCCESS, pipeline->Submit(0, {CreateFrame(-1.0f)}));
+    ASSERT_EQ(SUCCESS, pipeline->Submit(1, {CreateFrame(1.0f)}));
+    pipeline->Stop();
+    pipeline->Stop();
+
+    ASSERT_EQ(2U, results_.size());
+    EXPECT_EQ(FAILURE, results_[0]);
+    EXPECT_EQ(-1.0f, values_[0]);
+    EXPECT_EQ(SUCCESS, results_[1]);
+    EXPECT_EQ(1, lastStageNum.load());
+}
@@ -0,0 +1,213 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <mockcpp/mockcpp.hpp>
+#include <thread>
+#include <mutex>
+#include <memory>
+
+#include "model_manager/core/request_scheduler_impl.h"
+#include "model_manager/core/model_manager_impl.h"
+
+using namespace std;
+using namespace hiai;
+
+class RequestSchedulerUt : public testing::Test {
+public:
+    void SetUp()
+    {
+        RequestSchedulerOptions options;
+        options.maxConcurrency = 1;
+        options.agingIntervalInMS = 0;
+        SetRequestSchedulerOptions(options);
+        RequestScheduler::GetInstance().ResetStats();
+    }
+
+    void TearDown()
+    {
+        SetRequestSchedulerOptions(RequestSchedulerOptions());
+        RequestScheduler::GetInstance().ResetStats();
+        GlobalMockObject::verify();
+    }
+
+    // 在新线程中发起请求, 等到其进入排队后返回
+    std::thread StartQueuedRequest(const void* owner, ModelPriority priority, int id)
+    {
+        size_t queued = RequestScheduler::GetInstance().GetQueuedNum();
+        std::thread thread([this, owner, priority, id] {
+            ScheduledRequest request(owner, priority);
+            Status ret = request.Admit();
+            std::lock_guard<std::mutex> lock(mutex_);
+            order_.push_back(ret == SUCCESS ? id : -id);
+        });
+        while (RequestScheduler::GetInstance().GetQueuedNum() == queued) {
+            std::this_thread::yield();
+        }
+        return thread;
+    }
+
+    static bool HasWaitingWriter(RWMutex& mutex)
+    {
+        std::lock_guard<std::mutex> lock(mutex.mutex_);
+        return mutex.waitingWriters_ != 0;
+    }
+
+public:
+    std::mutex mutex_;
+    std::vector<int> order_;
+};
+
+/*
+ * 测试用例名称: TestCase_Request_Scheduler_001
+ * 测试用例描述: 并发上限为1, 低优先级请求先排队, 高优先级请求后排队
+ * 预期结果 :名额释放后高优先级请求先执行
+ */
+TEST_F(RequestSchedulerUt, Request_Scheduler_001)
+{
+    int owner = 0;
+    std::unique_ptr<ScheduledRequest> running(new ScheduledRequest(&owner, PRIORITY_MIDDLE));
+    ASSERT_EQ(SUCCESS, running->Admit());
+
+    std::thread low = StartQueuedRequest(&owner, PRIORITY_LOW, 1);
+    std::thread high = StartQueuedRequest(&owner, PRIORITY_HIGH, 2);
+    running.reset();
+    low.join();
+    high.join();
+
+    ASSERT_EQ(2U, order_.size());
+    EXPECT_EQ(2, order_[0]);
+    EXPECT_EQ(1, order_[1]);
+
+    RequestSchedulerStats stats;
+    EXPECT_EQ(SUCCESS, GetRequestSchedulerStats(PRIORITY_LOW, stats));
+    EXPECT_EQ(1U, stats.requestNum);
+    EXPECT_GE(stats.p99Latency, stats.p99QueueDelay);
+    EXPECT_EQ(SUCCESS, GetRequestSchedulerStats(PRIORITY_MIDDLE, stats));
+    EXPECT_EQ(1U, stats.requestNum);
+    EXPECT_NE(SUCCESS, GetRequestSchedulerStats(static_cast<ModelPriority>(0), stats));
+}
+
+/*
+ * 测试用例名称: TestCase_Request_Scheduler_002
+ * 测试用例描述: 开启老化, 低优先级请求排队超过两个老化周期后高优先级请求才排队
+ * 预期结果 :低优先级请求先执行
+ */
+TEST_F(RequestSchedulerUt, Request_Scheduler_002)
+{
+    RequestSchedulerOptions options;
+    options.maxConcurrency = 1;
+    options.agingIntervalInMS = 1;
+    SetRequestSchedulerOptions(options);
+
+    int owner = 0;
+    std::unique_ptr<ScheduledRequest> running(new ScheduledRequest(&owner, PRIORITY_MIDDLE));
+    ASSERT_EQ(SUCCESS, running->Admit());
+
+    std::thread low = StartQueuedRequest(&owner, PRIORITY_LOW, 1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    std::thread high = StartQueuedRequest(&owner, PRIORITY_HIGH, 2);
+    running.reset();
+    low.join();
+    high.join();
+
+    ASSERT_EQ(2U, order_.size());
+    EXPECT_EQ(1, order_[0]);
+    EXPECT_EQ(2, order_[1]);
+}
+
+/*
+ * 测试用例名称: TestCase_Request_Scheduler_003
+ * 测试用例描述: 取消某个owner排队中的请求, 放宽并发上限放行其余请求
+ * 预期结果 :被取消的请求失败, 其余请求成功
+ */
+TEST_F(RequestSchedulerUt, Request_Scheduler_003)
+{
+    int lowOwner = 0;
+    int highOwner = 0;
+    std::unique_ptr<ScheduledRequest> running(new ScheduledRequest(&highOwner, PRIORITY_HIGH));
+    ASSERT_EQ(SUCCESS, running->Admit());
+
+    std::thread low = StartQueuedRequest(&lowOwner, PRIORITY_LOW, 1);
+    std::thread high = StartQueuedRequest(&highOwner, PRIORITY_HIGH, 2);
+    RequestScheduler::GetInstance().CancelQueued(&lowOwner);
+    low.join();
+
+    SetRequestSchedulerOptions(RequestSchedulerOptions());
+    high.join();
+    running.reset();
+
+    ASSERT_EQ(2U, order_.size());
+    EXPECT_EQ(-1, order_[0]);
+    EXPECT_EQ(2, order_[1]);
+
+    RequestSchedulerStats stats;
+    EXPECT_EQ(SUCCESS, GetRequestSchedulerStats(PRIORITY_LOW, stats));
+    EXPECT_EQ(0U, stats.requestNum);
+    EXPECT_EQ(1U, stats.cancelledNum);
+}
+
+/*
+ * 测试用例名称: TestCase_Request_Scheduler_004
+ * 测试用例描述: 并发上限为1, 模型管理器的Run排队; 执行中的请求持有读锁时SetPriority等待写锁, 此时Cancel
+ * 预期结果 :写锁调用等待期间排队的Run及时失败, 读锁释放后SetPriority和Cancel成功
+ */
+TEST_F(RequestSchedulerUt, Request_Scheduler_004)
+{
+    std::shared_ptr<ModelManagerImpl> modelManager =
+        std::dynamic_pointer_cast<ModelManagerImpl>(IModelManagerExt::CreateModelManagerExt());
+    ASSERT_NE(nullptr, modelManager);
+    int runtime = 0;
+    modelManager->modelManagers_.push_back(std::shared_ptr<HIAI_MR_ModelManager>(
+        reinterpret_cast<HIAI_MR_ModelManager*>(&runtime), [](HIAI_MR_ModelManager*) {}));
+
+    int owner = 0;
+    std::unique_ptr<ScheduledRequest> running(new ScheduledRequest(&owner, PRIORITY_MIDDLE));
+    ASSERT_EQ(SUCCESS, running->Admit());
+
+    size_t queued = RequestScheduler::GetInstance().GetQueuedNum();
+    Status runRet = SUCCESS;
+    std::thread run([&modelManager, &runRet] {
+        std::vector<std::shared_ptr<INDTensorBuffer>> inputs;
+        std::vector<std::shared_ptr<INDTensorBuffer>> outputs;
+        runRet = modelManager->Run(inputs, outputs);
+    });
+    while (RequestScheduler::GetInstance().GetQueuedNum() == queued) {
+        std::this_thread::yield();
+    }
+
+    // 模拟正在执行的请求持有读锁
+    std::unique_ptr<ReadLockGuard> inFlight(new ReadLockGuard(modelManager->modelManagerMutex_));
+    Status priorityRet = FAILURE;
+    std::thread setPriority([&modelManager, &priorityRet] {
+        priorityRet = modelManager->SetPriority(PRIORITY_LOW);
+    });
+    while (!HasWaitingWriter(modelManager->modelManagerMutex_)) {
+        std::this_thread::yield();
+    }
+
+    Status cancelRet = FAILURE;
+    std::thread cancel([&modelManager, &cancelRet] { cancelRet = modelManager->Cancel(); });
+    run.join();
+    EXPECT_EQ(FAILURE, runRet);
+
+    inFlight.reset();
+    setPriority.join();
+    cancel.join();
+    EXPECT_EQ(SUCCESS, priorityRet);
+    EXPECT_EQ(SUCCESS, cancelRet);
+    running.reset();
+    modelManager->modelManagers_.clear();
+}
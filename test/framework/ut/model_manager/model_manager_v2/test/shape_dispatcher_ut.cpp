@@ -0,0 +1,153 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <mockcpp/mockcpp.hpp>
+#include <thread>
+
+#include "model_manager/core/shape_dispatcher.h"
+
+using namespace std;
+using namespace hiai;
+
+namespace {
+NDTensorDesc MakeDesc(const std::vector<int32_t>& dims)
+{
+    NDTensorDesc desc;
+    desc.dims = dims;
+    return desc;
+}
+
+ShapeGear MakeGear(int32_t height, int32_t width)
+{
+    ShapeGear gear;
+    gear.inputDescs.push_back(MakeDesc({1, 1, height, width}));
+    gear.outputDescs.push_back(MakeDesc({1, 2, height, width}));
+    return gear;
+}
+
+std::shared_ptr<INDTensorBuffer> CreateInput(int32_t height, int32_t width)
+{
+    std::vector<float> data(height * width);
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = static_cast<float>(i + 1);
+    }
+    return CreateNDTensorBuffer(MakeDesc({1, 1, height, width}), data.data(), data.size() * sizeof(float));
+}
+} // namespace
+
+class ShapeDispatcherUt : public testing::Test {
+public:
+    void SetUp()
+    {
+    }
+
+    void TearDown()
+    {
+        GlobalMockObject::verify();
+    }
+};
+
+/*
+ * 测试用例名称: TestCase_Shape_Dispatcher_001
+ * 测试用例描述: 登记两个档位, 输入shape与档位一致, 多次分派
+ * 预期结果 :不拷贝输入, 输出为该档位的shape, 输出被释放后归还复用
+ */
+TEST_F(ShapeDispatcherUt, Shape_Dispatcher_001)
+{
+    ShapeDispatcher dispatcher;
+    ASSERT_EQ(SUCCESS, dispatcher.Init({MakeGear(4, 4), MakeGear(2, 2)}, ShapeDispatchOptions()));
+
+    TensorBuffers inputs = {CreateInput(4, 4)};
+    TensorBuffers gearInputs;
+    TensorBuffers outputs;
+    ASSERT_EQ(SUCCESS, dispatcher.Dispatch(inputs, gearInputs, outputs));
+    EXPECT_TRUE(gearInputs.empty());
+    ASSERT_EQ(1U, outputs.size());
+    EXPECT_EQ(std::vector<int32_t>({1, 2, 4, 4}), outputs[0]->GetTensorDesc().dims);
+    INDTensorBuffer* first = outputs[0].get();
+
+    // 输出仍被持有时分配新的一组
+    TensorBuffers otherOutputs;
+    ASSERT_EQ(SUCCESS, dispatcher.Dispatch(inputs, gearInputs, otherOutputs));
+    EXPECT_NE(first, otherOutputs[0].get());
+
+    INDTensorBuffer* second = otherOutputs[0].get();
+
+    // 在其他线程释放后归还, 再次分派时复用
+    std::thread consumer([&outputs, &otherOutputs] {
+        outputs.clear();
+        otherOutputs.clear();
+    });
+    consumer.join();
+    ASSERT_EQ(SUCCESS, dispatcher.Dispatch(inputs, gearInputs, outputs));
+    EXPECT_TRUE(outputs[0].get() == first || outputs[0].get() == second);
+
+    // 切换到另一档位
+    inputs = {CreateInput(2, 2)};
+    outputs.clear();
+    ASSERT_EQ(SUCCESS, dispatcher.Dispatch(inputs, gearInputs, outputs));
+    EXPECT_EQ(std::vector<int32_t>({1, 2, 2, 2}), outputs[0]->GetTensorDesc().dims);
+}
+
+/*
+ * 测试用例名称: TestCase_Shape_Dispatcher_002
+ * 测试用例描述: 开启补零, 输入shape不属于任何档位
+ * 预期结果 :补零到能容纳输入的最小档位, 原数据位于左上角
+ */
+TEST_F(ShapeDispatcherUt, Shape_Dispatcher_002)
+{
+    ShapeDispatchOptions options;
+    options.padToLargerGear = true;
+    ShapeDispatcher dispatcher;
+    ASSERT_EQ(SUCCESS, dispatcher.Init({MakeGear(8, 8), MakeGear(4, 4), MakeGear(2, 2)}, options));
+
+    TensorBuffers inputs = {CreateInput(3, 2)};
+    TensorBuffers gearInputs;
+    TensorBuffers outputs;
+    ASSERT_EQ(SUCCESS, dispatcher.Dispatch(inputs, gearInputs, outputs));
+    ASSERT_EQ(1U, gearInputs.size());
+    EXPECT_EQ(std::vector<int32_t>({1, 1, 4, 4}), gearInputs[0]->GetTensorDesc().dims);
+    EXPECT_EQ(std::vector<int32_t>({1, 2, 4, 4}), outputs[0]->GetTensorDesc().dims);
+
+    const float* padded = static_cast<const float*>(gearInputs[0]->GetData());
+    const std::vector<float> expected = {1, 2, 0, 0, 3, 4, 0, 0, 5, 6, 0, 0, 0, 0, 0, 0};
+    EXPECT_EQ(expected, std::vector<float>(padded, padded + expected.size()));
+}
+
+/*
+ * 测试用例名称: TestCase_Shape_Dispatcher_003
+ * 测试用例描述: 非法档位登记, 未开启补零或超出最大档位时分派
+ * 预期结果 :返回INVALID_PARAM
+ */
+TEST_F(ShapeDispatcherUt, Shape_Dispatcher_003)
+{
+    ShapeDispatcher dispatcher;
+    EXPECT_EQ(INVALID_PARAM, dispatcher.Init({}, ShapeDispatchOptions()));
+    EXPECT_EQ(INVALID_PARAM, dispatcher.Init({MakeGear(-1, 4)}, ShapeDispatchOptions()));
+
+    ShapeDispatchOptions options;
+    ASSERT_EQ(SUCCESS, dispatcher.Init({MakeGear(4, 4)}, options));
+    TensorBuffers inputs = {CreateInput(2, 2)};
+    TensorBuffers gearInputs;
+    TensorBuffers outputs;
+    EXPECT_EQ(INVALID_PARAM, dispatcher.Dispatch(inputs, gearInputs, outputs));
+
+    options.padToLargerGear = true;
+    ASSERT_EQ(SUCCESS, dispatcher.Init({MakeGear(4, 4)}, options));
+    inputs = {CreateInput(5, 2)};
+    EXPECT_EQ(INVALID_PARAM, dispatcher.Dispatch(inputs, gearInputs, outputs));
+    EXPECT_TRUE(outputs.empty());
+}
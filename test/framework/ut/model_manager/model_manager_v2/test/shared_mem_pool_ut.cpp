@@ -0,0 +1,195 @@
+/**
+ * Copyright 2019-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <mockcpp/mockcpp.hpp>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "model_manager/shared_mem_pool.h"
+#include "model_manager/core/shared_mem_pool_impl.h"
+#include "model_manager/core/model_manager_impl.h"
+#include "framework/c/hiai_native_handle.h"
+
+using namespace std;
+using namespace hiai;
+
+namespace {
+// 以memfd模拟ion/dmabuf, 每次申请切成handleNum个handle
+class MemfdAllocator : public ISharedMemAllocator {
+public:
+    explicit MemfdAllocator(size_t handleNum = 1) : handleNum_(handleNum)
+    {
+    }
+
+    std::vector<NativeHandle> Allocate(size_t size) override
+    {
+        std::vector<NativeHandle> handles;
+        size_t handleSize = (size + handleNum_ - 1) / handleNum_;
+        for (size_t i = 0; i < handleNum_; i++) {
+            int fd = memfd_create("hiai_ut", 0);
+            if (fd < 0 || ftruncate(fd, static_cast<off_t>(handleSize)) != 0) {
+                Free(handles);
+                return {};
+            }
+            handles.push_back({fd, static_cast<int>(handleSize), 0});
+        }
+        allocateNum_++;
+        return handles;
+    }
+
+    void Free(std::vector<NativeHandle>& handles) override
+    {
+        for (const auto& handle : handles) {
+            close(handle.fd);
+        }
+        freeNum_ += handles.empty() ? 0 : 1;
+    }
+
+public:
+    size_t handleNum_;
+    uint32_t allocateNum_ {0};
+    uint32_t freeNum_ {0};
+};
+} // namespace
+
+class SharedMemPoolUt : public testing::Test {
+public:
+    void SetUp()
+    {
+        memfdAllocator_ = std::make_shared<MemfdAllocator>();
+    }
+
+    void TearDown()
+    {
+        GlobalMockObject::verify();
+    }
+
+public:
+    std::shared_ptr<MemfdAllocator> memfdAllocator_;
+};
+
+/*
+ * 测试用例名称: TestCase_Shared_Mem_Pool_001
+ * 测试用例描述: 申请后释放, 再次申请同一档位的大小
+ * 预期结果 :复用缓存的内存, 统计命中率及内部碎片
+ */
+TEST_F(SharedMemPoolUt, Shared_Mem_Pool_001)
+{
+    EXPECT_EQ(4096U, SharedMemPool::GetSizeClass(1));
+    EXPECT_EQ(5120U, SharedMemPool::GetSizeClass(4097));
+    EXPECT_EQ(10240U, SharedMemPool::GetSizeClass(10000));
+
+    std::shared_ptr<ISharedMemAllocator> pool =
+        CreatePooledSharedMemAllocator(memfdAllocator_, SharedMemPoolOptions());
+    ASSERT_NE(nullptr, pool);
+
+    std::vector<NativeHandle> handles = pool->Allocate(10000);
+    ASSERT_EQ(1U, handles.size());
+    EXPECT_EQ(10240, handles[0].size);
+    int fd = handles[0].fd;
+
+    SharedMemPoolStats stats;
+    ASSERT_EQ(SUCCESS, GetSharedMemPoolStats(pool, stats));
+    EXPECT_EQ(10240U, stats.inUseBytes);
+    EXPECT_EQ(10000U, stats.requestedBytes);
+
+    pool->Free(handles);
+    handles = pool->Allocate(9000);
+    ASSERT_EQ(1U, handles.size());
+    EXPECT_EQ(fd, handles[0].fd);
+    EXPECT_EQ(1U, memfdAllocator_->allocateNum_);
+
+    ASSERT_EQ(SUCCESS, GetSharedMemPoolStats(pool, stats));
+    EXPECT_EQ(2U, stats.allocateNum);
+    EXPECT_EQ(1U, stats.hitNum);
+    EXPECT_EQ(9000U, stats.requestedBytes);
+    EXPECT_EQ(0U, stats.cachedBytes);
+    pool->Free(handles);
+}
+
+/*
+ * 测试用例名称: TestCase_Shared_Mem_Pool_002
+ * 测试用例描述: 缓存上限为8K, 释放3块4K内存; 释放非本池申请的内存; 非法参数
+ * 预期结果 :超出上限的块归还给被包装的分配器, 非本池的内存直接释放
+ */
+TEST_F(SharedMemPoolUt, Shared_Mem_Pool_002)
+{
+    EXPECT_EQ(nullptr, CreatePooledSharedMemAllocator(nullptr, SharedMemPoolOptions()));
+    SharedMemPoolStats stats;
+    EXPECT_EQ(INVALID_PARAM, GetSharedMemPoolStats(memfdAllocator_, stats));
+
+    SharedMemPoolOptions options;
+    options.maxCachedBytes = 8192;
+    std::shared_ptr<ISharedMemAllocator> pool = CreatePooledSharedMemAllocator(memfdAllocator_, options);
+    EXPECT_TRUE(pool->Allocate(0).empty());
+
+    std::vector<std::vector<NativeHandle>> blocks;
+    for (int i = 0; i < 3; i++) {
+        blocks.push_back(pool->Allocate(100));
+    }
+    for (auto& block : blocks) {
+        pool->Free(block);
+    }
+    EXPECT_EQ(1U, memfdAllocator_->freeNum_);
+    ASSERT_EQ(SUCCESS, GetSharedMemPoolStats(pool, stats));
+    EXPECT_EQ(8192U, stats.cachedBytes);
+    EXPECT_EQ(2U, stats.cachedBlockNum);
+
+    std::vector<NativeHandle> foreign = memfdAllocator_->Allocate(100);
+    pool->Free(foreign);
+    EXPECT_EQ(2U, memfdAllocator_->freeNum_);
+
+    pool.reset();
+    EXPECT_EQ(4U, memfdAllocator_->freeNum_);
+}
+
+/*
+ * 测试用例名称: TestCase_Shared_Mem_Pool_003
+ * 测试用例描述: 模型管理器以带缓存的分配器申请10个handle的内存, 释放后再次申请; 再申请11个handle的内存
+ * 预期结果 :第二次申请命中缓存; handlesSize仅为出参, 超过10个handle时申请失败
+ */
+TEST_F(SharedMemPoolUt, Shared_Mem_Pool_003)
+{
+    const size_t handleNum = 10;
+    std::shared_ptr<ISharedMemAllocator> pool =
+        CreatePooledSharedMemAllocator(std::make_shared<MemfdAllocator>(handleNum), SharedMemPoolOptions());
+    std::shared_ptr<ModelManagerImpl> modelManager =
+        std::dynamic_pointer_cast<ModelManagerImpl>(IModelManagerExt::CreateModelManagerExt());
+    ASSERT_NE(nullptr, modelManager);
+    ASSERT_EQ(SUCCESS, modelManager->PrepareSharedMemAllocator(pool));
+    void* userData = modelManager->cAllocator_->userData;
+
+    HIAI_NativeHandle* handles[handleNum + 1] = {nullptr};
+    for (int i = 0; i < 2; i++) {
+        size_t handlesSize = 0;
+        ModelManagerImpl::OnAllocate(userData, 65536, handles, &handlesSize);
+        ASSERT_EQ(handleNum, handlesSize);
+        EXPECT_EQ(handleNum, modelManager->nativeHandles_.size());
+        ModelManagerImpl::OnFree(userData, handles, handlesSize);
+        EXPECT_TRUE(modelManager->nativeHandles_.empty());
+    }
+    SharedMemPoolStats stats;
+    ASSERT_EQ(SUCCESS, GetSharedMemPoolStats(pool, stats));
+    EXPECT_EQ(1U, stats.hitNum);
+
+    std::shared_ptr<MemfdAllocator> overCap = std::make_shared<MemfdAllocator>(handleNum + 1);
+    ASSERT_EQ(SUCCESS, modelManager->PrepareSharedMemAllocator(overCap));
+    size_t handlesSize = handleNum + 1;
+    ModelManagerImpl::OnAllocate(modelManager->cAllocator_->userData, 65536, handles, &handlesSize);
+    EXPECT_EQ(0U, handlesSize);
+    EXPECT_TRUE(modelManager->nativeHandles_.empty());
+    EXPECT_EQ(1U, overCap->freeNum_);
+}